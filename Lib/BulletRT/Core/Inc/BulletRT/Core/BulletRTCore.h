@@ -10,10 +10,18 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <functional>
 namespace BulletRT
 {
     namespace Core
     {
+        // FNV-1a over the raw bytes, chained through seed. Shared by every content hash of the library; only pass padding
+        // free, trivially copyable data.
+        auto HashBytes(const void *pData, size_t sizeInBytes, uint64_t seed = 0xcbf29ce484222325ull) noexcept -> uint64_t;
+
         class VulkanContext
         {
         public:
@@ -464,6 +472,8 @@ namespace BulletRT
         }
 
         class VulkanDevice;
+        class VulkanFence;
+        class VulkanSubmitDesc;
 
         class VulkanQueue
         {
@@ -480,6 +490,9 @@ namespace BulletRT
             auto GetQueueIndex() const noexcept -> uint32_t { return m_QueueIndex; }
             auto GetQueuePriority() const noexcept -> float { return m_Priority; }
 
+            auto Submit(const std::vector<VulkanSubmitDesc> &submitDescs, const VulkanFence *fence = nullptr) const -> vk::Result;
+            auto Submit(const VulkanSubmitDesc &submitDesc, const VulkanFence *fence = nullptr) const -> vk::Result;
+
         private:
             VulkanQueue() noexcept;
 
@@ -583,12 +596,15 @@ namespace BulletRT
         class VulkanCommandPool
         {
         public:
-            static auto New(const VulkanDevice *device, uint32_t queueFamilyIndex) noexcept -> std::unique_ptr<VulkanCommandPool>;
+            static auto New(const VulkanDevice *device, uint32_t queueFamilyIndex, vk::CommandPoolCreateFlags flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer) noexcept -> std::unique_ptr<VulkanCommandPool>;
             ~VulkanCommandPool() noexcept;
 
+            auto Reset(vk::CommandPoolResetFlags flags = {}) const noexcept -> vk::Result;
+
             auto GetDevice() const noexcept -> const VulkanDevice *;
             auto GetCommandPoolVk() const noexcept -> vk::CommandPool;
             auto GetQueueFamilyIndex() const noexcept -> uint32_t;
+            auto GetFlags() const noexcept -> vk::CommandPoolCreateFlags;
 
             auto NewCommandBuffer(vk::CommandBufferLevel level) const noexcept -> std::unique_ptr<VulkanCommandBuffer>;
 
@@ -599,6 +615,7 @@ namespace BulletRT
             const VulkanDevice *m_Device;
             vk::UniqueCommandPool m_CommandPool;
             uint32_t m_QueueFamilyIndex;
+            vk::CommandPoolCreateFlags m_Flags;
         };
 
         class VulkanCommandBuffer
@@ -618,6 +635,49 @@ namespace BulletRT
             vk::UniqueCommandBuffer m_CommandBuffer;
         };
 
+        // Hands out reusable command buffers from one transient pool per recording thread and
+        // frame slot. BeginFrame waits for the fence of the slot it is about to reuse, then resets
+        // every pool in it with vkResetCommandPool. Allocate may be called from any thread between
+        // BeginFrame and EndFrame; BeginFrame and EndFrame themselves must not race with Allocate.
+        class VulkanCommandBufferAllocator
+        {
+        public:
+            static auto New(const VulkanDevice *device, uint32_t queueFamilyIndex, uint32_t frameCount) -> std::unique_ptr<VulkanCommandBufferAllocator>;
+            virtual ~VulkanCommandBufferAllocator() noexcept;
+
+            auto BeginFrame() -> vk::Result;
+            auto Allocate(vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary) -> vk::CommandBuffer;
+            void EndFrame(const VulkanFence *fence);
+
+            auto GetDevice() const noexcept -> const VulkanDevice * { return m_Device; }
+            auto GetQueueFamilyIndex() const noexcept -> uint32_t { return m_QueueFamilyIndex; }
+            auto GetFrameCount() const noexcept -> uint32_t { return static_cast<uint32_t>(m_Frames.size()); }
+            auto GetFrameIndex() const noexcept -> uint32_t { return m_FrameIndex; }
+
+        private:
+            struct PoolDesc
+            {
+                std::unique_ptr<VulkanCommandPool> commandPool;
+                std::vector<vk::CommandBuffer> commandBuffers[2];
+                size_t cursors[2];
+            };
+            struct FrameDesc
+            {
+                std::unordered_map<std::thread::id, std::unique_ptr<PoolDesc>> pools;
+                const VulkanFence *fence;
+            };
+            VulkanCommandBufferAllocator() noexcept;
+
+            auto Impl_AcquirePool() -> PoolDesc *;
+
+        private:
+            const VulkanDevice *m_Device;
+            uint32_t m_QueueFamilyIndex;
+            uint32_t m_FrameIndex;
+            std::vector<FrameDesc> m_Frames;
+            std::mutex m_Mutex;
+        };
+
         class VulkanDeviceBuilder
         {
         public:
@@ -630,6 +690,7 @@ namespace BulletRT
                 m_QueueFamilyMap = {};
                 m_ExtProps = physicalDevice.enumerateDeviceExtensionProperties();
                 m_QueueFamilyProperties = physicalDevice.getQueueFamilyProperties();
+                m_PipelineCacheFilename = "";
             }
             VulkanDeviceBuilder(const VulkanDeviceBuilder &) noexcept = default;
             VulkanDeviceBuilder &operator=(const VulkanDeviceBuilder &) noexcept = default;
@@ -711,6 +772,14 @@ namespace BulletRT
             {
                 return m_QueueFamilyMap;
             }
+            // PipelineCache
+            // The device cache is loaded from this file at creation and saved back to it on destruction.
+            auto SetPipelineCacheFilename(const std::string &filename) noexcept -> VulkanDeviceBuilder &
+            {
+                m_PipelineCacheFilename = filename;
+                return *this;
+            }
+            auto GetPipelineCacheFilename() const noexcept -> const std::string & { return m_PipelineCacheFilename; }
             auto Build() const -> std::unique_ptr<VulkanDevice>;
 
         private:
@@ -721,9 +790,27 @@ namespace BulletRT
             std::unordered_map<uint32_t, VulkanQueueFamilyBuilder> m_QueueFamilyMap;
             std::vector<vk::ExtensionProperties> m_ExtProps;
             std::vector<vk::QueueFamilyProperties> m_QueueFamilyProperties;
+            std::string m_PipelineCacheFilename;
         };
 
-        class VulkanFence;
+        class VulkanSemaphore;
+        class VulkanPipelineCache;
+
+        struct VulkanSyncObjectPoolStatistics
+        {
+            size_t fenceAcquireCount;
+            size_t fenceCreateCount;
+            size_t semaphoreAcquireCount;
+            size_t semaphoreCreateCount;
+            auto GetFenceHitRate() const noexcept -> float
+            {
+                return fenceAcquireCount > 0 ? 1.0f - static_cast<float>(fenceCreateCount) / static_cast<float>(fenceAcquireCount) : 0.0f;
+            }
+            auto GetSemaphoreHitRate() const noexcept -> float
+            {
+                return semaphoreAcquireCount > 0 ? 1.0f - static_cast<float>(semaphoreCreateCount) / static_cast<float>(semaphoreAcquireCount) : 0.0f;
+            }
+        };
 
         class VulkanDevice
         {
@@ -734,6 +821,22 @@ namespace BulletRT
 
             auto NewFence(bool isSignaled = false) -> std::unique_ptr<VulkanFence>;
             auto WaitForFences(const std::vector<const VulkanFence *> &fences, uint64_t timeOut = UINT64_MAX, VkBool32 waitForAll = VK_FALSE) -> vk::Result;
+            auto NewSemaphore(vk::SemaphoreType semaphoreType = vk::SemaphoreType::eBinary, uint64_t initialValue = 0) -> std::unique_ptr<VulkanSemaphore>;
+            auto WaitForSemaphores(const std::vector<const VulkanSemaphore *> &semaphores, const std::vector<uint64_t> &values, uint64_t timeOut = UINT64_MAX, VkBool32 waitForAll = VK_TRUE) -> vk::Result;
+
+            // Pooled sync objects. Acquired fences are unsignaled; released fences are reset by the pool.
+            // Binary semaphores must be unsignaled with no pending wait when they are released.
+            auto AcquireFence() const -> std::unique_ptr<VulkanFence>;
+            void ReleaseFence(std::unique_ptr<VulkanFence> fence) const;
+            auto AcquireSemaphore() const -> std::unique_ptr<VulkanSemaphore>;
+            void ReleaseSemaphore(std::unique_ptr<VulkanSemaphore> semaphore) const;
+            auto QuerySyncObjectPoolStatistics() const -> VulkanSyncObjectPoolStatistics;
+
+            // Shared by every pipeline builder that is not given a cache of its own; null if it could not be created.
+            auto GetPipelineCache() const noexcept -> VulkanPipelineCache *;
+            auto GetPipelineCacheFilename() const noexcept -> const std::string & { return m_PipelineCacheFilename; }
+            // An empty filename saves to the file given to the builder.
+            auto SavePipelineCache(const std::string &filename = "") const -> vk::Result;
 
             auto GetInstance() const noexcept -> const VulkanInstance * { return m_Instance; }
             auto GetPhysicalDeviceVk() const noexcept -> vk::PhysicalDevice { return m_PhysicalDevice; }
@@ -773,6 +876,12 @@ namespace BulletRT
             std::unordered_set<std::string> m_EnabledExtNameSet;
             VulkanDeviceFeaturesSet m_EnabledFeaturesSet;
             std::unordered_map<uint32_t, VulkanQueueFamilyBuilder> m_QueueFamilyMap;
+            mutable std::mutex m_SyncObjectPoolMutex;
+            mutable std::vector<std::unique_ptr<VulkanFence>> m_FreeFences;
+            mutable std::vector<std::unique_ptr<VulkanSemaphore>> m_FreeSemaphores;
+            mutable VulkanSyncObjectPoolStatistics m_SyncObjectPoolStatistics;
+            std::unique_ptr<VulkanPipelineCache> m_PipelineCache;
+            std::string m_PipelineCacheFilename;
         };
 
         class VulkanFence
@@ -783,6 +892,7 @@ namespace BulletRT
 
             auto Wait(uint64_t timeout) const noexcept -> vk::Result;
             auto QueryStatus() const noexcept -> vk::Result;
+            auto Reset() const noexcept -> vk::Result;
             auto GetFenceVk() const noexcept -> vk::Fence { return m_Fence.get(); }
             auto GetDevice() const noexcept -> const VulkanDevice * { return m_Device; }
             auto GetDeviceVk() const noexcept -> vk::Device { return m_Device->GetDeviceVk(); }
@@ -795,6 +905,66 @@ namespace BulletRT
             vk::UniqueFence m_Fence;
         };
 
+        class VulkanSemaphore
+        {
+        public:
+            static auto New(const VulkanDevice *device, vk::SemaphoreType semaphoreType = vk::SemaphoreType::eBinary, uint64_t initialValue = 0) -> std::unique_ptr<VulkanSemaphore>;
+            virtual ~VulkanSemaphore() noexcept;
+
+            // Host side operations, only valid on timeline semaphores.
+            auto Signal(uint64_t value) const noexcept -> vk::Result;
+            auto Wait(uint64_t value, uint64_t timeout = UINT64_MAX) const noexcept -> vk::Result;
+            auto QueryCounterValue() const noexcept -> std::optional<uint64_t>;
+
+            auto GetSemaphoreVk() const noexcept -> vk::Semaphore { return m_Semaphore.get(); }
+            auto GetSemaphoreType() const noexcept -> vk::SemaphoreType { return m_SemaphoreType; }
+            bool IsTimeline() const noexcept { return m_SemaphoreType == vk::SemaphoreType::eTimeline; }
+            auto GetDevice() const noexcept -> const VulkanDevice * { return m_Device; }
+            auto GetDeviceVk() const noexcept -> vk::Device { return m_Device->GetDeviceVk(); }
+
+        private:
+            VulkanSemaphore() noexcept;
+
+        private:
+            const VulkanDevice *m_Device;
+            vk::UniqueSemaphore m_Semaphore;
+            vk::SemaphoreType m_SemaphoreType;
+        };
+
+        class VulkanSubmitDesc
+        {
+        public:
+            VulkanSubmitDesc() noexcept = default;
+            VulkanSubmitDesc(const VulkanSubmitDesc &) noexcept = default;
+            VulkanSubmitDesc &operator=(const VulkanSubmitDesc &) noexcept = default;
+
+            // The value is ignored for binary semaphores. A raw handle counts as a timeline semaphore when it is given a nonzero value;
+            // pass timeline semaphores waited or signalled at 0 through the VulkanSemaphore overloads.
+            auto AddWaitSemaphore(const VulkanSemaphore *semaphore, vk::PipelineStageFlags stageMask, uint64_t value = 0) noexcept -> VulkanSubmitDesc &;
+            auto AddWaitSemaphore(vk::Semaphore semaphore, vk::PipelineStageFlags stageMask, uint64_t value = 0) noexcept -> VulkanSubmitDesc &;
+            auto AddCommandBuffer(const VulkanCommandBuffer *commandBuffer) noexcept -> VulkanSubmitDesc &;
+            auto AddCommandBuffer(vk::CommandBuffer commandBuffer) noexcept -> VulkanSubmitDesc &;
+            auto AddSignalSemaphore(const VulkanSemaphore *semaphore, uint64_t value = 0) noexcept -> VulkanSubmitDesc &;
+            auto AddSignalSemaphore(vk::Semaphore semaphore, uint64_t value = 0) noexcept -> VulkanSubmitDesc &;
+
+            auto GetWaitSemaphores() const noexcept -> const std::vector<vk::Semaphore> & { return m_WaitSemaphores; }
+            auto GetWaitDstStageMasks() const noexcept -> const std::vector<vk::PipelineStageFlags> & { return m_WaitDstStageMasks; }
+            auto GetWaitValues() const noexcept -> const std::vector<uint64_t> & { return m_WaitValues; }
+            auto GetCommandBuffers() const noexcept -> const std::vector<vk::CommandBuffer> & { return m_CommandBuffers; }
+            auto GetSignalSemaphores() const noexcept -> const std::vector<vk::Semaphore> & { return m_SignalSemaphores; }
+            auto GetSignalValues() const noexcept -> const std::vector<uint64_t> & { return m_SignalValues; }
+            bool HasTimelineSemaphore() const noexcept { return m_HasTimelineSemaphore; }
+
+        private:
+            std::vector<vk::Semaphore> m_WaitSemaphores = {};
+            std::vector<vk::PipelineStageFlags> m_WaitDstStageMasks = {};
+            std::vector<uint64_t> m_WaitValues = {};
+            std::vector<vk::CommandBuffer> m_CommandBuffers = {};
+            std::vector<vk::Semaphore> m_SignalSemaphores = {};
+            std::vector<uint64_t> m_SignalValues = {};
+            bool m_HasTimelineSemaphore = false;
+        };
+
         class VulkanBuffer;
 
         class VulkanBufferBuilder
@@ -890,6 +1060,7 @@ namespace BulletRT
                 m_MipLevels = 1;
                 m_ArrayLayers = 1;
                 m_Samples = vk::SampleCountFlagBits::e1;
+                m_Tiling = vk::ImageTiling::eOptimal;
                 m_Usage = {};
                 m_QueueFamilyIndices = {};
                 m_InitialLayout = vk::ImageLayout::eUndefined;
@@ -1044,6 +1215,7 @@ namespace BulletRT
                 m_MemoryTypeIndex = 0;
                 m_MemoryAllocateFlagsInfo = std::nullopt;
                 m_MemoryDedicatedAllocateInfo = std::nullopt;
+                m_PersistentMapped = false;
             }
 
             VulkanDeviceMemoryBuilder(const VulkanDeviceMemoryBuilder &) = default;
@@ -1084,6 +1256,13 @@ namespace BulletRT
                 return *this;
             }
 
+            auto GetPersistentMapped() const noexcept -> bool { return m_PersistentMapped; }
+            auto SetPersistentMapped(bool persistentMapped) noexcept -> VulkanDeviceMemoryBuilder &
+            {
+                m_PersistentMapped = persistentMapped;
+                return *this;
+            }
+
             auto Build(const VulkanDevice *device) const -> std::unique_ptr<VulkanDeviceMemory>;
 
         private:
@@ -1091,6 +1270,7 @@ namespace BulletRT
             uint32_t m_MemoryTypeIndex;
             std::optional<vk::MemoryAllocateFlagsInfo> m_MemoryAllocateFlagsInfo;
             std::optional<vk::MemoryDedicatedAllocateInfo> m_MemoryDedicatedAllocateInfo;
+            bool m_PersistentMapped;
         };
 
         class VulkanDeviceMemory
@@ -1100,14 +1280,23 @@ namespace BulletRT
             static auto New(const VulkanDevice *device, const VulkanDeviceMemoryBuilder &builder) -> std::unique_ptr<VulkanDeviceMemory>;
             virtual ~VulkanDeviceMemory() noexcept;
 
+            // The whole allocation is mapped once and shared; every Map must be paired with an Unmap.
             auto Map(void **pPData, vk::MemoryMapFlags flags = {}) const -> vk::Result;
             auto Map(void **pPData, vk::DeviceSize size, vk::DeviceSize offset = 0, vk::MemoryMapFlags flags = {}) const -> vk::Result;
             void Unmap() const;
+            auto FlushMappedRange(vk::DeviceSize size = VK_WHOLE_SIZE, vk::DeviceSize offset = 0) const -> vk::Result;
+            auto InvalidateMappedRange(vk::DeviceSize size = VK_WHOLE_SIZE, vk::DeviceSize offset = 0) const -> vk::Result;
+
+            auto GetMappedData() const noexcept -> void *;
+            bool IsPersistentMapped() const noexcept { return m_PersistentMapped; }
+            bool IsHostVisible() const noexcept { return static_cast<bool>(m_MemoryPropertyFlags & vk::MemoryPropertyFlagBits::eHostVisible); }
+            bool IsHostCoherent() const noexcept { return static_cast<bool>(m_MemoryPropertyFlags & vk::MemoryPropertyFlagBits::eHostCoherent); }
 
             auto GetDevice() const -> const VulkanDevice * { return m_Device; }
             auto GetDeviceMemoryVk() const -> vk::DeviceMemory { return m_DeviceMemory.get(); }
             auto GetAllocationSize() const noexcept -> vk::DeviceSize { return m_AllocationSize; }
             auto GetMemoryTypeIndex() const noexcept -> uint32_t { return m_MemoryTypeIndex; }
+            auto GetMemoryPropertyFlags() const noexcept -> vk::MemoryPropertyFlags { return m_MemoryPropertyFlags; }
             auto GetMemoryAllocateFlagsInfo() const noexcept -> const std::optional<vk::MemoryAllocateFlagsInfo> &
             {
                 return m_MemoryAllocateFlagsInfo;
@@ -1120,13 +1309,21 @@ namespace BulletRT
         private:
             VulkanDeviceMemory() noexcept;
 
+            auto Impl_GetMappedRangeVk(vk::DeviceSize size, vk::DeviceSize offset) const noexcept -> vk::MappedMemoryRange;
+
         private:
             const VulkanDevice *m_Device;
             vk::UniqueDeviceMemory m_DeviceMemory;
             vk::DeviceSize m_AllocationSize;
             uint32_t m_MemoryTypeIndex;
+            vk::MemoryPropertyFlags m_MemoryPropertyFlags;
+            vk::DeviceSize m_NonCoherentAtomSize;
             std::optional<vk::MemoryAllocateFlagsInfo> m_MemoryAllocateFlagsInfo;
             std::optional<vk::MemoryDedicatedAllocateInfo> m_MemoryDedicatedAllocateInfo;
+            bool m_PersistentMapped;
+            mutable std::mutex m_MapMutex;
+            mutable void *m_MappedData;
+            mutable uint32_t m_MapCount;
         };
 
         class VulkanMemoryBuffer
@@ -1138,6 +1335,8 @@ namespace BulletRT
             auto Map(void **pPData, vk::MemoryMapFlags flags = {}) const -> vk::Result;
             auto Map(void **pPData, vk::DeviceSize size, vk::DeviceSize offset = 0, vk::MemoryMapFlags flags = {}) const -> vk::Result;
             void Unmap() const;
+            auto FlushMappedRange(vk::DeviceSize size = VK_WHOLE_SIZE, vk::DeviceSize offset = 0) const -> vk::Result;
+            auto InvalidateMappedRange(vk::DeviceSize size = VK_WHOLE_SIZE, vk::DeviceSize offset = 0) const -> vk::Result;
 
             auto GetBuffer() const noexcept -> const VulkanBuffer * { return m_Buffer; }
             auto GetBufferVk() const noexcept -> vk::Buffer { return m_Buffer->GetBufferVk(); }
@@ -1183,6 +1382,511 @@ namespace BulletRT
             const VulkanDeviceMemory *m_Memory;
             vk::DeviceSize m_MemoryOffset;
         };
+
+        // Wraps VkDeferredOperationKHR. Any number of threads may call Join concurrently. JoinAll joins on the calling
+        // thread and hands up to maxThreadCount - 1 helper jobs (0: the reported max concurrency) to the job submitter
+        // given to New, e.g. one that forwards to VulkanWorkerPool::Submit; without a submitter only the calling thread
+        // joins. Helpers that start after the operation finished return at once, so JoinAll never waits on a job that
+        // has not started and is safe to call from a worker of the same pool. JoinAsync runs JoinAll as a submitted
+        // job (on a std::async thread without a submitter), and the operation must outlive the returned future.
+        class VulkanDeferredOperation
+        {
+        public:
+            using JobSubmitter = std::function<void(std::function<void()>)>;
+
+            static auto New(const VulkanDevice *device, JobSubmitter submitter = nullptr) -> std::unique_ptr<VulkanDeferredOperation>;
+            virtual ~VulkanDeferredOperation() noexcept;
+
+            // Returns eSuccess once the operation is complete, or eThreadDoneKHR when this thread can no longer help.
+            auto Join() const -> vk::Result;
+            auto JoinAll(uint32_t maxThreadCount = 0) const -> vk::Result;
+            auto JoinAsync(uint32_t maxThreadCount = 0) const -> std::future<vk::Result>;
+            auto GetMaxConcurrency() const -> uint32_t;
+            auto GetResult() const -> vk::Result;
+
+            auto GetDevice() const noexcept -> const VulkanDevice * { return m_Device; }
+            auto GetDeferredOperationVk() const noexcept -> vk::DeferredOperationKHR { return m_DeferredOperation.get(); }
+            auto GetJobSubmitter() const noexcept -> const JobSubmitter & { return m_Submitter; }
+
+        private:
+            VulkanDeferredOperation() noexcept;
+
+        private:
+            const VulkanDevice *m_Device;
+            vk::UniqueDeferredOperationKHR m_DeferredOperation;
+            JobSubmitter m_Submitter;
+        };
+
+        class VulkanAccelerationStructureGeometryDesc
+        {
+        public:
+            VulkanAccelerationStructureGeometryDesc() noexcept
+            {
+                m_GeometryType = vk::GeometryTypeKHR::eTriangles;
+                m_Flags = vk::GeometryFlagBitsKHR::eOpaque;
+                m_PrimitiveCount = 0;
+                m_VertexBuffer = nullptr;
+                m_VertexOffset = 0;
+                m_VertexFormat = vk::Format::eR32G32B32Sfloat;
+                m_VertexStride = 0;
+                m_MaxVertex = 0;
+                m_IndexBuffer = nullptr;
+                m_IndexOffset = 0;
+                m_IndexType = vk::IndexType::eNoneKHR;
+                m_TransformBuffer = nullptr;
+                m_TransformOffset = 0;
+                m_AabbBuffer = nullptr;
+                m_AabbOffset = 0;
+                m_AabbStride = sizeof(vk::AabbPositionsKHR);
+                m_InstanceBuffer = nullptr;
+                m_InstanceOffset = 0;
+            }
+
+            VulkanAccelerationStructureGeometryDesc(const VulkanAccelerationStructureGeometryDesc &) noexcept = default;
+
+            VulkanAccelerationStructureGeometryDesc &operator=(const VulkanAccelerationStructureGeometryDesc &) noexcept = default;
+
+            auto GetGeometryType() const noexcept -> vk::GeometryTypeKHR { return m_GeometryType; }
+            auto SetGeometryType(vk::GeometryTypeKHR geometryType) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_GeometryType = geometryType;
+                return *this;
+            }
+            auto GetFlags() const noexcept -> vk::GeometryFlagsKHR { return m_Flags; }
+            auto SetFlags(vk::GeometryFlagsKHR flags) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_Flags = flags;
+                return *this;
+            }
+            // Triangle count, AABB count or instance count depending on the geometry type.
+            auto GetPrimitiveCount() const noexcept -> uint32_t { return m_PrimitiveCount; }
+            auto SetPrimitiveCount(uint32_t primitiveCount) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_PrimitiveCount = primitiveCount;
+                return *this;
+            }
+
+            auto GetVertexBuffer() const noexcept -> const VulkanMemoryBuffer * { return m_VertexBuffer; }
+            auto GetVertexOffset() const noexcept -> vk::DeviceSize { return m_VertexOffset; }
+            auto SetVertexBuffer(const VulkanMemoryBuffer *vertexBuffer, vk::DeviceSize vertexOffset = 0) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_VertexBuffer = vertexBuffer;
+                m_VertexOffset = vertexOffset;
+                return *this;
+            }
+            auto GetVertexFormat() const noexcept -> vk::Format { return m_VertexFormat; }
+            auto SetVertexFormat(vk::Format vertexFormat) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_VertexFormat = vertexFormat;
+                return *this;
+            }
+            auto GetVertexStride() const noexcept -> vk::DeviceSize { return m_VertexStride; }
+            auto SetVertexStride(vk::DeviceSize vertexStride) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_VertexStride = vertexStride;
+                return *this;
+            }
+            auto GetMaxVertex() const noexcept -> uint32_t { return m_MaxVertex; }
+            auto SetMaxVertex(uint32_t maxVertex) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_MaxVertex = maxVertex;
+                return *this;
+            }
+            auto GetIndexBuffer() const noexcept -> const VulkanMemoryBuffer * { return m_IndexBuffer; }
+            auto GetIndexOffset() const noexcept -> vk::DeviceSize { return m_IndexOffset; }
+            auto GetIndexType() const noexcept -> vk::IndexType { return m_IndexType; }
+            auto SetIndexBuffer(const VulkanMemoryBuffer *indexBuffer, vk::IndexType indexType, vk::DeviceSize indexOffset = 0) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_IndexBuffer = indexBuffer;
+                m_IndexType = indexType;
+                m_IndexOffset = indexOffset;
+                return *this;
+            }
+            auto GetTransformBuffer() const noexcept -> const VulkanMemoryBuffer * { return m_TransformBuffer; }
+            auto GetTransformOffset() const noexcept -> vk::DeviceSize { return m_TransformOffset; }
+            auto SetTransformBuffer(const VulkanMemoryBuffer *transformBuffer, vk::DeviceSize transformOffset = 0) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_TransformBuffer = transformBuffer;
+                m_TransformOffset = transformOffset;
+                return *this;
+            }
+
+            auto GetAabbBuffer() const noexcept -> const VulkanMemoryBuffer * { return m_AabbBuffer; }
+            auto GetAabbOffset() const noexcept -> vk::DeviceSize { return m_AabbOffset; }
+            auto SetAabbBuffer(const VulkanMemoryBuffer *aabbBuffer, vk::DeviceSize aabbOffset = 0) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_AabbBuffer = aabbBuffer;
+                m_AabbOffset = aabbOffset;
+                return *this;
+            }
+            auto GetAabbStride() const noexcept -> vk::DeviceSize { return m_AabbStride; }
+            auto SetAabbStride(vk::DeviceSize aabbStride) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_AabbStride = aabbStride;
+                return *this;
+            }
+
+            auto GetInstanceBuffer() const noexcept -> const VulkanMemoryBuffer * { return m_InstanceBuffer; }
+            auto GetInstanceOffset() const noexcept -> vk::DeviceSize { return m_InstanceOffset; }
+            auto SetInstanceBuffer(const VulkanMemoryBuffer *instanceBuffer, vk::DeviceSize instanceOffset = 0) noexcept -> VulkanAccelerationStructureGeometryDesc &
+            {
+                m_InstanceBuffer = instanceBuffer;
+                m_InstanceOffset = instanceOffset;
+                return *this;
+            }
+
+            static auto Triangles(const VulkanMemoryBuffer *vertexBuffer, vk::Format vertexFormat, vk::DeviceSize vertexStride, uint32_t vertexCount,
+                                  const VulkanMemoryBuffer *indexBuffer, vk::IndexType indexType, uint32_t triangleCount) noexcept -> VulkanAccelerationStructureGeometryDesc;
+            static auto Aabbs(const VulkanMemoryBuffer *aabbBuffer, uint32_t aabbCount, vk::DeviceSize aabbStride = sizeof(vk::AabbPositionsKHR)) noexcept -> VulkanAccelerationStructureGeometryDesc;
+            static auto Instances(const VulkanMemoryBuffer *instanceBuffer, uint32_t instanceCount) noexcept -> VulkanAccelerationStructureGeometryDesc;
+
+            // Buffer addresses are resolved at call time: device builds need buffers bound with device addresses,
+            // host builds need buffers whose memory is currently mapped.
+            auto GetGeometryVk(vk::AccelerationStructureBuildTypeKHR buildType = vk::AccelerationStructureBuildTypeKHR::eDevice) const noexcept -> vk::AccelerationStructureGeometryKHR;
+            auto GetBuildRangeInfoVk() const noexcept -> vk::AccelerationStructureBuildRangeInfoKHR;
+
+        private:
+            vk::GeometryTypeKHR m_GeometryType;
+            vk::GeometryFlagsKHR m_Flags;
+            uint32_t m_PrimitiveCount;
+            const VulkanMemoryBuffer *m_VertexBuffer;
+            vk::DeviceSize m_VertexOffset;
+            vk::Format m_VertexFormat;
+            vk::DeviceSize m_VertexStride;
+            uint32_t m_MaxVertex;
+            const VulkanMemoryBuffer *m_IndexBuffer;
+            vk::DeviceSize m_IndexOffset;
+            vk::IndexType m_IndexType;
+            const VulkanMemoryBuffer *m_TransformBuffer;
+            vk::DeviceSize m_TransformOffset;
+            const VulkanMemoryBuffer *m_AabbBuffer;
+            vk::DeviceSize m_AabbOffset;
+            vk::DeviceSize m_AabbStride;
+            const VulkanMemoryBuffer *m_InstanceBuffer;
+            vk::DeviceSize m_InstanceOffset;
+        };
+
+        // A range of a buffer handed out by a VulkanBufferSuballocator; userData belongs to the suballocator.
+        struct VulkanBufferRegion
+        {
+            const VulkanMemoryBuffer *buffer;
+            vk::DeviceSize offset;
+            vk::DeviceSize size;
+            uint64_t userData;
+        };
+
+        // Places small buffers such as acceleration structure storage and scratch inside larger shared buffers, so that
+        // thousands of them do not each need a device memory allocation. The suballocator must outlive every region
+        // it handed out, and its buffers must carry the usage the consumer documents.
+        class VulkanBufferSuballocator
+        {
+        public:
+            virtual ~VulkanBufferSuballocator() noexcept {}
+
+            // region.offset is a multiple of alignment. Returns std::nullopt when no range of size bytes is available.
+            virtual auto AllocateRegion(vk::DeviceSize size, vk::DeviceSize alignment) -> std::optional<VulkanBufferRegion> = 0;
+            virtual void FreeRegion(const VulkanBufferRegion &region) noexcept = 0;
+        };
+
+        class VulkanAccelerationStructure;
+
+        class VulkanAccelerationStructureBuilder
+        {
+        public:
+            VulkanAccelerationStructureBuilder() noexcept
+            {
+                m_Type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+                m_Flags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
+                m_Geometries = {};
+                m_StorageSize = 0;
+                m_BuildType = vk::AccelerationStructureBuildTypeKHR::eDevice;
+                m_StorageAllocator = nullptr;
+                m_ScratchAllocator = nullptr;
+            }
+
+            VulkanAccelerationStructureBuilder(const VulkanAccelerationStructureBuilder &) noexcept = default;
+
+            VulkanAccelerationStructureBuilder &operator=(const VulkanAccelerationStructureBuilder &) noexcept = default;
+
+            auto GetType() const noexcept -> vk::AccelerationStructureTypeKHR { return m_Type; }
+            auto SetType(vk::AccelerationStructureTypeKHR type) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_Type = type;
+                return *this;
+            }
+            auto GetFlags() const noexcept -> vk::BuildAccelerationStructureFlagsKHR { return m_Flags; }
+            auto SetFlags(vk::BuildAccelerationStructureFlagsKHR flags) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_Flags = flags;
+                return *this;
+            }
+            auto GetGeometries() const noexcept -> const std::vector<VulkanAccelerationStructureGeometryDesc> & { return m_Geometries; }
+            auto SetGeometries(const std::vector<VulkanAccelerationStructureGeometryDesc> &geometries) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_Geometries = geometries;
+                return *this;
+            }
+            auto AddGeometry(const VulkanAccelerationStructureGeometryDesc &geometry) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_Geometries.push_back(geometry);
+                return *this;
+            }
+            // Overrides the queried storage size, e.g. for structures filled by deserialization or compacting copies.
+            auto GetStorageSize() const noexcept -> vk::DeviceSize { return m_StorageSize; }
+            auto SetStorageSize(vk::DeviceSize storageSize) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_StorageSize = storageSize;
+                return *this;
+            }
+
+            // eHost places the storage in host visible memory and builds with BuildOnHost instead of RecordBuild.
+            auto GetBuildType() const noexcept -> vk::AccelerationStructureBuildTypeKHR { return m_BuildType; }
+            auto SetBuildType(vk::AccelerationStructureBuildTypeKHR buildType) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_BuildType = buildType;
+                return *this;
+            }
+
+            // Device builds only. Storage regions come from buffers created with eAccelerationStructureStorageKHR and
+            // eShaderDeviceAddress, and compacted storage is taken from the same suballocator. Without one, the
+            // structure allocates its own device memory.
+            auto GetStorageAllocator() const noexcept -> VulkanBufferSuballocator * { return m_StorageAllocator; }
+            auto SetStorageAllocator(VulkanBufferSuballocator *storageAllocator) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_StorageAllocator = storageAllocator;
+                return *this;
+            }
+            // Device builds only. Supplies the scratch RecordBuild allocates on first use from buffers created with
+            // eStorageBuffer and eShaderDeviceAddress.
+            auto GetScratchAllocator() const noexcept -> VulkanBufferSuballocator * { return m_ScratchAllocator; }
+            auto SetScratchAllocator(VulkanBufferSuballocator *scratchAllocator) noexcept -> VulkanAccelerationStructureBuilder &
+            {
+                m_ScratchAllocator = scratchAllocator;
+                return *this;
+            }
+
+            auto Build(const VulkanDevice *device) const -> std::unique_ptr<VulkanAccelerationStructure>;
+
+        private:
+            vk::AccelerationStructureTypeKHR m_Type;
+            vk::BuildAccelerationStructureFlagsKHR m_Flags;
+            std::vector<VulkanAccelerationStructureGeometryDesc> m_Geometries;
+            vk::DeviceSize m_StorageSize;
+            vk::AccelerationStructureBuildTypeKHR m_BuildType;
+            VulkanBufferSuballocator *m_StorageAllocator;
+            VulkanBufferSuballocator *m_ScratchAllocator;
+        };
+
+        // Owns the storage of one acceleration structure sized from vkGetAccelerationStructureBuildSizesKHR, and lazily
+        // a scratch range for builds recorded without an external scratch address. Both are either regions of the
+        // builder's suballocators or buffers with their own device memory.
+        class VulkanAccelerationStructure
+        {
+        public:
+            using Builder = VulkanAccelerationStructureBuilder;
+            static auto New(const VulkanDevice *device, const VulkanAccelerationStructureBuilder &builder) -> std::unique_ptr<VulkanAccelerationStructure>;
+            virtual ~VulkanAccelerationStructure() noexcept;
+
+            // eUpdate refits in place and requires eAllowUpdate; the owned scratch is sized for both modes.
+            auto RecordBuild(vk::CommandBuffer commandBuffer, vk::BuildAccelerationStructureModeKHR mode = vk::BuildAccelerationStructureModeKHR::eBuild) -> vk::Result;
+            // scratchAddress must be aligned to minAccelerationStructureScratchOffsetAlignment and hold GetScratchSize(mode) bytes.
+            void RecordBuild(vk::CommandBuffer commandBuffer, vk::DeviceAddress scratchAddress, vk::BuildAccelerationStructureModeKHR mode = vk::BuildAccelerationStructureModeKHR::eBuild) const;
+            // Host builds only. With a deferred operation the call returns eOperationDeferredKHR and the build runs on the
+            // threads joining the operation; the structure and its geometry must not change until the operation completes.
+            // Without one, the build runs on the calling thread.
+            auto BuildOnHost(const VulkanDeferredOperation *deferredOperation = nullptr, vk::BuildAccelerationStructureModeKHR mode = vk::BuildAccelerationStructureModeKHR::eBuild) -> vk::Result;
+
+            auto GetBuildGeometryInfoVk(std::vector<vk::AccelerationStructureGeometryKHR> &geometries, vk::BuildAccelerationStructureModeKHR mode = vk::BuildAccelerationStructureModeKHR::eBuild) const -> vk::AccelerationStructureBuildGeometryInfoKHR;
+            auto GetBuildRangeInfoVks() const -> std::vector<vk::AccelerationStructureBuildRangeInfoKHR>;
+
+            auto GetDevice() const noexcept -> const VulkanDevice * { return m_Device; }
+            auto GetAccelerationStructureVk() const noexcept -> vk::AccelerationStructureKHR { return m_AccelerationStructure.get(); }
+            auto GetDeviceAddress() const noexcept -> vk::DeviceAddress { return m_DeviceAddress; }
+            auto GetType() const noexcept -> vk::AccelerationStructureTypeKHR { return m_Type; }
+            auto GetFlags() const noexcept -> vk::BuildAccelerationStructureFlagsKHR { return m_Flags; }
+            auto GetBuildType() const noexcept -> vk::AccelerationStructureBuildTypeKHR { return m_BuildType; }
+            auto GetGeometries() const noexcept -> const std::vector<VulkanAccelerationStructureGeometryDesc> & { return m_Geometries; }
+            // Replaces one geometry for later builds; the type must match and the primitive count may not exceed the
+            // count the structure was sized for. Update builds additionally require an unchanged primitive count.
+            bool SetGeometry(size_t idx, const VulkanAccelerationStructureGeometryDesc &geometry) noexcept;
+            auto GetMaxPrimitiveCounts() const noexcept -> const std::vector<uint32_t> & { return m_MaxPrimitiveCounts; }
+            auto GetBuildSizes() const noexcept -> const vk::AccelerationStructureBuildSizesInfoKHR & { return m_BuildSizes; }
+            auto GetScratchSize(vk::BuildAccelerationStructureModeKHR mode = vk::BuildAccelerationStructureModeKHR::eBuild) const noexcept -> vk::DeviceSize
+            {
+                return mode == vk::BuildAccelerationStructureModeKHR::eUpdate ? m_BuildSizes.updateScratchSize : m_BuildSizes.buildScratchSize;
+            }
+            auto GetScratchAlignment() const noexcept -> vk::DeviceSize { return m_ScratchAlignment; }
+            auto GetSize() const noexcept -> vk::DeviceSize { return m_BuildSizes.accelerationStructureSize; }
+            auto GetBuffer() const noexcept -> const VulkanMemoryBuffer * { return m_Storage.GetBuffer(); }
+            auto GetBufferOffset() const noexcept -> vk::DeviceSize { return m_Storage.GetOffset(); }
+
+            // Records a compacting copy into freshly allocated storage of compactedSize bytes and swaps it into this
+            // object, so the handle and device address change. The returned object holds the original storage, which
+            // the copy reads: keep it alive until the command buffer has completed.
+            auto RecordCompact(vk::CommandBuffer commandBuffer, vk::DeviceSize compactedSize) -> std::unique_ptr<VulkanAccelerationStructure>;
+
+        private:
+            struct StorageDesc
+            {
+                std::unique_ptr<VulkanBuffer> buffer;
+                std::unique_ptr<VulkanDeviceMemory> memory;
+                std::unique_ptr<VulkanMemoryBuffer> memoryBuffer;
+                std::optional<VulkanBufferRegion> region;
+                VulkanBufferSuballocator *allocator = nullptr;
+
+                auto GetBuffer() const noexcept -> const VulkanMemoryBuffer * { return region ? region->buffer : memoryBuffer.get(); }
+                auto GetOffset() const noexcept -> vk::DeviceSize { return region ? region->offset : 0; }
+            };
+            VulkanAccelerationStructure() noexcept;
+
+            static auto Impl_NewStorage(const VulkanDevice *device, VulkanBufferSuballocator *allocator, vk::DeviceSize size, vk::DeviceSize alignment,
+                                        vk::BufferUsageFlags usage, vk::MemoryPropertyFlags memoryFlags) -> std::optional<StorageDesc>;
+            static void Impl_ReleaseStorage(StorageDesc &storage) noexcept;
+
+        private:
+            const VulkanDevice *m_Device;
+            vk::AccelerationStructureTypeKHR m_Type;
+            vk::BuildAccelerationStructureFlagsKHR m_Flags;
+            vk::AccelerationStructureBuildTypeKHR m_BuildType;
+            std::vector<VulkanAccelerationStructureGeometryDesc> m_Geometries;
+            std::vector<uint32_t> m_MaxPrimitiveCounts;
+            vk::AccelerationStructureBuildSizesInfoKHR m_BuildSizes;
+            vk::DeviceSize m_ScratchAlignment;
+            VulkanBufferSuballocator *m_StorageAllocator;
+            VulkanBufferSuballocator *m_ScratchAllocator;
+            StorageDesc m_Storage;
+            StorageDesc m_Scratch;
+            vk::UniqueAccelerationStructureKHR m_AccelerationStructure;
+            vk::DeviceAddress m_DeviceAddress;
+            std::vector<uint8_t> m_HostScratch;
+            std::vector<vk::AccelerationStructureGeometryKHR> m_HostGeometries;
+            std::vector<vk::AccelerationStructureBuildRangeInfoKHR> m_HostBuildRangeInfos;
+            vk::AccelerationStructureBuildGeometryInfoKHR m_HostBuildGeometryInfo;
+            const vk::AccelerationStructureBuildRangeInfoKHR *m_HostBuildRangeInfoPtr;
+        };
+
+        // Compacts acceleration structures built with eAllowCompaction without stalling the recording thread.
+        // Frame N records the compacted size queries, a later frame records the copies once N's fence has
+        // signaled, and the original storage is released once the copying frame's fence has signaled in turn.
+        // Fences passed to EndFrame must stay alive until then. Not thread safe.
+        class VulkanAccelerationStructureCompactor
+        {
+        public:
+            static auto New(const VulkanDevice *device) -> std::unique_ptr<VulkanAccelerationStructureCompactor>;
+            virtual ~VulkanAccelerationStructureCompactor() noexcept;
+
+            bool Enqueue(VulkanAccelerationStructure *accelerationStructure);
+            // The builds of the enqueued structures must be complete and visible to eAccelerationStructureBuildKHR.
+            void RecordQueries(vk::CommandBuffer commandBuffer);
+            // Returns the structures swapped to compacted storage by this call.
+            auto RecordCompactions(vk::CommandBuffer commandBuffer) -> std::vector<VulkanAccelerationStructure *>;
+            void EndFrame(const VulkanFence *fence);
+
+            auto GetDevice() const noexcept -> const VulkanDevice * { return m_Device; }
+            auto GetPendingCount() const noexcept -> size_t;
+            auto GetCompactedCount() const noexcept -> uint64_t { return m_CompactedCount; }
+            auto GetSavedSize() const noexcept -> vk::DeviceSize { return m_SavedSize; }
+
+        private:
+            struct QueryBatchDesc
+            {
+                vk::UniqueQueryPool queryPool;
+                uint32_t queryCapacity;
+                std::vector<VulkanAccelerationStructure *> accelerationStructures;
+                const VulkanFence *fence;
+                bool ended;
+            };
+            struct RetireDesc
+            {
+                std::vector<std::unique_ptr<VulkanAccelerationStructure>> accelerationStructures;
+                const VulkanFence *fence;
+                bool ended;
+            };
+            VulkanAccelerationStructureCompactor() noexcept;
+
+            void Impl_ReleaseRetired();
+
+        private:
+            const VulkanDevice *m_Device;
+            std::vector<VulkanAccelerationStructure *> m_Enqueued;
+            std::vector<QueryBatchDesc> m_QueryBatches;
+            std::vector<QueryBatchDesc> m_FreeQueryBatches;
+            std::vector<RetireDesc> m_Retires;
+            uint64_t m_CompactedCount;
+            vk::DeviceSize m_SavedSize;
+        };
+
+        struct VulkanTopLevelAccelerationStructureStatistics
+        {
+            uint64_t rebuildCount;
+            uint64_t updateCount;
+            uint32_t updatesSinceRebuild;
+            float degradation;
+        };
+
+        // Top level acceleration structure over a persistently mapped instance buffer. Instances are written in place,
+        // so the caller must not modify them while a build reading them is still executing. RecordBuild refits in place
+        // while only transforms changed, and falls back to a full rebuild when the instance count or a BLAS reference
+        // changed, after GetRebuildInterval() consecutive updates, or once the accumulated degradation (the sum over
+        // updates of the fraction of instances that moved) reaches GetDegradationThreshold().
+        class VulkanTopLevelAccelerationStructure
+        {
+        public:
+            static auto New(const VulkanDevice *device, uint32_t maxInstanceCount,
+                            vk::BuildAccelerationStructureFlagsKHR flags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace) -> std::unique_ptr<VulkanTopLevelAccelerationStructure>;
+            virtual ~VulkanTopLevelAccelerationStructure() noexcept;
+
+            bool SetInstanceCount(uint32_t instanceCount) noexcept;
+            bool SetInstance(uint32_t idx, const vk::AccelerationStructureInstanceKHR &instance) noexcept;
+            bool SetInstanceTransform(uint32_t idx, const vk::TransformMatrixKHR &transform) noexcept;
+            auto GetInstance(uint32_t idx) const noexcept -> std::optional<vk::AccelerationStructureInstanceKHR>;
+            void RequestRebuild() noexcept { m_NeedRebuild = true; }
+
+            // Records nothing when no instance changed since the last build.
+            auto RecordBuild(vk::CommandBuffer commandBuffer) -> vk::Result;
+
+            auto GetDevice() const noexcept -> const VulkanDevice * { return m_Device; }
+            auto GetAccelerationStructure() const noexcept -> const VulkanAccelerationStructure * { return m_AccelerationStructure.get(); }
+            auto GetAccelerationStructureVk() const noexcept -> vk::AccelerationStructureKHR { return m_AccelerationStructure->GetAccelerationStructureVk(); }
+            auto GetDeviceAddress() const noexcept -> vk::DeviceAddress { return m_AccelerationStructure->GetDeviceAddress(); }
+            auto GetInstanceBuffer() const noexcept -> const VulkanMemoryBuffer * { return m_InstanceBuffer.get(); }
+            auto GetInstanceCount() const noexcept -> uint32_t { return m_InstanceCount; }
+            auto GetMaxInstanceCount() const noexcept -> uint32_t { return m_MaxInstanceCount; }
+
+            auto GetRebuildInterval() const noexcept -> uint32_t { return m_RebuildInterval; }
+            void SetRebuildInterval(uint32_t rebuildInterval) noexcept { m_RebuildInterval = rebuildInterval; }
+            auto GetDegradationThreshold() const noexcept -> float { return m_DegradationThreshold; }
+            void SetDegradationThreshold(float degradationThreshold) noexcept { m_DegradationThreshold = degradationThreshold; }
+            auto QueryStatistics() const noexcept -> VulkanTopLevelAccelerationStructureStatistics;
+
+        private:
+            VulkanTopLevelAccelerationStructure() noexcept;
+
+            void Impl_MarkDirty(uint32_t idx) noexcept;
+
+        private:
+            const VulkanDevice *m_Device;
+            std::unique_ptr<VulkanBuffer> m_Buffer;
+            std::unique_ptr<VulkanDeviceMemory> m_Memory;
+            std::unique_ptr<VulkanMemoryBuffer> m_InstanceBuffer;
+            vk::AccelerationStructureInstanceKHR *m_MappedInstances;
+            std::unique_ptr<VulkanAccelerationStructure> m_AccelerationStructure;
+            uint32_t m_MaxInstanceCount;
+            uint32_t m_InstanceCount;
+            uint32_t m_BuiltInstanceCount;
+            uint32_t m_DirtyBegin;
+            uint32_t m_DirtyEnd;
+            uint32_t m_MovedCount;
+            bool m_Built;
+            bool m_NeedRebuild;
+            uint32_t m_RebuildInterval;
+            float m_DegradationThreshold;
+            uint32_t m_UpdatesSinceRebuild;
+            float m_Degradation;
+            uint64_t m_RebuildCount;
+            uint64_t m_UpdateCount;
+        };
+
         class VulkanShaderModule;
         class VulkanShaderModuleBuilder
         {
@@ -1344,7 +2048,7 @@ namespace BulletRT
             auto GetVertexAttributeDescription(size_t idx) const -> const vk::VertexInputAttributeDescription &;
 
             auto SetVertexBindingDivisors(const std::vector<vk::VertexInputBindingDivisorDescriptionEXT> &divisors) noexcept -> VulkanPipelineVertexInputStateDesc &;
-            auto AddVertexBindingDivisors(const vk::VertexInputBindingDivisorDescriptionEXT &divisor) const noexcept -> VulkanPipelineVertexInputStateDesc &;
+            auto AddVertexBindingDivisors(const vk::VertexInputBindingDivisorDescriptionEXT &divisor) noexcept -> VulkanPipelineVertexInputStateDesc &;
             auto SetVertexBindingDivisor(size_t idx, const vk::VertexInputBindingDivisorDescriptionEXT &divisor) noexcept -> VulkanPipelineVertexInputStateDesc &;
             auto GetVertexBindingDivisors() const noexcept -> const std::vector<vk::VertexInputBindingDivisorDescriptionEXT> &;
             auto GetVertexBindingDivisor(size_t idx) const -> const vk::VertexInputBindingDivisorDescriptionEXT &;
@@ -1462,18 +2166,20 @@ namespace BulletRT
             auto SetLineWidth(float lineWidth) noexcept -> VulkanPipelineRasterizationStateDesc &;
             auto GetLineWidth() const noexcept -> float;
 
+            auto GetPipelineRasterizationStateCreateInfoVk() const noexcept -> vk::PipelineRasterizationStateCreateInfo;
+
         private:
             vk::PipelineRasterizationStateCreateFlags m_Flags = {};
-            vk::Bool32 m_DepthClampEnable;
-            vk::Bool32 m_RasterizerDiscardEnable;
-            vk::PolygonMode m_PolygonMode;
-            vk::CullModeFlags m_CullMode;
-            vk::FrontFace m_FrontFace;
-            vk::Bool32 m_DepthBiasEnable;
-            float m_DepthBiasConstantFactor;
-            float m_DepthBiasClamp;
-            float m_DepthBiasSlopeFactor;
-            float m_LineWidth;
+            vk::Bool32 m_DepthClampEnable = VK_FALSE;
+            vk::Bool32 m_RasterizerDiscardEnable = VK_FALSE;
+            vk::PolygonMode m_PolygonMode = vk::PolygonMode::eFill;
+            vk::CullModeFlags m_CullMode = vk::CullModeFlagBits::eNone;
+            vk::FrontFace m_FrontFace = vk::FrontFace::eCounterClockwise;
+            vk::Bool32 m_DepthBiasEnable = VK_FALSE;
+            float m_DepthBiasConstantFactor = 0.0f;
+            float m_DepthBiasClamp = 0.0f;
+            float m_DepthBiasSlopeFactor = 0.0f;
+            float m_LineWidth = 1.0f;
         };
         class VulkanPipelineMultiSampleStateDesc
         {
@@ -1502,6 +2208,8 @@ namespace BulletRT
             auto GetAlphaToOneEnable() const noexcept -> vk::Bool32;
             auto SetAlphaToOneEnable(vk::Bool32 alphaToOneEnable) noexcept -> VulkanPipelineMultiSampleStateDesc &;
 
+            auto GetPipelineMultisampleStateCreateInfoVk() const noexcept -> vk::PipelineMultisampleStateCreateInfo;
+
         private:
             vk::PipelineMultisampleStateCreateFlags m_Flags = {};
             vk::SampleCountFlagBits m_RasterizationSamples = vk::SampleCountFlagBits::e1;
@@ -1541,6 +2249,8 @@ namespace BulletRT
             auto SetBlendConstant(size_t idx, float blendConstant) noexcept -> VulkanPipelineColorBlendStateDesc &;
             auto GetBlendConstant(size_t idx) const -> float;
 
+            auto GetPipelineColorBlendStateCreateInfoVk() const noexcept -> vk::PipelineColorBlendStateCreateInfo;
+
         private:
             vk::PipelineColorBlendStateCreateFlags m_Flags = {};
             vk::Bool32 m_LogicOpEnable = VK_FALSE;
@@ -1549,6 +2259,81 @@ namespace BulletRT
             float m_BlendConstants[4] = {};
         };
         class VulkanPipelineLayout;
+        class VulkanPipelineLayoutBuilder
+        {
+        public:
+            auto SetFlags(vk::PipelineLayoutCreateFlags flags) noexcept -> VulkanPipelineLayoutBuilder &;
+            auto GetFlags() const noexcept -> vk::PipelineLayoutCreateFlags;
+
+            auto SetSetLayouts(const std::vector<vk::DescriptorSetLayout> &setLayouts) noexcept -> VulkanPipelineLayoutBuilder &;
+            auto AddSetLayout(vk::DescriptorSetLayout setLayout) noexcept -> VulkanPipelineLayoutBuilder &;
+            auto GetSetLayouts() const noexcept -> const std::vector<vk::DescriptorSetLayout> &;
+
+            auto SetPushConstantRanges(const std::vector<vk::PushConstantRange> &pushConstantRanges) noexcept -> VulkanPipelineLayoutBuilder &;
+            auto AddPushConstantRange(const vk::PushConstantRange &pushConstantRange) noexcept -> VulkanPipelineLayoutBuilder &;
+            auto GetPushConstantRanges() const noexcept -> const std::vector<vk::PushConstantRange> &;
+
+            auto GetPipelineLayoutCreateInfoVk() const noexcept -> vk::PipelineLayoutCreateInfo;
+
+            auto Build(const VulkanDevice *device) const -> std::unique_ptr<VulkanPipelineLayout>;
+
+        private:
+            vk::PipelineLayoutCreateFlags m_Flags = {};
+            std::vector<vk::DescriptorSetLayout> m_SetLayouts = {};
+            std::vector<vk::PushConstantRange> m_PushConstantRanges = {};
+        };
+        class VulkanPipelineLayout
+        {
+        public:
+            using Builder = VulkanPipelineLayoutBuilder;
+            static auto New(const VulkanDevice *device, const VulkanPipelineLayoutBuilder &builder) -> std::unique_ptr<VulkanPipelineLayout>;
+            virtual ~VulkanPipelineLayout() noexcept;
+
+            auto GetDevice() const noexcept -> const VulkanDevice *;
+            auto GetDeviceVk() const noexcept -> vk::Device;
+
+            auto GetPipelineLayoutVk() const noexcept -> vk::PipelineLayout;
+
+            auto GetFlags() const noexcept -> vk::PipelineLayoutCreateFlags;
+            auto GetSetLayouts() const noexcept -> const std::vector<vk::DescriptorSetLayout> &;
+            auto GetPushConstantRanges() const noexcept -> const std::vector<vk::PushConstantRange> &;
+
+        private:
+            VulkanPipelineLayout() noexcept;
+
+        private:
+            const VulkanDevice *m_Device = nullptr;
+            vk::UniquePipelineLayout m_PipelineLayout = {};
+            VulkanPipelineLayoutBuilder m_Builder = {};
+        };
+        class VulkanPipelineCache
+        {
+        public:
+            // initialData that does not match this device is ignored and yields an empty cache.
+            static auto New(const VulkanDevice *device, const std::vector<uint8_t> &initialData = {}) -> std::unique_ptr<VulkanPipelineCache>;
+            // A missing, unreadable or foreign file yields an empty cache rather than a failure.
+            static auto Load(const VulkanDevice *device, const std::string &filename) -> std::unique_ptr<VulkanPipelineCache>;
+            // Checks the VkPipelineCacheHeaderVersionOne header against the vendor, device and pipelineCacheUUID of the device.
+            static bool IsCompatible(const VulkanDevice *device, const void *pData, size_t sizeInBytes) noexcept;
+            virtual ~VulkanPipelineCache() noexcept;
+
+            auto GetDevice() const noexcept -> const VulkanDevice *;
+            auto GetDeviceVk() const noexcept -> vk::Device;
+            auto GetPipelineCacheVk() const noexcept -> vk::PipelineCache;
+
+            auto GetData() const -> std::vector<uint8_t>;
+            // Writes to a temporary file first and renames it, so a crash never leaves a truncated cache behind.
+            auto Save(const std::string &filename) const -> vk::Result;
+            // Folds caches filled by parallel compile threads into this one. This cache must not be used concurrently.
+            auto Merge(const std::vector<const VulkanPipelineCache *> &srcCaches) -> vk::Result;
+
+        private:
+            VulkanPipelineCache() noexcept;
+
+        private:
+            const VulkanDevice *m_Device = nullptr;
+            vk::UniquePipelineCache m_PipelineCache = {};
+        };
         class VulkanRenderPass;
         class VulkanGraphicsPipeline;
         class VulkanGraphicsPipelineBuilder
@@ -1589,10 +2374,16 @@ namespace BulletRT
 
             auto GetDepthStencilState(const vk::PipelineDepthStencilStateCreateInfo &depthStencil) noexcept -> VulkanGraphicsPipelineBuilder &;
             auto SetDepthStencilState() const noexcept -> const std::optional<vk::PipelineDepthStencilStateCreateInfo> &;
+            auto SetDepthStencilState(const vk::PipelineDepthStencilStateCreateInfo &depthStencil) noexcept -> VulkanGraphicsPipelineBuilder &;
+            auto GetDepthStencilState() const noexcept -> const std::optional<vk::PipelineDepthStencilStateCreateInfo> &;
 
             auto SetColorBlendState(const VulkanPipelineColorBlendStateDesc &colorBlendState) noexcept -> VulkanGraphicsPipelineBuilder &;
             auto GetColorBlendState() const noexcept -> const std::optional<VulkanPipelineColorBlendStateDesc> &;
 
+            auto SetDynamicStates(const std::vector<vk::DynamicState> &dynamicStates) noexcept -> VulkanGraphicsPipelineBuilder &;
+            auto AddDynamicState(vk::DynamicState dynamicState) noexcept -> VulkanGraphicsPipelineBuilder &;
+            auto GetDynamicStates() const noexcept -> std::vector<vk::DynamicState>;
+
             auto SetLayout(const VulkanPipelineLayout *layout) noexcept -> VulkanGraphicsPipelineBuilder &;
             auto GetLayout() const noexcept -> const VulkanPipelineLayout *;
 
@@ -1608,6 +2399,20 @@ namespace BulletRT
             auto SetBasePipelineIndex(uint32_t basePipelineIndex) noexcept -> VulkanGraphicsPipelineBuilder &;
             auto GetBasePipelineIndex() const noexcept -> std::optional<uint32_t>;
 
+            // Defaults to the device pipeline cache.
+            auto SetPipelineCache(const VulkanPipelineCache *pipelineCache) noexcept -> VulkanGraphicsPipelineBuilder &;
+            auto GetPipelineCache() const noexcept -> const VulkanPipelineCache *;
+
+            // Serialized form of every state that affects the created pipeline: stages by SPIR-V and specialization data,
+            // fixed function state, dynamic states, the layout by its set layout handles and push constant ranges, and the render
+            // pass by compatibility rather than identity. The pipeline cache is not part of it. Builders with equal keys
+            // create interchangeable pipelines.
+            auto GetStateKey() const -> std::vector<uint8_t>;
+            // HashBytes of GetStateKey.
+            auto GetHash() const -> uint64_t;
+
+            auto Build(const VulkanDevice *device) const -> std::unique_ptr<VulkanGraphicsPipeline>;
+
         private:
             vk::PipelineCreateFlags m_Flags = {};
             std::vector<VulkanPipelineShaderStageDesc> m_Stages = {};
@@ -1625,11 +2430,30 @@ namespace BulletRT
             std::optional<uint32_t> m_Subpass = std::nullopt;
             const VulkanGraphicsPipeline *m_BasePipelineHandle = nullptr;
             std::optional<uint32_t> m_BasePipelineIndex = std::nullopt;
+            const VulkanPipelineCache *m_PipelineCache = nullptr;
         };
         class VulkanGraphicsPipeline
         {
         public:
+            using Builder = VulkanGraphicsPipelineBuilder;
+            // Requires a layout and a render pass. Unset input assembly, rasterization and multisample states take
+            // the Vulkan defaults; stages that only carry a VulkanShaderModuleBuilder get a temporary module.
+            static auto New(const VulkanDevice *device, const VulkanGraphicsPipelineBuilder &builder) -> std::unique_ptr<VulkanGraphicsPipeline>;
+            virtual ~VulkanGraphicsPipeline() noexcept;
+
+            auto GetDevice() const noexcept -> const VulkanDevice *;
+            auto GetDeviceVk() const noexcept -> vk::Device;
+
+            auto GetPipelineVk() const noexcept -> vk::Pipeline;
+            auto GetLayout() const noexcept -> const VulkanPipelineLayout *;
+            auto GetRenderPass() const noexcept -> const VulkanRenderPass *;
+            auto GetBuilder() const noexcept -> const VulkanGraphicsPipelineBuilder &;
+
+        private:
+            VulkanGraphicsPipeline() noexcept;
+
         private:
+            const VulkanDevice *m_Device = nullptr;
             vk::UniquePipeline m_Pipeline;
             VulkanGraphicsPipelineBuilder m_Builder;
         };
@@ -1808,6 +2632,194 @@ namespace BulletRT
             std::vector<VulkanSubpassDesc> m_Subpasses = {};
             std::vector<vk::SubpassDependency> m_Dependencies = {};
         };
+        // Indices refer to the stages of the owning VulkanRayTracingPipelineBuilder.
+        class VulkanRayTracingShaderGroupDesc
+        {
+        public:
+            static auto General(uint32_t generalShader) noexcept -> VulkanRayTracingShaderGroupDesc;
+            static auto TrianglesHit(uint32_t closestHitShader, uint32_t anyHitShader = VK_SHADER_UNUSED_KHR) noexcept -> VulkanRayTracingShaderGroupDesc;
+            static auto ProceduralHit(uint32_t intersectionShader, uint32_t closestHitShader = VK_SHADER_UNUSED_KHR, uint32_t anyHitShader = VK_SHADER_UNUSED_KHR) noexcept -> VulkanRayTracingShaderGroupDesc;
+
+            auto SetType(vk::RayTracingShaderGroupTypeKHR type) noexcept -> VulkanRayTracingShaderGroupDesc &;
+            auto GetType() const noexcept -> vk::RayTracingShaderGroupTypeKHR;
+
+            auto SetGeneralShader(uint32_t generalShader) noexcept -> VulkanRayTracingShaderGroupDesc &;
+            auto GetGeneralShader() const noexcept -> uint32_t;
+
+            auto SetClosestHitShader(uint32_t closestHitShader) noexcept -> VulkanRayTracingShaderGroupDesc &;
+            auto GetClosestHitShader() const noexcept -> uint32_t;
+
+            auto SetAnyHitShader(uint32_t anyHitShader) noexcept -> VulkanRayTracingShaderGroupDesc &;
+            auto GetAnyHitShader() const noexcept -> uint32_t;
+
+            auto SetIntersectionShader(uint32_t intersectionShader) noexcept -> VulkanRayTracingShaderGroupDesc &;
+            auto GetIntersectionShader() const noexcept -> uint32_t;
+
+            auto GetRayTracingShaderGroupCreateInfoVk() const noexcept -> vk::RayTracingShaderGroupCreateInfoKHR;
+
+        private:
+            vk::RayTracingShaderGroupTypeKHR m_Type = vk::RayTracingShaderGroupTypeKHR::eGeneral;
+            uint32_t m_GeneralShader = VK_SHADER_UNUSED_KHR;
+            uint32_t m_ClosestHitShader = VK_SHADER_UNUSED_KHR;
+            uint32_t m_AnyHitShader = VK_SHADER_UNUSED_KHR;
+            uint32_t m_IntersectionShader = VK_SHADER_UNUSED_KHR;
+        };
+        class VulkanRayTracingPipeline;
+        class VulkanRayTracingPipelineBuilder
+        {
+        public:
+            auto SetFlags(vk::PipelineCreateFlags flags) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetFlags() const noexcept -> vk::PipelineCreateFlags;
+
+            auto SetStages(const std::vector<VulkanPipelineShaderStageDesc> &stages) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto AddStage(const VulkanPipelineShaderStageDesc &stage) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetStages() const noexcept -> const std::vector<VulkanPipelineShaderStageDesc> &;
+            auto GetStage(size_t idx) const -> const VulkanPipelineShaderStageDesc &;
+
+            // Group order defines the group indices used by the shader binding table.
+            auto SetGroups(const std::vector<VulkanRayTracingShaderGroupDesc> &groups) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto AddGroup(const VulkanRayTracingShaderGroupDesc &group) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetGroups() const noexcept -> const std::vector<VulkanRayTracingShaderGroupDesc> &;
+            auto GetGroup(size_t idx) const -> const VulkanRayTracingShaderGroupDesc &;
+
+            // Clamped to maxRayRecursionDepth at creation.
+            auto SetMaxRecursionDepth(uint32_t maxRecursionDepth) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetMaxRecursionDepth() const noexcept -> uint32_t;
+
+            auto SetLayout(const VulkanPipelineLayout *layout) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetLayout() const noexcept -> const VulkanPipelineLayout *;
+
+            // Linked libraries must have been built with eLibraryKHR and the same layout, interface and max recursion depth. Their groups
+            // follow this builder's own groups, in library order, in the group indices of the linked pipeline.
+            auto SetLibraries(const std::vector<const VulkanRayTracingPipeline *> &libraries) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto AddLibrary(const VulkanRayTracingPipeline *library) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetLibraries() const noexcept -> const std::vector<const VulkanRayTracingPipeline *> &;
+
+            // Required when building or linking libraries.
+            auto SetLibraryInterface(uint32_t maxPipelineRayPayloadSize, uint32_t maxPipelineRayHitAttributeSize) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetLibraryInterface() const noexcept -> const std::optional<vk::RayTracingPipelineInterfaceCreateInfoKHR> &;
+
+            // Defaults to the device pipeline cache.
+            auto SetPipelineCache(const VulkanPipelineCache *pipelineCache) noexcept -> VulkanRayTracingPipelineBuilder &;
+            auto GetPipelineCache() const noexcept -> const VulkanPipelineCache *;
+
+            auto Build(const VulkanDevice *device, const VulkanDeferredOperation *deferredOperation = nullptr) const -> std::unique_ptr<VulkanRayTracingPipeline>;
+
+        private:
+            vk::PipelineCreateFlags m_Flags = {};
+            std::vector<VulkanPipelineShaderStageDesc> m_Stages = {};
+            std::vector<VulkanRayTracingShaderGroupDesc> m_Groups = {};
+            uint32_t m_MaxRecursionDepth = 1;
+            const VulkanPipelineLayout *m_Layout = nullptr;
+            std::vector<const VulkanRayTracingPipeline *> m_Libraries = {};
+            std::optional<vk::RayTracingPipelineInterfaceCreateInfoKHR> m_LibraryInterface = std::nullopt;
+            const VulkanPipelineCache *m_PipelineCache = nullptr;
+        };
+        class VulkanRayTracingPipeline
+        {
+        public:
+            using Builder = VulkanRayTracingPipelineBuilder;
+            // Stages that only carry a VulkanShaderModuleBuilder get a temporary module for the duration of the call.
+            // With a deferred operation the driver may split compilation across threads; the calling thread joins
+            // it through VulkanDeferredOperation::JoinAll, helped by the operation's job submitter, before returning.
+            static auto New(const VulkanDevice *device, const VulkanRayTracingPipelineBuilder &builder, const VulkanDeferredOperation *deferredOperation = nullptr) -> std::unique_ptr<VulkanRayTracingPipeline>;
+            virtual ~VulkanRayTracingPipeline() noexcept;
+
+            auto GetDevice() const noexcept -> const VulkanDevice *;
+            auto GetDeviceVk() const noexcept -> vk::Device;
+
+            auto GetPipelineVk() const noexcept -> vk::Pipeline;
+            auto GetLayout() const noexcept -> const VulkanPipelineLayout *;
+            auto GetBuilder() const noexcept -> const VulkanRayTracingPipelineBuilder &;
+
+            bool IsLibrary() const noexcept;
+            // Own groups plus the groups of every linked library.
+            auto GetGroupCount() const noexcept -> uint32_t;
+            auto GetShaderGroupHandleSize() const noexcept -> uint32_t;
+            // Opaque handle of group idx, GetShaderGroupHandleSize() bytes long; nullptr when out of range or for libraries.
+            auto GetShaderGroupHandle(uint32_t idx) const noexcept -> const uint8_t *;
+
+        private:
+            VulkanRayTracingPipeline() noexcept;
+
+        private:
+            const VulkanDevice *m_Device = nullptr;
+            vk::UniquePipeline m_Pipeline = {};
+            VulkanRayTracingPipelineBuilder m_Builder = {};
+            uint32_t m_GroupCount = 0;
+            uint32_t m_ShaderGroupHandleSize = 0;
+            std::vector<uint8_t> m_ShaderGroupHandles = {};
+        };
+        class VulkanShaderBindingTable;
+        // Each record is a group handle followed by optional inline data. Records of one region share a stride,
+        // rounded up to shaderGroupHandleAlignment; each region starts at shaderGroupBaseAlignment.
+        class VulkanShaderBindingTableBuilder
+        {
+        public:
+            auto SetRaygenRecord(uint32_t groupIndex, const std::vector<uint8_t> &data = {}) noexcept -> VulkanShaderBindingTableBuilder &;
+            auto AddMissRecord(uint32_t groupIndex, const std::vector<uint8_t> &data = {}) noexcept -> VulkanShaderBindingTableBuilder &;
+            auto AddHitRecord(uint32_t groupIndex, const std::vector<uint8_t> &data = {}) noexcept -> VulkanShaderBindingTableBuilder &;
+            auto AddCallableRecord(uint32_t groupIndex, const std::vector<uint8_t> &data = {}) noexcept -> VulkanShaderBindingTableBuilder &;
+
+            template <typename T>
+            auto AddHitRecord(uint32_t groupIndex, const T &t) noexcept -> VulkanShaderBindingTableBuilder &
+            {
+                auto data = std::vector<uint8_t>(sizeof(T));
+                std::memcpy(data.data(), &t, sizeof(T));
+                return AddHitRecord(groupIndex, data);
+            }
+
+            auto GetRaygenRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &;
+            auto GetMissRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &;
+            auto GetHitRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &;
+            auto GetCallableRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &;
+
+            auto Build(const VulkanRayTracingPipeline *pipeline) const -> std::unique_ptr<VulkanShaderBindingTable>;
+
+        private:
+            std::vector<std::pair<uint32_t, std::vector<uint8_t>>> m_RaygenRecords = {};
+            std::vector<std::pair<uint32_t, std::vector<uint8_t>>> m_MissRecords = {};
+            std::vector<std::pair<uint32_t, std::vector<uint8_t>>> m_HitRecords = {};
+            std::vector<std::pair<uint32_t, std::vector<uint8_t>>> m_CallableRecords = {};
+        };
+        class VulkanShaderBindingTable
+        {
+        public:
+            using Builder = VulkanShaderBindingTableBuilder;
+            static auto New(const VulkanRayTracingPipeline *pipeline, const VulkanShaderBindingTableBuilder &builder) -> std::unique_ptr<VulkanShaderBindingTable>;
+            virtual ~VulkanShaderBindingTable() noexcept;
+
+            // Copies the table into its device local buffer with vkCmdUpdateBuffer and makes it visible to
+            // ray tracing shaders. Callers streaming through staging can copy GetData() themselves instead.
+            void RecordUpload(vk::CommandBuffer commandBuffer) const;
+            void RecordTraceRays(vk::CommandBuffer commandBuffer, uint32_t width, uint32_t height, uint32_t depth = 1) const;
+
+            auto GetPipeline() const noexcept -> const VulkanRayTracingPipeline *;
+            auto GetBuffer() const noexcept -> const VulkanMemoryBuffer *;
+            auto GetData() const noexcept -> const std::vector<uint8_t> &;
+            // Offset of the table within GetBuffer(), placing it at shaderGroupBaseAlignment.
+            auto GetDataOffset() const noexcept -> vk::DeviceSize;
+
+            auto GetRaygenRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR;
+            auto GetMissRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR;
+            auto GetHitRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR;
+            auto GetCallableRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR;
+
+        private:
+            VulkanShaderBindingTable() noexcept;
+
+        private:
+            const VulkanRayTracingPipeline *m_Pipeline = nullptr;
+            std::unique_ptr<VulkanBuffer> m_Buffer = nullptr;
+            std::unique_ptr<VulkanDeviceMemory> m_Memory = nullptr;
+            std::unique_ptr<VulkanMemoryBuffer> m_MemoryBuffer = nullptr;
+            vk::DeviceSize m_DataOffset = 0;
+            std::vector<uint8_t> m_Data = {};
+            vk::StridedDeviceAddressRegionKHR m_RaygenRegion = {};
+            vk::StridedDeviceAddressRegionKHR m_MissRegion = {};
+            vk::StridedDeviceAddressRegionKHR m_HitRegion = {};
+            vk::StridedDeviceAddressRegionKHR m_CallableRegion = {};
+        };
     }
 }
 #endif
@@ -1,8 +1,109 @@
 #include <BulletRT/Core/BulletRTCore.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <type_traits>
 #include <vector>
 using namespace BulletRT::Core;
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
+static auto FindMemoryTypeIndices(const vk::PhysicalDeviceMemoryProperties &memoryProps,
+                                  uint32_t memoryTypeBits,
+                                  vk::MemoryPropertyFlags requiredFlags,
+                                  vk::MemoryPropertyFlags avoidFlags = vk::MemoryPropertyFlags{}) -> std::vector<uint32_t>
+{
+    auto indices = std::vector<uint32_t>();
+    for (uint32_t i = 0; i < memoryProps.memoryTypeCount; ++i)
+    {
+        if ((static_cast<uint32_t>(1) << i) & memoryTypeBits)
+        {
+            if (((memoryProps.memoryTypes[i].propertyFlags & requiredFlags) == requiredFlags) &&
+                ((memoryProps.memoryTypes[i].propertyFlags & ~avoidFlags) == memoryProps.memoryTypes[i].propertyFlags))
+            {
+                indices.push_back(i);
+            }
+        }
+    }
+    return indices;
+}
+static auto CalcAlignedSize(vk::DeviceSize size, vk::DeviceSize alignment) -> vk::DeviceSize
+{
+    return ((size + alignment - 1) / alignment) * alignment;
+}
+// VkAccelerationStructureCreateInfoKHR::offset must be a multiple of 256.
+static constexpr vk::DeviceSize accelerationStructureStorageAlignment = 256;
+// Stage create infos point into specializationInfos and, for stages given only a module builder, into temporaryModules;
+// both must outlive pipeline creation.
+static auto GetPipelineShaderStageCreateInfoVks(const VulkanDevice *device,
+                                                const std::vector<VulkanPipelineShaderStageDesc> &stages,
+                                                std::vector<vk::SpecializationInfo> &specializationInfos,
+                                                std::vector<std::unique_ptr<VulkanShaderModule>> &temporaryModules) -> std::optional<std::vector<vk::PipelineShaderStageCreateInfo>>
+{
+    auto stageInfos = std::vector<vk::PipelineShaderStageCreateInfo>();
+    stageInfos.reserve(stages.size());
+    specializationInfos.clear();
+    specializationInfos.reserve(stages.size());
+    for (auto &stage : stages)
+    {
+        auto stageInfo = stage.GetPipelineShaderStageCreateInfoVk();
+        if (!stage.GetModule())
+        {
+            if (!stage.GetShaderModuleBuilder())
+            {
+                return std::nullopt;
+            }
+            auto shaderModule = VulkanShaderModule::New(device, stage.GetShaderModuleBuilder().value());
+            if (!shaderModule)
+            {
+                return std::nullopt;
+            }
+            stageInfo.setModule(shaderModule->GetShaderModuleVk());
+            temporaryModules.push_back(std::move(shaderModule));
+        }
+        if (auto specializationInfo = stage.GetSpecializationInfoVk())
+        {
+            specializationInfos.push_back(specializationInfo.value());
+            stageInfo.setPSpecializationInfo(&specializationInfos.back());
+        }
+        stageInfos.push_back(stageInfo);
+    }
+    return stageInfos;
+}
+auto BulletRT::Core::HashBytes(const void *pData, size_t sizeInBytes, uint64_t seed) noexcept -> uint64_t
+{
+    auto hash = seed;
+    auto pBytes = static_cast<const uint8_t *>(pData);
+    for (size_t i = 0; i < sizeInBytes; ++i)
+    {
+        hash ^= pBytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+// Appends the raw bytes to a state key; the same padding free restriction as HashBytes applies.
+static void AppendBytes(std::vector<uint8_t> &key, const void *pData, size_t sizeInBytes)
+{
+    auto pBytes = static_cast<const uint8_t *>(pData);
+    key.insert(std::end(key), pBytes, pBytes + sizeInBytes);
+}
+template <typename T>
+static void AppendValue(std::vector<uint8_t> &key, const T &value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    AppendBytes(key, &value, sizeof(T));
+}
+template <typename T>
+static void AppendValues(std::vector<uint8_t> &key, const T *pValues, size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    AppendValue(key, count);
+    if (pValues && count > 0)
+    {
+        AppendBytes(key, pValues, sizeof(T) * count);
+    }
+}
 BulletRT::Core::VulkanDeviceFeaturesSet::VulkanDeviceFeaturesSet(const VulkanDeviceFeaturesSet &featureSet) noexcept
 {
     if (!featureSet.m_Holders.empty())
@@ -321,6 +422,15 @@ auto BulletRT::Core::VulkanDevice::New(const BulletRT::Core::VulkanDeviceBuilder
         vulkanDevice->m_EnabledFeaturesSet = enabledFeatureSet;
         vulkanDevice->m_QueueFamilyMap = queueFamilySet;
         vulkanDevice->m_Instance = builder.GetInstance();
+        vulkanDevice->m_PipelineCacheFilename = builder.GetPipelineCacheFilename();
+        if (vulkanDevice->m_PipelineCacheFilename.empty())
+        {
+            vulkanDevice->m_PipelineCache = BulletRT::Core::VulkanPipelineCache::New(vulkanDevice);
+        }
+        else
+        {
+            vulkanDevice->m_PipelineCache = BulletRT::Core::VulkanPipelineCache::Load(vulkanDevice, vulkanDevice->m_PipelineCacheFilename);
+        }
         return std::unique_ptr<BulletRT::Core::VulkanDevice>(vulkanDevice);
     }
     return nullptr;
@@ -328,6 +438,13 @@ auto BulletRT::Core::VulkanDevice::New(const BulletRT::Core::VulkanDeviceBuilder
 
 BulletRT::Core::VulkanDevice::~VulkanDevice() noexcept
 {
+    m_FreeFences.clear();
+    m_FreeSemaphores.clear();
+    if (m_PipelineCache && !m_PipelineCacheFilename.empty())
+    {
+        m_PipelineCache->Save(m_PipelineCacheFilename);
+    }
+    m_PipelineCache.reset();
     m_LogigalDevice.reset();
 }
 
@@ -366,6 +483,8 @@ BulletRT::Core::VulkanDevice::VulkanDevice() noexcept : m_PhysicalDevice(), m_Lo
     m_EnabledFeaturesSet = {};
     m_QueueFamilyMap = {};
     m_Instance = nullptr;
+    m_SyncObjectPoolStatistics = {};
+    m_PipelineCacheFilename = "";
 }
 
 auto BulletRT::Core::VulkanDeviceBuilder::Build() const -> std::unique_ptr<BulletRT::Core::VulkanDevice>
@@ -432,6 +551,9 @@ auto BulletRT::Core::VulkanImage::New(const VulkanDevice *device, const VulkanIm
                                .setExtent(builder.GetExtent())
                                .setMipLevels(builder.GetMipLevels())
                                .setArrayLayers(builder.GetArrayLayers())
+                               .setSamples(builder.GetSamples())
+                               .setTiling(builder.GetTiling())
+                               .setUsage(builder.GetUsage())
                                .setInitialLayout(builder.GetInitialLayout())
                                .setQueueFamilyIndices(queueFamilyIndices)
                                .setSharingMode(builder.GetSharingMode());
@@ -449,6 +571,8 @@ auto BulletRT::Core::VulkanImage::New(const VulkanDevice *device, const VulkanIm
         vulkanImage->m_Flags = builder.GetFlags();
         vulkanImage->m_MipLevels = builder.GetMipLevels();
         vulkanImage->m_ArrayLayers = builder.GetArrayLayers();
+        vulkanImage->m_Samples = builder.GetSamples();
+        vulkanImage->m_Tiling = builder.GetTiling();
         vulkanImage->m_InitialLayout = builder.GetInitialLayout();
         vulkanImage->m_QueueFamilyIndices = queueFamilyIndices;
         return std::unique_ptr<VulkanImage>(vulkanImage);
@@ -472,6 +596,7 @@ BulletRT::Core::VulkanImage::VulkanImage() noexcept
     m_MipLevels = 1;
     m_ArrayLayers = 1;
     m_Samples = vk::SampleCountFlagBits::e1;
+    m_Tiling = vk::ImageTiling::eOptimal;
     m_Usage = {};
     m_QueueFamilyIndices = {};
     m_InitialLayout = vk::ImageLayout::eUndefined;
@@ -557,8 +682,20 @@ auto BulletRT::Core::VulkanDeviceMemory::New(const VulkanDevice *device, const V
         vulkanDeviceMemory->m_DeviceMemory = std::move(deviceMemory);
         vulkanDeviceMemory->m_AllocationSize = builder.GetAllocationSize();
         vulkanDeviceMemory->m_MemoryTypeIndex = builder.GetMemoryTypeIndex();
+        vulkanDeviceMemory->m_MemoryPropertyFlags = device->GetPhysicalDeviceVk().getMemoryProperties().memoryTypes[builder.GetMemoryTypeIndex()].propertyFlags;
+        vulkanDeviceMemory->m_NonCoherentAtomSize = physicalDeviceProperties.limits.nonCoherentAtomSize;
         vulkanDeviceMemory->m_MemoryAllocateFlagsInfo = memoryAllocateFlagsInfo;
         vulkanDeviceMemory->m_MemoryDedicatedAllocateInfo = memoryDedicatedAllocateInfo;
+        if (builder.GetPersistentMapped() && vulkanDeviceMemory->IsHostVisible())
+        {
+            void *pMappedData = nullptr;
+            if (vulkanDeviceMemory->Map(&pMappedData) != vk::Result::eSuccess)
+            {
+                delete vulkanDeviceMemory;
+                return nullptr;
+            }
+            vulkanDeviceMemory->m_PersistentMapped = true;
+        }
         return std::unique_ptr<VulkanDeviceMemory>(vulkanDeviceMemory);
     }
     return nullptr;
@@ -570,28 +707,109 @@ BulletRT::Core::VulkanDeviceMemory::VulkanDeviceMemory() noexcept
     m_DeviceMemory = {};
     m_AllocationSize = 0;
     m_MemoryTypeIndex = 0;
+    m_MemoryPropertyFlags = {};
+    m_NonCoherentAtomSize = 1;
     m_MemoryAllocateFlagsInfo = std::nullopt;
     m_MemoryDedicatedAllocateInfo = std::nullopt;
+    m_PersistentMapped = false;
+    m_MappedData = nullptr;
+    m_MapCount = 0;
 }
 
 BulletRT::Core::VulkanDeviceMemory::~VulkanDeviceMemory() noexcept
 {
+    if (m_MappedData)
+    {
+        m_Device->GetDeviceVk().unmapMemory(m_DeviceMemory.get());
+        m_MappedData = nullptr;
+        m_MapCount = 0;
+    }
     m_DeviceMemory.reset();
 }
 
 auto BulletRT::Core::VulkanDeviceMemory::Map(void **pPData, vk::MemoryMapFlags flags) const -> vk::Result
 {
-    return m_Device->GetDeviceVk().mapMemory(m_DeviceMemory.get(), 0, m_AllocationSize, flags, pPData);
+    return Map(pPData, m_AllocationSize, 0, flags);
 }
 
 auto BulletRT::Core::VulkanDeviceMemory::Map(void **pPData, vk::DeviceSize size, vk::DeviceSize offset, vk::MemoryMapFlags flags) const -> vk::Result
 {
-    return m_Device->GetDeviceVk().mapMemory(m_DeviceMemory.get(), offset, size, flags, pPData);
+    if (!pPData)
+    {
+        return vk::Result::eErrorInitializationFailed;
+    }
+    std::lock_guard<std::mutex> lock(m_MapMutex);
+    if (!m_MappedData)
+    {
+        auto res = m_Device->GetDeviceVk().mapMemory(m_DeviceMemory.get(), 0, VK_WHOLE_SIZE, flags, &m_MappedData);
+        if (res != vk::Result::eSuccess)
+        {
+            m_MappedData = nullptr;
+            return res;
+        }
+    }
+    ++m_MapCount;
+    *pPData = static_cast<char *>(m_MappedData) + offset;
+    return vk::Result::eSuccess;
 }
 
 void BulletRT::Core::VulkanDeviceMemory::Unmap() const
 {
-    return m_Device->GetDeviceVk().unmapMemory(m_DeviceMemory.get());
+    std::lock_guard<std::mutex> lock(m_MapMutex);
+    if (m_MapCount == 0)
+    {
+        return;
+    }
+    --m_MapCount;
+    if (m_MapCount == 0 && !m_PersistentMapped)
+    {
+        m_Device->GetDeviceVk().unmapMemory(m_DeviceMemory.get());
+        m_MappedData = nullptr;
+    }
+}
+
+auto BulletRT::Core::VulkanDeviceMemory::FlushMappedRange(vk::DeviceSize size, vk::DeviceSize offset) const -> vk::Result
+{
+    if (IsHostCoherent())
+    {
+        return vk::Result::eSuccess;
+    }
+    auto mappedRange = Impl_GetMappedRangeVk(size, offset);
+    return m_Device->GetDeviceVk().flushMappedMemoryRanges(1, &mappedRange);
+}
+
+auto BulletRT::Core::VulkanDeviceMemory::InvalidateMappedRange(vk::DeviceSize size, vk::DeviceSize offset) const -> vk::Result
+{
+    if (IsHostCoherent())
+    {
+        return vk::Result::eSuccess;
+    }
+    auto mappedRange = Impl_GetMappedRangeVk(size, offset);
+    return m_Device->GetDeviceVk().invalidateMappedMemoryRanges(1, &mappedRange);
+}
+
+auto BulletRT::Core::VulkanDeviceMemory::GetMappedData() const noexcept -> void *
+{
+    std::lock_guard<std::mutex> lock(m_MapMutex);
+    return m_MappedData;
+}
+
+auto BulletRT::Core::VulkanDeviceMemory::Impl_GetMappedRangeVk(vk::DeviceSize size, vk::DeviceSize offset) const noexcept -> vk::MappedMemoryRange
+{
+    // Ranges on non coherent memory must start and end on nonCoherentAtomSize boundaries,
+    // except that the end may also be the end of the allocation.
+    auto atomSize = std::max<vk::DeviceSize>(m_NonCoherentAtomSize, 1);
+    auto beginOffset = (offset / atomSize) * atomSize;
+    auto rangeSize = vk::DeviceSize(VK_WHOLE_SIZE);
+    if (size != VK_WHOLE_SIZE)
+    {
+        auto endOffset = ((offset + size + atomSize - 1) / atomSize) * atomSize;
+        if (endOffset < m_AllocationSize)
+        {
+            rangeSize = endOffset - beginOffset;
+        }
+    }
+    return vk::MappedMemoryRange().setMemory(m_DeviceMemory.get()).setOffset(beginOffset).setSize(rangeSize);
 }
 
 auto BulletRT::Core::VulkanQueueFamily::Acquire(const VulkanDevice *device, uint32_t queueFamilyIndex) noexcept -> std::optional<VulkanQueueFamily>
@@ -657,6 +875,38 @@ BulletRT::Core::VulkanQueue::VulkanQueue() noexcept
     m_QueueIndex = 0;
 }
 
+auto BulletRT::Core::VulkanQueue::Submit(const std::vector<VulkanSubmitDesc> &submitDescs, const VulkanFence *fence) const -> vk::Result
+{
+    auto submitInfos = std::vector<vk::SubmitInfo>();
+    auto timelineSemaphoreSubmitInfos = std::vector<vk::TimelineSemaphoreSubmitInfo>();
+    submitInfos.reserve(submitDescs.size());
+    timelineSemaphoreSubmitInfos.reserve(submitDescs.size());
+    for (auto &submitDesc : submitDescs)
+    {
+        auto submitInfo = vk::SubmitInfo()
+                              .setWaitSemaphores(submitDesc.GetWaitSemaphores())
+                              .setWaitDstStageMask(submitDesc.GetWaitDstStageMasks())
+                              .setCommandBuffers(submitDesc.GetCommandBuffers())
+                              .setSignalSemaphores(submitDesc.GetSignalSemaphores());
+        // Only chain the timeline info when a timeline semaphore is involved, so binary-only submissions stay valid without the feature.
+        // A timeline semaphore waited or signalled at 0 still needs it; submitting one without it is invalid usage.
+        if (submitDesc.HasTimelineSemaphore())
+        {
+            timelineSemaphoreSubmitInfos.push_back(vk::TimelineSemaphoreSubmitInfo()
+                                                       .setWaitSemaphoreValues(submitDesc.GetWaitValues())
+                                                       .setSignalSemaphoreValues(submitDesc.GetSignalValues()));
+            submitInfo.setPNext(&timelineSemaphoreSubmitInfos.back());
+        }
+        submitInfos.push_back(submitInfo);
+    }
+    return m_Queue.submit(static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), fence ? fence->GetFenceVk() : vk::Fence());
+}
+
+auto BulletRT::Core::VulkanQueue::Submit(const VulkanSubmitDesc &submitDesc, const VulkanFence *fence) const -> vk::Result
+{
+    return Submit(std::vector<VulkanSubmitDesc>{submitDesc}, fence);
+}
+
 auto BulletRT::Core::VulkanQueueFamilyBuilder::Build(const VulkanDevice *device) const -> std::optional<VulkanQueueFamily>
 {
     return BulletRT::Core::VulkanQueueFamily::Acquire(device, GetQueueFamilyIndex());
@@ -667,17 +917,18 @@ auto BulletRT::Core::VulkanQueueFamily::NewCommandPool() const -> std::unique_pt
     return BulletRT::Core::VulkanCommandPool::New(GetDevice(), GetQueueFamilyIndex());
 }
 
-auto BulletRT::Core::VulkanCommandPool::New(const VulkanDevice *device, uint32_t queueFamilyIndex) noexcept -> std::unique_ptr<VulkanCommandPool>
+auto BulletRT::Core::VulkanCommandPool::New(const VulkanDevice *device, uint32_t queueFamilyIndex, vk::CommandPoolCreateFlags flags) noexcept -> std::unique_ptr<VulkanCommandPool>
 {
     auto commandPool = device->GetDeviceVk().createCommandPoolUnique(vk::CommandPoolCreateInfo()
                                                                          .setQueueFamilyIndex(queueFamilyIndex)
-                                                                         .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer));
+                                                                         .setFlags(flags));
     if (commandPool)
     {
         auto vulkanCommandPool = new VulkanCommandPool();
         vulkanCommandPool->m_Device = device;
         vulkanCommandPool->m_CommandPool = std::move(commandPool);
         vulkanCommandPool->m_QueueFamilyIndex = queueFamilyIndex;
+        vulkanCommandPool->m_Flags = flags;
         return std::unique_ptr<VulkanCommandPool>(vulkanCommandPool);
     }
     return nullptr;
@@ -703,6 +954,18 @@ auto BulletRT::Core::VulkanCommandPool::GetQueueFamilyIndex() const noexcept ->
     return m_QueueFamilyIndex;
 }
 
+auto BulletRT::Core::VulkanCommandPool::GetFlags() const noexcept -> vk::CommandPoolCreateFlags
+{
+    return m_Flags;
+}
+
+auto BulletRT::Core::VulkanCommandPool::Reset(vk::CommandPoolResetFlags flags) const noexcept -> vk::Result
+{
+    // The enhanced vulkan.hpp overload returns void and throws; the dispatcher entry point keeps this noexcept.
+    return static_cast<vk::Result>(VULKAN_HPP_DEFAULT_DISPATCHER.vkResetCommandPool(
+        static_cast<VkDevice>(m_Device->GetDeviceVk()), static_cast<VkCommandPool>(m_CommandPool.get()), static_cast<VkCommandPoolResetFlags>(flags)));
+}
+
 auto BulletRT::Core::VulkanCommandPool::NewCommandBuffer(vk::CommandBufferLevel level) const noexcept -> std::unique_ptr<VulkanCommandBuffer>
 {
     return BulletRT::Core::VulkanCommandBuffer::New(this, level);
@@ -713,6 +976,7 @@ BulletRT::Core::VulkanCommandPool::VulkanCommandPool() noexcept
     m_CommandPool = {};
     m_Device = nullptr;
     m_QueueFamilyIndex = 0;
+    m_Flags = {};
 }
 
 auto BulletRT::Core::VulkanCommandBuffer::New(const VulkanCommandPool *commandPool, vk::CommandBufferLevel commandBufferLevel) noexcept -> std::unique_ptr<VulkanCommandBuffer>
@@ -739,6 +1003,119 @@ auto BulletRT::Core::VulkanCommandBuffer::GetCommandPool() const noexcept -> con
     return m_CommandPool;
 }
 
+auto BulletRT::Core::VulkanCommandBufferAllocator::New(const VulkanDevice *device, uint32_t queueFamilyIndex, uint32_t frameCount) -> std::unique_ptr<VulkanCommandBufferAllocator>
+{
+    if (!device || frameCount == 0 || !device->SupportQueueFamily(queueFamilyIndex))
+    {
+        return nullptr;
+    }
+    auto allocator = new VulkanCommandBufferAllocator();
+    allocator->m_Device = device;
+    allocator->m_QueueFamilyIndex = queueFamilyIndex;
+    allocator->m_FrameIndex = frameCount - 1;
+    allocator->m_Frames = std::vector<FrameDesc>(frameCount);
+    return std::unique_ptr<VulkanCommandBufferAllocator>(allocator);
+}
+
+BulletRT::Core::VulkanCommandBufferAllocator::~VulkanCommandBufferAllocator() noexcept
+{
+    for (auto &frame : m_Frames)
+    {
+        if (frame.fence)
+        {
+            frame.fence->Wait(UINT64_MAX);
+        }
+        frame.pools.clear();
+    }
+    m_Frames.clear();
+}
+
+auto BulletRT::Core::VulkanCommandBufferAllocator::BeginFrame() -> vk::Result
+{
+    m_FrameIndex = (m_FrameIndex + 1) % static_cast<uint32_t>(m_Frames.size());
+    auto &frame = m_Frames[m_FrameIndex];
+    if (frame.fence)
+    {
+        auto res = frame.fence->Wait(UINT64_MAX);
+        if (res != vk::Result::eSuccess)
+        {
+            return res;
+        }
+        frame.fence = nullptr;
+    }
+    for (auto &[threadId, pool] : frame.pools)
+    {
+        if (pool->cursors[0] == 0 && pool->cursors[1] == 0)
+        {
+            continue;
+        }
+        auto res = pool->commandPool->Reset();
+        if (res != vk::Result::eSuccess)
+        {
+            return res;
+        }
+        pool->cursors[0] = 0;
+        pool->cursors[1] = 0;
+    }
+    return vk::Result::eSuccess;
+}
+
+auto BulletRT::Core::VulkanCommandBufferAllocator::Allocate(vk::CommandBufferLevel level) -> vk::CommandBuffer
+{
+    auto pool = Impl_AcquirePool();
+    if (!pool)
+    {
+        return nullptr;
+    }
+    auto levelIndex = level == vk::CommandBufferLevel::ePrimary ? 0 : 1;
+    auto &commandBuffers = pool->commandBuffers[levelIndex];
+    auto &cursor = pool->cursors[levelIndex];
+    if (cursor == commandBuffers.size())
+    {
+        // Grow in small batches so that steady state recording never reaches the driver.
+        auto growCount = std::max<uint32_t>(static_cast<uint32_t>(commandBuffers.size()), 1);
+        auto newCommandBuffers = m_Device->GetDeviceVk().allocateCommandBuffers(vk::CommandBufferAllocateInfo()
+                                                                                    .setCommandPool(pool->commandPool->GetCommandPoolVk())
+                                                                                    .setLevel(level)
+                                                                                    .setCommandBufferCount(growCount));
+        commandBuffers.insert(std::end(commandBuffers), std::begin(newCommandBuffers), std::end(newCommandBuffers));
+    }
+    return commandBuffers[cursor++];
+}
+
+void BulletRT::Core::VulkanCommandBufferAllocator::EndFrame(const VulkanFence *fence)
+{
+    m_Frames[m_FrameIndex].fence = fence;
+}
+
+BulletRT::Core::VulkanCommandBufferAllocator::VulkanCommandBufferAllocator() noexcept
+{
+    m_Device = nullptr;
+    m_QueueFamilyIndex = 0;
+    m_FrameIndex = 0;
+}
+
+auto BulletRT::Core::VulkanCommandBufferAllocator::Impl_AcquirePool() -> PoolDesc *
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto &pools = m_Frames[m_FrameIndex].pools;
+    auto &pool = pools[std::this_thread::get_id()];
+    if (!pool)
+    {
+        auto commandPool = VulkanCommandPool::New(m_Device, m_QueueFamilyIndex, vk::CommandPoolCreateFlagBits::eTransient);
+        if (!commandPool)
+        {
+            pools.erase(std::this_thread::get_id());
+            return nullptr;
+        }
+        pool = std::make_unique<PoolDesc>();
+        pool->commandPool = std::move(commandPool);
+        pool->cursors[0] = 0;
+        pool->cursors[1] = 0;
+    }
+    return pool.get();
+}
+
 BulletRT::Core::VulkanCommandBuffer::VulkanCommandBuffer() noexcept
 {
     m_CommandBuffer = {};
@@ -782,6 +1159,16 @@ void BulletRT::Core::VulkanMemoryBuffer::Unmap() const
     m_Memory->Unmap();
 }
 
+auto BulletRT::Core::VulkanMemoryBuffer::FlushMappedRange(vk::DeviceSize size, vk::DeviceSize offset) const -> vk::Result
+{
+    return m_Memory->FlushMappedRange(size == VK_WHOLE_SIZE ? m_Buffer->GetSize() - offset : size, m_MemoryOffset + offset);
+}
+
+auto BulletRT::Core::VulkanMemoryBuffer::InvalidateMappedRange(vk::DeviceSize size, vk::DeviceSize offset) const -> vk::Result
+{
+    return m_Memory->InvalidateMappedRange(size == VK_WHOLE_SIZE ? m_Buffer->GetSize() - offset : size, m_MemoryOffset + offset);
+}
+
 bool BulletRT::Core::VulkanMemoryBuffer::SupportDeviceAddress(const VulkanBuffer *buffer, const VulkanDeviceMemory *memory) noexcept
 {
     bool supportDeviceAddress = false;
@@ -875,1934 +1262,3970 @@ BulletRT::Core::VulkanMemoryImage::VulkanMemoryImage() noexcept
     m_MemoryOffset = 0;
 }
 
-auto BulletRT::Core::VulkanFence::New(const VulkanDevice *device, bool isSignaled) -> std::unique_ptr<VulkanFence>
+auto BulletRT::Core::VulkanDeferredOperation::New(const VulkanDevice *device, JobSubmitter submitter) -> std::unique_ptr<VulkanDeferredOperation>
 {
-    auto fenceVk = device->GetDeviceVk().createFenceUnique(vk::FenceCreateInfo().setFlags(isSignaled ? vk::FenceCreateFlagBits::eSignaled : vk::FenceCreateFlags{}));
-    auto fence = new VulkanFence();
-    fence->m_Device = device;
-    fence->m_Fence = std::move(fenceVk);
-    return std::unique_ptr<VulkanFence>(fence);
+    if (!device || !device->SupportExtension(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME))
+    {
+        return nullptr;
+    }
+    auto deferredOperation = std::unique_ptr<VulkanDeferredOperation>(new VulkanDeferredOperation());
+    deferredOperation->m_Device = device;
+    deferredOperation->m_DeferredOperation = device->GetDeviceVk().createDeferredOperationKHRUnique();
+    if (!deferredOperation->m_DeferredOperation)
+    {
+        return nullptr;
+    }
+    deferredOperation->m_Submitter = std::move(submitter);
+    return deferredOperation;
 }
 
-BulletRT::Core::VulkanFence::~VulkanFence() noexcept
+BulletRT::Core::VulkanDeferredOperation::~VulkanDeferredOperation() noexcept
 {
-    m_Fence.reset();
+    m_DeferredOperation.reset();
 }
 
-BulletRT::Core::VulkanFence::VulkanFence() noexcept
+auto BulletRT::Core::VulkanDeferredOperation::Join() const -> vk::Result
 {
-    m_Fence = {};
-    m_Device = nullptr;
+    while (true)
+    {
+        auto result = m_Device->GetDeviceVk().joinDeferredOperationKHR(m_DeferredOperation.get());
+        // eThreadIdleKHR: no work for this thread right now, but more may become available later.
+        if (result != vk::Result::eThreadIdleKHR)
+        {
+            return result;
+        }
+        std::this_thread::yield();
+    }
 }
-auto VulkanFence::Wait(uint64_t timeout) const noexcept -> vk::Result
+
+auto BulletRT::Core::VulkanDeferredOperation::JoinAll(uint32_t maxThreadCount) const -> vk::Result
 {
-    vk::Fence fence = m_Fence.get();
-    return m_Device->GetDeviceVk().waitForFences(1, &fence, VK_TRUE, timeout);
+    struct HelperState
+    {
+        std::mutex mutex;
+        std::condition_variable idleCondition;
+        uint32_t activeCount = 0;
+        bool isFinished = false;
+    };
+    auto threadCount = m_Submitter ? GetMaxConcurrency() : 1;
+    if (maxThreadCount > 0)
+    {
+        threadCount = std::min(threadCount, maxThreadCount);
+    }
+    // The calling thread joins as well, so only threadCount - 1 helpers are submitted. A helper that has not started
+    // by the time the caller is done skips the join, so the operation is never touched after JoinAll returned.
+    auto state = std::make_shared<HelperState>();
+    auto helper = [this, state]()
+    {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->isFinished)
+            {
+                return;
+            }
+            ++state->activeCount;
+        }
+        // Failures surface through GetResult on the joining caller.
+        try
+        {
+            Join();
+        }
+        catch (...)
+        {
+        }
+        std::lock_guard<std::mutex> lock(state->mutex);
+        --state->activeCount;
+        state->idleCondition.notify_all();
+    };
+    for (uint32_t i = 1; i < threadCount; ++i)
+    {
+        m_Submitter(helper);
+    }
+    auto exception = std::exception_ptr();
+    try
+    {
+        Join();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+    // eThreadDoneKHR on the caller means the remaining work belongs to helpers that already joined.
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->isFinished = true;
+        state->idleCondition.wait(lock, [&state]() { return state->activeCount == 0; });
+    }
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+    return GetResult();
 }
 
-auto VulkanFence::QueryStatus() const noexcept -> vk::Result
+auto BulletRT::Core::VulkanDeferredOperation::JoinAsync(uint32_t maxThreadCount) const -> std::future<vk::Result>
 {
-    return m_Device->GetDeviceVk().getFenceStatus(m_Fence.get());
+    if (!m_Submitter)
+    {
+        return std::async(std::launch::async, [this, maxThreadCount]() { return JoinAll(maxThreadCount); });
+    }
+    auto promise = std::make_shared<std::promise<vk::Result>>();
+    auto future = promise->get_future();
+    auto job = [this, maxThreadCount, promise]()
+    {
+        try
+        {
+            promise->set_value(JoinAll(maxThreadCount));
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    };
+    m_Submitter(job);
+    return future;
 }
 
-auto VulkanDevice::NewFence(bool isSignaled) -> std::unique_ptr<VulkanFence>
+auto BulletRT::Core::VulkanDeferredOperation::GetMaxConcurrency() const -> uint32_t
 {
-    return VulkanFence::New(this, isSignaled);
+    return std::max<uint32_t>(m_Device->GetDeviceVk().getDeferredOperationMaxConcurrencyKHR(m_DeferredOperation.get()), 1);
 }
 
-auto VulkanPipelineVertexInputStateDesc::GetVulkanPipelineVertexInputStateCreateInfoVk() const noexcept -> vk::PipelineVertexInputStateCreateInfo
+auto BulletRT::Core::VulkanDeferredOperation::GetResult() const -> vk::Result
 {
-    return vk::PipelineVertexInputStateCreateInfo()
-        .setVertexBindingDescriptions(m_VertexBindingDescriptions)
-        .setVertexAttributeDescriptions(m_VertexAttributeDescriptions)
-        .setFlags(m_Flags);
+    return m_Device->GetDeviceVk().getDeferredOperationResultKHR(m_DeferredOperation.get());
 }
 
-auto VulkanPipelineVertexInputStateDesc::GetPipelineVertexInputDivisorStateCreateInfoEXT() const noexcept -> std::optional<vk::PipelineVertexInputDivisorStateCreateInfoEXT>
+BulletRT::Core::VulkanDeferredOperation::VulkanDeferredOperation() noexcept
 {
-    if (!m_VertexBindingDivisors.empty())
-    {
-        return vk::PipelineVertexInputDivisorStateCreateInfoEXT().setVertexBindingDivisors(m_VertexBindingDivisors);
-    }
-    else
-    {
-        return std::nullopt;
-    }
+    m_Device = nullptr;
+    m_DeferredOperation = {};
+    m_Submitter = nullptr;
 }
 
-VulkanPipelineVertexInputStateDesc::VulkanPipelineVertexInputStateDesc() noexcept
+auto BulletRT::Core::VulkanAccelerationStructureGeometryDesc::Triangles(const VulkanMemoryBuffer *vertexBuffer, vk::Format vertexFormat, vk::DeviceSize vertexStride, uint32_t vertexCount,
+                                                                        const VulkanMemoryBuffer *indexBuffer, vk::IndexType indexType, uint32_t triangleCount) noexcept -> VulkanAccelerationStructureGeometryDesc
 {
+    return VulkanAccelerationStructureGeometryDesc()
+        .SetGeometryType(vk::GeometryTypeKHR::eTriangles)
+        .SetVertexBuffer(vertexBuffer)
+        .SetVertexFormat(vertexFormat)
+        .SetVertexStride(vertexStride)
+        .SetMaxVertex(vertexCount > 0 ? vertexCount - 1 : 0)
+        .SetIndexBuffer(indexBuffer, indexBuffer ? indexType : vk::IndexType::eNoneKHR)
+        .SetPrimitiveCount(triangleCount);
 }
 
-VulkanPipelineVertexInputStateDesc::VulkanPipelineVertexInputStateDesc(const BulletRT::Core::VulkanPipelineVertexInputStateDesc &builder) noexcept
+auto BulletRT::Core::VulkanAccelerationStructureGeometryDesc::Aabbs(const VulkanMemoryBuffer *aabbBuffer, uint32_t aabbCount, vk::DeviceSize aabbStride) noexcept -> VulkanAccelerationStructureGeometryDesc
 {
-    m_Flags = builder.m_Flags;
-    m_VertexBindingDescriptions = builder.m_VertexBindingDescriptions;
-    m_VertexAttributeDescriptions = builder.m_VertexAttributeDescriptions;
-    m_VertexBindingDivisors = builder.m_VertexBindingDivisors;
+    return VulkanAccelerationStructureGeometryDesc()
+        .SetGeometryType(vk::GeometryTypeKHR::eAabbs)
+        .SetAabbBuffer(aabbBuffer)
+        .SetAabbStride(aabbStride)
+        .SetPrimitiveCount(aabbCount);
 }
 
-VulkanPipelineVertexInputStateDesc::VulkanPipelineVertexInputStateDesc(BulletRT::Core::VulkanPipelineVertexInputStateDesc &&builder) noexcept
+auto BulletRT::Core::VulkanAccelerationStructureGeometryDesc::Instances(const VulkanMemoryBuffer *instanceBuffer, uint32_t instanceCount) noexcept -> VulkanAccelerationStructureGeometryDesc
 {
-    m_Flags = std::move(builder.m_Flags);
-    m_VertexBindingDescriptions = std::move(builder.m_VertexBindingDescriptions);
-    m_VertexAttributeDescriptions = std::move(builder.m_VertexAttributeDescriptions);
-    m_VertexBindingDivisors = std::move(builder.m_VertexBindingDivisors);
+    return VulkanAccelerationStructureGeometryDesc()
+        .SetGeometryType(vk::GeometryTypeKHR::eInstances)
+        .SetFlags({})
+        .SetInstanceBuffer(instanceBuffer)
+        .SetPrimitiveCount(instanceCount);
 }
 
-BulletRT::Core::VulkanPipelineVertexInputStateDesc &VulkanPipelineVertexInputStateDesc::operator=(const BulletRT::Core::VulkanPipelineVertexInputStateDesc &builder) noexcept
+auto BulletRT::Core::VulkanAccelerationStructureGeometryDesc::GetGeometryVk(vk::AccelerationStructureBuildTypeKHR buildType) const noexcept -> vk::AccelerationStructureGeometryKHR
 {
-    if (this != &builder)
+    auto getAddress = [buildType](const VulkanMemoryBuffer *buffer, vk::DeviceSize offset) {
+        if (buildType == vk::AccelerationStructureBuildTypeKHR::eHost)
+        {
+            auto mappedData = buffer ? static_cast<const uint8_t *>(buffer->GetMemory()->GetMappedData()) : nullptr;
+            return vk::DeviceOrHostAddressConstKHR().setHostAddress(mappedData ? mappedData + buffer->GetMemoryOffset() + offset : nullptr);
+        }
+        return vk::DeviceOrHostAddressConstKHR().setDeviceAddress(buffer ? buffer->GetDeviceAddress().value_or(0) + offset : 0);
+    };
+    auto geometryData = vk::AccelerationStructureGeometryDataKHR();
+    if (m_GeometryType == vk::GeometryTypeKHR::eTriangles)
     {
-        m_Flags = builder.m_Flags;
-        m_VertexBindingDescriptions = builder.m_VertexBindingDescriptions;
-        m_VertexAttributeDescriptions = builder.m_VertexAttributeDescriptions;
-        m_VertexBindingDivisors = builder.m_VertexBindingDivisors;
+        geometryData.setTriangles(vk::AccelerationStructureGeometryTrianglesDataKHR()
+                                      .setVertexFormat(m_VertexFormat)
+                                      .setVertexData(getAddress(m_VertexBuffer, m_VertexOffset))
+                                      .setVertexStride(m_VertexStride)
+                                      .setMaxVertex(m_MaxVertex)
+                                      .setIndexType(m_IndexType)
+                                      .setIndexData(getAddress(m_IndexBuffer, m_IndexOffset))
+                                      .setTransformData(getAddress(m_TransformBuffer, m_TransformOffset)));
     }
-    return *this;
-}
-
-BulletRT::Core::VulkanPipelineVertexInputStateDesc &VulkanPipelineVertexInputStateDesc::operator=(BulletRT::Core::VulkanPipelineVertexInputStateDesc &&builder) noexcept
-{
-    if (this != &builder)
+    if (m_GeometryType == vk::GeometryTypeKHR::eAabbs)
     {
-        m_Flags = std::move(builder.m_Flags);
-        m_VertexBindingDescriptions = std::move(builder.m_VertexBindingDescriptions);
-        m_VertexAttributeDescriptions = std::move(builder.m_VertexAttributeDescriptions);
-        m_VertexBindingDivisors = std::move(builder.m_VertexBindingDivisors);
+        geometryData.setAabbs(vk::AccelerationStructureGeometryAabbsDataKHR()
+                                  .setData(getAddress(m_AabbBuffer, m_AabbOffset))
+                                  .setStride(m_AabbStride));
     }
-    return *this;
+    if (m_GeometryType == vk::GeometryTypeKHR::eInstances)
+    {
+        geometryData.setInstances(vk::AccelerationStructureGeometryInstancesDataKHR()
+                                      .setArrayOfPointers(VK_FALSE)
+                                      .setData(getAddress(m_InstanceBuffer, m_InstanceOffset)));
+    }
+    return vk::AccelerationStructureGeometryKHR()
+        .setGeometryType(m_GeometryType)
+        .setGeometry(geometryData)
+        .setFlags(m_Flags);
 }
 
-VulkanGraphicsPipelineBuilder::VulkanGraphicsPipelineBuilder() noexcept
+auto BulletRT::Core::VulkanAccelerationStructureGeometryDesc::GetBuildRangeInfoVk() const noexcept -> vk::AccelerationStructureBuildRangeInfoKHR
 {
+    return vk::AccelerationStructureBuildRangeInfoKHR()
+        .setPrimitiveCount(m_PrimitiveCount)
+        .setPrimitiveOffset(0)
+        .setFirstVertex(0)
+        .setTransformOffset(0);
 }
 
-auto VulkanPipelineVertexInputStateDesc::AddVertexBindingDescription(const vk::VertexInputBindingDescription &bindingDesc) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
+auto BulletRT::Core::VulkanAccelerationStructureBuilder::Build(const VulkanDevice *device) const -> std::unique_ptr<VulkanAccelerationStructure>
 {
-    m_VertexBindingDescriptions.push_back(bindingDesc);
-    return *this;
+    return VulkanAccelerationStructure::New(device, *this);
 }
 
-auto VulkanPipelineVertexInputStateDesc::SetVertexBindingDescription(size_t idx, const vk::VertexInputBindingDescription &bindingDesc) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
+auto BulletRT::Core::VulkanAccelerationStructure::New(const VulkanDevice *device, const VulkanAccelerationStructureBuilder &builder) -> std::unique_ptr<VulkanAccelerationStructure>
 {
-    if (m_VertexBindingDescriptions.size() > idx)
+    if (!device || !device->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) || builder.GetGeometries().empty())
     {
-        m_VertexBindingDescriptions[idx] = bindingDesc;
+        return nullptr;
     }
-    return *this;
+    if (builder.GetBuildType() == vk::AccelerationStructureBuildTypeKHR::eHost)
+    {
+        // Host commands must have been enabled on the device, not merely be supported by the physical device.
+        auto features = device->QueryFeatures<vk::PhysicalDeviceAccelerationStructureFeaturesKHR>();
+        if (!features || !features->accelerationStructureHostCommands)
+        {
+            return nullptr;
+        }
+    }
+    auto accelerationStructure = std::unique_ptr<VulkanAccelerationStructure>(new VulkanAccelerationStructure());
+    accelerationStructure->m_Device = device;
+    accelerationStructure->m_Type = builder.GetType();
+    accelerationStructure->m_Flags = builder.GetFlags();
+    accelerationStructure->m_BuildType = builder.GetBuildType();
+    accelerationStructure->m_Geometries = builder.GetGeometries();
+    if (builder.GetBuildType() == vk::AccelerationStructureBuildTypeKHR::eDevice)
+    {
+        accelerationStructure->m_StorageAllocator = builder.GetStorageAllocator();
+        accelerationStructure->m_ScratchAllocator = builder.GetScratchAllocator();
+    }
+
+    auto geometries = std::vector<vk::AccelerationStructureGeometryKHR>();
+    auto buildGeometryInfo = accelerationStructure->GetBuildGeometryInfoVk(geometries);
+    auto maxPrimitiveCounts = std::vector<uint32_t>();
+    maxPrimitiveCounts.reserve(builder.GetGeometries().size());
+    for (auto &geometry : builder.GetGeometries())
+    {
+        maxPrimitiveCounts.push_back(geometry.GetPrimitiveCount());
+    }
+    accelerationStructure->m_BuildSizes = device->GetDeviceVk().getAccelerationStructureBuildSizesKHR(builder.GetBuildType(), buildGeometryInfo, maxPrimitiveCounts);
+    accelerationStructure->m_MaxPrimitiveCounts = maxPrimitiveCounts;
+    if (builder.GetStorageSize() > 0)
+    {
+        accelerationStructure->m_BuildSizes.accelerationStructureSize = builder.GetStorageSize();
+    }
+    accelerationStructure->m_ScratchAlignment = device->GetPhysicalDeviceVk().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceAccelerationStructurePropertiesKHR>().get<vk::PhysicalDeviceAccelerationStructurePropertiesKHR>().minAccelerationStructureScratchOffsetAlignment;
+    accelerationStructure->m_ScratchAlignment = std::max<vk::DeviceSize>(accelerationStructure->m_ScratchAlignment, 1);
+
+    // Host built structures are written by the CPU, so their storage must live in host visible memory.
+    auto storageMemoryFlags = builder.GetBuildType() == vk::AccelerationStructureBuildTypeKHR::eHost ? vk::MemoryPropertyFlags(vk::MemoryPropertyFlagBits::eHostVisible)
+                                                                                                     : vk::MemoryPropertyFlags(vk::MemoryPropertyFlagBits::eDeviceLocal);
+    auto storage = Impl_NewStorage(device, accelerationStructure->m_StorageAllocator, accelerationStructure->m_BuildSizes.accelerationStructureSize, accelerationStructureStorageAlignment,
+                                   vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress, storageMemoryFlags);
+    if (!storage)
+    {
+        return nullptr;
+    }
+    accelerationStructure->m_Storage = std::move(storage.value());
+    accelerationStructure->m_AccelerationStructure = device->GetDeviceVk().createAccelerationStructureKHRUnique(vk::AccelerationStructureCreateInfoKHR()
+                                                                                                                   .setBuffer(accelerationStructure->m_Storage.GetBuffer()->GetBufferVk())
+                                                                                                                   .setOffset(accelerationStructure->m_Storage.GetOffset())
+                                                                                                                   .setSize(accelerationStructure->m_BuildSizes.accelerationStructureSize)
+                                                                                                                   .setType(builder.GetType()));
+    if (!accelerationStructure->m_AccelerationStructure)
+    {
+        return nullptr;
+    }
+    accelerationStructure->m_DeviceAddress = device->GetDeviceVk().getAccelerationStructureAddressKHR(vk::AccelerationStructureDeviceAddressInfoKHR()
+                                                                                                          .setAccelerationStructure(accelerationStructure->m_AccelerationStructure.get()));
+    return accelerationStructure;
 }
 
-auto VulkanPipelineVertexInputStateDesc::GetVertexBindingDescriptions() const noexcept -> const std::vector<vk::VertexInputBindingDescription> &
+BulletRT::Core::VulkanAccelerationStructure::~VulkanAccelerationStructure() noexcept
 {
-    return m_VertexBindingDescriptions;
+    m_AccelerationStructure.reset();
+    Impl_ReleaseStorage(m_Scratch);
+    Impl_ReleaseStorage(m_Storage);
 }
 
-auto VulkanPipelineVertexInputStateDesc::GetVertexBindingDescription(size_t idx) const -> const vk::VertexInputBindingDescription &
+auto BulletRT::Core::VulkanAccelerationStructure::RecordBuild(vk::CommandBuffer commandBuffer, vk::BuildAccelerationStructureModeKHR mode) -> vk::Result
 {
-    return m_VertexBindingDescriptions.at(idx);
+    if (m_BuildType == vk::AccelerationStructureBuildTypeKHR::eHost)
+    {
+        return vk::Result::eErrorFeatureNotPresent;
+    }
+    if (mode == vk::BuildAccelerationStructureModeKHR::eUpdate && !(m_Flags & vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate))
+    {
+        return vk::Result::eErrorUnknown;
+    }
+    if (!m_Scratch.GetBuffer())
+    {
+        // The base address of a buffer need not satisfy the scratch alignment, so the address is rounded up within the range.
+        auto scratchSize = std::max(m_BuildSizes.buildScratchSize, m_BuildSizes.updateScratchSize) + m_ScratchAlignment;
+        auto scratch = Impl_NewStorage(m_Device, m_ScratchAllocator, scratchSize, 1,
+                                       vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress, vk::MemoryPropertyFlagBits::eDeviceLocal);
+        if (!scratch)
+        {
+            return vk::Result::eErrorOutOfDeviceMemory;
+        }
+        m_Scratch = std::move(scratch.value());
+    }
+    auto scratchAddress = CalcAlignedSize(m_Scratch.GetBuffer()->GetDeviceAddress().value_or(0) + m_Scratch.GetOffset(), m_ScratchAlignment);
+    RecordBuild(commandBuffer, scratchAddress, mode);
+    return vk::Result::eSuccess;
 }
 
-auto VulkanPipelineVertexInputStateDesc::SetVertexAttributeDescriptions(const std::vector<vk::VertexInputAttributeDescription> &attributeDescs) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
+void BulletRT::Core::VulkanAccelerationStructure::RecordBuild(vk::CommandBuffer commandBuffer, vk::DeviceAddress scratchAddress, vk::BuildAccelerationStructureModeKHR mode) const
 {
-    m_VertexAttributeDescriptions = attributeDescs;
-    return *this;
+    auto geometries = std::vector<vk::AccelerationStructureGeometryKHR>();
+    auto buildGeometryInfo = GetBuildGeometryInfoVk(geometries, mode)
+                                 .setScratchData(vk::DeviceOrHostAddressKHR().setDeviceAddress(scratchAddress));
+    auto buildRangeInfos = GetBuildRangeInfoVks();
+    commandBuffer.buildAccelerationStructuresKHR(buildGeometryInfo, buildRangeInfos.data());
 }
 
-auto VulkanPipelineVertexInputStateDesc::SetVertexBindingDescriptions(const std::vector<vk::VertexInputBindingDescription> &bindingDescs) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
+auto BulletRT::Core::VulkanAccelerationStructure::BuildOnHost(const VulkanDeferredOperation *deferredOperation, vk::BuildAccelerationStructureModeKHR mode) -> vk::Result
 {
-    m_VertexBindingDescriptions = bindingDescs;
-    return *this;
+    if (m_BuildType != vk::AccelerationStructureBuildTypeKHR::eHost)
+    {
+        return vk::Result::eErrorFeatureNotPresent;
+    }
+    if (mode == vk::BuildAccelerationStructureModeKHR::eUpdate && !(m_Flags & vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate))
+    {
+        return vk::Result::eErrorUnknown;
+    }
+    auto scratchSize = mode == vk::BuildAccelerationStructureModeKHR::eUpdate ? m_BuildSizes.updateScratchSize : m_BuildSizes.buildScratchSize;
+    if (m_HostScratch.size() < scratchSize)
+    {
+        m_HostScratch.resize(scratchSize);
+    }
+    // A deferred build reads these after the call returns, so they are kept alive in members.
+    m_HostBuildGeometryInfo = GetBuildGeometryInfoVk(m_HostGeometries, mode)
+                                  .setScratchData(vk::DeviceOrHostAddressKHR().setHostAddress(m_HostScratch.data()));
+    m_HostBuildRangeInfos = GetBuildRangeInfoVks();
+    m_HostBuildRangeInfoPtr = m_HostBuildRangeInfos.data();
+    auto deferredOperationVk = deferredOperation ? deferredOperation->GetDeferredOperationVk() : vk::DeferredOperationKHR();
+    return m_Device->GetDeviceVk().buildAccelerationStructuresKHR(deferredOperationVk, m_HostBuildGeometryInfo, m_HostBuildRangeInfoPtr);
 }
 
-VulkanGraphicsPipelineBuilder::VulkanGraphicsPipelineBuilder(const BulletRT::Core::VulkanGraphicsPipelineBuilder &builder) noexcept
+auto BulletRT::Core::VulkanAccelerationStructure::GetBuildGeometryInfoVk(std::vector<vk::AccelerationStructureGeometryKHR> &geometries, vk::BuildAccelerationStructureModeKHR mode) const -> vk::AccelerationStructureBuildGeometryInfoKHR
 {
-    m_Flags = builder.m_Flags;
-    m_Stages = builder.m_Stages;
-    m_VertexInputState = builder.m_VertexInputState;
-    m_InputAssemblyState = builder.m_InputAssemblyState;
-    m_TessellationState = builder.m_TessellationState;
-    m_ViewportState = builder.m_ViewportState;
-    m_RasterizationState = builder.m_RasterizationState;
-    m_MultiSampleState = builder.m_MultiSampleState;
-    m_DepthStencilState = builder.m_DepthStencilState;
-    m_ColorBlendState = builder.m_ColorBlendState;
-    m_DynamicStates = builder.m_DynamicStates;
-    m_Layout = builder.m_Layout;
-    m_RenderPass = builder.m_RenderPass;
-    m_Subpass = builder.m_Subpass;
-    m_BasePipelineHandle = builder.m_BasePipelineHandle;
-    m_BasePipelineIndex = builder.m_BasePipelineIndex;
+    geometries.clear();
+    geometries.reserve(m_Geometries.size());
+    for (auto &geometry : m_Geometries)
+    {
+        geometries.push_back(geometry.GetGeometryVk(m_BuildType));
+    }
+    return vk::AccelerationStructureBuildGeometryInfoKHR()
+        .setType(m_Type)
+        .setFlags(m_Flags)
+        .setMode(mode)
+        .setSrcAccelerationStructure(mode == vk::BuildAccelerationStructureModeKHR::eUpdate ? m_AccelerationStructure.get() : vk::AccelerationStructureKHR())
+        .setDstAccelerationStructure(m_AccelerationStructure.get())
+        .setGeometries(geometries);
 }
 
-VulkanGraphicsPipelineBuilder::VulkanGraphicsPipelineBuilder(BulletRT::Core::VulkanGraphicsPipelineBuilder &&builder) noexcept
+bool BulletRT::Core::VulkanAccelerationStructure::SetGeometry(size_t idx, const VulkanAccelerationStructureGeometryDesc &geometry) noexcept
 {
-    m_Flags = std::move(builder.m_Flags);
-    m_Stages = std::move(builder.m_Stages);
-    m_VertexInputState = std::move(builder.m_VertexInputState);
-    m_InputAssemblyState = std::move(builder.m_InputAssemblyState);
-    m_TessellationState = std::move(builder.m_TessellationState);
-    m_ViewportState = std::move(builder.m_ViewportState);
-    m_RasterizationState = std::move(builder.m_RasterizationState);
-    m_MultiSampleState = std::move(builder.m_MultiSampleState);
-    m_DepthStencilState = std::move(builder.m_DepthStencilState);
-    m_ColorBlendState = std::move(builder.m_ColorBlendState);
-    m_DynamicStates = std::move(builder.m_DynamicStates);
-    m_Layout = builder.m_Layout;
-    builder.m_Layout = nullptr;
-    m_RenderPass = builder.m_RenderPass;
-    builder.m_RenderPass = nullptr;
-    m_Subpass = std::move(builder.m_Subpass);
-    m_BasePipelineHandle = builder.m_BasePipelineHandle;
-    builder.m_BasePipelineHandle = nullptr;
-    m_BasePipelineIndex = std::move(builder.m_BasePipelineIndex);
+    if (idx >= m_Geometries.size() || m_Geometries[idx].GetGeometryType() != geometry.GetGeometryType() || geometry.GetPrimitiveCount() > m_MaxPrimitiveCounts[idx])
+    {
+        return false;
+    }
+    m_Geometries[idx] = geometry;
+    return true;
 }
 
-BulletRT::Core::VulkanGraphicsPipelineBuilder &VulkanGraphicsPipelineBuilder::operator=(const BulletRT::Core::VulkanGraphicsPipelineBuilder &builder) noexcept
+auto BulletRT::Core::VulkanAccelerationStructure::GetBuildRangeInfoVks() const -> std::vector<vk::AccelerationStructureBuildRangeInfoKHR>
 {
-    if (this != &builder)
+    auto buildRangeInfos = std::vector<vk::AccelerationStructureBuildRangeInfoKHR>();
+    buildRangeInfos.reserve(m_Geometries.size());
+    for (auto &geometry : m_Geometries)
     {
-        m_Flags = builder.m_Flags;
-        m_Stages = builder.m_Stages;
-        m_VertexInputState = builder.m_VertexInputState;
-        m_InputAssemblyState = builder.m_InputAssemblyState;
-        m_TessellationState = builder.m_TessellationState;
-        m_ViewportState = builder.m_ViewportState;
-        m_RasterizationState = builder.m_RasterizationState;
-        m_MultiSampleState = builder.m_MultiSampleState;
-        m_DepthStencilState = builder.m_DepthStencilState;
-        m_ColorBlendState = builder.m_ColorBlendState;
-        m_DynamicStates = builder.m_DynamicStates;
-        m_Layout = builder.m_Layout;
-        m_RenderPass = builder.m_RenderPass;
-        m_Subpass = builder.m_Subpass;
-        m_BasePipelineHandle = builder.m_BasePipelineHandle;
-        m_BasePipelineIndex = builder.m_BasePipelineIndex;
+        buildRangeInfos.push_back(geometry.GetBuildRangeInfoVk());
     }
-    return *this;
+    return buildRangeInfos;
 }
 
-BulletRT::Core::VulkanGraphicsPipelineBuilder &VulkanGraphicsPipelineBuilder::operator=(BulletRT::Core::VulkanGraphicsPipelineBuilder &&builder) noexcept
+auto BulletRT::Core::VulkanAccelerationStructure::RecordCompact(vk::CommandBuffer commandBuffer, vk::DeviceSize compactedSize) -> std::unique_ptr<VulkanAccelerationStructure>
 {
-    if (this != &builder)
+    if (m_BuildType == vk::AccelerationStructureBuildTypeKHR::eHost || !(m_Flags & vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction) || compactedSize == 0)
     {
-        m_Flags = std::move(builder.m_Flags);
-        m_Stages = std::move(builder.m_Stages);
-        m_VertexInputState = std::move(builder.m_VertexInputState);
-        m_InputAssemblyState = std::move(builder.m_InputAssemblyState);
-        m_TessellationState = std::move(builder.m_TessellationState);
-        m_ViewportState = std::move(builder.m_ViewportState);
-        m_RasterizationState = std::move(builder.m_RasterizationState);
-        m_MultiSampleState = std::move(builder.m_MultiSampleState);
-        m_DepthStencilState = std::move(builder.m_DepthStencilState);
-        m_ColorBlendState = std::move(builder.m_ColorBlendState);
-        m_DynamicStates = std::move(builder.m_DynamicStates);
-        m_Layout = builder.m_Layout;
-        builder.m_Layout = nullptr;
-        m_RenderPass = builder.m_RenderPass;
-        builder.m_RenderPass = nullptr;
-        m_Subpass = std::move(builder.m_Subpass);
-        m_BasePipelineHandle = builder.m_BasePipelineHandle;
-        builder.m_BasePipelineHandle = nullptr;
-        m_BasePipelineIndex = std::move(builder.m_BasePipelineIndex);
+        return nullptr;
     }
-    return *this;
+    auto storage = Impl_NewStorage(m_Device, m_StorageAllocator, compactedSize, accelerationStructureStorageAlignment,
+                                   vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress,
+                                   vk::MemoryPropertyFlagBits::eDeviceLocal);
+    if (!storage)
+    {
+        return nullptr;
+    }
+    auto accelerationStructureVk = m_Device->GetDeviceVk().createAccelerationStructureKHRUnique(vk::AccelerationStructureCreateInfoKHR()
+                                                                                                   .setBuffer(storage->GetBuffer()->GetBufferVk())
+                                                                                                   .setOffset(storage->GetOffset())
+                                                                                                   .setSize(compactedSize)
+                                                                                                   .setType(m_Type));
+    if (!accelerationStructureVk)
+    {
+        Impl_ReleaseStorage(storage.value());
+        return nullptr;
+    }
+    commandBuffer.copyAccelerationStructureKHR(vk::CopyAccelerationStructureInfoKHR()
+                                                   .setSrc(m_AccelerationStructure.get())
+                                                   .setDst(accelerationStructureVk.get())
+                                                   .setMode(vk::CopyAccelerationStructureModeKHR::eCompact));
+
+    auto original = std::unique_ptr<VulkanAccelerationStructure>(new VulkanAccelerationStructure());
+    original->m_Device = m_Device;
+    original->m_Type = m_Type;
+    original->m_Flags = m_Flags;
+    original->m_BuildType = m_BuildType;
+    original->m_Geometries = m_Geometries;
+    original->m_MaxPrimitiveCounts = m_MaxPrimitiveCounts;
+    original->m_BuildSizes = m_BuildSizes;
+    original->m_ScratchAlignment = m_ScratchAlignment;
+    original->m_Storage = std::move(m_Storage);
+    original->m_AccelerationStructure = std::move(m_AccelerationStructure);
+    original->m_DeviceAddress = m_DeviceAddress;
+
+    m_Storage = std::move(storage.value());
+    m_AccelerationStructure = std::move(accelerationStructureVk);
+    m_BuildSizes.accelerationStructureSize = compactedSize;
+    m_DeviceAddress = m_Device->GetDeviceVk().getAccelerationStructureAddressKHR(vk::AccelerationStructureDeviceAddressInfoKHR()
+                                                                                     .setAccelerationStructure(m_AccelerationStructure.get()));
+    return original;
+}
+
+BulletRT::Core::VulkanAccelerationStructure::VulkanAccelerationStructure() noexcept
+{
+    m_Device = nullptr;
+    m_Type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+    m_Flags = {};
+    m_BuildType = vk::AccelerationStructureBuildTypeKHR::eDevice;
+    m_BuildSizes = vk::AccelerationStructureBuildSizesInfoKHR();
+    m_ScratchAlignment = 1;
+    m_StorageAllocator = nullptr;
+    m_ScratchAllocator = nullptr;
+    m_Storage = {};
+    m_Scratch = {};
+    m_AccelerationStructure = {};
+    m_DeviceAddress = 0;
+    m_HostBuildGeometryInfo = vk::AccelerationStructureBuildGeometryInfoKHR();
+    m_HostBuildRangeInfoPtr = nullptr;
+}
+
+auto BulletRT::Core::VulkanAccelerationStructure::Impl_NewStorage(const VulkanDevice *device, VulkanBufferSuballocator *allocator, vk::DeviceSize size, vk::DeviceSize alignment,
+                                                                  vk::BufferUsageFlags usage, vk::MemoryPropertyFlags memoryFlags) -> std::optional<StorageDesc>
+{
+    auto storage = StorageDesc();
+    if (allocator)
+    {
+        storage.region = allocator->AllocateRegion(size, alignment);
+        if (!storage.region || !storage.region->buffer)
+        {
+            return std::nullopt;
+        }
+        storage.allocator = allocator;
+        return storage;
+    }
+    storage.buffer = VulkanBufferBuilder().SetSize(size).SetUsage(usage).Build(device);
+    if (!storage.buffer)
+    {
+        return std::nullopt;
+    }
+    auto memoryRequirements = storage.buffer->QueryMemoryRequirements();
+    auto memoryTypeIndices = FindMemoryTypeIndices(device->GetPhysicalDeviceVk().getMemoryProperties(), memoryRequirements.memoryTypeBits, memoryFlags);
+    if (memoryTypeIndices.empty())
+    {
+        return std::nullopt;
+    }
+    storage.memory = VulkanDeviceMemoryBuilder()
+                         .SetAllocationSize(memoryRequirements.size)
+                         .SetMemoryTypeIndex(memoryTypeIndices.front())
+                         .SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress))
+                         .Build(device);
+    if (!storage.memory)
+    {
+        return std::nullopt;
+    }
+    storage.memoryBuffer = VulkanMemoryBuffer::Bind(storage.buffer.get(), storage.memory.get());
+    if (!storage.memoryBuffer)
+    {
+        return std::nullopt;
+    }
+    return storage;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetFlags(vk::PipelineCreateFlags flags) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+void BulletRT::Core::VulkanAccelerationStructure::Impl_ReleaseStorage(StorageDesc &storage) noexcept
 {
-    m_Flags = flags;
-    return *this;
+    if (storage.region && storage.allocator)
+    {
+        storage.allocator->FreeRegion(storage.region.value());
+    }
+    storage.region.reset();
+    storage.allocator = nullptr;
+    storage.memoryBuffer.reset();
+    storage.memory.reset();
+    storage.buffer.reset();
 }
 
-auto VulkanGraphicsPipelineBuilder::GetFlags() const noexcept -> vk::PipelineCreateFlags
+auto BulletRT::Core::VulkanAccelerationStructureCompactor::New(const VulkanDevice *device) -> std::unique_ptr<VulkanAccelerationStructureCompactor>
 {
-    return m_Flags;
+    if (!device || !device->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME))
+    {
+        return nullptr;
+    }
+    auto compactor = new VulkanAccelerationStructureCompactor();
+    compactor->m_Device = device;
+    return std::unique_ptr<VulkanAccelerationStructureCompactor>(compactor);
 }
 
-auto VulkanGraphicsPipelineBuilder::SetStages(const std::vector<VulkanPipelineShaderStageDesc> &stages) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+BulletRT::Core::VulkanAccelerationStructureCompactor::~VulkanAccelerationStructureCompactor() noexcept
 {
-    m_Stages = stages;
-    return *this;
+    for (auto &retire : m_Retires)
+    {
+        if (retire.fence)
+        {
+            retire.fence->Wait(UINT64_MAX);
+        }
+    }
+    m_Retires.clear();
+    m_QueryBatches.clear();
+    m_FreeQueryBatches.clear();
+    m_Enqueued.clear();
 }
 
-auto VulkanGraphicsPipelineBuilder::AddStage(const BulletRT::Core::VulkanPipelineShaderStageDesc &stage) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+bool BulletRT::Core::VulkanAccelerationStructureCompactor::Enqueue(VulkanAccelerationStructure *accelerationStructure)
 {
-    m_Stages.push_back(stage);
-    return *this;
+    if (!accelerationStructure || accelerationStructure->GetBuildType() != vk::AccelerationStructureBuildTypeKHR::eDevice ||
+        !(accelerationStructure->GetFlags() & vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction))
+    {
+        return false;
+    }
+    m_Enqueued.push_back(accelerationStructure);
+    return true;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetStage(size_t idx, const BulletRT::Core::VulkanPipelineShaderStageDesc &stage) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+void BulletRT::Core::VulkanAccelerationStructureCompactor::RecordQueries(vk::CommandBuffer commandBuffer)
 {
-    if (m_Stages.size() > idx)
+    if (m_Enqueued.empty())
     {
-        m_Stages[idx] = stage;
+        return;
     }
-    return *this;
+    auto queryCount = static_cast<uint32_t>(m_Enqueued.size());
+    auto queryBatch = QueryBatchDesc();
+    auto freeIter = std::find_if(std::begin(m_FreeQueryBatches), std::end(m_FreeQueryBatches), [queryCount](const QueryBatchDesc &desc) {
+        return desc.queryCapacity >= queryCount;
+    });
+    if (freeIter != std::end(m_FreeQueryBatches))
+    {
+        queryBatch = std::move(*freeIter);
+        m_FreeQueryBatches.erase(freeIter);
+    }
+    else
+    {
+        queryBatch.queryCapacity = std::max<uint32_t>(queryCount, 64);
+        queryBatch.queryPool = m_Device->GetDeviceVk().createQueryPoolUnique(vk::QueryPoolCreateInfo()
+                                                                                 .setQueryType(vk::QueryType::eAccelerationStructureCompactedSizeKHR)
+                                                                                 .setQueryCount(queryBatch.queryCapacity));
+    }
+    auto accelerationStructureVks = std::vector<vk::AccelerationStructureKHR>();
+    accelerationStructureVks.reserve(m_Enqueued.size());
+    for (auto &accelerationStructure : m_Enqueued)
+    {
+        accelerationStructureVks.push_back(accelerationStructure->GetAccelerationStructureVk());
+    }
+    commandBuffer.resetQueryPool(queryBatch.queryPool.get(), 0, queryCount);
+    commandBuffer.writeAccelerationStructuresPropertiesKHR(accelerationStructureVks, vk::QueryType::eAccelerationStructureCompactedSizeKHR, queryBatch.queryPool.get(), 0);
+    queryBatch.accelerationStructures = std::move(m_Enqueued);
+    queryBatch.fence = nullptr;
+    queryBatch.ended = false;
+    m_QueryBatches.push_back(std::move(queryBatch));
+    m_Enqueued.clear();
 }
 
-auto VulkanGraphicsPipelineBuilder::GetStages() const noexcept -> std::vector<VulkanPipelineShaderStageDesc>
+auto BulletRT::Core::VulkanAccelerationStructureCompactor::RecordCompactions(vk::CommandBuffer commandBuffer) -> std::vector<VulkanAccelerationStructure *>
 {
-    return m_Stages;
+    Impl_ReleaseRetired();
+    auto compacted = std::vector<VulkanAccelerationStructure *>();
+    auto retire = RetireDesc{{}, nullptr, false};
+    while (!m_QueryBatches.empty())
+    {
+        auto &queryBatch = m_QueryBatches.front();
+        if (!queryBatch.ended || (queryBatch.fence && queryBatch.fence->QueryStatus() != vk::Result::eSuccess))
+        {
+            break;
+        }
+        auto queryCount = static_cast<uint32_t>(queryBatch.accelerationStructures.size());
+        auto queryResults = m_Device->GetDeviceVk().getQueryPoolResults<vk::DeviceSize>(queryBatch.queryPool.get(), 0, queryCount,
+                                                                                        queryCount * sizeof(vk::DeviceSize), sizeof(vk::DeviceSize),
+                                                                                        vk::QueryResultFlagBits::e64);
+        if (queryResults.result != vk::Result::eSuccess)
+        {
+            break;
+        }
+        for (uint32_t i = 0; i < queryCount; ++i)
+        {
+            auto accelerationStructure = queryBatch.accelerationStructures[i];
+            auto compactedSize = queryResults.value[i];
+            if (compactedSize == 0 || compactedSize >= accelerationStructure->GetSize())
+            {
+                continue;
+            }
+            auto originalSize = accelerationStructure->GetSize();
+            auto original = accelerationStructure->RecordCompact(commandBuffer, compactedSize);
+            if (!original)
+            {
+                continue;
+            }
+            retire.accelerationStructures.push_back(std::move(original));
+            compacted.push_back(accelerationStructure);
+            m_SavedSize += originalSize - compactedSize;
+            ++m_CompactedCount;
+        }
+        queryBatch.accelerationStructures.clear();
+        m_FreeQueryBatches.push_back(std::move(queryBatch));
+        m_QueryBatches.erase(std::begin(m_QueryBatches));
+    }
+    if (!compacted.empty())
+    {
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+                                      vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits::eRayTracingShaderKHR, {},
+                                      vk::MemoryBarrier()
+                                          .setSrcAccessMask(vk::AccessFlagBits::eAccelerationStructureWriteKHR)
+                                          .setDstAccessMask(vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR),
+                                      nullptr, nullptr);
+        m_Retires.push_back(std::move(retire));
+    }
+    return compacted;
 }
 
-auto VulkanGraphicsPipelineBuilder::GetStage(size_t idx) const -> const BulletRT::Core::VulkanPipelineShaderStageDesc &
+void BulletRT::Core::VulkanAccelerationStructureCompactor::EndFrame(const VulkanFence *fence)
 {
-    return m_Stages.at(idx);
+    for (auto &queryBatch : m_QueryBatches)
+    {
+        if (!queryBatch.ended)
+        {
+            queryBatch.fence = fence;
+            queryBatch.ended = true;
+        }
+    }
+    for (auto &retire : m_Retires)
+    {
+        if (!retire.ended)
+        {
+            retire.fence = fence;
+            retire.ended = true;
+        }
+    }
+    Impl_ReleaseRetired();
 }
 
-auto VulkanGraphicsPipelineBuilder::SetVertexInputState(const BulletRT::Core::VulkanPipelineVertexInputStateDesc &vertexInput) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto BulletRT::Core::VulkanAccelerationStructureCompactor::GetPendingCount() const noexcept -> size_t
 {
-    m_VertexInputState = vertexInput;
-    return *this;
+    auto pendingCount = m_Enqueued.size();
+    for (auto &queryBatch : m_QueryBatches)
+    {
+        pendingCount += queryBatch.accelerationStructures.size();
+    }
+    return pendingCount;
 }
 
-auto VulkanGraphicsPipelineBuilder::GetVertexInputState() const noexcept -> const std::optional<VulkanPipelineVertexInputStateDesc> &
+BulletRT::Core::VulkanAccelerationStructureCompactor::VulkanAccelerationStructureCompactor() noexcept
 {
-    return m_VertexInputState;
+    m_Device = nullptr;
+    m_Enqueued = {};
+    m_CompactedCount = 0;
+    m_SavedSize = 0;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetInputAssemblyState(const vk::PipelineInputAssemblyStateCreateInfo &inputAssembly) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+void BulletRT::Core::VulkanAccelerationStructureCompactor::Impl_ReleaseRetired()
 {
-    m_InputAssemblyState = inputAssembly;
-    return *this;
+    while (!m_Retires.empty())
+    {
+        auto &retire = m_Retires.front();
+        if (!retire.ended || (retire.fence && retire.fence->QueryStatus() != vk::Result::eSuccess))
+        {
+            break;
+        }
+        m_Retires.erase(std::begin(m_Retires));
+    }
 }
 
-auto VulkanGraphicsPipelineBuilder::GetInputAssemblyState() const noexcept -> const std::optional<vk::PipelineInputAssemblyStateCreateInfo> &
+auto BulletRT::Core::VulkanTopLevelAccelerationStructure::New(const VulkanDevice *device, uint32_t maxInstanceCount, vk::BuildAccelerationStructureFlagsKHR flags) -> std::unique_ptr<VulkanTopLevelAccelerationStructure>
 {
-    return m_InputAssemblyState;
+    if (!device || maxInstanceCount == 0 || !device->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME))
+    {
+        return nullptr;
+    }
+    auto tlas = std::unique_ptr<VulkanTopLevelAccelerationStructure>(new VulkanTopLevelAccelerationStructure());
+    tlas->m_Device = device;
+    tlas->m_MaxInstanceCount = maxInstanceCount;
+    tlas->m_Buffer = VulkanBufferBuilder()
+                         .SetSize(sizeof(vk::AccelerationStructureInstanceKHR) * maxInstanceCount)
+                         .SetUsage(vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress)
+                         .Build(device);
+    if (!tlas->m_Buffer)
+    {
+        return nullptr;
+    }
+    auto memoryProperties = device->GetPhysicalDeviceVk().getMemoryProperties();
+    auto memoryRequirements = tlas->m_Buffer->QueryMemoryRequirements();
+    auto memoryTypeIndices = FindMemoryTypeIndices(memoryProperties, memoryRequirements.memoryTypeBits,
+                                                   vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    if (memoryTypeIndices.empty())
+    {
+        memoryTypeIndices = FindMemoryTypeIndices(memoryProperties, memoryRequirements.memoryTypeBits,
+                                                  vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+    }
+    if (memoryTypeIndices.empty())
+    {
+        return nullptr;
+    }
+    tlas->m_Memory = VulkanDeviceMemoryBuilder()
+                         .SetAllocationSize(memoryRequirements.size)
+                         .SetMemoryTypeIndex(memoryTypeIndices.front())
+                         .SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress))
+                         .SetPersistentMapped(true)
+                         .Build(device);
+    if (!tlas->m_Memory || !tlas->m_Memory->GetMappedData())
+    {
+        return nullptr;
+    }
+    tlas->m_InstanceBuffer = VulkanMemoryBuffer::Bind(tlas->m_Buffer.get(), tlas->m_Memory.get());
+    if (!tlas->m_InstanceBuffer)
+    {
+        return nullptr;
+    }
+    tlas->m_MappedInstances = static_cast<vk::AccelerationStructureInstanceKHR *>(tlas->m_Memory->GetMappedData());
+    std::fill(tlas->m_MappedInstances, tlas->m_MappedInstances + maxInstanceCount, vk::AccelerationStructureInstanceKHR());
+    tlas->m_AccelerationStructure = VulkanAccelerationStructureBuilder()
+                                        .SetType(vk::AccelerationStructureTypeKHR::eTopLevel)
+                                        .SetFlags(flags | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate)
+                                        .AddGeometry(VulkanAccelerationStructureGeometryDesc::Instances(tlas->m_InstanceBuffer.get(), maxInstanceCount))
+                                        .Build(device);
+    if (!tlas->m_AccelerationStructure)
+    {
+        return nullptr;
+    }
+    tlas->m_AccelerationStructure->SetGeometry(0, VulkanAccelerationStructureGeometryDesc::Instances(tlas->m_InstanceBuffer.get(), 0));
+    return tlas;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetTessellationState(const BulletRT::Core::VulkanPipelineTessellationStateDesc &tessellation) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+BulletRT::Core::VulkanTopLevelAccelerationStructure::~VulkanTopLevelAccelerationStructure() noexcept
 {
-    m_TessellationState = tessellation;
-    return *this;
+    m_AccelerationStructure.reset();
+    m_MappedInstances = nullptr;
+    m_InstanceBuffer.reset();
+    m_Memory.reset();
+    m_Buffer.reset();
 }
 
-auto VulkanGraphicsPipelineBuilder::GetTessellationState() const noexcept -> const std::optional<VulkanPipelineTessellationStateDesc> &
+bool BulletRT::Core::VulkanTopLevelAccelerationStructure::SetInstanceCount(uint32_t instanceCount) noexcept
 {
-    return m_TessellationState;
+    if (instanceCount > m_MaxInstanceCount)
+    {
+        return false;
+    }
+    if (instanceCount != m_InstanceCount)
+    {
+        m_InstanceCount = instanceCount;
+        m_NeedRebuild = true;
+    }
+    return true;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetViewportState(const BulletRT::Core::VulkanPipelineViewportStateDesc &viewport) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+bool BulletRT::Core::VulkanTopLevelAccelerationStructure::SetInstance(uint32_t idx, const vk::AccelerationStructureInstanceKHR &instance) noexcept
 {
-    m_ViewportState = viewport;
-    return *this;
+    if (idx >= m_InstanceCount)
+    {
+        return false;
+    }
+    if (m_MappedInstances[idx].accelerationStructureReference != instance.accelerationStructureReference)
+    {
+        m_NeedRebuild = true;
+    }
+    m_MappedInstances[idx] = instance;
+    Impl_MarkDirty(idx);
+    return true;
 }
 
-auto VulkanGraphicsPipelineBuilder::GetViewportState() const noexcept -> const std::optional<BulletRT::Core::VulkanPipelineViewportStateDesc> &
+bool BulletRT::Core::VulkanTopLevelAccelerationStructure::SetInstanceTransform(uint32_t idx, const vk::TransformMatrixKHR &transform) noexcept
 {
-    return m_ViewportState;
+    if (idx >= m_InstanceCount)
+    {
+        return false;
+    }
+    m_MappedInstances[idx].transform = transform;
+    Impl_MarkDirty(idx);
+    return true;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetRasterizationState(const BulletRT::Core::VulkanPipelineRasterizationStateDesc &rasterization) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto BulletRT::Core::VulkanTopLevelAccelerationStructure::GetInstance(uint32_t idx) const noexcept -> std::optional<vk::AccelerationStructureInstanceKHR>
 {
-    m_RasterizationState = rasterization;
-    return *this;
+    if (idx >= m_InstanceCount)
+    {
+        return std::nullopt;
+    }
+    return m_MappedInstances[idx];
 }
 
-auto VulkanGraphicsPipelineBuilder::GetRasterizationState() const noexcept -> const std::optional<VulkanPipelineRasterizationStateDesc> &
+auto BulletRT::Core::VulkanTopLevelAccelerationStructure::RecordBuild(vk::CommandBuffer commandBuffer) -> vk::Result
 {
-    return m_RasterizationState;
+    auto dirty = m_DirtyBegin < m_DirtyEnd;
+    if (m_Built && !dirty && !m_NeedRebuild)
+    {
+        return vk::Result::eSuccess;
+    }
+    if (dirty && !m_Memory->IsHostCoherent())
+    {
+        auto res = m_InstanceBuffer->FlushMappedRange(sizeof(vk::AccelerationStructureInstanceKHR) * (m_DirtyEnd - m_DirtyBegin),
+                                                      sizeof(vk::AccelerationStructureInstanceKHR) * m_DirtyBegin);
+        if (res != vk::Result::eSuccess)
+        {
+            return res;
+        }
+    }
+    if (m_InstanceCount > 0)
+    {
+        m_Degradation += static_cast<float>(std::min(m_MovedCount, m_InstanceCount)) / static_cast<float>(m_InstanceCount);
+    }
+    auto rebuild = !m_Built || m_NeedRebuild || m_InstanceCount != m_BuiltInstanceCount ||
+                   (m_RebuildInterval > 0 && m_UpdatesSinceRebuild >= m_RebuildInterval) ||
+                   m_Degradation >= m_DegradationThreshold;
+    auto mode = rebuild ? vk::BuildAccelerationStructureModeKHR::eBuild : vk::BuildAccelerationStructureModeKHR::eUpdate;
+    m_AccelerationStructure->SetGeometry(0, VulkanAccelerationStructureGeometryDesc::Instances(m_InstanceBuffer.get(), m_InstanceCount));
+    auto res = m_AccelerationStructure->RecordBuild(commandBuffer, mode);
+    if (res != vk::Result::eSuccess)
+    {
+        return res;
+    }
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+                                  vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits::eRayTracingShaderKHR, {},
+                                  vk::MemoryBarrier()
+                                      .setSrcAccessMask(vk::AccessFlagBits::eAccelerationStructureWriteKHR)
+                                      .setDstAccessMask(vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR),
+                                  nullptr, nullptr);
+    if (rebuild)
+    {
+        m_UpdatesSinceRebuild = 0;
+        m_Degradation = 0.0f;
+        ++m_RebuildCount;
+    }
+    else
+    {
+        ++m_UpdatesSinceRebuild;
+        ++m_UpdateCount;
+    }
+    m_Built = true;
+    m_NeedRebuild = false;
+    m_BuiltInstanceCount = m_InstanceCount;
+    m_DirtyBegin = UINT32_MAX;
+    m_DirtyEnd = 0;
+    m_MovedCount = 0;
+    return vk::Result::eSuccess;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetMultiSampleState(const BulletRT::Core::VulkanPipelineMultiSampleStateDesc &multiSample) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto BulletRT::Core::VulkanTopLevelAccelerationStructure::QueryStatistics() const noexcept -> VulkanTopLevelAccelerationStructureStatistics
 {
-    m_MultiSampleState = multiSample;
-    return *this;
+    return VulkanTopLevelAccelerationStructureStatistics{m_RebuildCount, m_UpdateCount, m_UpdatesSinceRebuild, m_Degradation};
 }
 
-auto VulkanGraphicsPipelineBuilder::GetMultiSampleState() const noexcept -> const std::optional<VulkanPipelineMultiSampleStateDesc> &
+BulletRT::Core::VulkanTopLevelAccelerationStructure::VulkanTopLevelAccelerationStructure() noexcept
 {
-    return m_MultiSampleState;
+    m_Device = nullptr;
+    m_MappedInstances = nullptr;
+    m_MaxInstanceCount = 0;
+    m_InstanceCount = 0;
+    m_BuiltInstanceCount = 0;
+    m_DirtyBegin = UINT32_MAX;
+    m_DirtyEnd = 0;
+    m_MovedCount = 0;
+    m_Built = false;
+    m_NeedRebuild = false;
+    m_RebuildInterval = 64;
+    m_DegradationThreshold = 8.0f;
+    m_UpdatesSinceRebuild = 0;
+    m_Degradation = 0.0f;
+    m_RebuildCount = 0;
+    m_UpdateCount = 0;
+}
+
+void BulletRT::Core::VulkanTopLevelAccelerationStructure::Impl_MarkDirty(uint32_t idx) noexcept
+{
+    m_DirtyBegin = std::min(m_DirtyBegin, idx);
+    m_DirtyEnd = std::max(m_DirtyEnd, idx + 1);
+    ++m_MovedCount;
 }
 
-auto VulkanGraphicsPipelineBuilder::GetDepthStencilState(const vk::PipelineDepthStencilStateCreateInfo &depthStencil) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto BulletRT::Core::VulkanFence::New(const VulkanDevice *device, bool isSignaled) -> std::unique_ptr<VulkanFence>
 {
-    m_DepthStencilState = depthStencil;
-    return *this;
+    auto fenceVk = device->GetDeviceVk().createFenceUnique(vk::FenceCreateInfo().setFlags(isSignaled ? vk::FenceCreateFlagBits::eSignaled : vk::FenceCreateFlags{}));
+    auto fence = new VulkanFence();
+    fence->m_Device = device;
+    fence->m_Fence = std::move(fenceVk);
+    return std::unique_ptr<VulkanFence>(fence);
 }
 
-auto VulkanGraphicsPipelineBuilder::SetDepthStencilState() const noexcept -> const std::optional<vk::PipelineDepthStencilStateCreateInfo> &
+BulletRT::Core::VulkanFence::~VulkanFence() noexcept
 {
-    return m_DepthStencilState;
+    m_Fence.reset();
 }
 
-auto VulkanGraphicsPipelineBuilder::SetColorBlendState(const BulletRT::Core::VulkanPipelineColorBlendStateDesc &colorBlendState) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+BulletRT::Core::VulkanFence::VulkanFence() noexcept
 {
-    m_ColorBlendState = colorBlendState;
-    return *this;
+    m_Fence = {};
+    m_Device = nullptr;
+}
+auto VulkanFence::Wait(uint64_t timeout) const noexcept -> vk::Result
+{
+    vk::Fence fence = m_Fence.get();
+    return m_Device->GetDeviceVk().waitForFences(1, &fence, VK_TRUE, timeout);
 }
 
-auto VulkanGraphicsPipelineBuilder::GetColorBlendState() const noexcept -> const std::optional<VulkanPipelineColorBlendStateDesc> &
+auto VulkanFence::QueryStatus() const noexcept -> vk::Result
 {
-    return m_ColorBlendState;
+    return m_Device->GetDeviceVk().getFenceStatus(m_Fence.get());
 }
 
-auto VulkanGraphicsPipelineBuilder::SetLayout(const BulletRT::Core::VulkanPipelineLayout *layout) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto VulkanFence::Reset() const noexcept -> vk::Result
 {
-    m_Layout = layout;
-    return *this;
+    vk::Fence fence = m_Fence.get();
+    return m_Device->GetDeviceVk().resetFences(1, &fence);
 }
 
-auto VulkanGraphicsPipelineBuilder::GetLayout() const noexcept -> const BulletRT::Core::VulkanPipelineLayout *
+auto VulkanDevice::NewFence(bool isSignaled) -> std::unique_ptr<VulkanFence>
 {
-    return m_Layout;
+    return VulkanFence::New(this, isSignaled);
 }
 
-auto VulkanGraphicsPipelineBuilder::SetRenderPass(const BulletRT::Core::VulkanRenderPass *renderPass) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto BulletRT::Core::VulkanSemaphore::New(const VulkanDevice *device, vk::SemaphoreType semaphoreType, uint64_t initialValue) -> std::unique_ptr<VulkanSemaphore>
 {
-    m_RenderPass = renderPass;
-    return *this;
+    auto semaphoreTypeCreateInfo = vk::SemaphoreTypeCreateInfo()
+                                       .setSemaphoreType(semaphoreType)
+                                       .setInitialValue(semaphoreType == vk::SemaphoreType::eTimeline ? initialValue : 0);
+    auto semaphoreCreateInfo = vk::SemaphoreCreateInfo();
+    if (semaphoreType == vk::SemaphoreType::eTimeline)
+    {
+        semaphoreCreateInfo.setPNext(&semaphoreTypeCreateInfo);
+    }
+    auto semaphoreVk = device->GetDeviceVk().createSemaphoreUnique(semaphoreCreateInfo);
+    if (semaphoreVk)
+    {
+        auto semaphore = new VulkanSemaphore();
+        semaphore->m_Device = device;
+        semaphore->m_Semaphore = std::move(semaphoreVk);
+        semaphore->m_SemaphoreType = semaphoreType;
+        return std::unique_ptr<VulkanSemaphore>(semaphore);
+    }
+    return nullptr;
 }
 
-auto VulkanGraphicsPipelineBuilder::GetRenderPass() const noexcept -> const BulletRT::Core::VulkanRenderPass *
+BulletRT::Core::VulkanSemaphore::~VulkanSemaphore() noexcept
 {
-    return m_RenderPass;
+    m_Semaphore.reset();
 }
 
-auto VulkanGraphicsPipelineBuilder::SetSubpass(uint32_t subpass) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+BulletRT::Core::VulkanSemaphore::VulkanSemaphore() noexcept
 {
-    m_Subpass = subpass;
-    return *this;
+    m_Device = nullptr;
+    m_Semaphore = {};
+    m_SemaphoreType = vk::SemaphoreType::eBinary;
 }
 
-auto VulkanGraphicsPipelineBuilder::GetSubpass() const noexcept -> std::optional<uint32_t>
+auto BulletRT::Core::VulkanSemaphore::Signal(uint64_t value) const noexcept -> vk::Result
 {
-    return m_Subpass;
+    if (!IsTimeline())
+    {
+        return vk::Result::eErrorFeatureNotPresent;
+    }
+    auto signalInfo = vk::SemaphoreSignalInfo().setSemaphore(m_Semaphore.get()).setValue(value);
+    return m_Device->GetDeviceVk().signalSemaphore(&signalInfo);
 }
 
-auto VulkanGraphicsPipelineBuilder::SetBasePipelineHandle(const BulletRT::Core::VulkanGraphicsPipeline *basePipeline) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto BulletRT::Core::VulkanSemaphore::Wait(uint64_t value, uint64_t timeout) const noexcept -> vk::Result
 {
-    if (basePipeline)
+    if (!IsTimeline())
     {
-        m_Flags |= vk::PipelineCreateFlagBits::eDerivative;
-        if (m_BasePipelineIndex)
-        {
-            m_BasePipelineIndex = std::nullopt;
-        }
-        m_BasePipelineHandle = basePipeline;
+        return vk::Result::eErrorFeatureNotPresent;
     }
-    return *this;
+    auto semaphore = m_Semaphore.get();
+    auto waitInfo = vk::SemaphoreWaitInfo().setSemaphores(semaphore).setValues(value);
+    return m_Device->GetDeviceVk().waitSemaphores(&waitInfo, timeout);
 }
 
-auto VulkanGraphicsPipelineBuilder::GetBasePipelineHandle() const noexcept -> const BulletRT::Core::VulkanGraphicsPipeline *
+auto BulletRT::Core::VulkanSemaphore::QueryCounterValue() const noexcept -> std::optional<uint64_t>
 {
-    return m_BasePipelineHandle;
+    if (!IsTimeline())
+    {
+        return std::nullopt;
+    }
+    auto value = uint64_t(0);
+    if (m_Device->GetDeviceVk().getSemaphoreCounterValue(m_Semaphore.get(), &value) != vk::Result::eSuccess)
+    {
+        return std::nullopt;
+    }
+    return value;
 }
 
-auto VulkanGraphicsPipelineBuilder::SetBasePipelineIndex(uint32_t basePipelineIndex) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
+auto VulkanDevice::AcquireFence() const -> std::unique_ptr<VulkanFence>
 {
-    m_Flags |= vk::PipelineCreateFlagBits::eDerivative;
-    if (m_BasePipelineHandle)
     {
-        m_BasePipelineHandle = nullptr;
+        std::lock_guard<std::mutex> lock(m_SyncObjectPoolMutex);
+        ++m_SyncObjectPoolStatistics.fenceAcquireCount;
+        if (!m_FreeFences.empty())
+        {
+            auto fence = std::move(m_FreeFences.back());
+            m_FreeFences.pop_back();
+            return fence;
+        }
+        ++m_SyncObjectPoolStatistics.fenceCreateCount;
     }
-    m_BasePipelineIndex = basePipelineIndex;
-    return *this;
+    return VulkanFence::New(this, false);
 }
 
-auto VulkanGraphicsPipelineBuilder::GetBasePipelineIndex() const noexcept -> std::optional<uint32_t>
+void VulkanDevice::ReleaseFence(std::unique_ptr<VulkanFence> fence) const
 {
-    return m_BasePipelineIndex;
+    if (!fence || fence->GetDevice() != this)
+    {
+        return;
+    }
+    if (fence->Reset() != vk::Result::eSuccess)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_SyncObjectPoolMutex);
+    m_FreeFences.push_back(std::move(fence));
 }
 
-VulkanPipelineShaderStageDesc::VulkanPipelineShaderStageDesc() noexcept
+auto VulkanDevice::AcquireSemaphore() const -> std::unique_ptr<VulkanSemaphore>
 {
+    {
+        std::lock_guard<std::mutex> lock(m_SyncObjectPoolMutex);
+        ++m_SyncObjectPoolStatistics.semaphoreAcquireCount;
+        if (!m_FreeSemaphores.empty())
+        {
+            auto semaphore = std::move(m_FreeSemaphores.back());
+            m_FreeSemaphores.pop_back();
+            return semaphore;
+        }
+        ++m_SyncObjectPoolStatistics.semaphoreCreateCount;
+    }
+    return VulkanSemaphore::New(this, vk::SemaphoreType::eBinary);
 }
 
-VulkanPipelineShaderStageDesc::VulkanPipelineShaderStageDesc(const BulletRT::Core::VulkanPipelineShaderStageDesc &builder) noexcept
+void VulkanDevice::ReleaseSemaphore(std::unique_ptr<VulkanSemaphore> semaphore) const
 {
-    m_Flags = builder.m_Flags;
-    m_Stage = builder.m_Stage;
-    m_Module = builder.m_Module;
-    m_Name = builder.m_Name;
-    m_SpecializationDesc = builder.m_SpecializationDesc;
-    m_ModuleBuilder = builder.m_ModuleBuilder;
+    if (!semaphore || semaphore->GetDevice() != this || semaphore->IsTimeline())
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_SyncObjectPoolMutex);
+    m_FreeSemaphores.push_back(std::move(semaphore));
 }
 
-VulkanPipelineShaderStageDesc::VulkanPipelineShaderStageDesc(BulletRT::Core::VulkanPipelineShaderStageDesc &&builder) noexcept
+auto VulkanDevice::QuerySyncObjectPoolStatistics() const -> VulkanSyncObjectPoolStatistics
 {
-    m_Flags = std::move(builder.m_Flags);
-    m_Stage = std::move(builder.m_Stage);
-    m_Module = builder.m_Module;
-    builder.m_Module = nullptr;
-    m_Name = std::move(builder.m_Name);
-    m_SpecializationDesc = std::move(builder.m_SpecializationDesc);
-    m_ModuleBuilder = std::move(builder.m_ModuleBuilder);
+    std::lock_guard<std::mutex> lock(m_SyncObjectPoolMutex);
+    return m_SyncObjectPoolStatistics;
 }
 
-BulletRT::Core::VulkanPipelineShaderStageDesc &VulkanPipelineShaderStageDesc::operator=(const BulletRT::Core::VulkanPipelineShaderStageDesc &builder) noexcept
+auto VulkanDevice::NewSemaphore(vk::SemaphoreType semaphoreType, uint64_t initialValue) -> std::unique_ptr<VulkanSemaphore>
 {
-    if (this != &builder)
+    return VulkanSemaphore::New(this, semaphoreType, initialValue);
+}
+
+auto VulkanDevice::WaitForSemaphores(const std::vector<const VulkanSemaphore *> &semaphores, const std::vector<uint64_t> &values, uint64_t timeOut, VkBool32 waitForAll) -> vk::Result
+{
+    auto semaphoresVk = std::vector<vk::Semaphore>();
+    auto valuesVk = std::vector<uint64_t>();
+    semaphoresVk.reserve(semaphores.size());
+    valuesVk.reserve(semaphores.size());
+    for (size_t i = 0; i < semaphores.size() && i < values.size(); ++i)
     {
-        m_Flags = builder.m_Flags;
-        m_Stage = builder.m_Stage;
-        m_Module = builder.m_Module;
-        m_Name = builder.m_Name;
-        m_SpecializationDesc = builder.m_SpecializationDesc;
-        m_ModuleBuilder = builder.m_ModuleBuilder;
+        if (semaphores[i] && semaphores[i]->IsTimeline())
+        {
+            semaphoresVk.push_back(semaphores[i]->GetSemaphoreVk());
+            valuesVk.push_back(values[i]);
+        }
     }
-    return *this;
+    if (semaphoresVk.empty())
+    {
+        return vk::Result::eSuccess;
+    }
+    auto waitInfo = vk::SemaphoreWaitInfo()
+                        .setFlags(waitForAll ? vk::SemaphoreWaitFlags{} : vk::SemaphoreWaitFlagBits::eAny)
+                        .setSemaphores(semaphoresVk)
+                        .setValues(valuesVk);
+    return m_LogigalDevice->waitSemaphores(&waitInfo, timeOut);
 }
 
-BulletRT::Core::VulkanPipelineShaderStageDesc &VulkanPipelineShaderStageDesc::operator=(BulletRT::Core::VulkanPipelineShaderStageDesc &&builder) noexcept
+auto VulkanSubmitDesc::AddWaitSemaphore(const VulkanSemaphore *semaphore, vk::PipelineStageFlags stageMask, uint64_t value) noexcept -> VulkanSubmitDesc &
 {
-    if (this != &builder)
+    if (!semaphore)
     {
-        m_Flags = std::move(builder.m_Flags);
-        m_Stage = std::move(builder.m_Stage);
-        m_Module = builder.m_Module;
-        builder.m_Module = nullptr;
-        m_Name = std::move(builder.m_Name);
-        m_SpecializationDesc = std::move(builder.m_SpecializationDesc);
-        m_ModuleBuilder = std::move(builder.m_ModuleBuilder);
+        return *this;
     }
-    return *this;
+    m_HasTimelineSemaphore |= semaphore->IsTimeline();
+    return AddWaitSemaphore(semaphore->GetSemaphoreVk(), stageMask, semaphore->IsTimeline() ? value : 0);
 }
 
-auto VulkanPipelineShaderStageDesc::SetFlags(vk::PipelineShaderStageCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
+auto VulkanSubmitDesc::AddWaitSemaphore(vk::Semaphore semaphore, vk::PipelineStageFlags stageMask, uint64_t value) noexcept -> VulkanSubmitDesc &
 {
-    m_Flags = flags;
+    m_HasTimelineSemaphore |= value != 0;
+    m_WaitSemaphores.push_back(semaphore);
+    m_WaitDstStageMasks.push_back(stageMask);
+    m_WaitValues.push_back(value);
     return *this;
 }
 
-auto VulkanPipelineShaderStageDesc::GetFlags() const noexcept -> vk::PipelineShaderStageCreateFlags
+auto VulkanSubmitDesc::AddCommandBuffer(const VulkanCommandBuffer *commandBuffer) noexcept -> VulkanSubmitDesc &
 {
-    return m_Flags;
+    return commandBuffer ? AddCommandBuffer(commandBuffer->GetCommandBufferVk()) : *this;
 }
 
-auto VulkanPipelineShaderStageDesc::SetStage(vk::ShaderStageFlagBits stage) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
+auto VulkanSubmitDesc::AddCommandBuffer(vk::CommandBuffer commandBuffer) noexcept -> VulkanSubmitDesc &
 {
-    m_Stage = stage;
+    m_CommandBuffers.push_back(commandBuffer);
     return *this;
 }
 
-auto VulkanPipelineShaderStageDesc::GetStage() const noexcept -> vk::ShaderStageFlagBits
-{
-    return m_Stage;
-}
-
-auto VulkanPipelineShaderStageDesc::SetModule(const BulletRT::Core::VulkanShaderModule *module) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
+auto VulkanSubmitDesc::AddSignalSemaphore(const VulkanSemaphore *semaphore, uint64_t value) noexcept -> VulkanSubmitDesc &
 {
-    if (m_ModuleBuilder)
+    if (!semaphore)
     {
-        m_ModuleBuilder = std::nullopt;
+        return *this;
     }
-    m_Module = module;
-    return *this;
+    m_HasTimelineSemaphore |= semaphore->IsTimeline();
+    return AddSignalSemaphore(semaphore->GetSemaphoreVk(), semaphore->IsTimeline() ? value : 0);
 }
 
-auto VulkanPipelineShaderStageDesc::GetModule() const noexcept -> const BulletRT::Core::VulkanShaderModule *
+auto VulkanSubmitDesc::AddSignalSemaphore(vk::Semaphore semaphore, uint64_t value) noexcept -> VulkanSubmitDesc &
 {
-    return m_Module;
+    m_HasTimelineSemaphore |= value != 0;
+    m_SignalSemaphores.push_back(semaphore);
+    m_SignalValues.push_back(value);
+    return *this;
 }
 
-auto VulkanPipelineShaderStageDesc::GetModuleVk() const noexcept -> vk::ShaderModule
+auto VulkanPipelineVertexInputStateDesc::GetVulkanPipelineVertexInputStateCreateInfoVk() const noexcept -> vk::PipelineVertexInputStateCreateInfo
 {
-    return nullptr;
+    return vk::PipelineVertexInputStateCreateInfo()
+        .setVertexBindingDescriptions(m_VertexBindingDescriptions)
+        .setVertexAttributeDescriptions(m_VertexAttributeDescriptions)
+        .setFlags(m_Flags);
 }
 
-auto VulkanPipelineShaderStageDesc::SetName(const std::string &name) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
+auto VulkanPipelineVertexInputStateDesc::GetPipelineVertexInputDivisorStateCreateInfoEXT() const noexcept -> std::optional<vk::PipelineVertexInputDivisorStateCreateInfoEXT>
 {
-    m_Name = name;
-    return *this;
+    if (!m_VertexBindingDivisors.empty())
+    {
+        return vk::PipelineVertexInputDivisorStateCreateInfoEXT().setVertexBindingDivisors(m_VertexBindingDivisors);
+    }
+    else
+    {
+        return std::nullopt;
+    }
 }
 
-auto VulkanPipelineShaderStageDesc::GetName() const noexcept -> std::string
+VulkanPipelineVertexInputStateDesc::VulkanPipelineVertexInputStateDesc() noexcept
 {
-    return m_Name;
 }
 
-auto VulkanPipelineShaderStageDesc::SetSpecializationDesc(const BulletRT::Core::VulkanSpecializationDesc &specialization) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
+VulkanPipelineVertexInputStateDesc::VulkanPipelineVertexInputStateDesc(const BulletRT::Core::VulkanPipelineVertexInputStateDesc &builder) noexcept
 {
-    m_SpecializationDesc = specialization;
-    return *this;
+    m_Flags = builder.m_Flags;
+    m_VertexBindingDescriptions = builder.m_VertexBindingDescriptions;
+    m_VertexAttributeDescriptions = builder.m_VertexAttributeDescriptions;
+    m_VertexBindingDivisors = builder.m_VertexBindingDivisors;
 }
 
-auto VulkanPipelineShaderStageDesc::GetSpecializationDesc() const noexcept -> const std::optional<VulkanSpecializationDesc> &
+VulkanPipelineVertexInputStateDesc::VulkanPipelineVertexInputStateDesc(BulletRT::Core::VulkanPipelineVertexInputStateDesc &&builder) noexcept
 {
-    return m_SpecializationDesc;
+    m_Flags = std::move(builder.m_Flags);
+    m_VertexBindingDescriptions = std::move(builder.m_VertexBindingDescriptions);
+    m_VertexAttributeDescriptions = std::move(builder.m_VertexAttributeDescriptions);
+    m_VertexBindingDivisors = std::move(builder.m_VertexBindingDivisors);
 }
 
-auto VulkanPipelineShaderStageDesc::SetShaderModuleBuilder(const BulletRT::Core::VulkanShaderModuleBuilder &builder) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
+BulletRT::Core::VulkanPipelineVertexInputStateDesc &VulkanPipelineVertexInputStateDesc::operator=(const BulletRT::Core::VulkanPipelineVertexInputStateDesc &builder) noexcept
 {
-    if (m_Module)
+    if (this != &builder)
     {
-        m_Module = nullptr;
+        m_Flags = builder.m_Flags;
+        m_VertexBindingDescriptions = builder.m_VertexBindingDescriptions;
+        m_VertexAttributeDescriptions = builder.m_VertexAttributeDescriptions;
+        m_VertexBindingDivisors = builder.m_VertexBindingDivisors;
     }
-    m_ModuleBuilder = builder;
     return *this;
 }
 
-auto VulkanPipelineShaderStageDesc::GetShaderModuleBuilder() const noexcept -> const std::optional<VulkanShaderModuleBuilder> &
+BulletRT::Core::VulkanPipelineVertexInputStateDesc &VulkanPipelineVertexInputStateDesc::operator=(BulletRT::Core::VulkanPipelineVertexInputStateDesc &&builder) noexcept
 {
-    return m_ModuleBuilder;
-}
-
-auto VulkanPipelineShaderStageDesc::GetPipelineShaderStageCreateInfoVk() const noexcept -> vk::PipelineShaderStageCreateInfo
-{
-    return vk::PipelineShaderStageCreateInfo()
-        .setFlags(m_Flags)
-        .setStage(m_Stage)
-        .setModule(GetModuleVk())
-        .setPName(m_Name.data())
-        .setPSpecializationInfo(nullptr);
-}
-
-auto VulkanPipelineShaderStageDesc::GetSpecializationInfoVk() const noexcept -> std::optional<vk::SpecializationInfo>
-{
-    return m_SpecializationDesc ? std::optional<vk::SpecializationInfo>(m_SpecializationDesc->GetSpecializationInfoVk()) : std::nullopt;
-}
-
-auto VulkanPipelineShaderStageDesc::GetShaderModuleCreateInfoVk() const noexcept -> std::optional<vk::ShaderModuleCreateInfo>
-{
-    return m_ModuleBuilder ? std::optional<vk::ShaderModuleCreateInfo>(m_ModuleBuilder->GetShaderModuleCreateInfoVk()) : std::nullopt;
-}
-
-VulkanSpecializationDesc::VulkanSpecializationDesc() noexcept
-{
-}
-
-VulkanSpecializationDesc::VulkanSpecializationDesc(const BulletRT::Core::VulkanSpecializationDesc &builder) noexcept
-{
-    m_Entries = builder.m_Entries;
-    m_Data = builder.m_Data;
+    if (this != &builder)
+    {
+        m_Flags = std::move(builder.m_Flags);
+        m_VertexBindingDescriptions = std::move(builder.m_VertexBindingDescriptions);
+        m_VertexAttributeDescriptions = std::move(builder.m_VertexAttributeDescriptions);
+        m_VertexBindingDivisors = std::move(builder.m_VertexBindingDivisors);
+    }
+    return *this;
 }
 
-VulkanSpecializationDesc::VulkanSpecializationDesc(BulletRT::Core::VulkanSpecializationDesc &&builder) noexcept
+auto VulkanPipelineLayoutBuilder::SetFlags(vk::PipelineLayoutCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineLayoutBuilder &
 {
-    m_Entries = std::move(builder.m_Entries);
-    m_Data = std::move(builder.m_Data);
+    m_Flags = flags;
+    return *this;
 }
 
-BulletRT::Core::VulkanSpecializationDesc &VulkanSpecializationDesc::operator=(const BulletRT::Core::VulkanSpecializationDesc &builder) noexcept
+auto VulkanPipelineLayoutBuilder::GetFlags() const noexcept -> vk::PipelineLayoutCreateFlags
 {
-    if (this != &builder)
-    {
-        m_Entries = builder.m_Entries;
-        m_Data = builder.m_Data;
-    }
-    return *this;
+    return m_Flags;
 }
 
-BulletRT::Core::VulkanSpecializationDesc &VulkanSpecializationDesc::operator=(BulletRT::Core::VulkanSpecializationDesc &&builder) noexcept
+auto VulkanPipelineLayoutBuilder::SetSetLayouts(const std::vector<vk::DescriptorSetLayout> &setLayouts) noexcept -> BulletRT::Core::VulkanPipelineLayoutBuilder &
 {
-    if (this != &builder)
-    {
-        m_Entries = std::move(builder.m_Entries);
-        m_Data = std::move(builder.m_Data);
-    }
+    m_SetLayouts = setLayouts;
     return *this;
 }
 
-auto VulkanSpecializationDesc::SetEntryCount(size_t entryCount) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
+auto VulkanPipelineLayoutBuilder::AddSetLayout(vk::DescriptorSetLayout setLayout) noexcept -> BulletRT::Core::VulkanPipelineLayoutBuilder &
 {
-    m_Entries.resize(entryCount);
+    m_SetLayouts.push_back(setLayout);
     return *this;
 }
 
-auto VulkanSpecializationDesc::SetEntries(const std::vector<vk::SpecializationMapEntry> &entries) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
+auto VulkanPipelineLayoutBuilder::GetSetLayouts() const noexcept -> const std::vector<vk::DescriptorSetLayout> &
 {
-    m_Entries = entries;
-    return *this;
+    return m_SetLayouts;
 }
 
-auto VulkanSpecializationDesc::AddEntry(const vk::SpecializationMapEntry &entry) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
+auto VulkanPipelineLayoutBuilder::SetPushConstantRanges(const std::vector<vk::PushConstantRange> &pushConstantRanges) noexcept -> BulletRT::Core::VulkanPipelineLayoutBuilder &
 {
-    m_Entries.push_back(entry);
+    m_PushConstantRanges = pushConstantRanges;
     return *this;
 }
 
-auto VulkanSpecializationDesc::SetEntry(size_t idx, const vk::SpecializationMapEntry &entry) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
+auto VulkanPipelineLayoutBuilder::AddPushConstantRange(const vk::PushConstantRange &pushConstantRange) noexcept -> BulletRT::Core::VulkanPipelineLayoutBuilder &
 {
-    if (idx < m_Entries.size())
-    {
-        m_Entries[idx] = entry;
-    }
+    m_PushConstantRanges.push_back(pushConstantRange);
     return *this;
 }
 
-auto VulkanSpecializationDesc::GetEntries() const noexcept -> const std::vector<vk::SpecializationMapEntry> &
+auto VulkanPipelineLayoutBuilder::GetPushConstantRanges() const noexcept -> const std::vector<vk::PushConstantRange> &
 {
-    return m_Entries;
+    return m_PushConstantRanges;
 }
 
-auto VulkanSpecializationDesc::GetEntry(size_t idx) const -> const vk::SpecializationMapEntry &
+auto VulkanPipelineLayoutBuilder::GetPipelineLayoutCreateInfoVk() const noexcept -> vk::PipelineLayoutCreateInfo
 {
-    return m_Entries.at(idx);
+    return vk::PipelineLayoutCreateInfo().setFlags(m_Flags).setSetLayouts(m_SetLayouts).setPushConstantRanges(m_PushConstantRanges);
 }
 
-auto VulkanSpecializationDesc::GetSpecializationInfoVk() const noexcept -> vk::SpecializationInfo
+auto VulkanPipelineLayoutBuilder::Build(const BulletRT::Core::VulkanDevice *device) const -> std::unique_ptr<VulkanPipelineLayout>
 {
-    return vk::SpecializationInfo().setPData(m_Data.data()).setDataSize(m_Data.size()).setMapEntries(m_Entries);
+    return VulkanPipelineLayout::New(device, *this);
 }
 
-VulkanShaderModuleBuilder::VulkanShaderModuleBuilder() noexcept
+auto VulkanPipelineLayout::New(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanPipelineLayoutBuilder &builder) -> std::unique_ptr<VulkanPipelineLayout>
 {
+    if (!device)
+    {
+        return nullptr;
+    }
+    auto pipelineLayout = device->GetDeviceVk().createPipelineLayoutUnique(builder.GetPipelineLayoutCreateInfoVk());
+    if (pipelineLayout)
+    {
+        auto vulkanPipelineLayout = std::unique_ptr<VulkanPipelineLayout>(new VulkanPipelineLayout());
+        vulkanPipelineLayout->m_Device = device;
+        vulkanPipelineLayout->m_PipelineLayout = std::move(pipelineLayout);
+        vulkanPipelineLayout->m_Builder = builder;
+        return vulkanPipelineLayout;
+    }
+    return nullptr;
 }
 
-VulkanShaderModuleBuilder::VulkanShaderModuleBuilder(const BulletRT::Core::VulkanShaderModuleBuilder &builder) noexcept
+VulkanPipelineLayout::~VulkanPipelineLayout() noexcept
 {
-    m_Flags = builder.m_Flags;
-    m_Codes = builder.m_Codes;
+    m_PipelineLayout.reset();
 }
 
-VulkanShaderModuleBuilder::VulkanShaderModuleBuilder(BulletRT::Core::VulkanShaderModuleBuilder &&builder) noexcept
+auto VulkanPipelineLayout::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice *
 {
-    m_Flags = std::move(builder.m_Flags);
-    m_Codes = std::move(builder.m_Codes);
+    return m_Device;
 }
 
-BulletRT::Core::VulkanShaderModuleBuilder &VulkanShaderModuleBuilder::operator=(const BulletRT::Core::VulkanShaderModuleBuilder &builder) noexcept
+auto VulkanPipelineLayout::GetDeviceVk() const noexcept -> vk::Device
 {
-    if (this != &builder)
-    {
-        m_Flags = builder.m_Flags;
-        m_Codes = builder.m_Codes;
-    }
-    return *this;
+    return m_Device ? m_Device->GetDeviceVk() : nullptr;
 }
 
-BulletRT::Core::VulkanShaderModuleBuilder &VulkanShaderModuleBuilder::operator=(BulletRT::Core::VulkanShaderModuleBuilder &&builder) noexcept
+auto VulkanPipelineLayout::GetPipelineLayoutVk() const noexcept -> vk::PipelineLayout
 {
-    if (this != &builder)
-    {
-        m_Flags = std::move(builder.m_Flags);
-        m_Codes = std::move(builder.m_Codes);
-    }
-    return *this;
+    return m_PipelineLayout.get();
 }
 
-auto VulkanShaderModuleBuilder::SetFlags(vk::ShaderModuleCreateFlags flags) noexcept -> BulletRT::Core::VulkanShaderModuleBuilder &
+auto VulkanPipelineLayout::GetFlags() const noexcept -> vk::PipelineLayoutCreateFlags
 {
-    m_Flags = flags;
-    return *this;
+    return m_Builder.GetFlags();
 }
 
-auto VulkanShaderModuleBuilder::SetCodes(const std::vector<uint32_t> &codes) noexcept -> BulletRT::Core::VulkanShaderModuleBuilder &
+auto VulkanPipelineLayout::GetSetLayouts() const noexcept -> const std::vector<vk::DescriptorSetLayout> &
 {
-    m_Codes = codes;
-    return *this;
+    return m_Builder.GetSetLayouts();
 }
 
-auto VulkanShaderModuleBuilder::GetCodes() const noexcept -> const std::vector<uint32_t> &
+auto VulkanPipelineLayout::GetPushConstantRanges() const noexcept -> const std::vector<vk::PushConstantRange> &
 {
-    return m_Codes;
+    return m_Builder.GetPushConstantRanges();
 }
 
-auto VulkanShaderModuleBuilder::GetPCode() const noexcept -> const uint32_t *
+VulkanPipelineLayout::VulkanPipelineLayout() noexcept
 {
-    return m_Codes.data();
 }
 
-auto VulkanShaderModuleBuilder::GetCodeSize() const noexcept -> uint32_t
+auto VulkanPipelineCache::New(const BulletRT::Core::VulkanDevice *device, const std::vector<uint8_t> &initialData) -> std::unique_ptr<VulkanPipelineCache>
 {
-    return static_cast<uint32_t>(m_Codes.size());
+    if (!device)
+    {
+        return nullptr;
+    }
+    auto createInfo = vk::PipelineCacheCreateInfo();
+    // Implementations must reject foreign data themselves, but some crash on it instead, so it is filtered here.
+    if (IsCompatible(device, initialData.data(), initialData.size()))
+    {
+        createInfo.setInitialDataSize(initialData.size()).setPInitialData(initialData.data());
+    }
+    auto pipelineCache = device->GetDeviceVk().createPipelineCacheUnique(createInfo);
+    if (pipelineCache)
+    {
+        auto vulkanPipelineCache = std::unique_ptr<VulkanPipelineCache>(new VulkanPipelineCache());
+        vulkanPipelineCache->m_Device = device;
+        vulkanPipelineCache->m_PipelineCache = std::move(pipelineCache);
+        return vulkanPipelineCache;
+    }
+    return nullptr;
 }
 
-auto VulkanShaderModuleBuilder::GetShaderModuleCreateInfoVk() const noexcept -> vk::ShaderModuleCreateInfo
+auto VulkanPipelineCache::Load(const BulletRT::Core::VulkanDevice *device, const std::string &filename) -> std::unique_ptr<VulkanPipelineCache>
 {
-    return vk::ShaderModuleCreateInfo().setFlags(m_Flags).setCode(m_Codes);
+    auto data = std::vector<uint8_t>();
+    auto file = std::ifstream(filename, std::ios::binary | std::ios::ate);
+    if (file)
+    {
+        auto sizeInBytes = static_cast<std::streamsize>(file.tellg());
+        if (sizeInBytes > 0)
+        {
+            data.resize(static_cast<size_t>(sizeInBytes));
+            file.seekg(0);
+            file.read(reinterpret_cast<char *>(data.data()), sizeInBytes);
+            if (!file)
+            {
+                data.clear();
+            }
+        }
+    }
+    return New(device, data);
 }
 
-auto VulkanShaderModule::New(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanShaderModule::Builder &builder) -> std::unique_ptr<VulkanShaderModule>
+bool VulkanPipelineCache::IsCompatible(const BulletRT::Core::VulkanDevice *device, const void *pData, size_t sizeInBytes) noexcept
 {
-    auto shaderModule = device->GetDeviceVk().createShaderModuleUnique(builder.GetShaderModuleCreateInfoVk());
-    if (shaderModule)
+    auto header = VkPipelineCacheHeaderVersionOne{};
+    if (!device || !pData || sizeInBytes < sizeof(header))
     {
-        auto vulkanShaderModule = std::unique_ptr<VulkanShaderModule>(new VulkanShaderModule());
-        vulkanShaderModule->m_Device = device;
-        vulkanShaderModule->m_ShaderModule = std::move(shaderModule);
-        vulkanShaderModule->m_Flags = builder.GetFlags();
-        vulkanShaderModule->m_Codes = builder.GetCodes();
-        return vulkanShaderModule;
+        return false;
     }
-    return nullptr;
+    std::memcpy(&header, pData, sizeof(header));
+    auto properties = device->GetPhysicalDeviceVk().getProperties();
+    return header.headerSize >= sizeof(header) && header.headerSize <= sizeInBytes &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
 }
 
-VulkanShaderModule::~VulkanShaderModule() noexcept
+VulkanPipelineCache::~VulkanPipelineCache() noexcept
 {
-    m_ShaderModule.reset();
+    m_PipelineCache.reset();
 }
 
-auto VulkanShaderModule::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice *
+auto VulkanPipelineCache::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice *
 {
     return m_Device;
 }
 
-auto VulkanShaderModule::GetDeviceVk() const noexcept -> vk::Device
+auto VulkanPipelineCache::GetDeviceVk() const noexcept -> vk::Device
 {
     return m_Device ? m_Device->GetDeviceVk() : nullptr;
 }
 
-auto VulkanShaderModule::GetShaderModuleVk() const noexcept -> vk::ShaderModule
+auto VulkanPipelineCache::GetPipelineCacheVk() const noexcept -> vk::PipelineCache
 {
-    return m_ShaderModule.get();
+    return m_PipelineCache.get();
 }
 
-auto VulkanShaderModule::GetFlags() const noexcept -> vk::ShaderModuleCreateFlags
+auto VulkanPipelineCache::GetData() const -> std::vector<uint8_t>
 {
-    return m_Flags;
+    return GetDeviceVk().getPipelineCacheData(m_PipelineCache.get());
 }
 
-auto VulkanShaderModule::GetCodes() const noexcept -> const std::vector<uint32_t> &
+auto VulkanPipelineCache::Save(const std::string &filename) const -> vk::Result
 {
-    return m_Codes;
+    auto sizeInBytes = size_t(0);
+    auto res = GetDeviceVk().getPipelineCacheData(m_PipelineCache.get(), &sizeInBytes, nullptr);
+    if (res != vk::Result::eSuccess)
+    {
+        return res;
+    }
+    auto data = std::vector<uint8_t>(sizeInBytes);
+    // The cache may grow between both calls when other threads compile; the truncated data is still a valid cache.
+    res = GetDeviceVk().getPipelineCacheData(m_PipelineCache.get(), &sizeInBytes, data.data());
+    if (res != vk::Result::eSuccess && res != vk::Result::eIncomplete)
+    {
+        return res;
+    }
+    data.resize(sizeInBytes);
+    auto temporaryFilename = filename + ".tmp";
+    {
+        auto file = std::ofstream(temporaryFilename, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return vk::Result::eErrorUnknown;
+        }
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file)
+        {
+            return vk::Result::eErrorUnknown;
+        }
+    }
+    auto errorCode = std::error_code();
+    std::filesystem::rename(temporaryFilename, filename, errorCode);
+    if (errorCode)
+    {
+        std::filesystem::remove(temporaryFilename, errorCode);
+        return vk::Result::eErrorUnknown;
+    }
+    return vk::Result::eSuccess;
 }
 
-auto VulkanShaderModule::GetPCode() const noexcept -> const uint32_t *
+auto VulkanPipelineCache::Merge(const std::vector<const VulkanPipelineCache *> &srcCaches) -> vk::Result
 {
-    return m_Codes.data();
+    auto srcCacheVks = std::vector<vk::PipelineCache>();
+    srcCacheVks.reserve(srcCaches.size());
+    for (auto &srcCache : srcCaches)
+    {
+        if (srcCache && srcCache != this && srcCache->m_Device == m_Device)
+        {
+            srcCacheVks.push_back(srcCache->GetPipelineCacheVk());
+        }
+    }
+    if (srcCacheVks.empty())
+    {
+        return vk::Result::eSuccess;
+    }
+    return GetDeviceVk().mergePipelineCaches(m_PipelineCache.get(), static_cast<uint32_t>(srcCacheVks.size()), srcCacheVks.data());
 }
 
-auto VulkanShaderModule::GetCodeSize() const noexcept -> uint32_t
+VulkanPipelineCache::VulkanPipelineCache() noexcept
 {
-    return static_cast<uint32_t>(m_Codes.size());
 }
 
-VulkanShaderModule::VulkanShaderModule() noexcept
+auto VulkanDevice::GetPipelineCache() const noexcept -> BulletRT::Core::VulkanPipelineCache *
 {
+    return m_PipelineCache.get();
 }
 
-auto VulkanPipelineTessellationStateDesc::SetFlags(vk::PipelineTessellationStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineTessellationStateDesc &
+auto VulkanDevice::SavePipelineCache(const std::string &filename) const -> vk::Result
 {
-    m_Flags = flags;
-    return *this;
+    auto &path = filename.empty() ? m_PipelineCacheFilename : filename;
+    if (!m_PipelineCache || path.empty())
+    {
+        return vk::Result::eErrorInitializationFailed;
+    }
+    return m_PipelineCache->Save(path);
 }
 
-auto VulkanPipelineTessellationStateDesc::GetFlags() const noexcept -> vk::PipelineTessellationStateCreateFlags
+VulkanGraphicsPipelineBuilder::VulkanGraphicsPipelineBuilder() noexcept
 {
-    return m_Flags;
 }
 
-auto VulkanPipelineTessellationStateDesc::SetPatchControlPoints(uint32_t patchControlPoints) noexcept -> BulletRT::Core::VulkanPipelineTessellationStateDesc &
+auto VulkanPipelineVertexInputStateDesc::AddVertexBindingDescription(const vk::VertexInputBindingDescription &bindingDesc) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
-    m_PatchControlPoints = patchControlPoints;
+    m_VertexBindingDescriptions.push_back(bindingDesc);
     return *this;
 }
 
-auto VulkanPipelineTessellationStateDesc::GetPatchControlPoints() const noexcept -> uint32_t
+auto VulkanPipelineVertexInputStateDesc::SetVertexBindingDescription(size_t idx, const vk::VertexInputBindingDescription &bindingDesc) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
-    return m_PatchControlPoints;
+    if (m_VertexBindingDescriptions.size() > idx)
+    {
+        m_VertexBindingDescriptions[idx] = bindingDesc;
+    }
+    return *this;
 }
 
-auto VulkanPipelineTessellationStateDesc::SetDomainOrigin(const vk::TessellationDomainOrigin &origin) noexcept -> BulletRT::Core::VulkanPipelineTessellationStateDesc &
+auto VulkanPipelineVertexInputStateDesc::GetVertexBindingDescriptions() const noexcept -> const std::vector<vk::VertexInputBindingDescription> &
 {
-    m_DomainOrigin = origin;
-    return *this;
+    return m_VertexBindingDescriptions;
 }
 
-auto VulkanPipelineTessellationStateDesc::GetDomainOrigin() const noexcept -> const std::optional<vk::TessellationDomainOrigin> &
+auto VulkanPipelineVertexInputStateDesc::GetVertexBindingDescription(size_t idx) const -> const vk::VertexInputBindingDescription &
 {
-    return m_DomainOrigin;
+    return m_VertexBindingDescriptions.at(idx);
 }
 
-auto VulkanPipelineTessellationStateDesc::GetPipelineTessellationStateInfoVk() const noexcept -> vk::PipelineTessellationStateCreateInfo
+auto VulkanPipelineVertexInputStateDesc::AddVertexAttributeDescription(const vk::VertexInputAttributeDescription &attributeDesc) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
-    return vk::PipelineTessellationStateCreateInfo().setFlags(m_Flags).setPatchControlPoints(m_PatchControlPoints);
+    m_VertexAttributeDescriptions.push_back(attributeDesc);
+    return *this;
 }
 
-VulkanPipelineTessellationStateDesc::VulkanPipelineTessellationStateDesc() noexcept
+auto VulkanPipelineVertexInputStateDesc::SetVertexAttributeDescription(size_t idx, const vk::VertexInputAttributeDescription &attributeDesc) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
+    if (m_VertexAttributeDescriptions.size() > idx)
+    {
+        m_VertexAttributeDescriptions[idx] = attributeDesc;
+    }
+    return *this;
 }
 
-VulkanPipelineTessellationStateDesc::VulkanPipelineTessellationStateDesc(const BulletRT::Core::VulkanPipelineTessellationStateDesc &tessellation) noexcept
+auto VulkanPipelineVertexInputStateDesc::GetVertexAttributeDescriptions() const noexcept -> const std::vector<vk::VertexInputAttributeDescription> &
 {
-    m_Flags = tessellation.m_Flags;
-    m_DomainOrigin = tessellation.m_DomainOrigin;
-    m_PatchControlPoints = tessellation.m_PatchControlPoints;
+    return m_VertexAttributeDescriptions;
 }
 
-VulkanPipelineTessellationStateDesc::VulkanPipelineTessellationStateDesc(BulletRT::Core::VulkanPipelineTessellationStateDesc &&tessellation) noexcept
+auto VulkanPipelineVertexInputStateDesc::GetVertexAttributeDescription(size_t idx) const -> const vk::VertexInputAttributeDescription &
 {
-    m_Flags = std::move(tessellation.m_Flags);
-    m_DomainOrigin = std::move(tessellation.m_DomainOrigin);
-    m_PatchControlPoints = std::move(tessellation.m_PatchControlPoints);
+    return m_VertexAttributeDescriptions.at(idx);
 }
 
-BulletRT::Core::VulkanPipelineTessellationStateDesc &VulkanPipelineTessellationStateDesc::operator=(const BulletRT::Core::VulkanPipelineTessellationStateDesc &tessellation) noexcept
+auto VulkanPipelineVertexInputStateDesc::SetVertexBindingDivisors(const std::vector<vk::VertexInputBindingDivisorDescriptionEXT> &divisors) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
-    if (this != &tessellation)
-    {
-        m_Flags = tessellation.m_Flags;
-        m_DomainOrigin = tessellation.m_DomainOrigin;
-        m_PatchControlPoints = tessellation.m_PatchControlPoints;
-    }
+    m_VertexBindingDivisors = divisors;
     return *this;
 }
 
-BulletRT::Core::VulkanPipelineTessellationStateDesc &VulkanPipelineTessellationStateDesc::operator=(BulletRT::Core::VulkanPipelineTessellationStateDesc &&tessellation) noexcept
+auto VulkanPipelineVertexInputStateDesc::AddVertexBindingDivisors(const vk::VertexInputBindingDivisorDescriptionEXT &divisor) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
-    if (this != &tessellation)
+    m_VertexBindingDivisors.push_back(divisor);
+    return *this;
+}
+
+auto VulkanPipelineVertexInputStateDesc::SetVertexBindingDivisor(size_t idx, const vk::VertexInputBindingDivisorDescriptionEXT &divisor) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
+{
+    if (m_VertexBindingDivisors.size() > idx)
     {
-        m_Flags = std::move(tessellation.m_Flags);
-        m_DomainOrigin = std::move(tessellation.m_DomainOrigin);
-        m_PatchControlPoints = std::move(tessellation.m_PatchControlPoints);
+        m_VertexBindingDivisors[idx] = divisor;
     }
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::SetNegativeOneToOne(vk::Bool32 negativeOneToOne) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanPipelineVertexInputStateDesc::GetVertexBindingDivisors() const noexcept -> const std::vector<vk::VertexInputBindingDivisorDescriptionEXT> &
 {
-    m_NegativeOneToOne = negativeOneToOne;
-    return *this;
+    return m_VertexBindingDivisors;
 }
 
-auto VulkanPipelineViewportStateDesc::GetNegativeOneToOne() const noexcept -> std::optional<vk::Bool32>
+auto VulkanPipelineVertexInputStateDesc::GetVertexBindingDivisor(size_t idx) const -> const vk::VertexInputBindingDivisorDescriptionEXT &
 {
-    return m_NegativeOneToOne;
+    return m_VertexBindingDivisors.at(idx);
 }
 
-auto VulkanPipelineViewportStateDesc::GetPipelineViewportStateCreateInfoVk() const noexcept -> vk::PipelineViewportStateCreateInfo
+auto VulkanPipelineVertexInputStateDesc::SetVertexAttributeDescriptions(const std::vector<vk::VertexInputAttributeDescription> &attributeDescs) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
-    return vk::PipelineViewportStateCreateInfo()
-        .setFlags(m_Flags)
-        .setViewports(m_Viewports)
-        .setScissors(m_Scissors);
+    m_VertexAttributeDescriptions = attributeDescs;
+    return *this;
 }
 
-VulkanPipelineViewportStateDesc::VulkanPipelineViewportStateDesc() noexcept
+auto VulkanPipelineVertexInputStateDesc::SetVertexBindingDescriptions(const std::vector<vk::VertexInputBindingDescription> &bindingDescs) noexcept -> BulletRT::Core::VulkanPipelineVertexInputStateDesc &
 {
+    m_VertexBindingDescriptions = bindingDescs;
+    return *this;
 }
 
-VulkanPipelineViewportStateDesc::VulkanPipelineViewportStateDesc(const BulletRT::Core::VulkanPipelineViewportStateDesc &builder) noexcept
+VulkanGraphicsPipelineBuilder::VulkanGraphicsPipelineBuilder(const BulletRT::Core::VulkanGraphicsPipelineBuilder &builder) noexcept
 {
     m_Flags = builder.m_Flags;
-    m_Viewports = builder.m_Viewports;
-    m_Scissors = builder.m_Scissors;
-    m_NegativeOneToOne = builder.m_NegativeOneToOne;
+    m_Stages = builder.m_Stages;
+    m_VertexInputState = builder.m_VertexInputState;
+    m_InputAssemblyState = builder.m_InputAssemblyState;
+    m_TessellationState = builder.m_TessellationState;
+    m_ViewportState = builder.m_ViewportState;
+    m_RasterizationState = builder.m_RasterizationState;
+    m_MultiSampleState = builder.m_MultiSampleState;
+    m_DepthStencilState = builder.m_DepthStencilState;
+    m_ColorBlendState = builder.m_ColorBlendState;
+    m_DynamicStates = builder.m_DynamicStates;
+    m_Layout = builder.m_Layout;
+    m_RenderPass = builder.m_RenderPass;
+    m_Subpass = builder.m_Subpass;
+    m_BasePipelineHandle = builder.m_BasePipelineHandle;
+    m_BasePipelineIndex = builder.m_BasePipelineIndex;
+    m_PipelineCache = builder.m_PipelineCache;
 }
 
-VulkanPipelineViewportStateDesc::VulkanPipelineViewportStateDesc(BulletRT::Core::VulkanPipelineViewportStateDesc &&builder) noexcept
+VulkanGraphicsPipelineBuilder::VulkanGraphicsPipelineBuilder(BulletRT::Core::VulkanGraphicsPipelineBuilder &&builder) noexcept
 {
     m_Flags = std::move(builder.m_Flags);
-    m_Viewports = std::move(builder.m_Viewports);
-    m_Scissors = std::move(builder.m_Scissors);
-    m_NegativeOneToOne = std::move(builder.m_NegativeOneToOne);
+    m_Stages = std::move(builder.m_Stages);
+    m_VertexInputState = std::move(builder.m_VertexInputState);
+    m_InputAssemblyState = std::move(builder.m_InputAssemblyState);
+    m_TessellationState = std::move(builder.m_TessellationState);
+    m_ViewportState = std::move(builder.m_ViewportState);
+    m_RasterizationState = std::move(builder.m_RasterizationState);
+    m_MultiSampleState = std::move(builder.m_MultiSampleState);
+    m_DepthStencilState = std::move(builder.m_DepthStencilState);
+    m_ColorBlendState = std::move(builder.m_ColorBlendState);
+    m_DynamicStates = std::move(builder.m_DynamicStates);
+    m_Layout = builder.m_Layout;
+    builder.m_Layout = nullptr;
+    m_RenderPass = builder.m_RenderPass;
+    builder.m_RenderPass = nullptr;
+    m_Subpass = std::move(builder.m_Subpass);
+    m_BasePipelineHandle = builder.m_BasePipelineHandle;
+    builder.m_BasePipelineHandle = nullptr;
+    m_BasePipelineIndex = std::move(builder.m_BasePipelineIndex);
+    m_PipelineCache = builder.m_PipelineCache;
+    builder.m_PipelineCache = nullptr;
 }
 
-BulletRT::Core::VulkanPipelineViewportStateDesc &VulkanPipelineViewportStateDesc::operator=(const BulletRT::Core::VulkanPipelineViewportStateDesc &builder) noexcept
+BulletRT::Core::VulkanGraphicsPipelineBuilder &VulkanGraphicsPipelineBuilder::operator=(const BulletRT::Core::VulkanGraphicsPipelineBuilder &builder) noexcept
 {
     if (this != &builder)
     {
         m_Flags = builder.m_Flags;
-        m_Viewports = builder.m_Viewports;
-        m_Scissors = builder.m_Scissors;
-        m_NegativeOneToOne = builder.m_NegativeOneToOne;
+        m_Stages = builder.m_Stages;
+        m_VertexInputState = builder.m_VertexInputState;
+        m_InputAssemblyState = builder.m_InputAssemblyState;
+        m_TessellationState = builder.m_TessellationState;
+        m_ViewportState = builder.m_ViewportState;
+        m_RasterizationState = builder.m_RasterizationState;
+        m_MultiSampleState = builder.m_MultiSampleState;
+        m_DepthStencilState = builder.m_DepthStencilState;
+        m_ColorBlendState = builder.m_ColorBlendState;
+        m_DynamicStates = builder.m_DynamicStates;
+        m_Layout = builder.m_Layout;
+        m_RenderPass = builder.m_RenderPass;
+        m_Subpass = builder.m_Subpass;
+        m_BasePipelineHandle = builder.m_BasePipelineHandle;
+        m_BasePipelineIndex = builder.m_BasePipelineIndex;
+        m_PipelineCache = builder.m_PipelineCache;
     }
     return *this;
 }
 
-BulletRT::Core::VulkanPipelineViewportStateDesc &VulkanPipelineViewportStateDesc::operator=(BulletRT::Core::VulkanPipelineViewportStateDesc &&builder) noexcept
+BulletRT::Core::VulkanGraphicsPipelineBuilder &VulkanGraphicsPipelineBuilder::operator=(BulletRT::Core::VulkanGraphicsPipelineBuilder &&builder) noexcept
 {
     if (this != &builder)
     {
         m_Flags = std::move(builder.m_Flags);
-        m_Viewports = std::move(builder.m_Viewports);
-        m_Scissors = std::move(builder.m_Scissors);
-        m_NegativeOneToOne = std::move(builder.m_NegativeOneToOne);
+        m_Stages = std::move(builder.m_Stages);
+        m_VertexInputState = std::move(builder.m_VertexInputState);
+        m_InputAssemblyState = std::move(builder.m_InputAssemblyState);
+        m_TessellationState = std::move(builder.m_TessellationState);
+        m_ViewportState = std::move(builder.m_ViewportState);
+        m_RasterizationState = std::move(builder.m_RasterizationState);
+        m_MultiSampleState = std::move(builder.m_MultiSampleState);
+        m_DepthStencilState = std::move(builder.m_DepthStencilState);
+        m_ColorBlendState = std::move(builder.m_ColorBlendState);
+        m_DynamicStates = std::move(builder.m_DynamicStates);
+        m_Layout = builder.m_Layout;
+        builder.m_Layout = nullptr;
+        m_RenderPass = builder.m_RenderPass;
+        builder.m_RenderPass = nullptr;
+        m_Subpass = std::move(builder.m_Subpass);
+        m_BasePipelineHandle = builder.m_BasePipelineHandle;
+        builder.m_BasePipelineHandle = nullptr;
+        m_BasePipelineIndex = std::move(builder.m_BasePipelineIndex);
+        m_PipelineCache = builder.m_PipelineCache;
+        builder.m_PipelineCache = nullptr;
     }
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::SetFlags(vk::PipelineViewportStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetFlags(vk::PipelineCreateFlags flags) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
     m_Flags = flags;
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::GetFlags() const noexcept -> vk::PipelineViewportStateCreateFlags
+auto VulkanGraphicsPipelineBuilder::GetFlags() const noexcept -> vk::PipelineCreateFlags
 {
     return m_Flags;
 }
 
-auto VulkanPipelineViewportStateDesc::SetViewportCount(uint32_t viewportCount) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
-{
-    m_Viewports.resize(viewportCount);
-    return *this;
-}
-
-auto VulkanPipelineViewportStateDesc::SetViewports(const std::vector<vk::Viewport> &viewports) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetStages(const std::vector<VulkanPipelineShaderStageDesc> &stages) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_Viewports = viewports;
+    m_Stages = stages;
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::AddViewport(const vk::Viewport &viewport) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::AddStage(const BulletRT::Core::VulkanPipelineShaderStageDesc &stage) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_Viewports.push_back(viewport);
+    m_Stages.push_back(stage);
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::SetViewport(size_t idx, const vk::Viewport &viewport) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetStage(size_t idx, const BulletRT::Core::VulkanPipelineShaderStageDesc &stage) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    if (idx < m_Viewports.size())
+    if (m_Stages.size() > idx)
     {
-        m_Viewports[idx] = viewport;
+        m_Stages[idx] = stage;
     }
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::GetViewports() const noexcept -> const std::vector<vk::Viewport> &
+auto VulkanGraphicsPipelineBuilder::GetStages() const noexcept -> std::vector<VulkanPipelineShaderStageDesc>
 {
-    return m_Viewports;
+    return m_Stages;
 }
 
-auto VulkanPipelineViewportStateDesc::GetViewport(size_t idx) const -> const vk::Viewport &
+auto VulkanGraphicsPipelineBuilder::GetStage(size_t idx) const -> const BulletRT::Core::VulkanPipelineShaderStageDesc &
 {
-    return m_Viewports.at(idx);
+    return m_Stages.at(idx);
 }
 
-auto VulkanPipelineViewportStateDesc::SetScissorCount(uint32_t scissorCount) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetVertexInputState(const BulletRT::Core::VulkanPipelineVertexInputStateDesc &vertexInput) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_Scissors.resize(scissorCount);
+    m_VertexInputState = vertexInput;
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::SetScissors(const std::vector<vk::Rect2D> &scissors) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::GetVertexInputState() const noexcept -> const std::optional<VulkanPipelineVertexInputStateDesc> &
 {
-    m_Scissors = scissors;
-    return *this;
+    return m_VertexInputState;
 }
 
-auto VulkanPipelineViewportStateDesc::AddScissor(const vk::Rect2D &scissor) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetInputAssemblyState(const vk::PipelineInputAssemblyStateCreateInfo &inputAssembly) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_Scissors.push_back(scissor);
+    m_InputAssemblyState = inputAssembly;
     return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::SetScissor(size_t idx, const vk::Rect2D &scissor) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+auto VulkanGraphicsPipelineBuilder::GetInputAssemblyState() const noexcept -> const std::optional<vk::PipelineInputAssemblyStateCreateInfo> &
 {
-    if (idx < m_Scissors.size())
-    {
-        m_Scissors[idx] = scissor;
-    }
-    return *this;
+    return m_InputAssemblyState;
 }
 
-auto VulkanPipelineViewportStateDesc::GetScissors() const noexcept -> const std::vector<vk::Rect2D> &
+auto VulkanGraphicsPipelineBuilder::SetTessellationState(const BulletRT::Core::VulkanPipelineTessellationStateDesc &tessellation) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    return m_Scissors;
+    m_TessellationState = tessellation;
+    return *this;
 }
 
-auto VulkanPipelineViewportStateDesc::GetScissor(size_t idx) const -> const vk::Rect2D &
+auto VulkanGraphicsPipelineBuilder::GetTessellationState() const noexcept -> const std::optional<VulkanPipelineTessellationStateDesc> &
 {
-    return m_Scissors.at(idx);
+    return m_TessellationState;
 }
 
-VulkanPipelineRasterizationStateDesc::VulkanPipelineRasterizationStateDesc() noexcept {}
-
-VulkanPipelineRasterizationStateDesc::VulkanPipelineRasterizationStateDesc(const BulletRT::Core::VulkanPipelineRasterizationStateDesc &builder) noexcept
+auto VulkanGraphicsPipelineBuilder::SetViewportState(const BulletRT::Core::VulkanPipelineViewportStateDesc &viewport) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_Flags = builder.m_Flags;
-    m_DepthClampEnable = builder.m_DepthClampEnable;
-    m_RasterizerDiscardEnable = builder.m_RasterizerDiscardEnable;
-    m_PolygonMode = builder.m_PolygonMode;
-    m_CullMode = builder.m_CullMode;
-    m_FrontFace = builder.m_FrontFace;
-    m_DepthBiasEnable = builder.m_DepthBiasEnable;
-    m_DepthBiasConstantFactor = builder.m_DepthBiasConstantFactor;
-    m_DepthBiasClamp = builder.m_DepthBiasClamp;
-    m_DepthBiasSlopeFactor = builder.m_DepthBiasSlopeFactor;
-    m_LineWidth = builder.m_LineWidth;
+    m_ViewportState = viewport;
+    return *this;
 }
 
-VulkanPipelineRasterizationStateDesc::VulkanPipelineRasterizationStateDesc(BulletRT::Core::VulkanPipelineRasterizationStateDesc &&builder) noexcept
+auto VulkanGraphicsPipelineBuilder::GetViewportState() const noexcept -> const std::optional<BulletRT::Core::VulkanPipelineViewportStateDesc> &
 {
-    m_Flags = std::move(builder.m_Flags);
-    m_DepthClampEnable = std::move(builder.m_DepthClampEnable);
-    m_RasterizerDiscardEnable = std::move(builder.m_RasterizerDiscardEnable);
-    m_PolygonMode = std::move(builder.m_PolygonMode);
-    m_CullMode = std::move(builder.m_CullMode);
-    m_FrontFace = std::move(builder.m_FrontFace);
-    m_DepthBiasEnable = std::move(builder.m_DepthBiasEnable);
-    m_DepthBiasConstantFactor = std::move(builder.m_DepthBiasConstantFactor);
-    m_DepthBiasClamp = std::move(builder.m_DepthBiasClamp);
-    m_DepthBiasSlopeFactor = std::move(builder.m_DepthBiasSlopeFactor);
-    m_LineWidth = std::move(builder.m_LineWidth);
+    return m_ViewportState;
 }
 
-BulletRT::Core::VulkanPipelineRasterizationStateDesc &VulkanPipelineRasterizationStateDesc::operator=(const BulletRT::Core::VulkanPipelineRasterizationStateDesc &builder) noexcept
+auto VulkanGraphicsPipelineBuilder::SetRasterizationState(const BulletRT::Core::VulkanPipelineRasterizationStateDesc &rasterization) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    if (this != &builder)
-    {
-        m_Flags = builder.m_Flags;
-        m_DepthClampEnable = builder.m_DepthClampEnable;
-        m_RasterizerDiscardEnable = builder.m_RasterizerDiscardEnable;
-        m_PolygonMode = builder.m_PolygonMode;
-        m_CullMode = builder.m_CullMode;
-        m_FrontFace = builder.m_FrontFace;
-        m_DepthBiasEnable = builder.m_DepthBiasEnable;
-        m_DepthBiasConstantFactor = builder.m_DepthBiasConstantFactor;
-        m_DepthBiasClamp = builder.m_DepthBiasClamp;
-        m_DepthBiasSlopeFactor = builder.m_DepthBiasSlopeFactor;
-        m_LineWidth = builder.m_LineWidth;
-    }
+    m_RasterizationState = rasterization;
     return *this;
 }
 
-BulletRT::Core::VulkanPipelineRasterizationStateDesc &VulkanPipelineRasterizationStateDesc::operator=(BulletRT::Core::VulkanPipelineRasterizationStateDesc &&builder) noexcept
+auto VulkanGraphicsPipelineBuilder::GetRasterizationState() const noexcept -> const std::optional<VulkanPipelineRasterizationStateDesc> &
 {
-    if (this != &builder)
-    {
-        m_Flags = std::move(builder.m_Flags);
-        m_DepthClampEnable = std::move(builder.m_DepthClampEnable);
-        m_RasterizerDiscardEnable = std::move(builder.m_RasterizerDiscardEnable);
-        m_PolygonMode = std::move(builder.m_PolygonMode);
-        m_CullMode = std::move(builder.m_CullMode);
-        m_FrontFace = std::move(builder.m_FrontFace);
-        m_DepthBiasEnable = std::move(builder.m_DepthBiasEnable);
-        m_DepthBiasConstantFactor = std::move(builder.m_DepthBiasConstantFactor);
-        m_DepthBiasClamp = std::move(builder.m_DepthBiasClamp);
-        m_DepthBiasSlopeFactor = std::move(builder.m_DepthBiasSlopeFactor);
-        m_LineWidth = std::move(builder.m_LineWidth);
-    }
-    return *this;
+    return m_RasterizationState;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetFlags() const noexcept -> vk::PipelineRasterizationStateCreateFlags
+auto VulkanGraphicsPipelineBuilder::SetMultiSampleState(const BulletRT::Core::VulkanPipelineMultiSampleStateDesc &multiSample) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    return m_Flags;
+    m_MultiSampleState = multiSample;
+    return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetFlags(vk::PipelineRasterizationStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::GetMultiSampleState() const noexcept -> const std::optional<VulkanPipelineMultiSampleStateDesc> &
 {
-    m_Flags = flags;
-    return *this;
+    return m_MultiSampleState;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetDepthClampEnable(vk::Bool32 depthClampEnable) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::GetDepthStencilState(const vk::PipelineDepthStencilStateCreateInfo &depthStencil) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_DepthBiasClamp = depthClampEnable;
+    m_DepthStencilState = depthStencil;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetDepthClampEnable() const noexcept -> vk::Bool32
+auto VulkanGraphicsPipelineBuilder::SetDepthStencilState() const noexcept -> const std::optional<vk::PipelineDepthStencilStateCreateInfo> &
 {
-    return m_DepthClampEnable;
+    return m_DepthStencilState;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetRasterizerDiscardEnable(vk::Bool32 rasterizerDiscardEnable) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetDepthStencilState(const vk::PipelineDepthStencilStateCreateInfo &depthStencil) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_RasterizerDiscardEnable = rasterizerDiscardEnable;
+    m_DepthStencilState = depthStencil;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetRasterizerDiscardEnable() const noexcept -> vk::Bool32
+auto VulkanGraphicsPipelineBuilder::GetDepthStencilState() const noexcept -> const std::optional<vk::PipelineDepthStencilStateCreateInfo> &
 {
-    return m_RasterizerDiscardEnable;
+    return m_DepthStencilState;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetPolygonMode(vk::PolygonMode polygonMode) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetColorBlendState(const BulletRT::Core::VulkanPipelineColorBlendStateDesc &colorBlendState) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_PolygonMode = polygonMode;
+    m_ColorBlendState = colorBlendState;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetPolygonMode() const noexcept -> vk::PolygonMode
-{
-    return m_PolygonMode;
-}
-
-auto VulkanPipelineRasterizationStateDesc::GetCullMode() const noexcept -> vk::CullModeFlags
+auto VulkanGraphicsPipelineBuilder::GetColorBlendState() const noexcept -> const std::optional<VulkanPipelineColorBlendStateDesc> &
 {
-    return m_CullMode;
+    return m_ColorBlendState;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetCullMode(vk::CullModeFlags cullMode) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetLayout(const BulletRT::Core::VulkanPipelineLayout *layout) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_CullMode = cullMode;
+    m_Layout = layout;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetFrontFace() const noexcept -> vk::FrontFace
+auto VulkanGraphicsPipelineBuilder::GetLayout() const noexcept -> const BulletRT::Core::VulkanPipelineLayout *
 {
-    return m_FrontFace;
+    return m_Layout;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetFrontFace(vk::FrontFace frontFace) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
-{
-    m_FrontFace = frontFace;
-    return *this;
-}
-
-auto VulkanPipelineRasterizationStateDesc::SetDepthBiasEnable(vk::Bool32 depthBiasEnable) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetRenderPass(const BulletRT::Core::VulkanRenderPass *renderPass) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_DepthBiasEnable = depthBiasEnable;
+    m_RenderPass = renderPass;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetDepthBiasEnable() const noexcept -> vk::Bool32
+auto VulkanGraphicsPipelineBuilder::GetRenderPass() const noexcept -> const BulletRT::Core::VulkanRenderPass *
 {
-    return m_DepthBiasEnable;
+    return m_RenderPass;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetDepthBiasConstantFactor(float depthBiasConstantFactor) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetSubpass(uint32_t subpass) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_DepthBiasConstantFactor = depthBiasConstantFactor;
+    m_Subpass = subpass;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetDepthBiasConstantFactor() const noexcept -> float
+auto VulkanGraphicsPipelineBuilder::GetSubpass() const noexcept -> std::optional<uint32_t>
 {
-    return m_DepthBiasConstantFactor;
+    return m_Subpass;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetDepthBiasClamp(float depthBiasClamp) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetBasePipelineHandle(const BulletRT::Core::VulkanGraphicsPipeline *basePipeline) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_DepthBiasClamp = depthBiasClamp;
+    if (basePipeline)
+    {
+        m_Flags |= vk::PipelineCreateFlagBits::eDerivative;
+        if (m_BasePipelineIndex)
+        {
+            m_BasePipelineIndex = std::nullopt;
+        }
+        m_BasePipelineHandle = basePipeline;
+    }
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetDepthBiasClamp() const noexcept -> float
+auto VulkanGraphicsPipelineBuilder::GetBasePipelineHandle() const noexcept -> const BulletRT::Core::VulkanGraphicsPipeline *
 {
-    return m_DepthBiasClamp;
+    return m_BasePipelineHandle;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetDepthBiasSlopeFactor(float depthBiasSlopeFactor) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetBasePipelineIndex(uint32_t basePipelineIndex) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_DepthBiasSlopeFactor = depthBiasSlopeFactor;
+    m_Flags |= vk::PipelineCreateFlagBits::eDerivative;
+    if (m_BasePipelineHandle)
+    {
+        m_BasePipelineHandle = nullptr;
+    }
+    m_BasePipelineIndex = basePipelineIndex;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetDepthBiasSlopeFactor() const noexcept -> float
+auto VulkanGraphicsPipelineBuilder::GetBasePipelineIndex() const noexcept -> std::optional<uint32_t>
 {
-    return m_DepthBiasSlopeFactor;
+    return m_BasePipelineIndex;
 }
 
-auto VulkanPipelineRasterizationStateDesc::SetLineWidth(float lineWidth) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+auto VulkanGraphicsPipelineBuilder::SetPipelineCache(const BulletRT::Core::VulkanPipelineCache *pipelineCache) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_LineWidth = lineWidth;
+    m_PipelineCache = pipelineCache;
     return *this;
 }
 
-auto VulkanPipelineRasterizationStateDesc::GetLineWidth() const noexcept -> float
+auto VulkanGraphicsPipelineBuilder::GetPipelineCache() const noexcept -> const BulletRT::Core::VulkanPipelineCache *
 {
-    return m_LineWidth;
+    return m_PipelineCache;
 }
 
-VulkanPipelineMultiSampleStateDesc::VulkanPipelineMultiSampleStateDesc() noexcept
+auto VulkanGraphicsPipelineBuilder::SetDynamicStates(const std::vector<vk::DynamicState> &dynamicStates) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
+    m_DynamicStates = std::unordered_set<vk::DynamicState>(std::begin(dynamicStates), std::end(dynamicStates));
+    return *this;
 }
 
-VulkanPipelineMultiSampleStateDesc::VulkanPipelineMultiSampleStateDesc(const BulletRT::Core::VulkanPipelineMultiSampleStateDesc &builder) noexcept
+auto VulkanGraphicsPipelineBuilder::AddDynamicState(vk::DynamicState dynamicState) noexcept -> BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    m_Flags = builder.m_Flags;
-    m_RasterizationSamples = builder.m_RasterizationSamples;
-    m_SampleShadingEnable = builder.m_SampleShadingEnable;
-    m_MinSampleShading = builder.m_MinSampleShading;
-    m_SampleMasks = builder.m_SampleMasks;
-    m_AlphaToCoverageEnable = builder.m_AlphaToCoverageEnable;
-    m_AlphaToOneEnable = builder.m_AlphaToOneEnable;
+    m_DynamicStates.insert(dynamicState);
+    return *this;
 }
 
-VulkanPipelineMultiSampleStateDesc::VulkanPipelineMultiSampleStateDesc(BulletRT::Core::VulkanPipelineMultiSampleStateDesc &&builder) noexcept
+auto VulkanGraphicsPipelineBuilder::GetDynamicStates() const noexcept -> std::vector<vk::DynamicState>
 {
-    m_Flags = std::move(builder.m_Flags);
-    m_RasterizationSamples = std::move(builder.m_RasterizationSamples);
-    m_SampleShadingEnable = std::move(builder.m_SampleShadingEnable);
-    m_MinSampleShading = std::move(builder.m_MinSampleShading);
-    m_SampleMasks = std::move(builder.m_SampleMasks);
-    m_AlphaToCoverageEnable = std::move(builder.m_AlphaToCoverageEnable);
-    m_AlphaToOneEnable = std::move(builder.m_AlphaToOneEnable);
+    auto dynamicStates = std::vector<vk::DynamicState>(std::begin(m_DynamicStates), std::end(m_DynamicStates));
+    std::sort(std::begin(dynamicStates), std::end(dynamicStates));
+    return dynamicStates;
 }
 
-BulletRT::Core::VulkanPipelineMultiSampleStateDesc &VulkanPipelineMultiSampleStateDesc::operator=(const BulletRT::Core::VulkanPipelineMultiSampleStateDesc &builder) noexcept
+auto VulkanGraphicsPipelineBuilder::GetStateKey() const -> std::vector<uint8_t>
 {
-    if (this != &builder)
+    auto key = std::vector<uint8_t>();
+    AppendValue(key, m_Flags);
+    AppendValue(key, m_Stages.size());
+    for (auto &stage : m_Stages)
     {
-        m_Flags = builder.m_Flags;
-        m_RasterizationSamples = builder.m_RasterizationSamples;
-        m_SampleShadingEnable = builder.m_SampleShadingEnable;
-        m_MinSampleShading = builder.m_MinSampleShading;
-        m_SampleMasks = builder.m_SampleMasks;
-        m_AlphaToCoverageEnable = builder.m_AlphaToCoverageEnable;
-        m_AlphaToOneEnable = builder.m_AlphaToOneEnable;
+        AppendValue(key, stage.GetFlags());
+        AppendValue(key, stage.GetStage());
+        auto name = stage.GetName();
+        AppendValues(key, name.data(), name.size());
+        // Modules are identified by their code, so equal SPIR-V in distinct modules still yields one pipeline.
+        if (stage.GetModule())
+        {
+            AppendValues(key, stage.GetModule()->GetCodes().data(), stage.GetModule()->GetCodes().size());
+        }
+        else if (stage.GetShaderModuleBuilder())
+        {
+            AppendValues(key, stage.GetShaderModuleBuilder()->GetCodes().data(), stage.GetShaderModuleBuilder()->GetCodes().size());
+        }
+        auto specializationInfo = stage.GetSpecializationInfoVk();
+        AppendValue(key, specializationInfo.has_value());
+        if (specializationInfo)
+        {
+            AppendValues(key, specializationInfo->pMapEntries, specializationInfo->mapEntryCount);
+            AppendValues(key, static_cast<const uint8_t *>(specializationInfo->pData), specializationInfo->dataSize);
+        }
     }
-    return *this;
-}
 
-BulletRT::Core::VulkanPipelineMultiSampleStateDesc &VulkanPipelineMultiSampleStateDesc::operator=(BulletRT::Core::VulkanPipelineMultiSampleStateDesc &&builder) noexcept
-{
-    if (this != &builder)
+    AppendValue(key, m_VertexInputState.has_value());
+    if (m_VertexInputState)
     {
-        m_Flags = builder.m_Flags;
-        m_RasterizationSamples = builder.m_RasterizationSamples;
-        m_SampleShadingEnable = builder.m_SampleShadingEnable;
-        m_MinSampleShading = builder.m_MinSampleShading;
-        m_SampleMasks = builder.m_SampleMasks;
-        m_AlphaToCoverageEnable = builder.m_AlphaToCoverageEnable;
-        m_AlphaToOneEnable = builder.m_AlphaToOneEnable;
+        auto vertexInputState = m_VertexInputState->GetVulkanPipelineVertexInputStateCreateInfoVk();
+        AppendValue(key, vertexInputState.flags);
+        AppendValues(key, vertexInputState.pVertexBindingDescriptions, vertexInputState.vertexBindingDescriptionCount);
+        AppendValues(key, vertexInputState.pVertexAttributeDescriptions, vertexInputState.vertexAttributeDescriptionCount);
+        AppendValues(key, m_VertexInputState->GetVertexBindingDivisors().data(), m_VertexInputState->GetVertexBindingDivisors().size());
     }
-    return *this;
-}
 
-auto VulkanPipelineMultiSampleStateDesc::GetFlags() const noexcept -> vk::PipelineMultisampleStateCreateFlags
-{
-    return m_Flags;
+    AppendValue(key, m_InputAssemblyState.has_value());
+    if (m_InputAssemblyState)
+    {
+        AppendValue(key, m_InputAssemblyState->flags);
+        AppendValue(key, m_InputAssemblyState->topology);
+        AppendValue(key, m_InputAssemblyState->primitiveRestartEnable);
+    }
+
+    AppendValue(key, m_TessellationState.has_value());
+    if (m_TessellationState)
+    {
+        AppendValue(key, m_TessellationState->GetFlags());
+        AppendValue(key, m_TessellationState->GetPatchControlPoints());
+        AppendValue(key, m_TessellationState->GetDomainOrigin().value_or(vk::TessellationDomainOrigin::eUpperLeft));
+    }
+
+    AppendValue(key, m_ViewportState.has_value());
+    if (m_ViewportState)
+    {
+        AppendValue(key, m_ViewportState->GetFlags());
+        AppendValues(key, m_ViewportState->GetViewports().data(), m_ViewportState->GetViewports().size());
+        AppendValues(key, m_ViewportState->GetScissors().data(), m_ViewportState->GetScissors().size());
+        AppendValue(key, m_ViewportState->GetNegativeOneToOne().value_or(VK_FALSE));
+    }
+
+    AppendValue(key, m_RasterizationState.has_value());
+    if (m_RasterizationState)
+    {
+        auto rasterizationState = m_RasterizationState->GetPipelineRasterizationStateCreateInfoVk();
+        AppendValue(key, rasterizationState.flags);
+        AppendValue(key, rasterizationState.depthClampEnable);
+        AppendValue(key, rasterizationState.rasterizerDiscardEnable);
+        AppendValue(key, rasterizationState.polygonMode);
+        AppendValue(key, rasterizationState.cullMode);
+        AppendValue(key, rasterizationState.frontFace);
+        AppendValue(key, rasterizationState.depthBiasEnable);
+        AppendValue(key, rasterizationState.depthBiasConstantFactor);
+        AppendValue(key, rasterizationState.depthBiasClamp);
+        AppendValue(key, rasterizationState.depthBiasSlopeFactor);
+        AppendValue(key, rasterizationState.lineWidth);
+    }
+
+    AppendValue(key, m_MultiSampleState.has_value());
+    if (m_MultiSampleState)
+    {
+        auto multiSampleState = m_MultiSampleState->GetPipelineMultisampleStateCreateInfoVk();
+        AppendValue(key, multiSampleState.flags);
+        AppendValue(key, multiSampleState.rasterizationSamples);
+        AppendValue(key, multiSampleState.sampleShadingEnable);
+        AppendValue(key, multiSampleState.minSampleShading);
+        AppendValues(key, multiSampleState.pSampleMask, (static_cast<uint32_t>(multiSampleState.rasterizationSamples) + 31) / 32);
+        AppendValue(key, multiSampleState.alphaToCoverageEnable);
+        AppendValue(key, multiSampleState.alphaToOneEnable);
+    }
+
+    AppendValue(key, m_DepthStencilState.has_value());
+    if (m_DepthStencilState)
+    {
+        AppendValue(key, m_DepthStencilState->flags);
+        AppendValue(key, m_DepthStencilState->depthTestEnable);
+        AppendValue(key, m_DepthStencilState->depthWriteEnable);
+        AppendValue(key, m_DepthStencilState->depthCompareOp);
+        AppendValue(key, m_DepthStencilState->depthBoundsTestEnable);
+        AppendValue(key, m_DepthStencilState->stencilTestEnable);
+        AppendValue(key, m_DepthStencilState->front);
+        AppendValue(key, m_DepthStencilState->back);
+        AppendValue(key, m_DepthStencilState->minDepthBounds);
+        AppendValue(key, m_DepthStencilState->maxDepthBounds);
+    }
+
+    AppendValue(key, m_ColorBlendState.has_value());
+    if (m_ColorBlendState)
+    {
+        auto colorBlendState = m_ColorBlendState->GetPipelineColorBlendStateCreateInfoVk();
+        AppendValue(key, colorBlendState.flags);
+        AppendValue(key, colorBlendState.logicOpEnable);
+        AppendValue(key, colorBlendState.logicOp);
+        AppendValues(key, colorBlendState.pAttachments, colorBlendState.attachmentCount);
+        AppendValue(key, colorBlendState.blendConstants);
+    }
+
+    auto dynamicStates = GetDynamicStates();
+    AppendValues(key, dynamicStates.data(), dynamicStates.size());
+
+    // The layout by its set layout handles and push constant ranges rather than its own handle, so pipeline layouts
+    // created separately over the same descriptor set layouts share a pipeline. Set layouts are only known by handle.
+    AppendValue(key, m_Layout != nullptr);
+    if (m_Layout)
+    {
+        AppendValue(key, m_Layout->GetFlags());
+        AppendValues(key, m_Layout->GetSetLayouts().data(), m_Layout->GetSetLayouts().size());
+        AppendValues(key, m_Layout->GetPushConstantRanges().data(), m_Layout->GetPushConstantRanges().size());
+    }
+
+    // Render pass compatibility: attachment formats and sample counts plus the attachment references of every subpass.
+    AppendValue(key, m_RenderPass != nullptr);
+    if (m_RenderPass)
+    {
+        AppendValue(key, m_RenderPass->GetAttachments().size());
+        for (auto &attachment : m_RenderPass->GetAttachments())
+        {
+            AppendValue(key, attachment.format);
+            AppendValue(key, attachment.samples);
+        }
+        AppendValue(key, m_RenderPass->GetSubpasses().size());
+        for (auto &subpass : m_RenderPass->GetSubpasses())
+        {
+            auto subpassDesc = subpass.GetSubpassDescriptionVk();
+            auto hashReferences = [&key](const vk::AttachmentReference *pReferences, uint32_t count)
+            {
+                AppendValue(key, count);
+                for (uint32_t i = 0; pReferences && i < count; ++i)
+                {
+                    AppendValue(key, pReferences[i].attachment);
+                }
+            };
+            AppendValue(key, subpassDesc.flags);
+            AppendValue(key, subpassDesc.pipelineBindPoint);
+            hashReferences(subpassDesc.pInputAttachments, subpassDesc.inputAttachmentCount);
+            hashReferences(subpassDesc.pColorAttachments, subpassDesc.colorAttachmentCount);
+            hashReferences(subpassDesc.pResolveAttachments, subpassDesc.pResolveAttachments ? subpassDesc.colorAttachmentCount : 0);
+            hashReferences(subpassDesc.pDepthStencilAttachment, subpassDesc.pDepthStencilAttachment ? 1 : 0);
+        }
+    }
+    AppendValue(key, m_Subpass.value_or(0));
+    AppendValue(key, m_BasePipelineHandle ? m_BasePipelineHandle->GetPipelineVk() : vk::Pipeline());
+    AppendValue(key, m_BasePipelineIndex.value_or(UINT32_MAX));
+    return key;
 }
 
-auto VulkanPipelineMultiSampleStateDesc::SetFlags(vk::PipelineMultisampleStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+auto VulkanGraphicsPipelineBuilder::GetHash() const -> uint64_t
 {
-    m_Flags = flags;
-    return *this;
+    auto key = GetStateKey();
+    return HashBytes(key.data(), key.size());
 }
 
-auto VulkanPipelineMultiSampleStateDesc::GetRasterizationSamples() const noexcept -> vk::SampleCountFlagBits
+auto VulkanGraphicsPipelineBuilder::Build(const BulletRT::Core::VulkanDevice *device) const -> std::unique_ptr<VulkanGraphicsPipeline>
 {
-    return m_RasterizationSamples;
+    return VulkanGraphicsPipeline::New(device, *this);
 }
 
-auto VulkanPipelineMultiSampleStateDesc::SetRasterizationSamples(vk::SampleCountFlagBits rasterizationSamples) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+auto VulkanGraphicsPipeline::New(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanGraphicsPipelineBuilder &builder) -> std::unique_ptr<VulkanGraphicsPipeline>
 {
-    m_RasterizationSamples = rasterizationSamples;
-    return *this;
+    if (!device || !builder.GetLayout() || !builder.GetRenderPass() || builder.GetStages().empty())
+    {
+        return nullptr;
+    }
+    auto subpass = builder.GetSubpass().value_or(0);
+    if (subpass >= builder.GetRenderPass()->GetSubpassCount())
+    {
+        return nullptr;
+    }
+    auto specializationInfos = std::vector<vk::SpecializationInfo>();
+    auto temporaryModules = std::vector<std::unique_ptr<VulkanShaderModule>>();
+    auto stageInfos = GetPipelineShaderStageCreateInfoVks(device, builder.GetStages(), specializationInfos, temporaryModules);
+    if (!stageInfos)
+    {
+        return nullptr;
+    }
+    auto createInfo = vk::GraphicsPipelineCreateInfo()
+                          .setFlags(builder.GetFlags())
+                          .setStages(stageInfos.value())
+                          .setLayout(builder.GetLayout()->GetPipelineLayoutVk())
+                          .setRenderPass(builder.GetRenderPass()->GetRenderPassVk())
+                          .setSubpass(subpass)
+                          .setBasePipelineIndex(-1);
+    if (builder.GetBasePipelineHandle())
+    {
+        createInfo.setBasePipelineHandle(builder.GetBasePipelineHandle()->GetPipelineVk());
+    }
+
+    auto vertexInputState = builder.GetVertexInputState() ? builder.GetVertexInputState()->GetVulkanPipelineVertexInputStateCreateInfoVk() : vk::PipelineVertexInputStateCreateInfo();
+    auto vertexInputDivisorState = builder.GetVertexInputState() ? builder.GetVertexInputState()->GetPipelineVertexInputDivisorStateCreateInfoEXT() : std::nullopt;
+    if (vertexInputDivisorState)
+    {
+        vertexInputState.setPNext(&vertexInputDivisorState.value());
+    }
+    createInfo.setPVertexInputState(&vertexInputState);
+
+    auto inputAssemblyState = builder.GetInputAssemblyState().value_or(vk::PipelineInputAssemblyStateCreateInfo().setTopology(vk::PrimitiveTopology::eTriangleList));
+    createInfo.setPInputAssemblyState(&inputAssemblyState);
+
+    auto tessellationState = vk::PipelineTessellationStateCreateInfo();
+    auto tessellationDomainOriginState = vk::PipelineTessellationDomainOriginStateCreateInfo();
+    if (builder.GetTessellationState())
+    {
+        tessellationState = builder.GetTessellationState()->GetPipelineTessellationStateInfoVk();
+        if (builder.GetTessellationState()->GetDomainOrigin())
+        {
+            tessellationDomainOriginState.setDomainOrigin(builder.GetTessellationState()->GetDomainOrigin().value());
+            tessellationState.setPNext(&tessellationDomainOriginState);
+        }
+        createInfo.setPTessellationState(&tessellationState);
+    }
+
+    auto viewportState = vk::PipelineViewportStateCreateInfo();
+    auto viewportDepthClipControl = vk::PipelineViewportDepthClipControlCreateInfoEXT();
+    if (builder.GetViewportState())
+    {
+        viewportState = builder.GetViewportState()->GetPipelineViewportStateCreateInfoVk();
+        if (builder.GetViewportState()->GetNegativeOneToOne())
+        {
+            viewportDepthClipControl.setNegativeOneToOne(builder.GetViewportState()->GetNegativeOneToOne().value());
+            viewportState.setPNext(&viewportDepthClipControl);
+        }
+        createInfo.setPViewportState(&viewportState);
+    }
+
+    auto rasterizationState = builder.GetRasterizationState().value_or(VulkanPipelineRasterizationStateDesc()).GetPipelineRasterizationStateCreateInfoVk();
+    createInfo.setPRasterizationState(&rasterizationState);
+
+    // The create info points into the sample masks of the desc, so it is kept alive here.
+    auto multiSampleStateDesc = builder.GetMultiSampleState().value_or(VulkanPipelineMultiSampleStateDesc());
+    auto multiSampleState = multiSampleStateDesc.GetPipelineMultisampleStateCreateInfoVk();
+    createInfo.setPMultisampleState(&multiSampleState);
+
+    auto depthStencilState = builder.GetDepthStencilState().value_or(vk::PipelineDepthStencilStateCreateInfo());
+    if (builder.GetDepthStencilState())
+    {
+        createInfo.setPDepthStencilState(&depthStencilState);
+    }
+
+    auto colorBlendState = builder.GetColorBlendState() ? builder.GetColorBlendState()->GetPipelineColorBlendStateCreateInfoVk() : vk::PipelineColorBlendStateCreateInfo();
+    if (builder.GetColorBlendState())
+    {
+        createInfo.setPColorBlendState(&colorBlendState);
+    }
+
+    auto dynamicStates = builder.GetDynamicStates();
+    auto dynamicState = vk::PipelineDynamicStateCreateInfo().setDynamicStates(dynamicStates);
+    if (!dynamicStates.empty())
+    {
+        createInfo.setPDynamicState(&dynamicState);
+    }
+
+    auto pipelineCache = builder.GetPipelineCache() ? builder.GetPipelineCache() : device->GetPipelineCache();
+    auto pipelineCacheVk = pipelineCache ? pipelineCache->GetPipelineCacheVk() : vk::PipelineCache();
+    auto pipelineVk = vk::Pipeline();
+    if (device->GetDeviceVk().createGraphicsPipelines(pipelineCacheVk, 1, &createInfo, nullptr, &pipelineVk) != vk::Result::eSuccess || !pipelineVk)
+    {
+        return nullptr;
+    }
+    auto vulkanPipeline = std::unique_ptr<VulkanGraphicsPipeline>(new VulkanGraphicsPipeline());
+    vulkanPipeline->m_Device = device;
+    vulkanPipeline->m_Pipeline = vk::UniquePipeline(pipelineVk, vk::ObjectDestroy<vk::Device, VULKAN_HPP_DEFAULT_DISPATCHER_TYPE>(device->GetDeviceVk()));
+    vulkanPipeline->m_Builder = builder;
+    return vulkanPipeline;
 }
 
-auto VulkanPipelineMultiSampleStateDesc::GetSampleShadingEnable() const noexcept -> vk::Bool32
+VulkanGraphicsPipeline::~VulkanGraphicsPipeline() noexcept
 {
-    return m_SampleShadingEnable;
+    m_Pipeline.reset();
 }
 
-auto VulkanPipelineMultiSampleStateDesc::SetSampleShadingEnable(vk::Bool32 sampleShadingEnable) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+auto VulkanGraphicsPipeline::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice *
 {
-    m_SampleShadingEnable = sampleShadingEnable;
-    return *this;
+    return m_Device;
 }
 
-auto VulkanPipelineMultiSampleStateDesc::GetMinSampleShading() const noexcept -> float
+auto VulkanGraphicsPipeline::GetDeviceVk() const noexcept -> vk::Device
 {
-    return m_MinSampleShading;
+    return m_Device ? m_Device->GetDeviceVk() : nullptr;
 }
 
-auto VulkanPipelineMultiSampleStateDesc::SetMinSampleShading(float minSampleShading) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+auto VulkanGraphicsPipeline::GetPipelineVk() const noexcept -> vk::Pipeline
 {
-    m_MinSampleShading = minSampleShading;
-    return *this;
+    return m_Pipeline.get();
 }
 
-auto VulkanPipelineMultiSampleStateDesc::GetAlphaToCoverageEnable() const noexcept -> vk::Bool32
+auto VulkanGraphicsPipeline::GetLayout() const noexcept -> const BulletRT::Core::VulkanPipelineLayout *
 {
-    return m_AlphaToCoverageEnable;
+    return m_Builder.GetLayout();
 }
 
-auto VulkanPipelineMultiSampleStateDesc::SetAlphaToCoverageEnable(vk::Bool32 alphaToCoverageEnable) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+auto VulkanGraphicsPipeline::GetRenderPass() const noexcept -> const BulletRT::Core::VulkanRenderPass *
 {
-    m_AlphaToCoverageEnable = alphaToCoverageEnable;
-    return *this;
+    return m_Builder.GetRenderPass();
 }
 
-auto VulkanPipelineMultiSampleStateDesc::GetAlphaToOneEnable() const noexcept -> vk::Bool32
+auto VulkanGraphicsPipeline::GetBuilder() const noexcept -> const BulletRT::Core::VulkanGraphicsPipelineBuilder &
 {
-    return m_AlphaToOneEnable;
+    return m_Builder;
 }
 
-auto VulkanPipelineMultiSampleStateDesc::SetAlphaToOneEnable(vk::Bool32 alphaToOneEnable) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+VulkanGraphicsPipeline::VulkanGraphicsPipeline() noexcept
 {
-    m_AlphaToOneEnable = alphaToOneEnable;
-    return *this;
 }
 
-VulkanPipelineColorBlendStateDesc::VulkanPipelineColorBlendStateDesc() noexcept
+VulkanPipelineShaderStageDesc::VulkanPipelineShaderStageDesc() noexcept
 {
 }
 
-VulkanPipelineColorBlendStateDesc::VulkanPipelineColorBlendStateDesc(const BulletRT::Core::VulkanPipelineColorBlendStateDesc &builder) noexcept
+VulkanPipelineShaderStageDesc::VulkanPipelineShaderStageDesc(const BulletRT::Core::VulkanPipelineShaderStageDesc &builder) noexcept
 {
     m_Flags = builder.m_Flags;
-    m_LogicOpEnable = builder.m_LogicOpEnable;
-    m_LogicOp = builder.m_LogicOp;
-    m_Attachments = builder.m_Attachments;
-    m_BlendConstants[0] = builder.m_BlendConstants[0];
-    m_BlendConstants[1] = builder.m_BlendConstants[1];
-    m_BlendConstants[2] = builder.m_BlendConstants[2];
-    m_BlendConstants[3] = builder.m_BlendConstants[3];
+    m_Stage = builder.m_Stage;
+    m_Module = builder.m_Module;
+    m_Name = builder.m_Name;
+    m_SpecializationDesc = builder.m_SpecializationDesc;
+    m_ModuleBuilder = builder.m_ModuleBuilder;
 }
 
-VulkanPipelineColorBlendStateDesc::VulkanPipelineColorBlendStateDesc(BulletRT::Core::VulkanPipelineColorBlendStateDesc &&builder) noexcept
+VulkanPipelineShaderStageDesc::VulkanPipelineShaderStageDesc(BulletRT::Core::VulkanPipelineShaderStageDesc &&builder) noexcept
 {
     m_Flags = std::move(builder.m_Flags);
-    m_LogicOpEnable = std::move(builder.m_LogicOpEnable);
-    m_LogicOp = std::move(builder.m_LogicOp);
-    m_Attachments = std::move(builder.m_Attachments);
-    m_BlendConstants[0] = std::move(builder.m_BlendConstants[0]);
-    m_BlendConstants[1] = std::move(builder.m_BlendConstants[1]);
-    m_BlendConstants[2] = std::move(builder.m_BlendConstants[2]);
-    m_BlendConstants[3] = std::move(builder.m_BlendConstants[3]);
+    m_Stage = std::move(builder.m_Stage);
+    m_Module = builder.m_Module;
+    builder.m_Module = nullptr;
+    m_Name = std::move(builder.m_Name);
+    m_SpecializationDesc = std::move(builder.m_SpecializationDesc);
+    m_ModuleBuilder = std::move(builder.m_ModuleBuilder);
 }
 
-BulletRT::Core::VulkanPipelineColorBlendStateDesc &VulkanPipelineColorBlendStateDesc::operator=(const BulletRT::Core::VulkanPipelineColorBlendStateDesc &builder) noexcept
+BulletRT::Core::VulkanPipelineShaderStageDesc &VulkanPipelineShaderStageDesc::operator=(const BulletRT::Core::VulkanPipelineShaderStageDesc &builder) noexcept
 {
     if (this != &builder)
     {
         m_Flags = builder.m_Flags;
-        m_LogicOpEnable = builder.m_LogicOpEnable;
-        m_LogicOp = builder.m_LogicOp;
-        m_Attachments = builder.m_Attachments;
-        m_BlendConstants[0] = builder.m_BlendConstants[0];
-        m_BlendConstants[1] = builder.m_BlendConstants[1];
-        m_BlendConstants[2] = builder.m_BlendConstants[2];
-        m_BlendConstants[3] = builder.m_BlendConstants[3];
+        m_Stage = builder.m_Stage;
+        m_Module = builder.m_Module;
+        m_Name = builder.m_Name;
+        m_SpecializationDesc = builder.m_SpecializationDesc;
+        m_ModuleBuilder = builder.m_ModuleBuilder;
     }
     return *this;
 }
 
-BulletRT::Core::VulkanPipelineColorBlendStateDesc &VulkanPipelineColorBlendStateDesc::operator=(BulletRT::Core::VulkanPipelineColorBlendStateDesc &&builder) noexcept
+BulletRT::Core::VulkanPipelineShaderStageDesc &VulkanPipelineShaderStageDesc::operator=(BulletRT::Core::VulkanPipelineShaderStageDesc &&builder) noexcept
 {
     if (this != &builder)
     {
         m_Flags = std::move(builder.m_Flags);
-        m_LogicOpEnable = std::move(builder.m_LogicOpEnable);
-        m_LogicOp = std::move(builder.m_LogicOp);
-        m_Attachments = std::move(builder.m_Attachments);
-        m_BlendConstants[0] = std::move(builder.m_BlendConstants[0]);
-        m_BlendConstants[1] = std::move(builder.m_BlendConstants[1]);
-        m_BlendConstants[2] = std::move(builder.m_BlendConstants[2]);
-        m_BlendConstants[3] = std::move(builder.m_BlendConstants[3]);
+        m_Stage = std::move(builder.m_Stage);
+        m_Module = builder.m_Module;
+        builder.m_Module = nullptr;
+        m_Name = std::move(builder.m_Name);
+        m_SpecializationDesc = std::move(builder.m_SpecializationDesc);
+        m_ModuleBuilder = std::move(builder.m_ModuleBuilder);
     }
     return *this;
 }
 
-auto VulkanPipelineColorBlendStateDesc::GetFlags() const noexcept -> vk::PipelineColorBlendStateCreateFlags
+auto VulkanPipelineShaderStageDesc::SetFlags(vk::PipelineShaderStageCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
 {
-    return m_Flags;
+    m_Flags = flags;
+    return *this;
 }
 
-auto VulkanPipelineColorBlendStateDesc::SetFlags(vk::PipelineColorBlendStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::GetFlags() const noexcept -> vk::PipelineShaderStageCreateFlags
 {
-    m_Flags = flags;
-    return *this;
+    return m_Flags;
 }
 
-auto VulkanPipelineColorBlendStateDesc::SetLogicOpEnable(vk::Bool32 logicOpEnable) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::SetStage(vk::ShaderStageFlagBits stage) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
 {
-    m_LogicOpEnable = logicOpEnable;
+    m_Stage = stage;
     return *this;
 }
 
-auto VulkanPipelineColorBlendStateDesc::GetLogicOpEnable() const noexcept -> vk::Bool32
+auto VulkanPipelineShaderStageDesc::GetStage() const noexcept -> vk::ShaderStageFlagBits
 {
-    return m_LogicOpEnable;
+    return m_Stage;
 }
 
-auto VulkanPipelineColorBlendStateDesc::SetAttachmentCount(uint32_t attachmentCount) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::SetModule(const BulletRT::Core::VulkanShaderModule *module) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
 {
-    m_Attachments.resize(attachmentCount);
+    if (m_ModuleBuilder)
+    {
+        m_ModuleBuilder = std::nullopt;
+    }
+    m_Module = module;
     return *this;
 }
 
-auto VulkanPipelineColorBlendStateDesc::GetAttachmentCount() const noexcept -> uint32_t
+auto VulkanPipelineShaderStageDesc::GetModule() const noexcept -> const BulletRT::Core::VulkanShaderModule *
 {
-    return static_cast<uint32_t>(m_Attachments.size());
+    return m_Module;
 }
 
-auto VulkanPipelineColorBlendStateDesc::AddAttachment(const vk::PipelineColorBlendAttachmentState &attachment) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::GetModuleVk() const noexcept -> vk::ShaderModule
 {
-    m_Attachments.push_back(attachment);
-    return *this;
+    return nullptr;
 }
 
-auto VulkanPipelineColorBlendStateDesc::SetAttachment(size_t idx, const vk::PipelineColorBlendAttachmentState &attachment) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::SetName(const std::string &name) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
 {
-    if (idx < m_Attachments.size())
-    {
-        m_Attachments[idx] = attachment;
-    }
+    m_Name = name;
     return *this;
 }
 
-auto VulkanPipelineColorBlendStateDesc::GetAttachment(size_t idx) const -> const vk::PipelineColorBlendAttachmentState &
+auto VulkanPipelineShaderStageDesc::GetName() const noexcept -> std::string
 {
-    return m_Attachments.at(idx);
+    return m_Name;
 }
 
-auto VulkanPipelineColorBlendStateDesc::SetAttachments(const std::vector<vk::PipelineColorBlendAttachmentState> &attachments) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::SetSpecializationDesc(const BulletRT::Core::VulkanSpecializationDesc &specialization) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
 {
-    m_Attachments = attachments;
+    m_SpecializationDesc = specialization;
     return *this;
 }
 
-auto VulkanPipelineColorBlendStateDesc::GetAttachments() const noexcept -> const std::vector<vk::PipelineColorBlendAttachmentState> &
+auto VulkanPipelineShaderStageDesc::GetSpecializationDesc() const noexcept -> const std::optional<VulkanSpecializationDesc> &
 {
-    return m_Attachments;
+    return m_SpecializationDesc;
 }
 
-auto VulkanPipelineColorBlendStateDesc::SetBlendConstants(const std::array<float, 4> &blendConstants) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::SetShaderModuleBuilder(const BulletRT::Core::VulkanShaderModuleBuilder &builder) noexcept -> BulletRT::Core::VulkanPipelineShaderStageDesc &
 {
-    m_BlendConstants[0] = blendConstants[0];
-    m_BlendConstants[1] = blendConstants[1];
-    m_BlendConstants[2] = blendConstants[2];
-    m_BlendConstants[3] = blendConstants[3];
+    if (m_Module)
+    {
+        m_Module = nullptr;
+    }
+    m_ModuleBuilder = builder;
     return *this;
 }
 
-auto VulkanPipelineColorBlendStateDesc::GetBlendConstants() const noexcept -> std::array<float, 4>
+auto VulkanPipelineShaderStageDesc::GetShaderModuleBuilder() const noexcept -> const std::optional<VulkanShaderModuleBuilder> &
 {
-    return std::array<float, 4>{m_BlendConstants[0], m_BlendConstants[1], m_BlendConstants[2], m_BlendConstants[3]};
+    return m_ModuleBuilder;
 }
 
-auto VulkanPipelineColorBlendStateDesc::SetBlendConstant(size_t idx, float blendConstant) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+auto VulkanPipelineShaderStageDesc::GetPipelineShaderStageCreateInfoVk() const noexcept -> vk::PipelineShaderStageCreateInfo
 {
-    if (idx < 4)
-    {
-        m_BlendConstants[idx] = blendConstant;
-    }
-    return *this;
+    return vk::PipelineShaderStageCreateInfo()
+        .setFlags(m_Flags)
+        .setStage(m_Stage)
+        .setModule(GetModuleVk())
+        .setPName(m_Name.data())
+        .setPSpecializationInfo(nullptr);
 }
 
-auto VulkanPipelineColorBlendStateDesc::GetBlendConstant(size_t idx) const -> float
+auto VulkanPipelineShaderStageDesc::GetSpecializationInfoVk() const noexcept -> std::optional<vk::SpecializationInfo>
 {
-    return m_BlendConstants[idx];
+    return m_SpecializationDesc ? std::optional<vk::SpecializationInfo>(m_SpecializationDesc->GetSpecializationInfoVk()) : std::nullopt;
 }
 
-VulkanSubpassDesc::VulkanSubpassDesc() noexcept
+auto VulkanPipelineShaderStageDesc::GetShaderModuleCreateInfoVk() const noexcept -> std::optional<vk::ShaderModuleCreateInfo>
 {
+    return m_ModuleBuilder ? std::optional<vk::ShaderModuleCreateInfo>(m_ModuleBuilder->GetShaderModuleCreateInfoVk()) : std::nullopt;
 }
 
-VulkanSubpassDesc::VulkanSubpassDesc(const BulletRT::Core::VulkanSubpassDesc &builder) noexcept
+VulkanSpecializationDesc::VulkanSpecializationDesc() noexcept
 {
-    m_Flags = builder.m_Flags;
-    m_PipelineBindPoint = builder.m_PipelineBindPoint;
-    m_InputAttachments = builder.m_InputAttachments;
-    m_ColorAttachments = builder.m_ColorAttachments;
-    m_ResolveAttachments = builder.m_ResolveAttachments;
-    m_DepthStencilAttachment = builder.m_DepthStencilAttachment;
-    m_PreserveAttachments = builder.m_PreserveAttachments;
 }
 
-VulkanSubpassDesc::VulkanSubpassDesc(BulletRT::Core::VulkanSubpassDesc &&builder) noexcept
+VulkanSpecializationDesc::VulkanSpecializationDesc(const BulletRT::Core::VulkanSpecializationDesc &builder) noexcept
 {
-    m_Flags = std::move(builder.m_Flags);
-    m_PipelineBindPoint = std::move(builder.m_PipelineBindPoint);
-    m_InputAttachments = std::move(builder.m_InputAttachments);
-    m_ColorAttachments = std::move(builder.m_ColorAttachments);
-    m_ResolveAttachments = std::move(builder.m_ResolveAttachments);
-    m_DepthStencilAttachment = std::move(builder.m_DepthStencilAttachment);
-    m_PreserveAttachments = std::move(builder.m_PreserveAttachments);
+    m_Entries = builder.m_Entries;
+    m_Data = builder.m_Data;
 }
 
-BulletRT::Core::VulkanSubpassDesc &VulkanSubpassDesc::operator=(const BulletRT::Core::VulkanSubpassDesc &builder) noexcept
+VulkanSpecializationDesc::VulkanSpecializationDesc(BulletRT::Core::VulkanSpecializationDesc &&builder) noexcept
+{
+    m_Entries = std::move(builder.m_Entries);
+    m_Data = std::move(builder.m_Data);
+}
+
+BulletRT::Core::VulkanSpecializationDesc &VulkanSpecializationDesc::operator=(const BulletRT::Core::VulkanSpecializationDesc &builder) noexcept
 {
     if (this != &builder)
     {
-
-        m_Flags = builder.m_Flags;
-        m_PipelineBindPoint = builder.m_PipelineBindPoint;
-        m_InputAttachments = builder.m_InputAttachments;
-        m_ColorAttachments = builder.m_ColorAttachments;
-        m_ResolveAttachments = builder.m_ResolveAttachments;
-        m_DepthStencilAttachment = builder.m_DepthStencilAttachment;
-        m_PreserveAttachments = builder.m_PreserveAttachments;
+        m_Entries = builder.m_Entries;
+        m_Data = builder.m_Data;
     }
     return *this;
 }
 
-BulletRT::Core::VulkanSubpassDesc &VulkanSubpassDesc::operator=(BulletRT::Core::VulkanSubpassDesc &&builder) noexcept
+BulletRT::Core::VulkanSpecializationDesc &VulkanSpecializationDesc::operator=(BulletRT::Core::VulkanSpecializationDesc &&builder) noexcept
 {
     if (this != &builder)
     {
-        m_Flags = std::move(builder.m_Flags);
-        m_PipelineBindPoint = std::move(builder.m_PipelineBindPoint);
-        m_InputAttachments = std::move(builder.m_InputAttachments);
-        m_ColorAttachments = std::move(builder.m_ColorAttachments);
-        m_ResolveAttachments = std::move(builder.m_ResolveAttachments);
-        m_DepthStencilAttachment = std::move(builder.m_DepthStencilAttachment);
-        m_PreserveAttachments = std::move(builder.m_PreserveAttachments);
+        m_Entries = std::move(builder.m_Entries);
+        m_Data = std::move(builder.m_Data);
     }
     return *this;
 }
 
-auto VulkanSubpassDesc::GetFlags() const noexcept -> vk::SubpassDescriptionFlags
+auto VulkanSpecializationDesc::SetEntryCount(size_t entryCount) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
 {
-    return m_Flags;
+    m_Entries.resize(entryCount);
+    return *this;
 }
 
-auto VulkanSubpassDesc::SetFlags(vk::SubpassDescriptionFlags flags) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanSpecializationDesc::SetEntries(const std::vector<vk::SpecializationMapEntry> &entries) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
 {
-    m_Flags = flags;
+    m_Entries = entries;
     return *this;
 }
 
-auto VulkanSubpassDesc::SetPipelineBindPoint(vk::PipelineBindPoint pipelineBindPoint) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanSpecializationDesc::AddEntry(const vk::SpecializationMapEntry &entry) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
 {
-    m_PipelineBindPoint = pipelineBindPoint;
+    m_Entries.push_back(entry);
     return *this;
 }
 
-auto VulkanSubpassDesc::GetPipelineBindPoint() const noexcept -> vk::PipelineBindPoint
+auto VulkanSpecializationDesc::SetEntry(size_t idx, const vk::SpecializationMapEntry &entry) noexcept -> BulletRT::Core::VulkanSpecializationDesc &
 {
-    return m_PipelineBindPoint;
+    if (idx < m_Entries.size())
+    {
+        m_Entries[idx] = entry;
+    }
+    return *this;
 }
 
-auto VulkanSubpassDesc::SetInputAttachmentCount(uint32_t inputAttachmentCount) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanSpecializationDesc::GetEntries() const noexcept -> const std::vector<vk::SpecializationMapEntry> &
 {
-    m_InputAttachments.resize(inputAttachmentCount);
-    return *this;
+    return m_Entries;
 }
 
-auto VulkanSubpassDesc::GetInputAttachmentCount() const noexcept -> uint32_t
+auto VulkanSpecializationDesc::GetEntry(size_t idx) const -> const vk::SpecializationMapEntry &
 {
-    return static_cast<uint32_t>(m_InputAttachments.size());
+    return m_Entries.at(idx);
 }
 
-auto VulkanSubpassDesc::GetInputAttachments() const noexcept -> const std::vector<vk::AttachmentReference> &
+auto VulkanSpecializationDesc::GetSpecializationInfoVk() const noexcept -> vk::SpecializationInfo
 {
-    return m_InputAttachments;
+    return vk::SpecializationInfo().setPData(m_Data.data()).setDataSize(m_Data.size()).setMapEntries(m_Entries);
 }
 
-auto VulkanSubpassDesc::SetInputAttachments(const std::vector<vk::AttachmentReference> &attachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+VulkanShaderModuleBuilder::VulkanShaderModuleBuilder() noexcept
 {
-    m_InputAttachments = attachments;
-    return *this;
 }
 
-auto VulkanSubpassDesc::AddInputAttachment(const vk::AttachmentReference &attachmentReference) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+VulkanShaderModuleBuilder::VulkanShaderModuleBuilder(const BulletRT::Core::VulkanShaderModuleBuilder &builder) noexcept
 {
-    m_InputAttachments.push_back(attachmentReference);
-    return *this;
+    m_Flags = builder.m_Flags;
+    m_Codes = builder.m_Codes;
 }
 
-auto VulkanSubpassDesc::SetInputAttachment(size_t idx, const vk::AttachmentReference &attachmentReference) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+VulkanShaderModuleBuilder::VulkanShaderModuleBuilder(BulletRT::Core::VulkanShaderModuleBuilder &&builder) noexcept
 {
-    if (idx < m_InputAttachments.size())
+    m_Flags = std::move(builder.m_Flags);
+    m_Codes = std::move(builder.m_Codes);
+}
+
+BulletRT::Core::VulkanShaderModuleBuilder &VulkanShaderModuleBuilder::operator=(const BulletRT::Core::VulkanShaderModuleBuilder &builder) noexcept
+{
+    if (this != &builder)
     {
-        m_InputAttachments[idx] = attachmentReference;
+        m_Flags = builder.m_Flags;
+        m_Codes = builder.m_Codes;
     }
     return *this;
 }
 
-auto VulkanSubpassDesc::GetInputAttachment(size_t idx) const noexcept -> std::optional<vk::AttachmentReference>
+BulletRT::Core::VulkanShaderModuleBuilder &VulkanShaderModuleBuilder::operator=(BulletRT::Core::VulkanShaderModuleBuilder &&builder) noexcept
 {
-    return m_InputAttachments.size() > idx ? std::optional<vk::AttachmentReference>(m_InputAttachments[idx]) : std::nullopt;
+    if (this != &builder)
+    {
+        m_Flags = std::move(builder.m_Flags);
+        m_Codes = std::move(builder.m_Codes);
+    }
+    return *this;
 }
 
-auto VulkanSubpassDesc::SetColorAttachmentCount(uint32_t colorAttachmentCount) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanShaderModuleBuilder::SetFlags(vk::ShaderModuleCreateFlags flags) noexcept -> BulletRT::Core::VulkanShaderModuleBuilder &
 {
-    m_ColorAttachments.resize(colorAttachmentCount);
-    if (!m_ResolveAttachments.empty()){
-        m_ResolveAttachments.resize(colorAttachmentCount);
-    }
+    m_Flags = flags;
     return *this;
 }
 
-auto VulkanSubpassDesc::GetColorAttachmentCount() const noexcept -> uint32_t
+auto VulkanShaderModuleBuilder::SetCodes(const std::vector<uint32_t> &codes) noexcept -> BulletRT::Core::VulkanShaderModuleBuilder &
 {
-    return static_cast<uint32_t>(m_ColorAttachments.size());
+    m_Codes = codes;
+    return *this;
 }
 
-auto VulkanSubpassDesc::GetColorAttachments() const noexcept -> const std::vector<vk::AttachmentReference> &
+auto VulkanShaderModuleBuilder::GetCodes() const noexcept -> const std::vector<uint32_t> &
 {
-    return m_ColorAttachments;
+    return m_Codes;
 }
 
-auto VulkanSubpassDesc::SetColorAttachments(const std::vector<vk::AttachmentReference> &attachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanShaderModuleBuilder::GetPCode() const noexcept -> const uint32_t *
 {
-    m_ColorAttachments = attachments;
-    return *this;
+    return m_Codes.data();
 }
 
-auto VulkanSubpassDesc::SetResolveAttachments(const std::vector<vk::AttachmentReference> &attachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanShaderModuleBuilder::GetCodeSize() const noexcept -> uint32_t
 {
-    m_ResolveAttachments = attachments;
-    m_ColorAttachments.resize(attachments.size());
-    return *this;
+    return static_cast<uint32_t>(m_Codes.size());
 }
 
-auto VulkanSubpassDesc::GetResolveAttachments() const noexcept -> const std::vector<vk::AttachmentReference> &
+auto VulkanShaderModuleBuilder::GetShaderModuleCreateInfoVk() const noexcept -> vk::ShaderModuleCreateInfo
 {
-    return m_ResolveAttachments;
+    return vk::ShaderModuleCreateInfo().setFlags(m_Flags).setCode(m_Codes);
 }
 
-auto VulkanSubpassDesc::SetResolveEnable(bool resolveEnable) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanShaderModule::New(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanShaderModule::Builder &builder) -> std::unique_ptr<VulkanShaderModule>
 {
-    if (resolveEnable)
+    auto shaderModule = device->GetDeviceVk().createShaderModuleUnique(builder.GetShaderModuleCreateInfoVk());
+    if (shaderModule)
     {
-        m_ResolveAttachments.resize(m_ColorAttachments.size());
-    }
-    else
-    {
-        m_ResolveAttachments = std::vector<vk::AttachmentReference>();
+        auto vulkanShaderModule = std::unique_ptr<VulkanShaderModule>(new VulkanShaderModule());
+        vulkanShaderModule->m_Device = device;
+        vulkanShaderModule->m_ShaderModule = std::move(shaderModule);
+        vulkanShaderModule->m_Flags = builder.GetFlags();
+        vulkanShaderModule->m_Codes = builder.GetCodes();
+        return vulkanShaderModule;
     }
-    return *this;
+    return nullptr;
 }
 
-auto VulkanSubpassDesc::GetResolveEnable() const noexcept -> bool
+VulkanShaderModule::~VulkanShaderModule() noexcept
 {
-    return !m_ResolveAttachments.empty();
+    m_ShaderModule.reset();
 }
 
-auto VulkanSubpassDesc::SetDepthStencilAttachment(const vk::AttachmentReference &attachment) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanShaderModule::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice *
 {
-    m_DepthStencilAttachment = attachment;
-    return *this;
+    return m_Device;
 }
 
-auto VulkanSubpassDesc::GetDepthStencilAttachment() const noexcept -> std::optional<vk::AttachmentReference>
+auto VulkanShaderModule::GetDeviceVk() const noexcept -> vk::Device
 {
-    return m_DepthStencilAttachment;
+    return m_Device ? m_Device->GetDeviceVk() : nullptr;
 }
 
-auto VulkanSubpassDesc::SetPreserveAttachmentCount(uint32_t attachmentCount) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanShaderModule::GetShaderModuleVk() const noexcept -> vk::ShaderModule
 {
-    m_PreserveAttachments.resize(attachmentCount);
-    return *this;
+    return m_ShaderModule.get();
 }
 
-auto VulkanSubpassDesc::GetPreserveAttachmentCount() const noexcept -> uint32_t
+auto VulkanShaderModule::GetFlags() const noexcept -> vk::ShaderModuleCreateFlags
 {
-    return static_cast<uint32_t>(m_PreserveAttachments.size());
+    return m_Flags;
 }
 
-auto VulkanSubpassDesc::SetPreserveAttachments(const std::vector<uint32_t> &preserveAttachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanShaderModule::GetCodes() const noexcept -> const std::vector<uint32_t> &
 {
-    m_PreserveAttachments = preserveAttachments;
+    return m_Codes;
+}
+
+auto VulkanShaderModule::GetPCode() const noexcept -> const uint32_t *
+{
+    return m_Codes.data();
+}
+
+auto VulkanShaderModule::GetCodeSize() const noexcept -> uint32_t
+{
+    return static_cast<uint32_t>(m_Codes.size());
+}
+
+VulkanShaderModule::VulkanShaderModule() noexcept
+{
+}
+
+auto VulkanPipelineTessellationStateDesc::SetFlags(vk::PipelineTessellationStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineTessellationStateDesc &
+{
+    m_Flags = flags;
     return *this;
 }
 
-auto VulkanSubpassDesc::GetPreserveAttachments() const noexcept -> const std::vector<uint32_t> &
+auto VulkanPipelineTessellationStateDesc::GetFlags() const noexcept -> vk::PipelineTessellationStateCreateFlags
 {
-    return m_PreserveAttachments;
+    return m_Flags;
 }
 
-auto VulkanSubpassDesc::AddPreserveAttachment(uint32_t preserveAttachment) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanPipelineTessellationStateDesc::SetPatchControlPoints(uint32_t patchControlPoints) noexcept -> BulletRT::Core::VulkanPipelineTessellationStateDesc &
 {
-    m_PreserveAttachments.push_back(preserveAttachment);
+    m_PatchControlPoints = patchControlPoints;
     return *this;
 }
 
-auto VulkanSubpassDesc::SetPreserveAttachment(uint32_t idx, uint32_t preserveAttachment) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+auto VulkanPipelineTessellationStateDesc::GetPatchControlPoints() const noexcept -> uint32_t
 {
-    if (idx < m_PreserveAttachments.size())
-    {
-        m_PreserveAttachments[idx] = preserveAttachment;
-    }
+    return m_PatchControlPoints;
+}
+
+auto VulkanPipelineTessellationStateDesc::SetDomainOrigin(const vk::TessellationDomainOrigin &origin) noexcept -> BulletRT::Core::VulkanPipelineTessellationStateDesc &
+{
+    m_DomainOrigin = origin;
     return *this;
 }
 
-auto VulkanSubpassDesc::GetPreserveAttachment(uint32_t idx) const noexcept -> std::optional<uint32_t>
+auto VulkanPipelineTessellationStateDesc::GetDomainOrigin() const noexcept -> const std::optional<vk::TessellationDomainOrigin> &
 {
-    return m_PreserveAttachments.at(idx);
+    return m_DomainOrigin;
 }
 
-auto VulkanSubpassDesc::GetSubpassDescriptionVk() const noexcept -> vk::SubpassDescription { 
-    auto subpassDesc = vk::SubpassDescription()
-        .setFlags(m_Flags)
-        .setPipelineBindPoint(m_PipelineBindPoint)
-        .setInputAttachments(m_InputAttachments)
-        .setColorAttachments(m_ColorAttachments)
-        .setPreserveAttachments(m_PreserveAttachments);
-    if (!m_ResolveAttachments.empty())
-    {
-        subpassDesc.setResolveAttachments(m_ResolveAttachments);
-    }
-    if (m_DepthStencilAttachment){
-        subpassDesc.setPDepthStencilAttachment(&m_DepthStencilAttachment.value());
-    }
-    return subpassDesc;
+auto VulkanPipelineTessellationStateDesc::GetPipelineTessellationStateInfoVk() const noexcept -> vk::PipelineTessellationStateCreateInfo
+{
+    return vk::PipelineTessellationStateCreateInfo().setFlags(m_Flags).setPatchControlPoints(m_PatchControlPoints);
 }
 
-auto VulkanSubpassDesc::AddColorAttachment(const vk::AttachmentReference &reference) noexcept -> BulletRT::Core::VulkanSubpassDesc & { 
-    if (!m_ResolveAttachments.empty()){
-        m_ResolveAttachments.resize(m_ColorAttachments.size()+1);
+VulkanPipelineTessellationStateDesc::VulkanPipelineTessellationStateDesc() noexcept
+{
+}
+
+VulkanPipelineTessellationStateDesc::VulkanPipelineTessellationStateDesc(const BulletRT::Core::VulkanPipelineTessellationStateDesc &tessellation) noexcept
+{
+    m_Flags = tessellation.m_Flags;
+    m_DomainOrigin = tessellation.m_DomainOrigin;
+    m_PatchControlPoints = tessellation.m_PatchControlPoints;
+}
+
+VulkanPipelineTessellationStateDesc::VulkanPipelineTessellationStateDesc(BulletRT::Core::VulkanPipelineTessellationStateDesc &&tessellation) noexcept
+{
+    m_Flags = std::move(tessellation.m_Flags);
+    m_DomainOrigin = std::move(tessellation.m_DomainOrigin);
+    m_PatchControlPoints = std::move(tessellation.m_PatchControlPoints);
+}
+
+BulletRT::Core::VulkanPipelineTessellationStateDesc &VulkanPipelineTessellationStateDesc::operator=(const BulletRT::Core::VulkanPipelineTessellationStateDesc &tessellation) noexcept
+{
+    if (this != &tessellation)
+    {
+        m_Flags = tessellation.m_Flags;
+        m_DomainOrigin = tessellation.m_DomainOrigin;
+        m_PatchControlPoints = tessellation.m_PatchControlPoints;
     }
-    m_ColorAttachments.push_back(reference);
     return *this;
 }
 
-auto VulkanSubpassDesc::SetColorAttachment(size_t idx, const vk::AttachmentReference &reference) noexcept -> BulletRT::Core::VulkanSubpassDesc & { 
-    if (m_ColorAttachments.size() > idx){
-        m_ColorAttachments[idx] = reference;
+BulletRT::Core::VulkanPipelineTessellationStateDesc &VulkanPipelineTessellationStateDesc::operator=(BulletRT::Core::VulkanPipelineTessellationStateDesc &&tessellation) noexcept
+{
+    if (this != &tessellation)
+    {
+        m_Flags = std::move(tessellation.m_Flags);
+        m_DomainOrigin = std::move(tessellation.m_DomainOrigin);
+        m_PatchControlPoints = std::move(tessellation.m_PatchControlPoints);
     }
     return *this;
 }
 
-auto VulkanSubpassDesc::GetColorAttachment(size_t idx) const noexcept -> std::optional<vk::AttachmentReference> { 
-    if (m_ColorAttachments.size() > idx){
-        return m_ColorAttachments[idx];
-    }
-    return std::nullopt;
+auto VulkanPipelineViewportStateDesc::SetNegativeOneToOne(vk::Bool32 negativeOneToOne) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_NegativeOneToOne = negativeOneToOne;
+    return *this;
 }
 
+auto VulkanPipelineViewportStateDesc::GetNegativeOneToOne() const noexcept -> std::optional<vk::Bool32>
+{
+    return m_NegativeOneToOne;
+}
 
+auto VulkanPipelineViewportStateDesc::GetPipelineViewportStateCreateInfoVk() const noexcept -> vk::PipelineViewportStateCreateInfo
+{
+    return vk::PipelineViewportStateCreateInfo()
+        .setFlags(m_Flags)
+        .setViewports(m_Viewports)
+        .setScissors(m_Scissors);
+}
 
-VulkanRenderPassBuilder::VulkanRenderPassBuilder() noexcept
+VulkanPipelineViewportStateDesc::VulkanPipelineViewportStateDesc() noexcept
 {
 }
 
-VulkanRenderPassBuilder::VulkanRenderPassBuilder(const BulletRT::Core::VulkanRenderPassBuilder &builder) noexcept
+VulkanPipelineViewportStateDesc::VulkanPipelineViewportStateDesc(const BulletRT::Core::VulkanPipelineViewportStateDesc &builder) noexcept
 {
     m_Flags = builder.m_Flags;
-    m_Attachments = builder.m_Attachments;
-    m_Subpasses = builder.m_Subpasses;
-    m_Dependencies = builder.m_Dependencies;
+    m_Viewports = builder.m_Viewports;
+    m_Scissors = builder.m_Scissors;
+    m_NegativeOneToOne = builder.m_NegativeOneToOne;
 }
 
-VulkanRenderPassBuilder::VulkanRenderPassBuilder(BulletRT::Core::VulkanRenderPassBuilder &&builder) noexcept
+VulkanPipelineViewportStateDesc::VulkanPipelineViewportStateDesc(BulletRT::Core::VulkanPipelineViewportStateDesc &&builder) noexcept
 {
     m_Flags = std::move(builder.m_Flags);
-    m_Attachments = std::move(builder.m_Attachments);
-    m_Subpasses = std::move(builder.m_Subpasses);
-    m_Dependencies = std::move(builder.m_Dependencies);
+    m_Viewports = std::move(builder.m_Viewports);
+    m_Scissors = std::move(builder.m_Scissors);
+    m_NegativeOneToOne = std::move(builder.m_NegativeOneToOne);
 }
 
-BulletRT::Core::VulkanRenderPassBuilder &VulkanRenderPassBuilder::operator=(const BulletRT::Core::VulkanRenderPassBuilder &builder) noexcept
+BulletRT::Core::VulkanPipelineViewportStateDesc &VulkanPipelineViewportStateDesc::operator=(const BulletRT::Core::VulkanPipelineViewportStateDesc &builder) noexcept
 {
     if (this != &builder)
     {
         m_Flags = builder.m_Flags;
-        m_Attachments = builder.m_Attachments;
-        m_Subpasses = builder.m_Subpasses;
-        m_Dependencies = builder.m_Dependencies;
+        m_Viewports = builder.m_Viewports;
+        m_Scissors = builder.m_Scissors;
+        m_NegativeOneToOne = builder.m_NegativeOneToOne;
     }
     return *this;
 }
 
-BulletRT::Core::VulkanRenderPassBuilder &VulkanRenderPassBuilder::operator=(BulletRT::Core::VulkanRenderPassBuilder &&builder) noexcept
+BulletRT::Core::VulkanPipelineViewportStateDesc &VulkanPipelineViewportStateDesc::operator=(BulletRT::Core::VulkanPipelineViewportStateDesc &&builder) noexcept
 {
     if (this != &builder)
     {
         m_Flags = std::move(builder.m_Flags);
-        m_Attachments = std::move(builder.m_Attachments);
-        m_Subpasses = std::move(builder.m_Subpasses);
-        m_Dependencies = std::move(builder.m_Dependencies);
+        m_Viewports = std::move(builder.m_Viewports);
+        m_Scissors = std::move(builder.m_Scissors);
+        m_NegativeOneToOne = std::move(builder.m_NegativeOneToOne);
     }
     return *this;
 }
 
-auto VulkanRenderPassBuilder::GetSubpassDescriptionVks() const noexcept -> std::vector<vk::SubpassDescription> { 
-    std::vector<vk::SubpassDescription> subpassDescs;
-    subpassDescs.reserve(m_Subpasses.size());
-    for (auto& subpass:m_Subpasses){
-        subpassDescs.push_back(subpass.GetSubpassDescriptionVk());
-    }
-    return subpassDescs;
+auto VulkanPipelineViewportStateDesc::SetFlags(vk::PipelineViewportStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_Flags = flags;
+    return *this;
 }
 
-auto VulkanRenderPassBuilder::GetSubpasses() const noexcept -> const std::vector<VulkanSubpassDesc> & { 
-    return m_Subpasses;
+auto VulkanPipelineViewportStateDesc::GetFlags() const noexcept -> vk::PipelineViewportStateCreateFlags
+{
+    return m_Flags;
 }
 
-auto VulkanRenderPassBuilder::SetDependencies(const std::vector<vk::SubpassDependency> &dependencies) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Dependencies = dependencies; return *this;
+auto VulkanPipelineViewportStateDesc::SetViewportCount(uint32_t viewportCount) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_Viewports.resize(viewportCount);
+    return *this;
 }
 
-auto VulkanRenderPassBuilder::GetDependencies() const noexcept -> const std::vector<vk::SubpassDependency> & { 
-    return m_Dependencies;
+auto VulkanPipelineViewportStateDesc::SetViewports(const std::vector<vk::Viewport> &viewports) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_Viewports = viewports;
+    return *this;
 }
 
-auto VulkanRenderPassBuilder::GetFlags() const noexcept -> vk::RenderPassCreateFlags { 
-    return m_Flags;
+auto VulkanPipelineViewportStateDesc::AddViewport(const vk::Viewport &viewport) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_Viewports.push_back(viewport);
+    return *this;
 }
 
-auto VulkanRenderPassBuilder::GetAttachments() const noexcept -> const std::vector<vk::AttachmentDescription> & { 
-    return m_Attachments;
+auto VulkanPipelineViewportStateDesc::SetViewport(size_t idx, const vk::Viewport &viewport) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    if (idx < m_Viewports.size())
+    {
+        m_Viewports[idx] = viewport;
+    }
+    return *this;
 }
 
-auto VulkanRenderPassBuilder::SetFlags(vk::RenderPassCreateFlags flags) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Flags = flags ; return *this;
+auto VulkanPipelineViewportStateDesc::GetViewports() const noexcept -> const std::vector<vk::Viewport> &
+{
+    return m_Viewports;
 }
 
-auto VulkanRenderPassBuilder::SetAttachmentCount(uint32_t attachmentCount) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Attachments.resize(attachmentCount); return *this;
+auto VulkanPipelineViewportStateDesc::GetViewport(size_t idx) const -> const vk::Viewport &
+{
+    return m_Viewports.at(idx);
 }
 
-auto VulkanRenderPassBuilder::GetAttachmentCount() const noexcept -> uint32_t { 
-    return static_cast<uint32_t>(m_Attachments.size());
+auto VulkanPipelineViewportStateDesc::SetScissorCount(uint32_t scissorCount) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_Scissors.resize(scissorCount);
+    return *this;
 }
 
-auto VulkanRenderPassBuilder::SetAttachments(const std::vector<vk::AttachmentDescription> &attachments) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Attachments = attachments; return *this;
+auto VulkanPipelineViewportStateDesc::SetScissors(const std::vector<vk::Rect2D> &scissors) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_Scissors = scissors;
+    return *this;
+}
+
+auto VulkanPipelineViewportStateDesc::AddScissor(const vk::Rect2D &scissor) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    m_Scissors.push_back(scissor);
+    return *this;
+}
+
+auto VulkanPipelineViewportStateDesc::SetScissor(size_t idx, const vk::Rect2D &scissor) noexcept -> BulletRT::Core::VulkanPipelineViewportStateDesc &
+{
+    if (idx < m_Scissors.size())
+    {
+        m_Scissors[idx] = scissor;
+    }
+    return *this;
+}
+
+auto VulkanPipelineViewportStateDesc::GetScissors() const noexcept -> const std::vector<vk::Rect2D> &
+{
+    return m_Scissors;
+}
+
+auto VulkanPipelineViewportStateDesc::GetScissor(size_t idx) const -> const vk::Rect2D &
+{
+    return m_Scissors.at(idx);
+}
+
+VulkanPipelineRasterizationStateDesc::VulkanPipelineRasterizationStateDesc() noexcept {}
+
+VulkanPipelineRasterizationStateDesc::VulkanPipelineRasterizationStateDesc(const BulletRT::Core::VulkanPipelineRasterizationStateDesc &builder) noexcept
+{
+    m_Flags = builder.m_Flags;
+    m_DepthClampEnable = builder.m_DepthClampEnable;
+    m_RasterizerDiscardEnable = builder.m_RasterizerDiscardEnable;
+    m_PolygonMode = builder.m_PolygonMode;
+    m_CullMode = builder.m_CullMode;
+    m_FrontFace = builder.m_FrontFace;
+    m_DepthBiasEnable = builder.m_DepthBiasEnable;
+    m_DepthBiasConstantFactor = builder.m_DepthBiasConstantFactor;
+    m_DepthBiasClamp = builder.m_DepthBiasClamp;
+    m_DepthBiasSlopeFactor = builder.m_DepthBiasSlopeFactor;
+    m_LineWidth = builder.m_LineWidth;
+}
+
+VulkanPipelineRasterizationStateDesc::VulkanPipelineRasterizationStateDesc(BulletRT::Core::VulkanPipelineRasterizationStateDesc &&builder) noexcept
+{
+    m_Flags = std::move(builder.m_Flags);
+    m_DepthClampEnable = std::move(builder.m_DepthClampEnable);
+    m_RasterizerDiscardEnable = std::move(builder.m_RasterizerDiscardEnable);
+    m_PolygonMode = std::move(builder.m_PolygonMode);
+    m_CullMode = std::move(builder.m_CullMode);
+    m_FrontFace = std::move(builder.m_FrontFace);
+    m_DepthBiasEnable = std::move(builder.m_DepthBiasEnable);
+    m_DepthBiasConstantFactor = std::move(builder.m_DepthBiasConstantFactor);
+    m_DepthBiasClamp = std::move(builder.m_DepthBiasClamp);
+    m_DepthBiasSlopeFactor = std::move(builder.m_DepthBiasSlopeFactor);
+    m_LineWidth = std::move(builder.m_LineWidth);
+}
+
+BulletRT::Core::VulkanPipelineRasterizationStateDesc &VulkanPipelineRasterizationStateDesc::operator=(const BulletRT::Core::VulkanPipelineRasterizationStateDesc &builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = builder.m_Flags;
+        m_DepthClampEnable = builder.m_DepthClampEnable;
+        m_RasterizerDiscardEnable = builder.m_RasterizerDiscardEnable;
+        m_PolygonMode = builder.m_PolygonMode;
+        m_CullMode = builder.m_CullMode;
+        m_FrontFace = builder.m_FrontFace;
+        m_DepthBiasEnable = builder.m_DepthBiasEnable;
+        m_DepthBiasConstantFactor = builder.m_DepthBiasConstantFactor;
+        m_DepthBiasClamp = builder.m_DepthBiasClamp;
+        m_DepthBiasSlopeFactor = builder.m_DepthBiasSlopeFactor;
+        m_LineWidth = builder.m_LineWidth;
+    }
+    return *this;
+}
+
+BulletRT::Core::VulkanPipelineRasterizationStateDesc &VulkanPipelineRasterizationStateDesc::operator=(BulletRT::Core::VulkanPipelineRasterizationStateDesc &&builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = std::move(builder.m_Flags);
+        m_DepthClampEnable = std::move(builder.m_DepthClampEnable);
+        m_RasterizerDiscardEnable = std::move(builder.m_RasterizerDiscardEnable);
+        m_PolygonMode = std::move(builder.m_PolygonMode);
+        m_CullMode = std::move(builder.m_CullMode);
+        m_FrontFace = std::move(builder.m_FrontFace);
+        m_DepthBiasEnable = std::move(builder.m_DepthBiasEnable);
+        m_DepthBiasConstantFactor = std::move(builder.m_DepthBiasConstantFactor);
+        m_DepthBiasClamp = std::move(builder.m_DepthBiasClamp);
+        m_DepthBiasSlopeFactor = std::move(builder.m_DepthBiasSlopeFactor);
+        m_LineWidth = std::move(builder.m_LineWidth);
+    }
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetFlags() const noexcept -> vk::PipelineRasterizationStateCreateFlags
+{
+    return m_Flags;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetFlags(vk::PipelineRasterizationStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_Flags = flags;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetDepthClampEnable(vk::Bool32 depthClampEnable) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_DepthBiasClamp = depthClampEnable;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetDepthClampEnable() const noexcept -> vk::Bool32
+{
+    return m_DepthClampEnable;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetRasterizerDiscardEnable(vk::Bool32 rasterizerDiscardEnable) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_RasterizerDiscardEnable = rasterizerDiscardEnable;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetRasterizerDiscardEnable() const noexcept -> vk::Bool32
+{
+    return m_RasterizerDiscardEnable;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetPolygonMode(vk::PolygonMode polygonMode) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_PolygonMode = polygonMode;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetPolygonMode() const noexcept -> vk::PolygonMode
+{
+    return m_PolygonMode;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetCullMode() const noexcept -> vk::CullModeFlags
+{
+    return m_CullMode;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetCullMode(vk::CullModeFlags cullMode) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_CullMode = cullMode;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetFrontFace() const noexcept -> vk::FrontFace
+{
+    return m_FrontFace;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetFrontFace(vk::FrontFace frontFace) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_FrontFace = frontFace;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetDepthBiasEnable(vk::Bool32 depthBiasEnable) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_DepthBiasEnable = depthBiasEnable;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetDepthBiasEnable() const noexcept -> vk::Bool32
+{
+    return m_DepthBiasEnable;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetDepthBiasConstantFactor(float depthBiasConstantFactor) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_DepthBiasConstantFactor = depthBiasConstantFactor;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetDepthBiasConstantFactor() const noexcept -> float
+{
+    return m_DepthBiasConstantFactor;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetDepthBiasClamp(float depthBiasClamp) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_DepthBiasClamp = depthBiasClamp;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetDepthBiasClamp() const noexcept -> float
+{
+    return m_DepthBiasClamp;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetDepthBiasSlopeFactor(float depthBiasSlopeFactor) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_DepthBiasSlopeFactor = depthBiasSlopeFactor;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetDepthBiasSlopeFactor() const noexcept -> float
+{
+    return m_DepthBiasSlopeFactor;
+}
+
+auto VulkanPipelineRasterizationStateDesc::SetLineWidth(float lineWidth) noexcept -> BulletRT::Core::VulkanPipelineRasterizationStateDesc &
+{
+    m_LineWidth = lineWidth;
+    return *this;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetLineWidth() const noexcept -> float
+{
+    return m_LineWidth;
+}
+
+auto VulkanPipelineRasterizationStateDesc::GetPipelineRasterizationStateCreateInfoVk() const noexcept -> vk::PipelineRasterizationStateCreateInfo
+{
+    return vk::PipelineRasterizationStateCreateInfo()
+        .setFlags(m_Flags)
+        .setDepthClampEnable(m_DepthClampEnable)
+        .setRasterizerDiscardEnable(m_RasterizerDiscardEnable)
+        .setPolygonMode(m_PolygonMode)
+        .setCullMode(m_CullMode)
+        .setFrontFace(m_FrontFace)
+        .setDepthBiasEnable(m_DepthBiasEnable)
+        .setDepthBiasConstantFactor(m_DepthBiasConstantFactor)
+        .setDepthBiasClamp(m_DepthBiasClamp)
+        .setDepthBiasSlopeFactor(m_DepthBiasSlopeFactor)
+        .setLineWidth(m_LineWidth);
+}
+
+VulkanPipelineMultiSampleStateDesc::VulkanPipelineMultiSampleStateDesc() noexcept
+{
+}
+
+VulkanPipelineMultiSampleStateDesc::VulkanPipelineMultiSampleStateDesc(const BulletRT::Core::VulkanPipelineMultiSampleStateDesc &builder) noexcept
+{
+    m_Flags = builder.m_Flags;
+    m_RasterizationSamples = builder.m_RasterizationSamples;
+    m_SampleShadingEnable = builder.m_SampleShadingEnable;
+    m_MinSampleShading = builder.m_MinSampleShading;
+    m_SampleMasks = builder.m_SampleMasks;
+    m_AlphaToCoverageEnable = builder.m_AlphaToCoverageEnable;
+    m_AlphaToOneEnable = builder.m_AlphaToOneEnable;
+}
+
+VulkanPipelineMultiSampleStateDesc::VulkanPipelineMultiSampleStateDesc(BulletRT::Core::VulkanPipelineMultiSampleStateDesc &&builder) noexcept
+{
+    m_Flags = std::move(builder.m_Flags);
+    m_RasterizationSamples = std::move(builder.m_RasterizationSamples);
+    m_SampleShadingEnable = std::move(builder.m_SampleShadingEnable);
+    m_MinSampleShading = std::move(builder.m_MinSampleShading);
+    m_SampleMasks = std::move(builder.m_SampleMasks);
+    m_AlphaToCoverageEnable = std::move(builder.m_AlphaToCoverageEnable);
+    m_AlphaToOneEnable = std::move(builder.m_AlphaToOneEnable);
+}
+
+BulletRT::Core::VulkanPipelineMultiSampleStateDesc &VulkanPipelineMultiSampleStateDesc::operator=(const BulletRT::Core::VulkanPipelineMultiSampleStateDesc &builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = builder.m_Flags;
+        m_RasterizationSamples = builder.m_RasterizationSamples;
+        m_SampleShadingEnable = builder.m_SampleShadingEnable;
+        m_MinSampleShading = builder.m_MinSampleShading;
+        m_SampleMasks = builder.m_SampleMasks;
+        m_AlphaToCoverageEnable = builder.m_AlphaToCoverageEnable;
+        m_AlphaToOneEnable = builder.m_AlphaToOneEnable;
+    }
+    return *this;
+}
+
+BulletRT::Core::VulkanPipelineMultiSampleStateDesc &VulkanPipelineMultiSampleStateDesc::operator=(BulletRT::Core::VulkanPipelineMultiSampleStateDesc &&builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = builder.m_Flags;
+        m_RasterizationSamples = builder.m_RasterizationSamples;
+        m_SampleShadingEnable = builder.m_SampleShadingEnable;
+        m_MinSampleShading = builder.m_MinSampleShading;
+        m_SampleMasks = builder.m_SampleMasks;
+        m_AlphaToCoverageEnable = builder.m_AlphaToCoverageEnable;
+        m_AlphaToOneEnable = builder.m_AlphaToOneEnable;
+    }
+    return *this;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::GetFlags() const noexcept -> vk::PipelineMultisampleStateCreateFlags
+{
+    return m_Flags;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::SetFlags(vk::PipelineMultisampleStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+{
+    m_Flags = flags;
+    return *this;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::GetRasterizationSamples() const noexcept -> vk::SampleCountFlagBits
+{
+    return m_RasterizationSamples;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::SetRasterizationSamples(vk::SampleCountFlagBits rasterizationSamples) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+{
+    m_RasterizationSamples = rasterizationSamples;
+    return *this;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::GetSampleShadingEnable() const noexcept -> vk::Bool32
+{
+    return m_SampleShadingEnable;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::SetSampleShadingEnable(vk::Bool32 sampleShadingEnable) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+{
+    m_SampleShadingEnable = sampleShadingEnable;
+    return *this;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::GetMinSampleShading() const noexcept -> float
+{
+    return m_MinSampleShading;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::SetMinSampleShading(float minSampleShading) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+{
+    m_MinSampleShading = minSampleShading;
+    return *this;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::GetAlphaToCoverageEnable() const noexcept -> vk::Bool32
+{
+    return m_AlphaToCoverageEnable;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::SetAlphaToCoverageEnable(vk::Bool32 alphaToCoverageEnable) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+{
+    m_AlphaToCoverageEnable = alphaToCoverageEnable;
+    return *this;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::GetAlphaToOneEnable() const noexcept -> vk::Bool32
+{
+    return m_AlphaToOneEnable;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::SetAlphaToOneEnable(vk::Bool32 alphaToOneEnable) noexcept -> BulletRT::Core::VulkanPipelineMultiSampleStateDesc &
+{
+    m_AlphaToOneEnable = alphaToOneEnable;
+    return *this;
+}
+
+auto VulkanPipelineMultiSampleStateDesc::GetPipelineMultisampleStateCreateInfoVk() const noexcept -> vk::PipelineMultisampleStateCreateInfo
+{
+    return vk::PipelineMultisampleStateCreateInfo()
+        .setFlags(m_Flags)
+        .setRasterizationSamples(m_RasterizationSamples)
+        .setSampleShadingEnable(m_SampleShadingEnable)
+        .setMinSampleShading(m_MinSampleShading)
+        .setPSampleMask(m_SampleMasks.empty() ? nullptr : m_SampleMasks.data())
+        .setAlphaToCoverageEnable(m_AlphaToCoverageEnable)
+        .setAlphaToOneEnable(m_AlphaToOneEnable);
+}
+
+VulkanPipelineColorBlendStateDesc::VulkanPipelineColorBlendStateDesc() noexcept
+{
+}
+
+VulkanPipelineColorBlendStateDesc::VulkanPipelineColorBlendStateDesc(const BulletRT::Core::VulkanPipelineColorBlendStateDesc &builder) noexcept
+{
+    m_Flags = builder.m_Flags;
+    m_LogicOpEnable = builder.m_LogicOpEnable;
+    m_LogicOp = builder.m_LogicOp;
+    m_Attachments = builder.m_Attachments;
+    m_BlendConstants[0] = builder.m_BlendConstants[0];
+    m_BlendConstants[1] = builder.m_BlendConstants[1];
+    m_BlendConstants[2] = builder.m_BlendConstants[2];
+    m_BlendConstants[3] = builder.m_BlendConstants[3];
+}
+
+VulkanPipelineColorBlendStateDesc::VulkanPipelineColorBlendStateDesc(BulletRT::Core::VulkanPipelineColorBlendStateDesc &&builder) noexcept
+{
+    m_Flags = std::move(builder.m_Flags);
+    m_LogicOpEnable = std::move(builder.m_LogicOpEnable);
+    m_LogicOp = std::move(builder.m_LogicOp);
+    m_Attachments = std::move(builder.m_Attachments);
+    m_BlendConstants[0] = std::move(builder.m_BlendConstants[0]);
+    m_BlendConstants[1] = std::move(builder.m_BlendConstants[1]);
+    m_BlendConstants[2] = std::move(builder.m_BlendConstants[2]);
+    m_BlendConstants[3] = std::move(builder.m_BlendConstants[3]);
+}
+
+BulletRT::Core::VulkanPipelineColorBlendStateDesc &VulkanPipelineColorBlendStateDesc::operator=(const BulletRT::Core::VulkanPipelineColorBlendStateDesc &builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = builder.m_Flags;
+        m_LogicOpEnable = builder.m_LogicOpEnable;
+        m_LogicOp = builder.m_LogicOp;
+        m_Attachments = builder.m_Attachments;
+        m_BlendConstants[0] = builder.m_BlendConstants[0];
+        m_BlendConstants[1] = builder.m_BlendConstants[1];
+        m_BlendConstants[2] = builder.m_BlendConstants[2];
+        m_BlendConstants[3] = builder.m_BlendConstants[3];
+    }
+    return *this;
+}
+
+BulletRT::Core::VulkanPipelineColorBlendStateDesc &VulkanPipelineColorBlendStateDesc::operator=(BulletRT::Core::VulkanPipelineColorBlendStateDesc &&builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = std::move(builder.m_Flags);
+        m_LogicOpEnable = std::move(builder.m_LogicOpEnable);
+        m_LogicOp = std::move(builder.m_LogicOp);
+        m_Attachments = std::move(builder.m_Attachments);
+        m_BlendConstants[0] = std::move(builder.m_BlendConstants[0]);
+        m_BlendConstants[1] = std::move(builder.m_BlendConstants[1]);
+        m_BlendConstants[2] = std::move(builder.m_BlendConstants[2]);
+        m_BlendConstants[3] = std::move(builder.m_BlendConstants[3]);
+    }
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetFlags() const noexcept -> vk::PipelineColorBlendStateCreateFlags
+{
+    return m_Flags;
+}
+
+auto VulkanPipelineColorBlendStateDesc::SetFlags(vk::PipelineColorBlendStateCreateFlags flags) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    m_Flags = flags;
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::SetLogicOpEnable(vk::Bool32 logicOpEnable) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    m_LogicOpEnable = logicOpEnable;
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetLogicOpEnable() const noexcept -> vk::Bool32
+{
+    return m_LogicOpEnable;
+}
+
+auto VulkanPipelineColorBlendStateDesc::SetAttachmentCount(uint32_t attachmentCount) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    m_Attachments.resize(attachmentCount);
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetAttachmentCount() const noexcept -> uint32_t
+{
+    return static_cast<uint32_t>(m_Attachments.size());
+}
+
+auto VulkanPipelineColorBlendStateDesc::AddAttachment(const vk::PipelineColorBlendAttachmentState &attachment) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    m_Attachments.push_back(attachment);
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::SetAttachment(size_t idx, const vk::PipelineColorBlendAttachmentState &attachment) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    if (idx < m_Attachments.size())
+    {
+        m_Attachments[idx] = attachment;
+    }
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetAttachment(size_t idx) const -> const vk::PipelineColorBlendAttachmentState &
+{
+    return m_Attachments.at(idx);
+}
+
+auto VulkanPipelineColorBlendStateDesc::SetAttachments(const std::vector<vk::PipelineColorBlendAttachmentState> &attachments) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    m_Attachments = attachments;
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetAttachments() const noexcept -> const std::vector<vk::PipelineColorBlendAttachmentState> &
+{
+    return m_Attachments;
+}
+
+auto VulkanPipelineColorBlendStateDesc::SetBlendConstants(const std::array<float, 4> &blendConstants) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    m_BlendConstants[0] = blendConstants[0];
+    m_BlendConstants[1] = blendConstants[1];
+    m_BlendConstants[2] = blendConstants[2];
+    m_BlendConstants[3] = blendConstants[3];
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetBlendConstants() const noexcept -> std::array<float, 4>
+{
+    return std::array<float, 4>{m_BlendConstants[0], m_BlendConstants[1], m_BlendConstants[2], m_BlendConstants[3]};
+}
+
+auto VulkanPipelineColorBlendStateDesc::SetBlendConstant(size_t idx, float blendConstant) noexcept -> BulletRT::Core::VulkanPipelineColorBlendStateDesc &
+{
+    if (idx < 4)
+    {
+        m_BlendConstants[idx] = blendConstant;
+    }
+    return *this;
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetBlendConstant(size_t idx) const -> float
+{
+    return m_BlendConstants[idx];
+}
+
+auto VulkanPipelineColorBlendStateDesc::GetPipelineColorBlendStateCreateInfoVk() const noexcept -> vk::PipelineColorBlendStateCreateInfo
+{
+    return vk::PipelineColorBlendStateCreateInfo()
+        .setFlags(m_Flags)
+        .setLogicOpEnable(m_LogicOpEnable)
+        .setLogicOp(m_LogicOp)
+        .setAttachments(m_Attachments)
+        .setBlendConstants({m_BlendConstants[0], m_BlendConstants[1], m_BlendConstants[2], m_BlendConstants[3]});
+}
+
+VulkanSubpassDesc::VulkanSubpassDesc() noexcept
+{
+}
+
+VulkanSubpassDesc::VulkanSubpassDesc(const BulletRT::Core::VulkanSubpassDesc &builder) noexcept
+{
+    m_Flags = builder.m_Flags;
+    m_PipelineBindPoint = builder.m_PipelineBindPoint;
+    m_InputAttachments = builder.m_InputAttachments;
+    m_ColorAttachments = builder.m_ColorAttachments;
+    m_ResolveAttachments = builder.m_ResolveAttachments;
+    m_DepthStencilAttachment = builder.m_DepthStencilAttachment;
+    m_PreserveAttachments = builder.m_PreserveAttachments;
+}
+
+VulkanSubpassDesc::VulkanSubpassDesc(BulletRT::Core::VulkanSubpassDesc &&builder) noexcept
+{
+    m_Flags = std::move(builder.m_Flags);
+    m_PipelineBindPoint = std::move(builder.m_PipelineBindPoint);
+    m_InputAttachments = std::move(builder.m_InputAttachments);
+    m_ColorAttachments = std::move(builder.m_ColorAttachments);
+    m_ResolveAttachments = std::move(builder.m_ResolveAttachments);
+    m_DepthStencilAttachment = std::move(builder.m_DepthStencilAttachment);
+    m_PreserveAttachments = std::move(builder.m_PreserveAttachments);
+}
+
+BulletRT::Core::VulkanSubpassDesc &VulkanSubpassDesc::operator=(const BulletRT::Core::VulkanSubpassDesc &builder) noexcept
+{
+    if (this != &builder)
+    {
+
+        m_Flags = builder.m_Flags;
+        m_PipelineBindPoint = builder.m_PipelineBindPoint;
+        m_InputAttachments = builder.m_InputAttachments;
+        m_ColorAttachments = builder.m_ColorAttachments;
+        m_ResolveAttachments = builder.m_ResolveAttachments;
+        m_DepthStencilAttachment = builder.m_DepthStencilAttachment;
+        m_PreserveAttachments = builder.m_PreserveAttachments;
+    }
+    return *this;
+}
+
+BulletRT::Core::VulkanSubpassDesc &VulkanSubpassDesc::operator=(BulletRT::Core::VulkanSubpassDesc &&builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = std::move(builder.m_Flags);
+        m_PipelineBindPoint = std::move(builder.m_PipelineBindPoint);
+        m_InputAttachments = std::move(builder.m_InputAttachments);
+        m_ColorAttachments = std::move(builder.m_ColorAttachments);
+        m_ResolveAttachments = std::move(builder.m_ResolveAttachments);
+        m_DepthStencilAttachment = std::move(builder.m_DepthStencilAttachment);
+        m_PreserveAttachments = std::move(builder.m_PreserveAttachments);
+    }
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetFlags() const noexcept -> vk::SubpassDescriptionFlags
+{
+    return m_Flags;
+}
+
+auto VulkanSubpassDesc::SetFlags(vk::SubpassDescriptionFlags flags) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_Flags = flags;
+    return *this;
+}
+
+auto VulkanSubpassDesc::SetPipelineBindPoint(vk::PipelineBindPoint pipelineBindPoint) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_PipelineBindPoint = pipelineBindPoint;
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetPipelineBindPoint() const noexcept -> vk::PipelineBindPoint
+{
+    return m_PipelineBindPoint;
+}
+
+auto VulkanSubpassDesc::SetInputAttachmentCount(uint32_t inputAttachmentCount) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_InputAttachments.resize(inputAttachmentCount);
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetInputAttachmentCount() const noexcept -> uint32_t
+{
+    return static_cast<uint32_t>(m_InputAttachments.size());
+}
+
+auto VulkanSubpassDesc::GetInputAttachments() const noexcept -> const std::vector<vk::AttachmentReference> &
+{
+    return m_InputAttachments;
+}
+
+auto VulkanSubpassDesc::SetInputAttachments(const std::vector<vk::AttachmentReference> &attachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_InputAttachments = attachments;
+    return *this;
+}
+
+auto VulkanSubpassDesc::AddInputAttachment(const vk::AttachmentReference &attachmentReference) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_InputAttachments.push_back(attachmentReference);
+    return *this;
+}
+
+auto VulkanSubpassDesc::SetInputAttachment(size_t idx, const vk::AttachmentReference &attachmentReference) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    if (idx < m_InputAttachments.size())
+    {
+        m_InputAttachments[idx] = attachmentReference;
+    }
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetInputAttachment(size_t idx) const noexcept -> std::optional<vk::AttachmentReference>
+{
+    return m_InputAttachments.size() > idx ? std::optional<vk::AttachmentReference>(m_InputAttachments[idx]) : std::nullopt;
+}
+
+auto VulkanSubpassDesc::SetColorAttachmentCount(uint32_t colorAttachmentCount) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_ColorAttachments.resize(colorAttachmentCount);
+    if (!m_ResolveAttachments.empty()){
+        m_ResolveAttachments.resize(colorAttachmentCount);
+    }
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetColorAttachmentCount() const noexcept -> uint32_t
+{
+    return static_cast<uint32_t>(m_ColorAttachments.size());
+}
+
+auto VulkanSubpassDesc::GetColorAttachments() const noexcept -> const std::vector<vk::AttachmentReference> &
+{
+    return m_ColorAttachments;
+}
+
+auto VulkanSubpassDesc::SetColorAttachments(const std::vector<vk::AttachmentReference> &attachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_ColorAttachments = attachments;
+    return *this;
+}
+
+auto VulkanSubpassDesc::SetResolveAttachments(const std::vector<vk::AttachmentReference> &attachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_ResolveAttachments = attachments;
+    m_ColorAttachments.resize(attachments.size());
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetResolveAttachments() const noexcept -> const std::vector<vk::AttachmentReference> &
+{
+    return m_ResolveAttachments;
+}
+
+auto VulkanSubpassDesc::SetResolveEnable(bool resolveEnable) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    if (resolveEnable)
+    {
+        m_ResolveAttachments.resize(m_ColorAttachments.size());
+    }
+    else
+    {
+        m_ResolveAttachments = std::vector<vk::AttachmentReference>();
+    }
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetResolveEnable() const noexcept -> bool
+{
+    return !m_ResolveAttachments.empty();
+}
+
+auto VulkanSubpassDesc::SetDepthStencilAttachment(const vk::AttachmentReference &attachment) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_DepthStencilAttachment = attachment;
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetDepthStencilAttachment() const noexcept -> std::optional<vk::AttachmentReference>
+{
+    return m_DepthStencilAttachment;
+}
+
+auto VulkanSubpassDesc::SetPreserveAttachmentCount(uint32_t attachmentCount) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_PreserveAttachments.resize(attachmentCount);
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetPreserveAttachmentCount() const noexcept -> uint32_t
+{
+    return static_cast<uint32_t>(m_PreserveAttachments.size());
+}
+
+auto VulkanSubpassDesc::SetPreserveAttachments(const std::vector<uint32_t> &preserveAttachments) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_PreserveAttachments = preserveAttachments;
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetPreserveAttachments() const noexcept -> const std::vector<uint32_t> &
+{
+    return m_PreserveAttachments;
+}
+
+auto VulkanSubpassDesc::AddPreserveAttachment(uint32_t preserveAttachment) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    m_PreserveAttachments.push_back(preserveAttachment);
+    return *this;
+}
+
+auto VulkanSubpassDesc::SetPreserveAttachment(uint32_t idx, uint32_t preserveAttachment) noexcept -> BulletRT::Core::VulkanSubpassDesc &
+{
+    if (idx < m_PreserveAttachments.size())
+    {
+        m_PreserveAttachments[idx] = preserveAttachment;
+    }
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetPreserveAttachment(uint32_t idx) const noexcept -> std::optional<uint32_t>
+{
+    return m_PreserveAttachments.at(idx);
+}
+
+auto VulkanSubpassDesc::GetSubpassDescriptionVk() const noexcept -> vk::SubpassDescription { 
+    auto subpassDesc = vk::SubpassDescription()
+        .setFlags(m_Flags)
+        .setPipelineBindPoint(m_PipelineBindPoint)
+        .setInputAttachments(m_InputAttachments)
+        .setColorAttachments(m_ColorAttachments)
+        .setPreserveAttachments(m_PreserveAttachments);
+    if (!m_ResolveAttachments.empty())
+    {
+        subpassDesc.setResolveAttachments(m_ResolveAttachments);
+    }
+    if (m_DepthStencilAttachment){
+        subpassDesc.setPDepthStencilAttachment(&m_DepthStencilAttachment.value());
+    }
+    return subpassDesc;
+}
+
+auto VulkanSubpassDesc::AddColorAttachment(const vk::AttachmentReference &reference) noexcept -> BulletRT::Core::VulkanSubpassDesc & { 
+    if (!m_ResolveAttachments.empty()){
+        m_ResolveAttachments.resize(m_ColorAttachments.size()+1);
+    }
+    m_ColorAttachments.push_back(reference);
+    return *this;
+}
+
+auto VulkanSubpassDesc::SetColorAttachment(size_t idx, const vk::AttachmentReference &reference) noexcept -> BulletRT::Core::VulkanSubpassDesc & { 
+    if (m_ColorAttachments.size() > idx){
+        m_ColorAttachments[idx] = reference;
+    }
+    return *this;
+}
+
+auto VulkanSubpassDesc::GetColorAttachment(size_t idx) const noexcept -> std::optional<vk::AttachmentReference> { 
+    if (m_ColorAttachments.size() > idx){
+        return m_ColorAttachments[idx];
+    }
+    return std::nullopt;
+}
+
+
+
+VulkanRenderPassBuilder::VulkanRenderPassBuilder() noexcept
+{
+}
+
+VulkanRenderPassBuilder::VulkanRenderPassBuilder(const BulletRT::Core::VulkanRenderPassBuilder &builder) noexcept
+{
+    m_Flags = builder.m_Flags;
+    m_Attachments = builder.m_Attachments;
+    m_Subpasses = builder.m_Subpasses;
+    m_Dependencies = builder.m_Dependencies;
+}
+
+VulkanRenderPassBuilder::VulkanRenderPassBuilder(BulletRT::Core::VulkanRenderPassBuilder &&builder) noexcept
+{
+    m_Flags = std::move(builder.m_Flags);
+    m_Attachments = std::move(builder.m_Attachments);
+    m_Subpasses = std::move(builder.m_Subpasses);
+    m_Dependencies = std::move(builder.m_Dependencies);
+}
+
+BulletRT::Core::VulkanRenderPassBuilder &VulkanRenderPassBuilder::operator=(const BulletRT::Core::VulkanRenderPassBuilder &builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = builder.m_Flags;
+        m_Attachments = builder.m_Attachments;
+        m_Subpasses = builder.m_Subpasses;
+        m_Dependencies = builder.m_Dependencies;
+    }
+    return *this;
+}
+
+BulletRT::Core::VulkanRenderPassBuilder &VulkanRenderPassBuilder::operator=(BulletRT::Core::VulkanRenderPassBuilder &&builder) noexcept
+{
+    if (this != &builder)
+    {
+        m_Flags = std::move(builder.m_Flags);
+        m_Attachments = std::move(builder.m_Attachments);
+        m_Subpasses = std::move(builder.m_Subpasses);
+        m_Dependencies = std::move(builder.m_Dependencies);
+    }
+    return *this;
+}
+
+auto VulkanRenderPassBuilder::GetSubpassDescriptionVks() const noexcept -> std::vector<vk::SubpassDescription> { 
+    std::vector<vk::SubpassDescription> subpassDescs;
+    subpassDescs.reserve(m_Subpasses.size());
+    for (auto& subpass:m_Subpasses){
+        subpassDescs.push_back(subpass.GetSubpassDescriptionVk());
+    }
+    return subpassDescs;
+}
+
+auto VulkanRenderPassBuilder::GetSubpasses() const noexcept -> const std::vector<VulkanSubpassDesc> & { 
+    return m_Subpasses;
+}
+
+auto VulkanRenderPassBuilder::SetDependencies(const std::vector<vk::SubpassDependency> &dependencies) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Dependencies = dependencies; return *this;
+}
+
+auto VulkanRenderPassBuilder::GetDependencies() const noexcept -> const std::vector<vk::SubpassDependency> & { 
+    return m_Dependencies;
+}
+
+auto VulkanRenderPassBuilder::GetFlags() const noexcept -> vk::RenderPassCreateFlags { 
+    return m_Flags;
+}
+
+auto VulkanRenderPassBuilder::GetAttachments() const noexcept -> const std::vector<vk::AttachmentDescription> & { 
+    return m_Attachments;
+}
+
+auto VulkanRenderPassBuilder::SetFlags(vk::RenderPassCreateFlags flags) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Flags = flags ; return *this;
+}
+
+auto VulkanRenderPassBuilder::SetAttachmentCount(uint32_t attachmentCount) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Attachments.resize(attachmentCount); return *this;
+}
+
+auto VulkanRenderPassBuilder::GetAttachmentCount() const noexcept -> uint32_t { 
+    return static_cast<uint32_t>(m_Attachments.size());
+}
+
+auto VulkanRenderPassBuilder::SetAttachments(const std::vector<vk::AttachmentDescription> &attachments) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Attachments = attachments; return *this;
 }
 
 auto VulkanRenderPassBuilder::AddAttachment(const vk::AttachmentDescription &attachment) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
     m_Attachments.push_back(attachment); return *this;
 }
 
-auto VulkanRenderPassBuilder::SetAttachment(size_t idx, const vk::AttachmentDescription &attachment) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    if (idx < m_Attachments.size()){
-        m_Attachments[idx] = attachment;
+auto VulkanRenderPassBuilder::SetAttachment(size_t idx, const vk::AttachmentDescription &attachment) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    if (idx < m_Attachments.size()){
+        m_Attachments[idx] = attachment;
+    }
+    return *this;
+}
+
+auto VulkanRenderPassBuilder::GetAttachment(size_t idx) const -> std::optional<vk::AttachmentDescription> {
+
+    if (idx < m_Attachments.size()){
+        return m_Attachments[idx];
+    }
+    return std::nullopt;
+}
+
+auto VulkanRenderPassBuilder::SetSubpassCount(uint32_t subpassCount) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Subpasses.resize(subpassCount); return *this;
+}
+
+auto VulkanRenderPassBuilder::GetSubpassCount() const noexcept -> uint32_t { 
+    return static_cast<uint32_t>(m_Subpasses.size());
+}
+
+auto VulkanRenderPassBuilder::SetSubpasses(const std::vector<VulkanSubpassDesc> &subpasses) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Subpasses =subpasses; return *this;
+}
+
+auto VulkanRenderPassBuilder::AddSubpass(const BulletRT::Core::VulkanSubpassDesc &subpass) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Subpasses.push_back(subpass); return *this;
+}
+
+auto VulkanRenderPassBuilder::SetSubpass(size_t idx, const BulletRT::Core::VulkanSubpassDesc &subpass) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    if (idx < m_Subpasses.size()){
+        m_Subpasses[idx] = subpass;
+    }
+    return *this;
+}
+
+auto VulkanRenderPassBuilder::GetSubpass(size_t idx) const noexcept -> std::optional<VulkanSubpassDesc> { 
+    if (idx < m_Subpasses.size()){
+        return m_Subpasses[idx];
+    }else{
+        return std::nullopt;
+    }
+}
+
+auto VulkanRenderPassBuilder::SetDependencyCount(uint32_t dependencyCount) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Dependencies.resize(dependencyCount); return *this;
+}
+
+auto VulkanRenderPassBuilder::GetDependencyCount() const noexcept -> uint32_t { 
+    return static_cast<uint32_t>(m_Dependencies.size());
+}
+
+auto VulkanRenderPassBuilder::AddDependency(const vk::SubpassDependency &dependency) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    m_Dependencies.push_back(dependency); return *this;
+}
+
+auto VulkanRenderPassBuilder::SetDependency(size_t idx, const vk::SubpassDependency &dependency) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
+    if (idx < m_Dependencies.size()){
+        m_Dependencies[idx] = dependency;
+    }
+    return *this;
+}
+
+auto VulkanRenderPassBuilder::GetDependency(size_t idx) const noexcept -> std::optional<vk::SubpassDependency> { 
+    if (idx < m_Dependencies.size()){
+        return m_Dependencies[idx];
+    }else{
+        return std::nullopt;
+    }
+}
+
+auto VulkanRenderPassBuilder::GetSrcSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> { 
+    if (m_Dependencies.size() > subpassDependIdx){
+        if (m_Subpasses.size() > m_Dependencies[subpassDependIdx].srcSubpass){
+            return m_Subpasses[m_Dependencies[subpassDependIdx].srcSubpass];
+        }
+    }
+    return std::nullopt;
+
+}
+
+auto VulkanRenderPassBuilder::GetDstSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> {
+    if (m_Dependencies.size() > subpassDependIdx){
+        if (m_Subpasses.size() > m_Dependencies[subpassDependIdx].dstSubpass){
+            return m_Subpasses[m_Dependencies[subpassDependIdx].dstSubpass];
+        }
+    }
+    return std::nullopt;
+
+}
+
+auto VulkanRenderPassBuilder::GetInputAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+    if (m_Subpasses.size() > subpassIdx){
+        auto& inputAttachments = m_Subpasses[subpassIdx].GetInputAttachments();
+        auto attachs = std::vector<vk::AttachmentDescription>();
+        attachs.reserve(inputAttachments.size());
+        for (auto& attachment:inputAttachments){
+            attachs.push_back(m_Attachments[attachment.attachment]);
+        }
+        return attachs;
+    }
+    return std::vector<vk::AttachmentDescription>();
+}
+
+auto VulkanRenderPassBuilder::GetColorAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+    if (m_Subpasses.size() > subpassIdx){
+        auto& colorAttachments = m_Subpasses[subpassIdx].GetColorAttachments();
+        auto attachs = std::vector<vk::AttachmentDescription>();
+        attachs.reserve(colorAttachments.size());
+        for (auto& attachment:colorAttachments){
+            attachs.push_back(m_Attachments[attachment.attachment]);
+        }
+        return attachs;
+    }
+    return std::vector<vk::AttachmentDescription>();
+}
+
+auto VulkanRenderPassBuilder::GetResolveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+    if (m_Subpasses.size() > subpassIdx){
+        auto& resolveAttachments = m_Subpasses[subpassIdx].GetResolveAttachments();
+        auto attachs = std::vector<vk::AttachmentDescription>();
+        attachs.reserve(resolveAttachments.size());
+        for (auto& attachment:resolveAttachments){
+            attachs.push_back(m_Attachments[attachment.attachment]);
+        }
+        return attachs;
+    }
+    return std::vector<vk::AttachmentDescription>();
+}
+
+auto VulkanRenderPassBuilder::GetDepthStencilAttachment(size_t subpassIdx) const noexcept -> std::optional<vk::AttachmentDescription> {
+    if (m_Subpasses.size() > subpassIdx){
+        auto depthStencilAttachment = m_Subpasses[subpassIdx].GetDepthStencilAttachment();
+        if (depthStencilAttachment){
+            return m_Attachments[depthStencilAttachment->attachment];
+        }
     }
-    return *this;
+    return std::optional<vk::AttachmentDescription>();
 }
 
-auto VulkanRenderPassBuilder::GetAttachment(size_t idx) const -> std::optional<vk::AttachmentDescription> {
+auto VulkanRenderPassBuilder::GetPreserveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+    if (m_Subpasses.size() > subpassIdx){
+        auto preserveAttachments = m_Subpasses[subpassIdx].GetPreserveAttachments();
+        auto attachs = std::vector<vk::AttachmentDescription>();
+        attachs.reserve(preserveAttachments.size());
+        for (auto& attachment:preserveAttachments){
+            attachs.push_back(m_Attachments[attachment]);
+        }
+        return attachs;
+    }
+    return std::vector<vk::AttachmentDescription>();
+}
 
-    if (idx < m_Attachments.size()){
-        return m_Attachments[idx];
+auto VulkanRenderPassBuilder::Build(const BulletRT::Core::VulkanDevice *device) const -> std::unique_ptr<BulletRT::Core::VulkanRenderPass> { 
+    return VulkanRenderPass::New(device, *this);
+}
+
+
+
+
+
+
+
+
+auto VulkanRenderPass::New(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanRenderPassBuilder &builder) -> std::unique_ptr<VulkanRenderPass> { 
+    auto subpassDescriptionVks  = builder.GetSubpassDescriptionVks();
+    auto renderPassCreateInfoVk = vk::RenderPassCreateInfo()
+        .setFlags(builder.GetFlags())
+        .setAttachments(builder.GetAttachments())
+        .setSubpasses(subpassDescriptionVks)
+        .setDependencies(builder.GetDependencies());
+    auto renderPass = device->GetDeviceVk().createRenderPassUnique(
+        renderPassCreateInfoVk
+    );
+    if (renderPass){
+        auto vulkanRenderPass = std::unique_ptr<VulkanRenderPass>(new VulkanRenderPass());
+        vulkanRenderPass->m_Flags = builder.GetFlags();
+        vulkanRenderPass->m_Device= device;
+        vulkanRenderPass->m_RenderPass = std::move(renderPass);
+        vulkanRenderPass->m_Subpasses = builder.GetSubpasses();
+        vulkanRenderPass->m_Dependencies = builder.GetDependencies();
+        vulkanRenderPass->m_Attachments = builder.GetAttachments();
+        return vulkanRenderPass;
     }
-    return std::nullopt;
+    return nullptr;
 }
 
-auto VulkanRenderPassBuilder::SetSubpassCount(uint32_t subpassCount) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Subpasses.resize(subpassCount); return *this;
+VulkanRenderPass::~VulkanRenderPass() noexcept { 
+    m_RenderPass.reset();
 }
 
-auto VulkanRenderPassBuilder::GetSubpassCount() const noexcept -> uint32_t { 
-    return static_cast<uint32_t>(m_Subpasses.size());
+auto VulkanRenderPass::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice * { 
+    return m_Device;
 }
 
-auto VulkanRenderPassBuilder::SetSubpasses(const std::vector<VulkanSubpassDesc> &subpasses) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Subpasses =subpasses; return *this;
+auto VulkanRenderPass::GetDeviceVk() const noexcept -> vk::Device { 
+    return m_Device ? m_Device->GetDeviceVk() : nullptr;
 }
 
-auto VulkanRenderPassBuilder::AddSubpass(const BulletRT::Core::VulkanSubpassDesc &subpass) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Subpasses.push_back(subpass); return *this;
+auto VulkanRenderPass::GetRenderPassVk() const noexcept -> vk::RenderPass { 
+    return m_RenderPass.get();
 }
 
-auto VulkanRenderPassBuilder::SetSubpass(size_t idx, const BulletRT::Core::VulkanSubpassDesc &subpass) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    if (idx < m_Subpasses.size()){
-        m_Subpasses[idx] = subpass;
-    }
-    return *this;
+auto VulkanRenderPass::GetFlags() const noexcept -> vk::RenderPassCreateFlags { 
+    return m_Flags;
 }
 
-auto VulkanRenderPassBuilder::GetSubpass(size_t idx) const noexcept -> std::optional<VulkanSubpassDesc> { 
-    if (idx < m_Subpasses.size()){
-        return m_Subpasses[idx];
-    }else{
-        return std::nullopt;
-    }
+auto VulkanRenderPass::GetAttachmentCount() const noexcept -> uint32_t { 
+    return static_cast<uint32_t>(m_Attachments.size());
 }
 
-auto VulkanRenderPassBuilder::SetDependencyCount(uint32_t dependencyCount) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Dependencies.resize(dependencyCount); return *this;
+auto VulkanRenderPass::GetAttachments() const noexcept -> const std::vector<vk::AttachmentDescription> & {
+    return m_Attachments;
 }
 
-auto VulkanRenderPassBuilder::GetDependencyCount() const noexcept -> uint32_t { 
-    return static_cast<uint32_t>(m_Dependencies.size());
+auto VulkanRenderPass::GetAttachment(size_t idx) const -> std::optional<vk::AttachmentDescription> { 
+    return m_Attachments.size() > idx ? std::optional<vk::AttachmentDescription>(m_Attachments[idx]):std::nullopt;
 }
 
-auto VulkanRenderPassBuilder::AddDependency(const vk::SubpassDependency &dependency) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    m_Dependencies.push_back(dependency); return *this;
+auto VulkanRenderPass::GetSubpassCount() const noexcept -> uint32_t { 
+    return static_cast<uint32_t>(m_Subpasses.size());
 }
 
-auto VulkanRenderPassBuilder::SetDependency(size_t idx, const vk::SubpassDependency &dependency) noexcept -> BulletRT::Core::VulkanRenderPassBuilder & { 
-    if (idx < m_Dependencies.size()){
-        m_Dependencies[idx] = dependency;
-    }
-    return *this;
+auto VulkanRenderPass::GetSubpasses() const noexcept -> const std::vector<VulkanSubpassDesc> & { 
+    return m_Subpasses;
 }
 
-auto VulkanRenderPassBuilder::GetDependency(size_t idx) const noexcept -> std::optional<vk::SubpassDependency> { 
-    if (idx < m_Dependencies.size()){
-        return m_Dependencies[idx];
-    }else{
-        return std::nullopt;
-    }
+auto VulkanRenderPass::GetSubpass(size_t idx) const noexcept -> std::optional<VulkanSubpassDesc> { 
+    return m_Subpasses.size() > idx ? std::optional<VulkanSubpassDesc>(m_Subpasses[idx]):std::nullopt;
 }
 
-auto VulkanRenderPassBuilder::GetSrcSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> { 
+auto VulkanRenderPass::GetDependencyCount() const noexcept -> uint32_t { 
+    return static_cast<uint32_t>(m_Subpasses.size());
+}
+
+auto VulkanRenderPass::GetDependencies() const noexcept -> const std::vector<vk::SubpassDependency> & { 
+    return m_Dependencies;
+}
+
+auto VulkanRenderPass::GetDependency(size_t idx) const noexcept -> std::optional<vk::SubpassDependency> { 
+    return m_Dependencies.size() > idx ? std::optional<vk::SubpassDependency>(m_Dependencies.at(idx)):std::nullopt;
+}
+
+auto VulkanRenderPass::GetSrcSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> { 
     if (m_Dependencies.size() > subpassDependIdx){
         if (m_Subpasses.size() > m_Dependencies[subpassDependIdx].srcSubpass){
             return m_Subpasses[m_Dependencies[subpassDependIdx].srcSubpass];
         }
     }
     return std::nullopt;
-
 }
 
-auto VulkanRenderPassBuilder::GetDstSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> {
+auto VulkanRenderPass::GetDstSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> { 
     if (m_Dependencies.size() > subpassDependIdx){
         if (m_Subpasses.size() > m_Dependencies[subpassDependIdx].dstSubpass){
             return m_Subpasses[m_Dependencies[subpassDependIdx].dstSubpass];
@@ -2812,7 +5235,7 @@ auto VulkanRenderPassBuilder::GetDstSubpass(size_t subpassDependIdx) const -> st
 
 }
 
-auto VulkanRenderPassBuilder::GetInputAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+auto VulkanRenderPass::GetInputAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
     if (m_Subpasses.size() > subpassIdx){
         auto& inputAttachments = m_Subpasses[subpassIdx].GetInputAttachments();
         auto attachs = std::vector<vk::AttachmentDescription>();
@@ -2825,7 +5248,7 @@ auto VulkanRenderPassBuilder::GetInputAttachments(size_t subpassIdx) const noexc
     return std::vector<vk::AttachmentDescription>();
 }
 
-auto VulkanRenderPassBuilder::GetColorAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+auto VulkanRenderPass::GetColorAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
     if (m_Subpasses.size() > subpassIdx){
         auto& colorAttachments = m_Subpasses[subpassIdx].GetColorAttachments();
         auto attachs = std::vector<vk::AttachmentDescription>();
@@ -2838,7 +5261,7 @@ auto VulkanRenderPassBuilder::GetColorAttachments(size_t subpassIdx) const noexc
     return std::vector<vk::AttachmentDescription>();
 }
 
-auto VulkanRenderPassBuilder::GetResolveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+auto VulkanRenderPass::GetResolveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
     if (m_Subpasses.size() > subpassIdx){
         auto& resolveAttachments = m_Subpasses[subpassIdx].GetResolveAttachments();
         auto attachs = std::vector<vk::AttachmentDescription>();
@@ -2851,7 +5274,7 @@ auto VulkanRenderPassBuilder::GetResolveAttachments(size_t subpassIdx) const noe
     return std::vector<vk::AttachmentDescription>();
 }
 
-auto VulkanRenderPassBuilder::GetDepthStencilAttachment(size_t subpassIdx) const noexcept -> std::optional<vk::AttachmentDescription> {
+auto VulkanRenderPass::GetDepthStencilAttachment(size_t subpassIdx) const noexcept -> std::optional<vk::AttachmentDescription> { 
     if (m_Subpasses.size() > subpassIdx){
         auto depthStencilAttachment = m_Subpasses[subpassIdx].GetDepthStencilAttachment();
         if (depthStencilAttachment){
@@ -2861,7 +5284,7 @@ auto VulkanRenderPassBuilder::GetDepthStencilAttachment(size_t subpassIdx) const
     return std::optional<vk::AttachmentDescription>();
 }
 
-auto VulkanRenderPassBuilder::GetPreserveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> {
+auto VulkanRenderPass::GetPreserveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
     if (m_Subpasses.size() > subpassIdx){
         auto preserveAttachments = m_Subpasses[subpassIdx].GetPreserveAttachments();
         auto attachs = std::vector<vk::AttachmentDescription>();
@@ -2874,178 +5297,598 @@ auto VulkanRenderPassBuilder::GetPreserveAttachments(size_t subpassIdx) const no
     return std::vector<vk::AttachmentDescription>();
 }
 
-auto VulkanRenderPassBuilder::Build(const BulletRT::Core::VulkanDevice *device) const -> std::unique_ptr<BulletRT::Core::VulkanRenderPass> { 
-    return VulkanRenderPass::New(device, *this);
+
+VulkanRenderPass::VulkanRenderPass() noexcept { 
+    
+}
+
+auto VulkanRayTracingShaderGroupDesc::General(uint32_t generalShader) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc
+{
+    return VulkanRayTracingShaderGroupDesc()
+        .SetType(vk::RayTracingShaderGroupTypeKHR::eGeneral)
+        .SetGeneralShader(generalShader);
+}
+
+auto VulkanRayTracingShaderGroupDesc::TrianglesHit(uint32_t closestHitShader, uint32_t anyHitShader) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc
+{
+    return VulkanRayTracingShaderGroupDesc()
+        .SetType(vk::RayTracingShaderGroupTypeKHR::eTrianglesHitGroup)
+        .SetClosestHitShader(closestHitShader)
+        .SetAnyHitShader(anyHitShader);
+}
+
+auto VulkanRayTracingShaderGroupDesc::ProceduralHit(uint32_t intersectionShader, uint32_t closestHitShader, uint32_t anyHitShader) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc
+{
+    return VulkanRayTracingShaderGroupDesc()
+        .SetType(vk::RayTracingShaderGroupTypeKHR::eProceduralHitGroup)
+        .SetIntersectionShader(intersectionShader)
+        .SetClosestHitShader(closestHitShader)
+        .SetAnyHitShader(anyHitShader);
+}
+
+auto VulkanRayTracingShaderGroupDesc::SetType(vk::RayTracingShaderGroupTypeKHR type) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc &
+{
+    m_Type = type;
+    return *this;
+}
+
+auto VulkanRayTracingShaderGroupDesc::GetType() const noexcept -> vk::RayTracingShaderGroupTypeKHR
+{
+    return m_Type;
+}
+
+auto VulkanRayTracingShaderGroupDesc::SetGeneralShader(uint32_t generalShader) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc &
+{
+    m_GeneralShader = generalShader;
+    return *this;
+}
+
+auto VulkanRayTracingShaderGroupDesc::GetGeneralShader() const noexcept -> uint32_t
+{
+    return m_GeneralShader;
+}
+
+auto VulkanRayTracingShaderGroupDesc::SetClosestHitShader(uint32_t closestHitShader) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc &
+{
+    m_ClosestHitShader = closestHitShader;
+    return *this;
+}
+
+auto VulkanRayTracingShaderGroupDesc::GetClosestHitShader() const noexcept -> uint32_t
+{
+    return m_ClosestHitShader;
+}
+
+auto VulkanRayTracingShaderGroupDesc::SetAnyHitShader(uint32_t anyHitShader) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc &
+{
+    m_AnyHitShader = anyHitShader;
+    return *this;
+}
+
+auto VulkanRayTracingShaderGroupDesc::GetAnyHitShader() const noexcept -> uint32_t
+{
+    return m_AnyHitShader;
+}
+
+auto VulkanRayTracingShaderGroupDesc::SetIntersectionShader(uint32_t intersectionShader) noexcept -> BulletRT::Core::VulkanRayTracingShaderGroupDesc &
+{
+    m_IntersectionShader = intersectionShader;
+    return *this;
+}
+
+auto VulkanRayTracingShaderGroupDesc::GetIntersectionShader() const noexcept -> uint32_t
+{
+    return m_IntersectionShader;
+}
+
+auto VulkanRayTracingShaderGroupDesc::GetRayTracingShaderGroupCreateInfoVk() const noexcept -> vk::RayTracingShaderGroupCreateInfoKHR
+{
+    return vk::RayTracingShaderGroupCreateInfoKHR()
+        .setType(m_Type)
+        .setGeneralShader(m_GeneralShader)
+        .setClosestHitShader(m_ClosestHitShader)
+        .setAnyHitShader(m_AnyHitShader)
+        .setIntersectionShader(m_IntersectionShader);
+}
+
+auto VulkanRayTracingPipelineBuilder::SetFlags(vk::PipelineCreateFlags flags) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Flags = flags;
+    return *this;
+}
+
+auto VulkanRayTracingPipelineBuilder::GetFlags() const noexcept -> vk::PipelineCreateFlags
+{
+    return m_Flags;
+}
+
+auto VulkanRayTracingPipelineBuilder::SetStages(const std::vector<VulkanPipelineShaderStageDesc> &stages) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Stages = stages;
+    return *this;
+}
+
+auto VulkanRayTracingPipelineBuilder::AddStage(const BulletRT::Core::VulkanPipelineShaderStageDesc &stage) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Stages.push_back(stage);
+    return *this;
+}
+
+auto VulkanRayTracingPipelineBuilder::GetStages() const noexcept -> const std::vector<VulkanPipelineShaderStageDesc> &
+{
+    return m_Stages;
+}
+
+auto VulkanRayTracingPipelineBuilder::GetStage(size_t idx) const -> const BulletRT::Core::VulkanPipelineShaderStageDesc &
+{
+    return m_Stages.at(idx);
+}
+
+auto VulkanRayTracingPipelineBuilder::SetGroups(const std::vector<VulkanRayTracingShaderGroupDesc> &groups) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Groups = groups;
+    return *this;
+}
+
+auto VulkanRayTracingPipelineBuilder::AddGroup(const BulletRT::Core::VulkanRayTracingShaderGroupDesc &group) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Groups.push_back(group);
+    return *this;
+}
+
+auto VulkanRayTracingPipelineBuilder::GetGroups() const noexcept -> const std::vector<VulkanRayTracingShaderGroupDesc> &
+{
+    return m_Groups;
+}
+
+auto VulkanRayTracingPipelineBuilder::GetGroup(size_t idx) const -> const BulletRT::Core::VulkanRayTracingShaderGroupDesc &
+{
+    return m_Groups.at(idx);
+}
+
+auto VulkanRayTracingPipelineBuilder::SetMaxRecursionDepth(uint32_t maxRecursionDepth) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_MaxRecursionDepth = maxRecursionDepth;
+    return *this;
+}
+
+auto VulkanRayTracingPipelineBuilder::GetMaxRecursionDepth() const noexcept -> uint32_t
+{
+    return m_MaxRecursionDepth;
+}
+
+auto VulkanRayTracingPipelineBuilder::SetLayout(const BulletRT::Core::VulkanPipelineLayout *layout) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Layout = layout;
+    return *this;
+}
+
+auto VulkanRayTracingPipelineBuilder::GetLayout() const noexcept -> const BulletRT::Core::VulkanPipelineLayout *
+{
+    return m_Layout;
+}
+
+auto VulkanRayTracingPipelineBuilder::SetLibraries(const std::vector<const VulkanRayTracingPipeline *> &libraries) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Libraries = libraries;
+    return *this;
 }
 
+auto VulkanRayTracingPipelineBuilder::AddLibrary(const BulletRT::Core::VulkanRayTracingPipeline *library) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_Libraries.push_back(library);
+    return *this;
+}
 
+auto VulkanRayTracingPipelineBuilder::GetLibraries() const noexcept -> const std::vector<const VulkanRayTracingPipeline *> &
+{
+    return m_Libraries;
+}
 
+auto VulkanRayTracingPipelineBuilder::SetLibraryInterface(uint32_t maxPipelineRayPayloadSize, uint32_t maxPipelineRayHitAttributeSize) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_LibraryInterface = vk::RayTracingPipelineInterfaceCreateInfoKHR()
+                             .setMaxPipelineRayPayloadSize(maxPipelineRayPayloadSize)
+                             .setMaxPipelineRayHitAttributeSize(maxPipelineRayHitAttributeSize);
+    return *this;
+}
 
+auto VulkanRayTracingPipelineBuilder::GetLibraryInterface() const noexcept -> const std::optional<vk::RayTracingPipelineInterfaceCreateInfoKHR> &
+{
+    return m_LibraryInterface;
+}
 
+auto VulkanRayTracingPipelineBuilder::SetPipelineCache(const BulletRT::Core::VulkanPipelineCache *pipelineCache) noexcept -> BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    m_PipelineCache = pipelineCache;
+    return *this;
+}
 
+auto VulkanRayTracingPipelineBuilder::GetPipelineCache() const noexcept -> const BulletRT::Core::VulkanPipelineCache *
+{
+    return m_PipelineCache;
+}
 
+auto VulkanRayTracingPipelineBuilder::Build(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanDeferredOperation *deferredOperation) const -> std::unique_ptr<VulkanRayTracingPipeline>
+{
+    return VulkanRayTracingPipeline::New(device, *this, deferredOperation);
+}
 
-auto VulkanRenderPass::New(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanRenderPassBuilder &builder) -> std::unique_ptr<VulkanRenderPass> { 
-    auto subpassDescriptionVks  = builder.GetSubpassDescriptionVks();
-    auto renderPassCreateInfoVk = vk::RenderPassCreateInfo()
-        .setFlags(builder.GetFlags())
-        .setAttachments(builder.GetAttachments())
-        .setSubpasses(subpassDescriptionVks)
-        .setDependencies(builder.GetDependencies());
-    auto renderPass = device->GetDeviceVk().createRenderPassUnique(
-        renderPassCreateInfoVk
-    );
-    if (renderPass){
-        auto vulkanRenderPass = std::unique_ptr<VulkanRenderPass>(new VulkanRenderPass());
-        vulkanRenderPass->m_Flags = builder.GetFlags();
-        vulkanRenderPass->m_Device= device;
-        vulkanRenderPass->m_RenderPass = std::move(renderPass);
-        vulkanRenderPass->m_Subpasses = builder.GetSubpasses();
-        vulkanRenderPass->m_Dependencies = builder.GetDependencies();
-        vulkanRenderPass->m_Attachments = builder.GetAttachments();
-        return vulkanRenderPass;
+auto VulkanRayTracingPipeline::New(const BulletRT::Core::VulkanDevice *device, const BulletRT::Core::VulkanRayTracingPipelineBuilder &builder, const BulletRT::Core::VulkanDeferredOperation *deferredOperation) -> std::unique_ptr<VulkanRayTracingPipeline>
+{
+    if (!device || !device->SupportExtension(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME) || !builder.GetLayout())
+    {
+        return nullptr;
     }
-    return nullptr;
+    auto isLibrary = static_cast<bool>(builder.GetFlags() & vk::PipelineCreateFlagBits::eLibraryKHR);
+    if ((isLibrary || !builder.GetLibraries().empty()) &&
+        (!device->SupportExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) || !builder.GetLibraryInterface()))
+    {
+        return nullptr;
+    }
+    auto libraries = std::vector<vk::Pipeline>();
+    auto groupCount = static_cast<uint32_t>(builder.GetGroups().size());
+    for (auto &library : builder.GetLibraries())
+    {
+        if (!library || !library->IsLibrary())
+        {
+            return nullptr;
+        }
+        libraries.push_back(library->GetPipelineVk());
+        groupCount += library->GetGroupCount();
+    }
+    if (groupCount == 0)
+    {
+        return nullptr;
+    }
+    auto stageCount = static_cast<uint32_t>(builder.GetStages().size());
+    auto isValidShader = [stageCount](uint32_t shader) { return shader == VK_SHADER_UNUSED_KHR || shader < stageCount; };
+    auto groupInfos = std::vector<vk::RayTracingShaderGroupCreateInfoKHR>();
+    groupInfos.reserve(builder.GetGroups().size());
+    for (auto &group : builder.GetGroups())
+    {
+        if (!isValidShader(group.GetGeneralShader()) || !isValidShader(group.GetClosestHitShader()) ||
+            !isValidShader(group.GetAnyHitShader()) || !isValidShader(group.GetIntersectionShader()))
+        {
+            return nullptr;
+        }
+        groupInfos.push_back(group.GetRayTracingShaderGroupCreateInfoVk());
+    }
+    auto properties = device->GetPhysicalDeviceVk().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceRayTracingPipelinePropertiesKHR>().get<vk::PhysicalDeviceRayTracingPipelinePropertiesKHR>();
+    auto specializationInfos = std::vector<vk::SpecializationInfo>();
+    auto temporaryModules = std::vector<std::unique_ptr<VulkanShaderModule>>();
+    auto stageInfos = GetPipelineShaderStageCreateInfoVks(device, builder.GetStages(), specializationInfos, temporaryModules);
+    if (!stageInfos)
+    {
+        return nullptr;
+    }
+    auto createInfo = vk::RayTracingPipelineCreateInfoKHR()
+                          .setFlags(builder.GetFlags())
+                          .setStages(stageInfos.value())
+                          .setGroups(groupInfos)
+                          .setMaxPipelineRayRecursionDepth(std::min(builder.GetMaxRecursionDepth(), properties.maxRayRecursionDepth))
+                          .setLayout(builder.GetLayout()->GetPipelineLayoutVk());
+    auto libraryInfo = vk::PipelineLibraryCreateInfoKHR().setLibraries(libraries);
+    if (!libraries.empty())
+    {
+        createInfo.setPLibraryInfo(&libraryInfo);
+    }
+    if (builder.GetLibraryInterface())
+    {
+        createInfo.setPLibraryInterface(&builder.GetLibraryInterface().value());
+    }
+    auto pipelineCache = builder.GetPipelineCache() ? builder.GetPipelineCache() : device->GetPipelineCache();
+    auto pipelineCacheVk = pipelineCache ? pipelineCache->GetPipelineCacheVk() : vk::PipelineCache();
+    auto deferredOperationVk = deferredOperation ? deferredOperation->GetDeferredOperationVk() : vk::DeferredOperationKHR();
+    // The pipeline handle is only written once a deferred operation completes, so the raw entry point is used
+    // and the handle is wrapped afterwards.
+    auto pipelineVk = vk::Pipeline();
+    auto res = device->GetDeviceVk().createRayTracingPipelinesKHR(deferredOperationVk, pipelineCacheVk, 1, &createInfo, nullptr, &pipelineVk);
+    if (res == vk::Result::eOperationDeferredKHR)
+    {
+        res = deferredOperation->JoinAll();
+    }
+    if ((res != vk::Result::eSuccess && res != vk::Result::eOperationNotDeferredKHR) || !pipelineVk)
+    {
+        return nullptr;
+    }
+    auto vulkanPipeline = std::unique_ptr<VulkanRayTracingPipeline>(new VulkanRayTracingPipeline());
+    vulkanPipeline->m_Device = device;
+    vulkanPipeline->m_Pipeline = vk::UniquePipeline(pipelineVk, vk::ObjectDestroy<vk::Device, VULKAN_HPP_DEFAULT_DISPATCHER_TYPE>(device->GetDeviceVk()));
+    vulkanPipeline->m_Builder = builder;
+    vulkanPipeline->m_GroupCount = groupCount;
+    vulkanPipeline->m_ShaderGroupHandleSize = properties.shaderGroupHandleSize;
+    // Group handles cannot be queried from libraries; they are read from the linked pipeline instead.
+    if (!isLibrary)
+    {
+        vulkanPipeline->m_ShaderGroupHandles = device->GetDeviceVk().getRayTracingShaderGroupHandlesKHR<uint8_t>(
+            vulkanPipeline->m_Pipeline.get(), 0, groupCount, static_cast<size_t>(groupCount) * properties.shaderGroupHandleSize);
+    }
+    return vulkanPipeline;
 }
 
-VulkanRenderPass::~VulkanRenderPass() noexcept { 
-    m_RenderPass.reset();
+VulkanRayTracingPipeline::~VulkanRayTracingPipeline() noexcept
+{
+    m_Pipeline.reset();
 }
 
-auto VulkanRenderPass::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice * { 
+auto VulkanRayTracingPipeline::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice *
+{
     return m_Device;
 }
 
-auto VulkanRenderPass::GetDeviceVk() const noexcept -> vk::Device { 
+auto VulkanRayTracingPipeline::GetDeviceVk() const noexcept -> vk::Device
+{
     return m_Device ? m_Device->GetDeviceVk() : nullptr;
 }
 
-auto VulkanRenderPass::GetRenderPassVk() const noexcept -> vk::RenderPass { 
-    return m_RenderPass.get();
+auto VulkanRayTracingPipeline::GetPipelineVk() const noexcept -> vk::Pipeline
+{
+    return m_Pipeline.get();
 }
 
-auto VulkanRenderPass::GetFlags() const noexcept -> vk::RenderPassCreateFlags { 
-    return m_Flags;
+auto VulkanRayTracingPipeline::GetLayout() const noexcept -> const BulletRT::Core::VulkanPipelineLayout *
+{
+    return m_Builder.GetLayout();
 }
 
-auto VulkanRenderPass::GetAttachmentCount() const noexcept -> uint32_t { 
-    return static_cast<uint32_t>(m_Attachments.size());
+auto VulkanRayTracingPipeline::GetBuilder() const noexcept -> const BulletRT::Core::VulkanRayTracingPipelineBuilder &
+{
+    return m_Builder;
 }
 
-auto VulkanRenderPass::GetAttachments() const noexcept -> const std::vector<vk::AttachmentDescription> & {
-    return m_Attachments;
+bool VulkanRayTracingPipeline::IsLibrary() const noexcept
+{
+    return static_cast<bool>(m_Builder.GetFlags() & vk::PipelineCreateFlagBits::eLibraryKHR);
 }
 
-auto VulkanRenderPass::GetAttachment(size_t idx) const -> std::optional<vk::AttachmentDescription> { 
-    return m_Attachments.size() > idx ? std::optional<vk::AttachmentDescription>(m_Attachments[idx]):std::nullopt;
+auto VulkanRayTracingPipeline::GetGroupCount() const noexcept -> uint32_t
+{
+    return m_GroupCount;
 }
 
-auto VulkanRenderPass::GetSubpassCount() const noexcept -> uint32_t { 
-    return static_cast<uint32_t>(m_Subpasses.size());
+auto VulkanRayTracingPipeline::GetShaderGroupHandleSize() const noexcept -> uint32_t
+{
+    return m_ShaderGroupHandleSize;
 }
 
-auto VulkanRenderPass::GetSubpasses() const noexcept -> const std::vector<VulkanSubpassDesc> & { 
-    return m_Subpasses;
+auto VulkanRayTracingPipeline::GetShaderGroupHandle(uint32_t idx) const noexcept -> const uint8_t *
+{
+    if (idx >= m_GroupCount || m_ShaderGroupHandles.empty())
+    {
+        return nullptr;
+    }
+    return m_ShaderGroupHandles.data() + static_cast<size_t>(idx) * m_ShaderGroupHandleSize;
 }
 
-auto VulkanRenderPass::GetSubpass(size_t idx) const noexcept -> std::optional<VulkanSubpassDesc> { 
-    return m_Subpasses.size() > idx ? std::optional<VulkanSubpassDesc>(m_Subpasses[idx]):std::nullopt;
+VulkanRayTracingPipeline::VulkanRayTracingPipeline() noexcept
+{
 }
 
-auto VulkanRenderPass::GetDependencyCount() const noexcept -> uint32_t { 
-    return static_cast<uint32_t>(m_Subpasses.size());
+auto VulkanShaderBindingTableBuilder::SetRaygenRecord(uint32_t groupIndex, const std::vector<uint8_t> &data) noexcept -> BulletRT::Core::VulkanShaderBindingTableBuilder &
+{
+    m_RaygenRecords.clear();
+    m_RaygenRecords.emplace_back(groupIndex, data);
+    return *this;
 }
 
-auto VulkanRenderPass::GetDependencies() const noexcept -> const std::vector<vk::SubpassDependency> & { 
-    return m_Dependencies;
+auto VulkanShaderBindingTableBuilder::AddMissRecord(uint32_t groupIndex, const std::vector<uint8_t> &data) noexcept -> BulletRT::Core::VulkanShaderBindingTableBuilder &
+{
+    m_MissRecords.emplace_back(groupIndex, data);
+    return *this;
 }
 
-auto VulkanRenderPass::GetDependency(size_t idx) const noexcept -> std::optional<vk::SubpassDependency> { 
-    return m_Dependencies.size() > idx ? std::optional<vk::SubpassDependency>(m_Dependencies.at(idx)):std::nullopt;
+auto VulkanShaderBindingTableBuilder::AddHitRecord(uint32_t groupIndex, const std::vector<uint8_t> &data) noexcept -> BulletRT::Core::VulkanShaderBindingTableBuilder &
+{
+    m_HitRecords.emplace_back(groupIndex, data);
+    return *this;
 }
 
-auto VulkanRenderPass::GetSrcSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> { 
-    if (m_Dependencies.size() > subpassDependIdx){
-        if (m_Subpasses.size() > m_Dependencies[subpassDependIdx].srcSubpass){
-            return m_Subpasses[m_Dependencies[subpassDependIdx].srcSubpass];
-        }
-    }
-    return std::nullopt;
+auto VulkanShaderBindingTableBuilder::AddCallableRecord(uint32_t groupIndex, const std::vector<uint8_t> &data) noexcept -> BulletRT::Core::VulkanShaderBindingTableBuilder &
+{
+    m_CallableRecords.emplace_back(groupIndex, data);
+    return *this;
 }
 
-auto VulkanRenderPass::GetDstSubpass(size_t subpassDependIdx) const -> std::optional<VulkanSubpassDesc> { 
-    if (m_Dependencies.size() > subpassDependIdx){
-        if (m_Subpasses.size() > m_Dependencies[subpassDependIdx].dstSubpass){
-            return m_Subpasses[m_Dependencies[subpassDependIdx].dstSubpass];
-        }
-    }
-    return std::nullopt;
+auto VulkanShaderBindingTableBuilder::GetRaygenRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &
+{
+    return m_RaygenRecords;
+}
 
+auto VulkanShaderBindingTableBuilder::GetMissRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &
+{
+    return m_MissRecords;
 }
 
-auto VulkanRenderPass::GetInputAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
-    if (m_Subpasses.size() > subpassIdx){
-        auto& inputAttachments = m_Subpasses[subpassIdx].GetInputAttachments();
-        auto attachs = std::vector<vk::AttachmentDescription>();
-        attachs.reserve(inputAttachments.size());
-        for (auto& attachment:inputAttachments){
-            attachs.push_back(m_Attachments[attachment.attachment]);
-        }
-        return attachs;
-    }
-    return std::vector<vk::AttachmentDescription>();
+auto VulkanShaderBindingTableBuilder::GetHitRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &
+{
+    return m_HitRecords;
 }
 
-auto VulkanRenderPass::GetColorAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
-    if (m_Subpasses.size() > subpassIdx){
-        auto& colorAttachments = m_Subpasses[subpassIdx].GetColorAttachments();
-        auto attachs = std::vector<vk::AttachmentDescription>();
-        attachs.reserve(colorAttachments.size());
-        for (auto& attachment:colorAttachments){
-            attachs.push_back(m_Attachments[attachment.attachment]);
+auto VulkanShaderBindingTableBuilder::GetCallableRecords() const noexcept -> const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> &
+{
+    return m_CallableRecords;
+}
+
+auto VulkanShaderBindingTableBuilder::Build(const BulletRT::Core::VulkanRayTracingPipeline *pipeline) const -> std::unique_ptr<VulkanShaderBindingTable>
+{
+    return VulkanShaderBindingTable::New(pipeline, *this);
+}
+
+auto VulkanShaderBindingTable::New(const BulletRT::Core::VulkanRayTracingPipeline *pipeline, const BulletRT::Core::VulkanShaderBindingTableBuilder &builder) -> std::unique_ptr<VulkanShaderBindingTable>
+{
+    if (!pipeline || pipeline->IsLibrary() || builder.GetRaygenRecords().empty())
+    {
+        return nullptr;
+    }
+    auto device = pipeline->GetDevice();
+    auto properties = device->GetPhysicalDeviceVk().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceRayTracingPipelinePropertiesKHR>().get<vk::PhysicalDeviceRayTracingPipelinePropertiesKHR>();
+    auto handleSize = static_cast<vk::DeviceSize>(properties.shaderGroupHandleSize);
+    auto handleAlignment = std::max<vk::DeviceSize>(properties.shaderGroupHandleAlignment, 1);
+    auto baseAlignment = std::max<vk::DeviceSize>(properties.shaderGroupBaseAlignment, 1);
+
+    using RecordsType = std::vector<std::pair<uint32_t, std::vector<uint8_t>>>;
+    auto regionRecords = std::vector<const RecordsType *>{&builder.GetRaygenRecords(), &builder.GetMissRecords(), &builder.GetHitRecords(), &builder.GetCallableRecords()};
+    auto regions = std::vector<vk::StridedDeviceAddressRegionKHR>(regionRecords.size());
+    auto regionOffsets = std::vector<vk::DeviceSize>(regionRecords.size(), 0);
+    auto dataSize = vk::DeviceSize(0);
+    for (size_t i = 0; i < regionRecords.size(); ++i)
+    {
+        if (regionRecords[i]->empty())
+        {
+            continue;
         }
-        return attachs;
+        auto maxDataSize = size_t(0);
+        for (auto &[groupIndex, data] : *regionRecords[i])
+        {
+            if (groupIndex >= pipeline->GetGroupCount())
+            {
+                return nullptr;
+            }
+            maxDataSize = std::max(maxDataSize, data.size());
+        }
+        auto stride = CalcAlignedSize(handleSize + maxDataSize, handleAlignment);
+        if (stride > properties.maxShaderGroupStride)
+        {
+            return nullptr;
+        }
+        regionOffsets[i] = CalcAlignedSize(dataSize, baseAlignment);
+        // The raygen region holds a single record and its size must equal its stride.
+        regions[i].stride = stride;
+        regions[i].size = stride * regionRecords[i]->size();
+        dataSize = regionOffsets[i] + regions[i].size;
     }
-    return std::vector<vk::AttachmentDescription>();
-}
+    // vkCmdUpdateBuffer works in multiples of four bytes.
+    dataSize = CalcAlignedSize(dataSize, 4);
 
-auto VulkanRenderPass::GetResolveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
-    if (m_Subpasses.size() > subpassIdx){
-        auto& resolveAttachments = m_Subpasses[subpassIdx].GetResolveAttachments();
-        auto attachs = std::vector<vk::AttachmentDescription>();
-        attachs.reserve(resolveAttachments.size());
-        for (auto& attachment:resolveAttachments){
-            attachs.push_back(m_Attachments[attachment.attachment]);
+    auto shaderBindingTable = std::unique_ptr<VulkanShaderBindingTable>(new VulkanShaderBindingTable());
+    shaderBindingTable->m_Pipeline = pipeline;
+    shaderBindingTable->m_Data.assign(dataSize, 0);
+    for (size_t i = 0; i < regionRecords.size(); ++i)
+    {
+        auto pRecord = shaderBindingTable->m_Data.data() + regionOffsets[i];
+        for (auto &[groupIndex, data] : *regionRecords[i])
+        {
+            std::memcpy(pRecord, pipeline->GetShaderGroupHandle(groupIndex), handleSize);
+            if (!data.empty())
+            {
+                std::memcpy(pRecord + handleSize, data.data(), data.size());
+            }
+            pRecord += regions[i].stride;
         }
-        return attachs;
     }
-    return std::vector<vk::AttachmentDescription>();
-}
 
-auto VulkanRenderPass::GetDepthStencilAttachment(size_t subpassIdx) const noexcept -> std::optional<vk::AttachmentDescription> { 
-    if (m_Subpasses.size() > subpassIdx){
-        auto depthStencilAttachment = m_Subpasses[subpassIdx].GetDepthStencilAttachment();
-        if (depthStencilAttachment){
-            return m_Attachments[depthStencilAttachment->attachment];
+    shaderBindingTable->m_Buffer = VulkanBufferBuilder()
+                                       .SetSize(dataSize + baseAlignment)
+                                       .SetUsage(vk::BufferUsageFlagBits::eShaderBindingTableKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress | vk::BufferUsageFlagBits::eTransferDst)
+                                       .Build(device);
+    if (!shaderBindingTable->m_Buffer)
+    {
+        return nullptr;
+    }
+    auto memoryRequirements = shaderBindingTable->m_Buffer->QueryMemoryRequirements();
+    auto memoryTypeIndices = FindMemoryTypeIndices(device->GetPhysicalDeviceVk().getMemoryProperties(), memoryRequirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+    if (memoryTypeIndices.empty())
+    {
+        return nullptr;
+    }
+    shaderBindingTable->m_Memory = VulkanDeviceMemoryBuilder()
+                                       .SetAllocationSize(memoryRequirements.size)
+                                       .SetMemoryTypeIndex(memoryTypeIndices.front())
+                                       .SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress))
+                                       .Build(device);
+    if (!shaderBindingTable->m_Memory)
+    {
+        return nullptr;
+    }
+    shaderBindingTable->m_MemoryBuffer = VulkanMemoryBuffer::Bind(shaderBindingTable->m_Buffer.get(), shaderBindingTable->m_Memory.get());
+    if (!shaderBindingTable->m_MemoryBuffer || !shaderBindingTable->m_MemoryBuffer->GetDeviceAddress())
+    {
+        return nullptr;
+    }
+    auto deviceAddress = shaderBindingTable->m_MemoryBuffer->GetDeviceAddress().value();
+    auto baseAddress = CalcAlignedSize(deviceAddress, baseAlignment);
+    shaderBindingTable->m_DataOffset = baseAddress - deviceAddress;
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        if (regions[i].size > 0)
+        {
+            regions[i].deviceAddress = baseAddress + regionOffsets[i];
         }
     }
-    return std::optional<vk::AttachmentDescription>();
+    shaderBindingTable->m_RaygenRegion = regions[0];
+    shaderBindingTable->m_MissRegion = regions[1];
+    shaderBindingTable->m_HitRegion = regions[2];
+    shaderBindingTable->m_CallableRegion = regions[3];
+    return shaderBindingTable;
 }
 
-auto VulkanRenderPass::GetPreserveAttachments(size_t subpassIdx) const noexcept -> std::vector<vk::AttachmentDescription> { 
-    if (m_Subpasses.size() > subpassIdx){
-        auto preserveAttachments = m_Subpasses[subpassIdx].GetPreserveAttachments();
-        auto attachs = std::vector<vk::AttachmentDescription>();
-        attachs.reserve(preserveAttachments.size());
-        for (auto& attachment:preserveAttachments){
-            attachs.push_back(m_Attachments[attachment]);
-        }
-        return attachs;
+VulkanShaderBindingTable::~VulkanShaderBindingTable() noexcept
+{
+    m_MemoryBuffer.reset();
+    m_Memory.reset();
+    m_Buffer.reset();
+}
+
+void VulkanShaderBindingTable::RecordUpload(vk::CommandBuffer commandBuffer) const
+{
+    // vkCmdUpdateBuffer accepts at most 65536 bytes per call.
+    constexpr vk::DeviceSize maxUpdateSize = 65536;
+    for (vk::DeviceSize offset = 0; offset < m_Data.size(); offset += maxUpdateSize)
+    {
+        auto size = std::min<vk::DeviceSize>(maxUpdateSize, m_Data.size() - offset);
+        commandBuffer.updateBuffer(m_Buffer->GetBufferVk(), m_DataOffset + offset, size, m_Data.data() + offset);
     }
-    return std::vector<vk::AttachmentDescription>();
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eRayTracingShaderKHR, {},
+                                  vk::MemoryBarrier().setSrcAccessMask(vk::AccessFlagBits::eTransferWrite).setDstAccessMask(vk::AccessFlagBits::eShaderRead),
+                                  nullptr, nullptr);
 }
 
+void VulkanShaderBindingTable::RecordTraceRays(vk::CommandBuffer commandBuffer, uint32_t width, uint32_t height, uint32_t depth) const
+{
+    commandBuffer.traceRaysKHR(m_RaygenRegion, m_MissRegion, m_HitRegion, m_CallableRegion, width, height, depth);
+}
 
-VulkanRenderPass::VulkanRenderPass() noexcept { 
-    
+auto VulkanShaderBindingTable::GetPipeline() const noexcept -> const BulletRT::Core::VulkanRayTracingPipeline *
+{
+    return m_Pipeline;
+}
+
+auto VulkanShaderBindingTable::GetBuffer() const noexcept -> const BulletRT::Core::VulkanMemoryBuffer *
+{
+    return m_MemoryBuffer.get();
+}
+
+auto VulkanShaderBindingTable::GetData() const noexcept -> const std::vector<uint8_t> &
+{
+    return m_Data;
+}
+
+auto VulkanShaderBindingTable::GetDataOffset() const noexcept -> vk::DeviceSize
+{
+    return m_DataOffset;
+}
+
+auto VulkanShaderBindingTable::GetRaygenRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR
+{
+    return m_RaygenRegion;
+}
+
+auto VulkanShaderBindingTable::GetMissRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR
+{
+    return m_MissRegion;
+}
+
+auto VulkanShaderBindingTable::GetHitRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR
+{
+    return m_HitRegion;
+}
+
+auto VulkanShaderBindingTable::GetCallableRegion() const noexcept -> vk::StridedDeviceAddressRegionKHR
+{
+    return m_CallableRegion;
+}
+
+VulkanShaderBindingTable::VulkanShaderBindingTable() noexcept
+{
 }
@@ -0,0 +1,48 @@
+#ifndef BULLET_RT_UTILS_VULKAN_ACCELERATION_STRUCTURE_BATCH_H
+#define BULLET_RT_UTILS_VULKAN_ACCELERATION_STRUCTURE_BATCH_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanAllocator.h>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Records the builds of many acceleration structures with as few vkCmdBuildAccelerationStructuresKHR
+        // calls as the scratch budget allows. Every build in a call gets its own aligned slice of one scratch
+        // buffer; consecutive calls reuse the buffer and are separated by a build-to-build barrier. A trailing
+        // barrier makes the results visible to later builds and ray tracing shaders.
+        class VulkanAccelerationStructureBatch
+        {
+        public:
+            static auto New(VulkanAllocator* allocator, vk::DeviceSize scratchBudget = 64 * 1024 * 1024)->std::unique_ptr<VulkanAccelerationStructureBatch>;
+            ~VulkanAccelerationStructureBatch()noexcept;
+
+            bool Add(const BulletRT::Core::VulkanAccelerationStructure* accelerationStructure, vk::BuildAccelerationStructureModeKHR mode = vk::BuildAccelerationStructureModeKHR::eBuild);
+            // Records and clears every pending build. The scratch buffer is shared by all recordings of this batch,
+            // so command buffers recorded from it must execute in recording order on one queue.
+            auto Record(vk::CommandBuffer commandBuffer)->vk::Result;
+            void Clear();
+
+            auto GetDevice()const noexcept -> const BulletRT::Core::VulkanDevice*;
+            auto GetScratchBudget()const noexcept -> vk::DeviceSize;
+            auto GetPendingCount()const noexcept -> size_t;
+            // Number of vkCmdBuildAccelerationStructuresKHR calls emitted by the last Record.
+            auto GetLastCallCount()const noexcept -> uint32_t;
+        private:
+            struct BuildDesc
+            {
+                const BulletRT::Core::VulkanAccelerationStructure* accelerationStructure;
+                vk::BuildAccelerationStructureModeKHR              mode;
+            };
+            VulkanAccelerationStructureBatch()noexcept;
+        private:
+            const BulletRT::Core::VulkanDevice*                 m_Device;
+            vk::DeviceSize                                      m_ScratchBudget;
+            vk::DeviceSize                                      m_ScratchAlignment;
+            std::unique_ptr<VulkanAllocation>                   m_Scratch;
+            vk::DeviceAddress                                   m_ScratchAddress;
+            std::vector<BuildDesc>                              m_Builds;
+            uint32_t                                            m_LastCallCount;
+        };
+    }
+}
+#endif
@@ -0,0 +1,70 @@
+#ifndef BULLET_RT_UTILS_VULKAN_ACCELERATION_STRUCTURE_CACHE_H
+#define BULLET_RT_UTILS_VULKAN_ACCELERATION_STRUCTURE_CACHE_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanAllocator.h>
+#include <array>
+#include <string>
+#include <unordered_map>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Disk cache of serialized bottom-level acceleration structures. Entries are keyed by a caller supplied hash
+        // of the geometry content (e.g. BulletRT::Core::HashBytes of the vertex and index data) combined with the
+        // builder's type, flags and geometry layout. Top-level structures are rejected: their serialized instances
+        // hold BLAS device addresses that would dangle after a reload. The file records the device's vendor/device
+        // id, driver version and driver UUID and is discarded on mismatch; every blob is additionally checked with
+        // vkGetDeviceAccelerationStructureCompatibilityKHR before it is deserialized.
+        // File layout: header, entry table, then blobs at 256 byte aligned offsets, so it can be mapped as is.
+        // A file that is truncated or whose entry table does not fit its size is ignored as a whole; Save writes a
+        // temporary file and renames it over the old one, so an interrupted save leaves the previous file intact.
+        // Store and Load submit on the given queue and wait for completion. Not thread safe.
+        class VulkanAccelerationStructureCache
+        {
+        public:
+            struct StoreDesc
+            {
+                uint64_t                                           contentHash;
+                const BulletRT::Core::VulkanAccelerationStructure* accelerationStructure;
+            };
+            struct LoadDesc
+            {
+                uint64_t                                           contentHash;
+                BulletRT::Core::VulkanAccelerationStructureBuilder builder;
+            };
+
+            // Store and Load stage the blobs through a host visible buffer taken from allocator for the duration of the call.
+            static auto New(VulkanAllocator* allocator, const BulletRT::Core::VulkanCommandPool* commandPool, const BulletRT::Core::VulkanQueue& queue, const std::string& path)->std::unique_ptr<VulkanAccelerationStructureCache>;
+            ~VulkanAccelerationStructureCache()noexcept;
+
+            bool Contains(uint64_t contentHash, const BulletRT::Core::VulkanAccelerationStructureBuilder& builder)const;
+            // eErrorUnknown, storing nothing, if any desc is null or top-level.
+            auto Store(const std::vector<StoreDesc>& descs)->vk::Result;
+            // Returns one structure per desc; entries that are missing, incompatible or top-level yield nullptr and must be built.
+            auto Load(const std::vector<LoadDesc>& descs)->std::vector<std::unique_ptr<BulletRT::Core::VulkanAccelerationStructure>>;
+            auto Save()const->bool;
+            void Clear();
+
+            auto GetPath()const noexcept -> const std::string&;
+            auto GetEntryCount()const noexcept -> size_t;
+        private:
+            VulkanAccelerationStructureCache()noexcept;
+
+            static auto Impl_MakeKey(uint64_t contentHash, vk::AccelerationStructureTypeKHR type, vk::BuildAccelerationStructureFlagsKHR flags,
+                const std::vector<BulletRT::Core::VulkanAccelerationStructureGeometryDesc>& geometries)noexcept -> uint64_t;
+            auto Impl_NewHostBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage)const->std::unique_ptr<VulkanAllocation>;
+            auto Impl_Submit(vk::CommandBuffer commandBuffer)const->vk::Result;
+            bool Impl_Load();
+        private:
+            VulkanAllocator*                                      m_Allocator;
+            const BulletRT::Core::VulkanDevice*                   m_Device;
+            const BulletRT::Core::VulkanCommandPool*              m_CommandPool;
+            std::optional<BulletRT::Core::VulkanQueue>            m_Queue;
+            std::string                                           m_Path;
+            vk::PhysicalDeviceProperties                          m_DeviceProperties;
+            std::array<uint8_t, VK_UUID_SIZE>                     m_DriverUUID;
+            std::unordered_map<uint64_t, std::vector<uint8_t>>    m_Entries;
+        };
+    }
+}
+#endif
@@ -0,0 +1,101 @@
+#ifndef BULLET_RT_UTILS_VULKAN_ALLOCATOR_H
+#define BULLET_RT_UTILS_VULKAN_ALLOCATOR_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanOffsetAllocator.h>
+#include <mutex>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        class VulkanAllocator;
+        class VulkanAllocatorBlock;
+        class VulkanAllocation
+        {
+        public:
+            ~VulkanAllocation() noexcept;
+
+            auto GetAllocator()const noexcept -> VulkanAllocator*;
+            auto GetMemory()const noexcept -> const BulletRT::Core::VulkanDeviceMemory*;
+            auto GetMemoryVk()const noexcept -> vk::DeviceMemory;
+            auto GetMemoryOffset()const noexcept -> vk::DeviceSize;
+            auto GetMemoryTypeIndex()const noexcept -> uint32_t;
+            auto GetSize()const noexcept -> vk::DeviceSize;
+            auto GetMemoryBuffer()const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*;
+            auto GetMemoryImage()const noexcept -> const BulletRT::Core::VulkanMemoryImage*;
+            // Start of the range in host address space, or nullptr when the memory type is not host visible.
+            auto GetMappedData()const noexcept -> void*;
+            bool IsDedicated()const noexcept;
+        private:
+            friend class VulkanAllocator;
+            VulkanAllocation()noexcept;
+        private:
+            VulkanAllocator*                                   m_Allocator;
+            VulkanAllocatorBlock*                              m_Block;
+            VulkanOffsetAllocation                             m_Range;
+            std::unique_ptr<BulletRT::Core::VulkanBuffer>       m_Buffer;
+            std::unique_ptr<BulletRT::Core::VulkanMemoryBuffer> m_MemoryBuffer;
+            std::unique_ptr<BulletRT::Core::VulkanMemoryImage>  m_MemoryImage;
+        };
+        struct VulkanAllocatorBlockStatistics
+        {
+            uint32_t                        memoryTypeIndex;
+            bool                            isOptimalImage;
+            bool                            isDedicated;
+            VulkanOffsetAllocatorStatistics statistics;
+        };
+        // Suballocates buffers and images from large device memory blocks. Allocations and the Utils objects built on
+        // them (pools, batches, caches, tables) keep a pointer to the allocator, which must outlive all of them.
+        class VulkanAllocator
+        {
+        public:
+            static auto New(const BulletRT::Core::VulkanDevice* device, vk::DeviceSize blockSize = 256 * 1024 * 1024,
+                VulkanOffsetAllocatorStrategy strategy = VulkanOffsetAllocatorStrategy::eTlsf)->std::unique_ptr<VulkanAllocator>;
+            ~VulkanAllocator()noexcept;
+
+            auto AllocateBuffer(const BulletRT::Core::VulkanBuffer* buffer,
+                vk::MemoryPropertyFlags requiredFlags,
+                vk::MemoryPropertyFlags avoidFlags = {})->std::unique_ptr<VulkanAllocation>;
+            // Builds the buffer and binds it like AllocateBuffer; the returned allocation owns the buffer.
+            auto NewBuffer(const BulletRT::Core::VulkanBufferBuilder& builder,
+                vk::MemoryPropertyFlags requiredFlags,
+                vk::MemoryPropertyFlags avoidFlags = {})->std::unique_ptr<VulkanAllocation>;
+            auto AllocateImage(const BulletRT::Core::VulkanImage* image,
+                vk::MemoryPropertyFlags requiredFlags,
+                vk::MemoryPropertyFlags avoidFlags = {})->std::unique_ptr<VulkanAllocation>;
+
+            auto GetDevice()const noexcept -> const BulletRT::Core::VulkanDevice*;
+            auto GetBlockSize()const noexcept -> vk::DeviceSize;
+            auto GetStrategy()const noexcept -> VulkanOffsetAllocatorStrategy;
+            auto GetBlockCount()const -> size_t;
+            auto GetAllocationCount()const -> size_t;
+            auto QueryBlockStatistics()const -> std::vector<VulkanAllocatorBlockStatistics>;
+        private:
+            friend class VulkanAllocation;
+            VulkanAllocator()noexcept;
+
+            auto Impl_Allocate(const vk::MemoryRequirements& requirements,
+                vk::MemoryPropertyFlags requiredFlags,
+                vk::MemoryPropertyFlags avoidFlags,
+                bool isOptimalImage,
+                VulkanOffsetAllocation* pRange)->VulkanAllocatorBlock*;
+            auto Impl_AllocateFromType(uint32_t memoryTypeIndex,
+                const vk::MemoryRequirements& requirements,
+                bool isOptimalImage,
+                VulkanOffsetAllocation* pRange)->VulkanAllocatorBlock*;
+            auto Impl_NewBlock(uint32_t memoryTypeIndex, vk::DeviceSize size, bool isOptimalImage, bool isDedicated)->VulkanAllocatorBlock*;
+            void Impl_Free(VulkanAllocatorBlock* block, const VulkanOffsetAllocation& range)noexcept;
+            void Impl_RemoveBlock(VulkanAllocatorBlock* block)noexcept;
+        private:
+            const BulletRT::Core::VulkanDevice*                 m_Device;
+            vk::PhysicalDeviceMemoryProperties                  m_MemoryProperties;
+            vk::DeviceSize                                      m_BufferImageGranularity;
+            vk::DeviceSize                                      m_BlockSize;
+            VulkanOffsetAllocatorStrategy                       m_Strategy;
+            bool                                                m_SupportDeviceAddress;
+            std::vector<std::unique_ptr<VulkanAllocatorBlock>>  m_Blocks;
+            size_t                                              m_AllocationCount;
+            mutable std::mutex                                  m_Mutex;
+        };
+    }
+}
+#endif
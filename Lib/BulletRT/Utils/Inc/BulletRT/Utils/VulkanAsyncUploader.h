@@ -0,0 +1,86 @@
+#ifndef BULLET_RT_UTILS_VULKAN_ASYNC_UPLOADER_H
+#define BULLET_RT_UTILS_VULKAN_ASYNC_UPLOADER_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanStagingRing.h>
+#include <deque>
+#include <unordered_set>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Records staging copies on a dedicated transfer queue and signals a timeline semaphore
+        // per submission. Upload submits copies on its own when the ring runs low, but exclusive
+        // destination buffers are released to the consumer queue family only by Submit, once per
+        // buffer written since the previous Submit. The consumer records the matching acquire barriers
+        // with RecordAcquireBarriers and waits on GetSemaphoreVk() at the value returned by Submit.
+        // Uploads to a released buffer fail until the consumer hands it back with RecordReleaseBarriers
+        // and passes the semaphore signalled after that release to AddWaitSemaphore; the next
+        // submission then acquires it on the transfer queue. Not thread safe.
+        class VulkanAsyncUploader
+        {
+        public:
+            static auto New(const VulkanStaging* staging,
+                const BulletRT::Core::VulkanCommandPool* commandPool,
+                const BulletRT::Core::VulkanQueue& queue,
+                uint32_t dstQueueFamilyIndex)->std::unique_ptr<VulkanAsyncUploader>;
+            ~VulkanAsyncUploader()noexcept;
+
+            auto Upload(const void* pData, vk::DeviceSize sizeInBytes, const BulletRT::Core::VulkanBuffer* dstBuffer, vk::DeviceSize dstOffset = 0)->vk::Result;
+            auto Submit()->std::optional<uint64_t>;
+            void RecordAcquireBarriers(vk::CommandBuffer commandBuffer, uint64_t value);
+            // Recorded by the consumer on its own queue; releases buffer back to the transfer queue family.
+            void RecordReleaseBarriers(vk::CommandBuffer commandBuffer, const BulletRT::Core::VulkanBuffer* buffer);
+            // The next Submit waits on semaphore before its copies start.
+            void AddWaitSemaphore(const BulletRT::Core::VulkanSemaphore* semaphore, uint64_t value = 0);
+            auto Wait(uint64_t value, uint64_t timeout = UINT64_MAX)const->vk::Result;
+            auto QueryCompletedValue()const->uint64_t;
+
+            auto GetStaging()const noexcept -> const VulkanStaging*;
+            auto GetSemaphore()const noexcept -> const BulletRT::Core::VulkanSemaphore*;
+            auto GetSemaphoreVk()const noexcept -> vk::Semaphore;
+            auto GetSubmittedValue()const noexcept -> uint64_t;
+            auto GetSrcQueueFamilyIndex()const noexcept -> uint32_t;
+            auto GetDstQueueFamilyIndex()const noexcept -> uint32_t;
+        private:
+            struct BatchDesc
+            {
+                std::unique_ptr<BulletRT::Core::VulkanCommandBuffer> commandBuffer;
+                uint64_t                                             value;
+                vk::DeviceSize                                       sizeInBytes;
+            };
+            struct OwnershipDesc
+            {
+                uint64_t                value;
+                vk::BufferMemoryBarrier barrier;
+            };
+            struct WaitDesc
+            {
+                const BulletRT::Core::VulkanSemaphore* semaphore;
+                uint64_t                               value;
+            };
+            VulkanAsyncUploader()noexcept;
+
+            auto Impl_Submit(bool releaseBuffers)->std::optional<uint64_t>;
+            bool Impl_NeedOwnershipTransfer(const BulletRT::Core::VulkanBuffer* buffer)const noexcept;
+            auto Impl_NewOwnershipBarrier(const BulletRT::Core::VulkanBuffer* buffer, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex)const noexcept -> vk::BufferMemoryBarrier;
+            bool Impl_RetireOldestBatch(bool wait);
+        private:
+            std::unique_ptr<VulkanStagingRing>                        m_Ring;
+            const BulletRT::Core::VulkanCommandPool*                  m_CommandPool;
+            std::optional<BulletRT::Core::VulkanQueue>                m_Queue;
+            uint32_t                                                  m_SrcQueueFamilyIndex;
+            uint32_t                                                  m_DstQueueFamilyIndex;
+            std::unique_ptr<BulletRT::Core::VulkanSemaphore>          m_Semaphore;
+            uint64_t                                                  m_SubmittedValue;
+            std::deque<BatchDesc>                                     m_Batches;
+            std::deque<OwnershipDesc>                                 m_PendingAcquires;
+            std::vector<vk::BufferMemoryBarrier>                      m_PendingReturns;
+            std::vector<WaitDesc>                                     m_PendingWaits;
+            // Exclusive buffers written since the last Submit, and those released to the consumer family and not yet returned.
+            std::unordered_set<const BulletRT::Core::VulkanBuffer*>   m_WrittenBuffers;
+            std::unordered_set<const BulletRT::Core::VulkanBuffer*>   m_ReleasedBuffers;
+            std::vector<std::unique_ptr<BulletRT::Core::VulkanCommandBuffer>> m_FreeCommandBuffers;
+        };
+    }
+}
+#endif
@@ -0,0 +1,51 @@
+#ifndef BULLET_RT_UTILS_VULKAN_BUFFER_POOL_H
+#define BULLET_RT_UTILS_VULKAN_BUFFER_POOL_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanAllocator.h>
+#include <BulletRT/Utils/VulkanOffsetAllocator.h>
+#include <mutex>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Hands out ranges of large buffers allocated from a VulkanAllocator, so that thousands of small buffers such as
+        // acceleration structure storage and scratch share a few device memory allocations. Requests larger than the
+        // block size get a block of their own. One empty block is kept for reuse. Thread safe.
+        class VulkanBufferPool : public BulletRT::Core::VulkanBufferSuballocator
+        {
+        public:
+            static auto New(VulkanAllocator* allocator, vk::BufferUsageFlags usage,
+                vk::MemoryPropertyFlags requiredFlags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+                vk::DeviceSize blockSize = 64 * 1024 * 1024,
+                VulkanOffsetAllocatorStrategy strategy = VulkanOffsetAllocatorStrategy::eTlsf)->std::unique_ptr<VulkanBufferPool>;
+            virtual ~VulkanBufferPool()noexcept;
+
+            virtual auto AllocateRegion(vk::DeviceSize size, vk::DeviceSize alignment)->std::optional<BulletRT::Core::VulkanBufferRegion> override;
+            virtual void FreeRegion(const BulletRT::Core::VulkanBufferRegion& region)noexcept override;
+
+            auto GetAllocator()const noexcept -> VulkanAllocator*;
+            auto GetUsage()const noexcept -> vk::BufferUsageFlags;
+            auto GetBlockSize()const noexcept -> vk::DeviceSize;
+            auto GetBlockCount()const -> size_t;
+            auto QueryBlockStatistics()const -> std::vector<VulkanOffsetAllocatorStatistics>;
+        private:
+            struct BlockDesc
+            {
+                std::unique_ptr<VulkanAllocation>      allocation;
+                std::unique_ptr<VulkanOffsetAllocator> allocator;
+            };
+            VulkanBufferPool()noexcept;
+
+            auto Impl_NewBlock(vk::DeviceSize size)->BlockDesc*;
+        private:
+            VulkanAllocator*              m_Allocator;
+            vk::BufferUsageFlags          m_Usage;
+            vk::MemoryPropertyFlags       m_RequiredFlags;
+            vk::DeviceSize                m_BlockSize;
+            VulkanOffsetAllocatorStrategy m_Strategy;
+            std::vector<BlockDesc>        m_Blocks;
+            mutable std::mutex            m_Mutex;
+        };
+    }
+}
+#endif
@@ -0,0 +1,60 @@
+#ifndef BULLET_RT_UTILS_VULKAN_FRAME_ALLOCATOR_H
+#define BULLET_RT_UTILS_VULKAN_FRAME_ALLOCATOR_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <deque>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        struct VulkanFrameAllocation
+        {
+            vk::Buffer                       buffer;
+            vk::DeviceSize                   offset;
+            vk::DeviceSize                   size;
+            void*                            pMappedData;
+            std::optional<vk::DeviceAddress> deviceAddress;
+        };
+        // Ring of transient slices on one persistently mapped, host coherent buffer.
+        // Slices allocated between two EndFrame calls are reclaimed together once the
+        // fence passed to the second EndFrame signals, so the fence must stay alive until then.
+        class VulkanFrameAllocator
+        {
+        public:
+            static auto New(const BulletRT::Core::VulkanDevice* device, vk::DeviceSize size,
+                vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer)->std::unique_ptr<VulkanFrameAllocator>;
+            ~VulkanFrameAllocator()noexcept;
+
+            auto Allocate(vk::DeviceSize size, vk::DeviceSize alignment = 256)->std::optional<VulkanFrameAllocation>;
+            void BeginFrame();
+            void EndFrame(const BulletRT::Core::VulkanFence* fence);
+
+            auto GetBuffer()const noexcept -> const BulletRT::Core::VulkanBuffer*;
+            auto GetBufferVk()const noexcept -> vk::Buffer;
+            auto GetMemory()const noexcept -> const BulletRT::Core::VulkanDeviceMemory*;
+            auto GetMemoryVk()const noexcept -> vk::DeviceMemory;
+            auto GetSize()const noexcept -> vk::DeviceSize;
+            auto GetUsedSize()const noexcept -> vk::DeviceSize;
+            auto GetDeviceAddress()const noexcept -> std::optional<vk::DeviceAddress>;
+        private:
+            struct FrameDesc
+            {
+                const BulletRT::Core::VulkanFence* fence;
+                vk::DeviceSize                     sizeInBytes;
+            };
+            VulkanFrameAllocator()noexcept;
+
+            auto Impl_TryAllocate(vk::DeviceSize size, vk::DeviceSize alignment)->std::optional<vk::DeviceSize>;
+            bool Impl_RetireOldestFrame(bool wait);
+        private:
+            std::unique_ptr<BulletRT::Core::VulkanBuffer>       m_Buffer;
+            std::unique_ptr<BulletRT::Core::VulkanDeviceMemory> m_Memory;
+            std::unique_ptr<BulletRT::Core::VulkanMemoryBuffer> m_MemoryBuffer;
+            void*                                               m_MappedData;
+            vk::DeviceSize                                      m_Head;
+            vk::DeviceSize                                      m_UsedSize;
+            vk::DeviceSize                                      m_FrameSize;
+            std::deque<FrameDesc>                               m_Frames;
+        };
+    }
+}
+#endif
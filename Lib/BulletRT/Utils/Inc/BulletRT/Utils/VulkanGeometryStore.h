@@ -0,0 +1,95 @@
+#ifndef BULLET_RT_UTILS_VULKAN_GEOMETRY_STORE_H
+#define BULLET_RT_UTILS_VULKAN_GEOMETRY_STORE_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanAllocator.h>
+#include <BulletRT/Utils/VulkanOffsetAllocator.h>
+#include <BulletRT/Utils/VulkanStagingStream.h>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        using VulkanGeometryHandle = uint32_t;
+        struct VulkanGeometryMeshDesc
+        {
+            const void* pVertexData;
+            vk::Format  vertexFormat;
+            uint32_t    vertexStride;
+            uint32_t    vertexCount;
+            // 32 bit indices; may be null for non indexed meshes.
+            const uint32_t* pIndexData;
+            uint32_t        indexCount;
+        };
+        // Layout of one entry of the mesh table buffer, matching a std430 struct of
+        // { uint64_t vertexAddress; uint64_t indexAddress; uint vertexStride; uint vertexCount; uint firstIndex; uint indexCount; }.
+        struct VulkanGeometryMeshRecord
+        {
+            vk::DeviceAddress vertexAddress;
+            vk::DeviceAddress indexAddress;
+            uint32_t          vertexStride;
+            uint32_t          vertexCount;
+            // Offsets in elements from the start of the shared vertex/index buffers.
+            uint32_t          firstIndex;
+            uint32_t          indexCount;
+        };
+        static_assert(sizeof(VulkanGeometryMeshRecord) == 32);
+        // Packs the vertices and indices of every mesh into one vertex buffer and one index buffer, and keeps a
+        // mesh table buffer of VulkanGeometryMeshRecord indexed by handle, so hit shaders reach any mesh's
+        // attributes through the table's device address. Handles are stable and recycled after RemoveMesh.
+        // Data is written through the mapping when the memory is host visible, otherwise queued on the stream,
+        // which the caller flushes before use. Not thread safe.
+        class VulkanGeometryStore
+        {
+        public:
+            static constexpr VulkanGeometryHandle InvalidHandle = UINT32_MAX;
+
+            static auto New(VulkanAllocator* allocator, vk::DeviceSize vertexCapacity, vk::DeviceSize indexCapacity, uint32_t maxMeshCount,
+                vk::MemoryPropertyFlags requiredFlags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+                vk::MemoryPropertyFlags avoidFlags = {})->std::unique_ptr<VulkanGeometryStore>;
+            ~VulkanGeometryStore()noexcept;
+
+            auto AddMesh(const VulkanGeometryMeshDesc& desc, VulkanStagingStream* stream = nullptr)->VulkanGeometryHandle;
+            // Frees the mesh's ranges immediately; the caller must ensure the GPU no longer reads them.
+            bool RemoveMesh(VulkanGeometryHandle handle);
+            auto GetMesh(VulkanGeometryHandle handle)const -> std::optional<VulkanGeometryMeshRecord>;
+            auto GetVertexOffset(VulkanGeometryHandle handle)const -> std::optional<vk::DeviceSize>;
+            auto GetIndexOffset(VulkanGeometryHandle handle)const -> std::optional<vk::DeviceSize>;
+            // Triangle geometry of one mesh, for VulkanAccelerationStructure builds.
+            auto GetGeometryDesc(VulkanGeometryHandle handle, vk::GeometryFlagsKHR flags = vk::GeometryFlagBitsKHR::eOpaque)const -> std::optional<BulletRT::Core::VulkanAccelerationStructureGeometryDesc>;
+
+            auto GetVertexBuffer()const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*;
+            auto GetIndexBuffer()const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*;
+            auto GetMeshTableBuffer()const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*;
+            auto GetMeshTableAddress()const noexcept -> vk::DeviceAddress;
+            auto GetMeshCount()const noexcept -> uint32_t;
+            auto GetMaxMeshCount()const noexcept -> uint32_t;
+            auto QueryVertexStatistics()const noexcept -> VulkanOffsetAllocatorStatistics;
+            auto QueryIndexStatistics()const noexcept -> VulkanOffsetAllocatorStatistics;
+        private:
+            struct MeshDesc
+            {
+                VulkanOffsetAllocation   vertexRange;
+                VulkanOffsetAllocation   indexRange;
+                vk::Format               vertexFormat;
+                VulkanGeometryMeshRecord record;
+                bool                     isAlive;
+            };
+            VulkanGeometryStore()noexcept;
+
+            auto Impl_Write(const VulkanAllocation* allocation, const void* pData, vk::DeviceSize sizeInBytes, vk::DeviceSize offset, VulkanStagingStream* stream)->vk::Result;
+        private:
+            std::unique_ptr<BulletRT::Core::VulkanBuffer> m_VertexBuffer;
+            std::unique_ptr<BulletRT::Core::VulkanBuffer> m_IndexBuffer;
+            std::unique_ptr<BulletRT::Core::VulkanBuffer> m_MeshTableBuffer;
+            std::unique_ptr<VulkanAllocation>             m_VertexAllocation;
+            std::unique_ptr<VulkanAllocation>             m_IndexAllocation;
+            std::unique_ptr<VulkanAllocation>             m_MeshTableAllocation;
+            std::unique_ptr<VulkanOffsetAllocator>        m_VertexAllocator;
+            std::unique_ptr<VulkanOffsetAllocator>        m_IndexAllocator;
+            uint32_t                                      m_MaxMeshCount;
+            uint32_t                                      m_MeshCount;
+            std::vector<MeshDesc>                         m_Meshes;
+            std::vector<VulkanGeometryHandle>             m_FreeHandles;
+        };
+    }
+}
+#endif
@@ -0,0 +1,53 @@
+#ifndef BULLET_RT_UTILS_VULKAN_GRAPHICS_PIPELINE_POOL_H
+#define BULLET_RT_UTILS_VULKAN_GRAPHICS_PIPELINE_POOL_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <unordered_map>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Deduplicates graphics pipelines by VulkanGraphicsPipelineBuilder::GetStateKey, so materials that end up with
+        // the same shaders and state share one pipeline instead of each compiling and binding their own. Entries are
+        // bucketed by GetHash and a hit also compares the stored key, so colliding hashes never alias. Pipelines stay
+        // alive until removed or the pool is destroyed. A pooled pipeline keeps the builder of the first Acquire, so
+        // its GetLayout and GetRenderPass return that caller's objects even when a later caller passed equivalent
+        // ones: the pool does not own them, and the layout, render pass and modules of the first Acquire must stay
+        // alive until the pipeline is removed. Thread safe: creation runs outside the lock, and if two threads race
+        // on the same state the first pipeline inserted wins.
+        class VulkanGraphicsPipelinePool
+        {
+        public:
+            static auto New(const BulletRT::Core::VulkanDevice* device)->std::unique_ptr<VulkanGraphicsPipelinePool>;
+            ~VulkanGraphicsPipelinePool()noexcept;
+
+            // Returns the pooled pipeline for builder's state, creating it on a miss; null if creation failed.
+            auto Acquire(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder) -> const BulletRT::Core::VulkanGraphicsPipeline*;
+            auto Find(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder)const -> const BulletRT::Core::VulkanGraphicsPipeline*;
+            bool Remove(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder);
+            void Clear();
+
+            auto GetDevice()const noexcept -> const BulletRT::Core::VulkanDevice*;
+            auto GetPipelineCount()const -> size_t;
+            auto GetHitCount()const -> uint64_t;
+            auto GetMissCount()const -> uint64_t;
+        private:
+            struct PipelineDesc
+            {
+                std::vector<uint8_t>                                    key;
+                std::unique_ptr<BulletRT::Core::VulkanGraphicsPipeline> pipeline;
+            };
+            using PipelineMap = std::unordered_multimap<uint64_t, PipelineDesc>;
+
+            VulkanGraphicsPipelinePool()noexcept;
+
+            auto Impl_Find(uint64_t hash, const std::vector<uint8_t>& key)const -> PipelineMap::const_iterator;
+        private:
+            const BulletRT::Core::VulkanDevice* m_Device;
+            PipelineMap                         m_Pipelines;
+            uint64_t                            m_HitCount;
+            uint64_t                            m_MissCount;
+            mutable std::mutex                  m_Mutex;
+        };
+    }
+}
+#endif
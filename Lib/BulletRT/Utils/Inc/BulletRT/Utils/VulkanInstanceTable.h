@@ -0,0 +1,62 @@
+#ifndef BULLET_RT_UTILS_VULKAN_INSTANCE_TABLE_H
+#define BULLET_RT_UTILS_VULKAN_INSTANCE_TABLE_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanAllocator.h>
+#include <BulletRT/Utils/VulkanStagingStream.h>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        using VulkanInstanceHandle = uint32_t;
+        // Dense device local array of VkAccelerationStructureInstanceKHR records addressed by stable handles.
+        // Removing an instance moves the last record into the freed slot and handles are recycled through a
+        // free list, so [0, GetInstanceCount()) is always packed. Only the records touched since the previous
+        // Upload are sent, coalesced into ranges. Not thread safe.
+        class VulkanInstanceTable
+        {
+        public:
+            static constexpr VulkanInstanceHandle InvalidHandle = UINT32_MAX;
+
+            static auto New(VulkanAllocator* allocator, uint32_t maxInstanceCount)->std::unique_ptr<VulkanInstanceTable>;
+            ~VulkanInstanceTable()noexcept;
+
+            auto Add(const vk::AccelerationStructureInstanceKHR& instance)->VulkanInstanceHandle;
+            bool Remove(VulkanInstanceHandle handle);
+            bool Set(VulkanInstanceHandle handle, const vk::AccelerationStructureInstanceKHR& instance);
+            bool SetTransform(VulkanInstanceHandle handle, const vk::TransformMatrixKHR& transform);
+            bool SetMask(VulkanInstanceHandle handle, uint32_t mask);
+            bool SetShaderBindingTableRecordOffset(VulkanInstanceHandle handle, uint32_t offset);
+            bool SetFlags(VulkanInstanceHandle handle, vk::GeometryInstanceFlagsKHR flags);
+            auto Get(VulkanInstanceHandle handle)const -> std::optional<vk::AccelerationStructureInstanceKHR>;
+            auto GetSlot(VulkanInstanceHandle handle)const -> std::optional<uint32_t>;
+
+            // Queues the dirty records on stream; the caller flushes the stream before building with the table.
+            // On failure the records of the failed range and of every later range stay dirty for the next Upload.
+            auto Upload(VulkanStagingStream* stream)->vk::Result;
+
+            // Instance geometry over the packed records, for VulkanAccelerationStructure builds.
+            auto GetGeometryDesc()const noexcept -> BulletRT::Core::VulkanAccelerationStructureGeometryDesc;
+            auto GetBuffer()const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*;
+            auto GetInstanceCount()const noexcept -> uint32_t;
+            auto GetMaxInstanceCount()const noexcept -> uint32_t;
+            auto GetDirtyCount()const noexcept -> size_t;
+            // Number of records sent by the last Upload, including gaps merged into ranges.
+            auto GetLastUploadCount()const noexcept -> uint32_t;
+        private:
+            VulkanInstanceTable()noexcept;
+
+            void Impl_MarkDirty(uint32_t slot);
+        private:
+            std::unique_ptr<VulkanAllocation>                   m_Allocation;
+            uint32_t                                            m_MaxInstanceCount;
+            std::vector<vk::AccelerationStructureInstanceKHR>   m_Instances;
+            std::vector<VulkanInstanceHandle>                   m_SlotHandles;
+            std::vector<uint32_t>                               m_HandleSlots;
+            std::vector<VulkanInstanceHandle>                   m_FreeHandles;
+            std::vector<uint32_t>                               m_DirtySlots;
+            std::vector<bool>                                   m_DirtyFlags;
+            uint32_t                                            m_LastUploadCount;
+        };
+    }
+}
+#endif
@@ -0,0 +1,19 @@
+#ifndef BULLET_RT_UTILS_VULKAN_MEMORY_UTILS_H
+#define BULLET_RT_UTILS_VULKAN_MEMORY_UTILS_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <vector>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Indices of the memory types allowed by memoryTypeBits that have all of requiredFlags and none of avoidFlags, in device order.
+        auto FindMemoryTypeIndices(const vk::PhysicalDeviceMemoryProperties& memoryProps,
+            uint32_t memoryTypeBits,
+            vk::MemoryPropertyFlags requiredFlags,
+            vk::MemoryPropertyFlags avoidFlags = vk::MemoryPropertyFlags{})->std::vector<uint32_t>;
+        auto CalcAlignedSize(vk::DeviceSize size, vk::DeviceSize alignment)noexcept -> vk::DeviceSize;
+        bool SupportBufferDeviceAddress(const BulletRT::Core::VulkanDevice* device);
+        bool SupportTimelineSemaphore(const BulletRT::Core::VulkanDevice* device);
+    }
+}
+#endif
@@ -0,0 +1,55 @@
+#ifndef BULLET_RT_UTILS_VULKAN_OFFSET_ALLOCATOR_H
+#define BULLET_RT_UTILS_VULKAN_OFFSET_ALLOCATOR_H
+#include <BulletRT/Core/BulletRTCore.h>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        enum class VulkanOffsetAllocatorStrategy
+        {
+            eLinear,
+            eTlsf,
+        };
+        struct VulkanOffsetAllocation
+        {
+            vk::DeviceSize offset;
+            vk::DeviceSize size;
+            uint32_t       metadata;
+        };
+        struct VulkanOffsetAllocatorStatistics
+        {
+            vk::DeviceSize totalSize;
+            vk::DeviceSize totalFreeSize;
+            vk::DeviceSize largestFreeRange;
+            size_t         allocationCount;
+            size_t         freeRangeCount;
+            // 0 when all free space is one contiguous range, approaching 1 as it splinters.
+            auto GetFragmentation()const noexcept -> float
+            {
+                return totalFreeSize > 0 ? 1.0f - static_cast<float>(largestFreeRange) / static_cast<float>(totalFreeSize) : 0.0f;
+            }
+        };
+        // Manages ranges of an abstract [0, size) space; not internally synchronized.
+        class VulkanOffsetAllocator
+        {
+        public:
+            static auto New(VulkanOffsetAllocatorStrategy strategy, vk::DeviceSize size)->std::unique_ptr<VulkanOffsetAllocator>;
+            virtual ~VulkanOffsetAllocator()noexcept {}
+
+            virtual auto Allocate(vk::DeviceSize size, vk::DeviceSize alignment = 1)->std::optional<VulkanOffsetAllocation> = 0;
+            virtual void Free(const VulkanOffsetAllocation& allocation)noexcept = 0;
+            virtual void Reset()noexcept = 0;
+            virtual bool IsEmpty()const noexcept = 0;
+            virtual auto QueryStatistics()const noexcept -> VulkanOffsetAllocatorStatistics = 0;
+
+            auto GetStrategy()const noexcept -> VulkanOffsetAllocatorStrategy { return m_Strategy; }
+            auto GetSize()const noexcept -> vk::DeviceSize { return m_Size; }
+        protected:
+            VulkanOffsetAllocator(VulkanOffsetAllocatorStrategy strategy, vk::DeviceSize size)noexcept : m_Strategy{ strategy }, m_Size{ size } {}
+        private:
+            VulkanOffsetAllocatorStrategy m_Strategy;
+            vk::DeviceSize                m_Size;
+        };
+    }
+}
+#endif
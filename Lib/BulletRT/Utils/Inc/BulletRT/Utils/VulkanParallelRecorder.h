@@ -0,0 +1,47 @@
+#ifndef BULLET_RT_UTILS_VULKAN_PARALLEL_RECORDER_H
+#define BULLET_RT_UTILS_VULKAN_PARALLEL_RECORDER_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanWorkerPool.h>
+#include <functional>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Splits the recording of itemCount items across a VulkanWorkerPool. Every range is recorded
+        // into its own secondary command buffer taken from a VulkanCommandBufferAllocator on the
+        // recording thread, and the secondaries are executed in range order on the primary.
+        // When recording inside a render pass, the primary must have begun the subpass with
+        // vk::SubpassContents::eSecondaryCommandBuffers.
+        class VulkanParallelRecorder
+        {
+        public:
+            using RecordFunc = std::function<void(vk::CommandBuffer, size_t, size_t)>;
+
+            static auto New(BulletRT::Core::VulkanCommandBufferAllocator* allocator, VulkanWorkerPool* workerPool, size_t grainSize = 1024)->std::unique_ptr<VulkanParallelRecorder>;
+            ~VulkanParallelRecorder()noexcept;
+
+            auto Record(vk::CommandBuffer primary, size_t itemCount, const RecordFunc& func)->vk::Result;
+            auto Record(vk::CommandBuffer primary,
+                const BulletRT::Core::VulkanRenderPass* renderPass,
+                uint32_t subpass,
+                vk::Framebuffer framebuffer,
+                size_t itemCount,
+                const RecordFunc& func)->vk::Result;
+
+            auto GetAllocator()const noexcept -> BulletRT::Core::VulkanCommandBufferAllocator*;
+            auto GetWorkerPool()const noexcept -> VulkanWorkerPool*;
+            auto GetGrainSize()const noexcept -> size_t;
+            void SetGrainSize(size_t grainSize)noexcept;
+        private:
+            VulkanParallelRecorder()noexcept;
+
+            auto Impl_Record(vk::CommandBuffer primary, const vk::CommandBufferInheritanceInfo& inheritanceInfo, vk::CommandBufferUsageFlags usage, size_t itemCount, const RecordFunc& func)->vk::Result;
+        private:
+            BulletRT::Core::VulkanCommandBufferAllocator* m_Allocator;
+            VulkanWorkerPool*                             m_WorkerPool;
+            size_t                                        m_GrainSize;
+            std::vector<vk::CommandBuffer>                m_Secondaries;
+        };
+    }
+}
+#endif
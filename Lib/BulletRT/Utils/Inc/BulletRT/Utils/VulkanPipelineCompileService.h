@@ -0,0 +1,81 @@
+#ifndef BULLET_RT_UTILS_VULKAN_PIPELINE_COMPILE_SERVICE_H
+#define BULLET_RT_UTILS_VULKAN_PIPELINE_COMPILE_SERVICE_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanWorkerPool.h>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Result of a VulkanPipelineCompileService request. Copies share the same compilation.
+        template<typename PipelineType>
+        class VulkanAsyncPipeline
+        {
+        public:
+            VulkanAsyncPipeline()noexcept = default;
+            VulkanAsyncPipeline(std::shared_future<std::shared_ptr<PipelineType>> future, const PipelineType* placeholder)noexcept
+                : m_Future{ std::move(future) }, m_Placeholder{ placeholder } {}
+
+            bool IsValid()const noexcept { return m_Future.valid(); }
+            bool IsReady()const { return m_Future.valid() && m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+            // Ready, but compilation failed or the request was cancelled.
+            bool IsFailed()const { return IsReady() && !m_Future.get(); }
+            // Never blocks: the compiled pipeline once it is ready, the placeholder until then or on failure.
+            auto Get()const -> const PipelineType* { return IsReady() && m_Future.get() ? m_Future.get().get() : m_Placeholder; }
+            // Blocks until compilation finished; null on failure.
+            auto Wait()const -> std::shared_ptr<PipelineType> { return m_Future.valid() ? m_Future.get() : nullptr; }
+            auto GetPlaceholder()const noexcept -> const PipelineType* { return m_Placeholder; }
+        private:
+            std::shared_future<std::shared_ptr<PipelineType>> m_Future      = {};
+            const PipelineType*                               m_Placeholder = nullptr;
+        };
+        using VulkanAsyncGraphicsPipeline   = VulkanAsyncPipeline<BulletRT::Core::VulkanGraphicsPipeline>;
+        using VulkanAsyncRayTracingPipeline = VulkanAsyncPipeline<BulletRT::Core::VulkanRayTracingPipeline>;
+
+        // Compiles pipelines as tasks of a VulkanWorkerPool so streaming content never blocks the render thread, which
+        // keeps drawing with a placeholder until VulkanAsyncPipeline::IsReady. Ray tracing pipelines additionally go
+        // through a deferred host operation when VK_KHR_deferred_host_operations is enabled, letting the driver
+        // spread one large pipeline over several threads. A build that throws resolves to null like a failed one.
+        // Builders are copied, but the layouts, render passes, modules and libraries they reference must outlive the
+        // request. Thread safe.
+        class VulkanPipelineCompileService
+        {
+        public:
+            // workerPool must outlive the service.
+            static auto New(const BulletRT::Core::VulkanDevice* device, VulkanWorkerPool* workerPool)->std::unique_ptr<VulkanPipelineCompileService>;
+            // Waits for running compilations; queued ones are cancelled and resolve to null.
+            ~VulkanPipelineCompileService()noexcept;
+
+            auto Compile(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder, const BulletRT::Core::VulkanGraphicsPipeline* placeholder = nullptr)->VulkanAsyncGraphicsPipeline;
+            auto Compile(const BulletRT::Core::VulkanRayTracingPipelineBuilder& builder, const BulletRT::Core::VulkanRayTracingPipeline* placeholder = nullptr)->VulkanAsyncRayTracingPipeline;
+            void WaitIdle();
+
+            auto GetDevice()const noexcept -> const BulletRT::Core::VulkanDevice*;
+            auto GetWorkerPool()const noexcept -> VulkanWorkerPool*;
+            // Queued plus running requests.
+            auto GetPendingCount()const -> size_t;
+        private:
+            // Shared with the queued tasks, which may still run on the worker pool after the service is gone.
+            struct SharedState
+            {
+                std::mutex              mutex;
+                std::condition_variable idleCondition;
+                size_t                  queuedCount = 0;
+                size_t                  activeCount = 0;
+                bool                    isCancelled = false;
+            };
+            VulkanPipelineCompileService()noexcept;
+
+            // job is called with true when the request was cancelled before it started.
+            void Impl_Enqueue(std::function<void(bool)> job);
+        private:
+            const BulletRT::Core::VulkanDevice* m_Device;
+            VulkanWorkerPool*                   m_WorkerPool;
+            std::shared_ptr<SharedState>        m_State;
+            bool                                m_UseDeferredOperations;
+        };
+    }
+}
+#endif
@@ -0,0 +1,55 @@
+#ifndef BULLET_RT_UTILS_VULKAN_RAY_TRACING_PIPELINE_LIBRARY_CACHE_H
+#define BULLET_RT_UTILS_VULKAN_RAY_TRACING_PIPELINE_LIBRARY_CACHE_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanWorkerPool.h>
+#include <unordered_map>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        struct VulkanRayTracingPipelineLibraryDesc
+        {
+            // Caller chosen identity of the library, e.g. a material ID or a hash of its shaders.
+            uint64_t                                        key;
+            BulletRT::Core::VulkanRayTracingPipelineBuilder builder;
+        };
+        // Keeps ray tracing pipeline libraries (typically one per material's hit groups) by key, compiles the missing
+        // ones in parallel on a VulkanWorkerPool and links cached libraries into complete pipelines, so adding a
+        // material compiles only that material. All libraries linked together must share the layout, the library
+        // interface and the max recursion depth of the linking builder. Compile, Link and Remove may be called from
+        // any thread, but a library must not be removed while it is being linked.
+        class VulkanRayTracingPipelineLibraryCache
+        {
+        public:
+            static auto New(const BulletRT::Core::VulkanDevice* device, VulkanWorkerPool* workerPool = nullptr)->std::unique_ptr<VulkanRayTracingPipelineLibraryCache>;
+            ~VulkanRayTracingPipelineLibraryCache()noexcept;
+
+            // Builds every library whose key is not cached yet, adding eLibraryKHR to its flags. Returns
+            // eErrorInitializationFailed if any of them failed; the ones that succeeded are cached regardless.
+            auto Compile(const std::vector<VulkanRayTracingPipelineLibraryDesc>& descs)->vk::Result;
+            bool Contains(uint64_t key)const;
+            auto Get(uint64_t key)const -> const BulletRT::Core::VulkanRayTracingPipeline*;
+            bool Remove(uint64_t key);
+
+            // Links baseBuilder (usually raygen and miss groups) with the libraries of keys, in order. pGroupOffsets
+            // receives, per key, the index of the library's first group in the linked pipeline for SBT records.
+            auto Link(const BulletRT::Core::VulkanRayTracingPipelineBuilder& baseBuilder, const std::vector<uint64_t>& keys,
+                std::vector<uint32_t>* pGroupOffsets = nullptr)const->std::unique_ptr<BulletRT::Core::VulkanRayTracingPipeline>;
+
+            auto GetDevice()const noexcept -> const BulletRT::Core::VulkanDevice*;
+            auto GetWorkerPool()const noexcept -> VulkanWorkerPool*;
+            auto GetLibraryCount()const -> size_t;
+        private:
+            VulkanRayTracingPipelineLibraryCache()noexcept;
+
+            auto Impl_NewDeferredOperation()const -> std::unique_ptr<BulletRT::Core::VulkanDeferredOperation>;
+        private:
+            const BulletRT::Core::VulkanDevice*                                                  m_Device;
+            VulkanWorkerPool*                                                                    m_WorkerPool;
+            bool                                                                                 m_UseDeferredOperations;
+            std::unordered_map<uint64_t, std::unique_ptr<BulletRT::Core::VulkanRayTracingPipeline>> m_Libraries;
+            mutable std::mutex                                                                   m_Mutex;
+        };
+    }
+}
+#endif
@@ -1,13 +1,110 @@
 #ifndef BULLET_RT_UTILS_VULKAN_REFLECTION_H
 #define BULLET_RT_UTILS_VULKAN_REFLECTION_H
 #include <BulletRT/Core/BulletRTCore.h>
+#include <unordered_map>
 namespace BulletRT
 {
     namespace Utils
     {
-        class Allocator
+        struct VulkanReflectedDescriptorBinding
         {
+            uint32_t             set;
+            uint32_t             binding;
+            vk::DescriptorType   descriptorType;
+            // 0 for runtime sized arrays; set the real count (and variable count binding flags, if wanted) before
+            // creating layouts.
+            uint32_t             descriptorCount;
+            vk::ShaderStageFlags stageFlags;
+            std::string          name;
+        };
+        struct VulkanReflectedSpecializationConstant
+        {
+            uint32_t    constantID;
+            // Bytes the constant takes in VkSpecializationInfo::pData; booleans are VkBool32.
+            uint32_t    size;
+            std::string name;
+        };
+        struct VulkanReflectedVertexInput
+        {
+            uint32_t    location;
+            vk::Format  format;
+            std::string name;
+        };
+        // Interface of one entry point of a SPIR-V module.
+        struct VulkanShaderReflection
+        {
+            vk::ShaderStageFlagBits                            stage;
+            std::string                                        entryPoint;
+            std::vector<VulkanReflectedDescriptorBinding>      descriptorBindings;
+            // At most one range, covering the members the entry point actually uses.
+            std::vector<vk::PushConstantRange>                 pushConstantRanges;
+            std::vector<VulkanReflectedSpecializationConstant> specializationConstants;
+            // Vertex stage only; matrices take one entry per column.
+            std::vector<VulkanReflectedVertexInput>            vertexInputs;
+        };
+        // Interface of all stages of a pipeline, merged.
+        struct VulkanPipelineReflection
+        {
+            vk::ShaderStageFlags                                       stageFlags;
+            // Indexed by set number; sets no stage uses are empty.
+            std::vector<std::vector<VulkanReflectedDescriptorBinding>> setBindings;
+            // Identical ranges of different stages share one entry.
+            std::vector<vk::PushConstantRange>                         pushConstantRanges;
+            std::vector<VulkanReflectedSpecializationConstant>         specializationConstants;
+            std::vector<VulkanReflectedVertexInput>                    vertexInputs;
+        };
+        struct VulkanReflectedPipelineLayout
+        {
+            std::vector<vk::UniqueDescriptorSetLayout>            setLayouts;
+            std::unique_ptr<BulletRT::Core::VulkanPipelineLayout> pipelineLayout;
+        };
+        // Reflects SPIR-V with SPIRV-Cross and turns the merged interface of a pipeline's stages into descriptor set
+        // layouts and a pipeline layout, so layouts no longer have to be kept in sync with shaders by hand. Results
+        // are cached by a hash of the SPIR-V and entry point, so each unique module is parsed once. Entries keep a copy of
+        // the code and a hit compares it and the entry point, so colliding hashes never share a reflection. Thread safe.
+        class VulkanReflection
+        {
+        public:
+            static auto New(const BulletRT::Core::VulkanDevice* device)->std::unique_ptr<VulkanReflection>;
+            ~VulkanReflection()noexcept;
+
+            // An empty entryPoint selects the module's first entry point. Null if the code is not valid SPIR-V or
+            // has no such entry point.
+            auto Reflect(const std::vector<uint32_t>& codes, const std::string& entryPoint = "") -> std::shared_ptr<const VulkanShaderReflection>;
+            auto Reflect(const BulletRT::Core::VulkanShaderModule* module, const std::string& entryPoint = "") -> std::shared_ptr<const VulkanShaderReflection>;
+            // Reflects and merges every stage, taking the code from the stage's module or module builder.
+            auto Reflect(const std::vector<BulletRT::Core::VulkanPipelineShaderStageDesc>& stages) -> std::optional<VulkanPipelineReflection>;
+
+            // Nullopt if two stages declare the same set and binding with different descriptor types.
+            static auto Merge(const std::vector<const VulkanShaderReflection*>& reflections)->std::optional<VulkanPipelineReflection>;
+
+            // Nullopt if a binding still has a descriptorCount of 0, i.e. a runtime sized array whose count was not set.
+            // pBindingFlags, if given, is indexed like setBindings and chained as VkDescriptorSetLayoutBindingFlagsCreateInfo
+            // so such bindings can be made variable count. CreatePipelineLayout is also nullopt if the layout cannot be built.
+            auto CreateDescriptorSetLayouts(const VulkanPipelineReflection& reflection, vk::DescriptorSetLayoutCreateFlags flags = {},
+                const std::vector<std::vector<vk::DescriptorBindingFlags>>* pBindingFlags = nullptr)const -> std::optional<std::vector<vk::UniqueDescriptorSetLayout>>;
+            auto CreatePipelineLayout(const VulkanPipelineReflection& reflection, vk::DescriptorSetLayoutCreateFlags setLayoutFlags = {},
+                const std::vector<std::vector<vk::DescriptorBindingFlags>>* pBindingFlags = nullptr)const -> std::optional<VulkanReflectedPipelineLayout>;
+
+            auto GetDevice()const noexcept -> const BulletRT::Core::VulkanDevice*;
+            auto GetReflectionCount()const -> size_t;
+            void Clear();
+        private:
+            struct ReflectionDesc
+            {
+                std::vector<uint32_t>                         codes;
+                std::string                                   entryPoint;
+                std::shared_ptr<const VulkanShaderReflection> reflection;
+            };
+            using ReflectionMap = std::unordered_multimap<uint64_t, ReflectionDesc>;
+
+            VulkanReflection()noexcept;
 
+            auto Impl_Find(uint64_t hash, const std::vector<uint32_t>& codes, const std::string& entryPoint)const -> std::shared_ptr<const VulkanShaderReflection>;
+        private:
+            const BulletRT::Core::VulkanDevice* m_Device;
+            ReflectionMap                       m_Reflections;
+            mutable std::mutex                  m_Mutex;
         };
     }
 }
@@ -0,0 +1,64 @@
+#ifndef BULLET_RT_UTILS_VULKAN_SCRATCH_POOL_H
+#define BULLET_RT_UTILS_VULKAN_SCRATCH_POOL_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanBufferPool.h>
+#include <deque>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        struct VulkanScratchAllocation
+        {
+            vk::DeviceAddress                  deviceAddress;
+            vk::DeviceSize                     size;
+            BulletRT::Core::VulkanBufferRegion region;
+        };
+        struct VulkanScratchPoolStatistics
+        {
+            size_t         blockCount;
+            vk::DeviceSize totalSize;
+            vk::DeviceSize allocatedSize;
+            size_t         allocationCount;
+            size_t         pendingFreeCount;
+        };
+        // Hands out acceleration structure scratch ranges, aligned to minAccelerationStructureScratchOffsetAlignment,
+        // from the device local blocks of a VulkanBufferPool, which grows when no block can satisfy a request and
+        // releases blocks once they are empty. Ranges are freed against a timeline value and only returned to the
+        // pool once Reclaim reports that value as completed. Not thread safe.
+        class VulkanScratchPool
+        {
+        public:
+            // blockSize is the size of each VulkanBufferPool block; larger requests get a block of their own.
+            static auto New(VulkanAllocator* allocator, vk::DeviceSize blockSize = 32 * 1024 * 1024,
+                VulkanOffsetAllocatorStrategy strategy = VulkanOffsetAllocatorStrategy::eTlsf)->std::unique_ptr<VulkanScratchPool>;
+            ~VulkanScratchPool()noexcept;
+
+            auto Allocate(vk::DeviceSize size)->std::optional<VulkanScratchAllocation>;
+            auto Allocate(const BulletRT::Core::VulkanAccelerationStructure* accelerationStructure,
+                vk::BuildAccelerationStructureModeKHR mode = vk::BuildAccelerationStructureModeKHR::eBuild)->std::optional<VulkanScratchAllocation>;
+            // The range stays reserved until Reclaim is called with a value of at least timelineValue.
+            void Free(const VulkanScratchAllocation& allocation, uint64_t timelineValue);
+            void Reclaim(uint64_t completedValue);
+            auto Reclaim(const BulletRT::Core::VulkanSemaphore* timelineSemaphore)->vk::Result;
+
+            auto GetDevice()const noexcept -> const BulletRT::Core::VulkanDevice*;
+            auto GetBlockSize()const noexcept -> vk::DeviceSize;
+            auto GetAlignment()const noexcept -> vk::DeviceSize;
+            auto QueryStatistics()const -> VulkanScratchPoolStatistics;
+        private:
+            struct PendingFreeDesc
+            {
+                uint64_t                timelineValue;
+                VulkanScratchAllocation allocation;
+            };
+            VulkanScratchPool()noexcept;
+        private:
+            std::unique_ptr<VulkanBufferPool> m_BufferPool;
+            vk::DeviceSize                    m_Alignment;
+            vk::DeviceSize                    m_AllocatedSize;
+            size_t                            m_AllocationCount;
+            std::deque<PendingFreeDesc>       m_PendingFrees;
+        };
+    }
+}
+#endif
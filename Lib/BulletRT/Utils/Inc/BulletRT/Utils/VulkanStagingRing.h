@@ -0,0 +1,50 @@
+#ifndef BULLET_RT_UTILS_VULKAN_STAGING_RING_H
+#define BULLET_RT_UTILS_VULKAN_STAGING_RING_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanStaging.h>
+#include <functional>
+#include <unordered_map>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Uses a VulkanStaging buffer as a ring and batches the copy regions written into it per destination
+        // buffer. VulkanStagingStream and VulkanAsyncUploader build on it and only differ in how a batch is
+        // submitted and retired. Not thread safe.
+        class VulkanStagingRing
+        {
+        public:
+            using BatchRegions = std::unordered_map<const BulletRT::Core::VulkanBuffer*, std::vector<vk::BufferCopy>>;
+
+            static auto New(const VulkanStaging* staging)->std::unique_ptr<VulkanStagingRing>;
+            ~VulkanStagingRing()noexcept;
+
+            // Copies pData into the ring in contiguous chunks and records them as regions of dstBuffer. flush submits
+            // the open batch and is called once the batch covers half of the ring. When the ring is full, flush is
+            // followed by retire, which releases the oldest submitted batch and returns false if there is none.
+            auto Write(const void* pData, vk::DeviceSize sizeInBytes, const BulletRT::Core::VulkanBuffer* dstBuffer, vk::DeviceSize dstOffset,
+                const std::function<vk::Result()>& flush, const std::function<bool()>& retire)->vk::Result;
+            // Closes the open batch and returns the ring space it covers, to be passed to Release once its copies completed.
+            auto EndBatch()noexcept -> vk::DeviceSize;
+            void Release(vk::DeviceSize sizeInBytes)noexcept;
+
+            auto GetStaging()const noexcept -> const VulkanStaging*;
+            auto GetSize()const noexcept -> vk::DeviceSize;
+            auto GetUsedSize()const noexcept -> vk::DeviceSize;
+            auto GetBatchSize()const noexcept -> vk::DeviceSize;
+            auto GetBatchRegions()const noexcept -> const BatchRegions&;
+        private:
+            VulkanStagingRing()noexcept;
+
+            auto Impl_Reserve(vk::DeviceSize sizeInBytes, vk::DeviceSize* pOffset)noexcept -> vk::DeviceSize;
+        private:
+            const VulkanStaging* m_Staging;
+            void*                m_MappedData;
+            vk::DeviceSize       m_Head;
+            vk::DeviceSize       m_UsedSize;
+            vk::DeviceSize       m_BatchSize;
+            BatchRegions         m_BatchRegions;
+        };
+    }
+}
+#endif
@@ -0,0 +1,47 @@
+#ifndef BULLET_RT_UTILS_VULKAN_STAGING_STREAM_H
+#define BULLET_RT_UTILS_VULKAN_STAGING_STREAM_H
+#include <BulletRT/Core/BulletRTCore.h>
+#include <BulletRT/Utils/VulkanStagingRing.h>
+#include <deque>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Streams arbitrarily large uploads through a VulkanStaging buffer used as a ring.
+        // Copies are batched per destination buffer and submitted whenever half of the ring
+        // is filled; ring space is recycled as the batches' pooled fences signal. Not thread safe.
+        class VulkanStagingStream
+        {
+        public:
+            static auto New(const VulkanStaging* staging, const BulletRT::Core::VulkanCommandPool* commandPool, const BulletRT::Core::VulkanQueue& queue)->std::unique_ptr<VulkanStagingStream>;
+            ~VulkanStagingStream()noexcept;
+
+            auto Upload(const void* pData, vk::DeviceSize sizeInBytes, const BulletRT::Core::VulkanBuffer* dstBuffer, vk::DeviceSize dstOffset = 0)->vk::Result;
+            auto Flush()->vk::Result;
+            auto Finish()->vk::Result;
+
+            auto GetStaging()const noexcept -> const VulkanStaging*;
+            auto GetCommandPool()const noexcept -> const BulletRT::Core::VulkanCommandPool*;
+            auto GetSize()const noexcept -> vk::DeviceSize;
+            auto GetUsedSize()const noexcept -> vk::DeviceSize;
+            auto GetPendingBatchCount()const noexcept -> size_t;
+        private:
+            struct BatchDesc
+            {
+                std::unique_ptr<BulletRT::Core::VulkanCommandBuffer> commandBuffer;
+                std::unique_ptr<BulletRT::Core::VulkanFence>         fence;
+                vk::DeviceSize                                       sizeInBytes;
+            };
+            VulkanStagingStream()noexcept;
+
+            bool Impl_RetireOldestBatch(bool wait);
+        private:
+            std::unique_ptr<VulkanStagingRing>                        m_Ring;
+            const BulletRT::Core::VulkanCommandPool*                  m_CommandPool;
+            vk::Queue                                                 m_Queue;
+            std::deque<BatchDesc>                                     m_Batches;
+            std::vector<std::unique_ptr<BulletRT::Core::VulkanCommandBuffer>> m_FreeCommandBuffers;
+        };
+    }
+}
+#endif
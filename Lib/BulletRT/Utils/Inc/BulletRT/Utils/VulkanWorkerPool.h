@@ -0,0 +1,56 @@
+#ifndef BULLET_RT_UTILS_VULKAN_WORKER_POOL_H
+#define BULLET_RT_UTILS_VULKAN_WORKER_POOL_H
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace BulletRT
+{
+    namespace Utils
+    {
+        // Fixed set of worker threads executing one ParallelFor at a time plus a queue of background tasks.
+        // The calling thread takes part in a ParallelFor, so a pool of N workers runs it on up to N + 1 threads;
+        // workers busy with a task join once the task returns.
+        class VulkanWorkerPool
+        {
+        public:
+            static auto New(uint32_t workerCount = 0)->std::unique_ptr<VulkanWorkerPool>;
+            ~VulkanWorkerPool()noexcept;
+
+            // Calls func(begin, end) for consecutive ranges of at most grainSize items covering [0, count)
+            // and returns once every range has been processed.
+            void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func);
+            // Queues task to run on a worker without waiting for it. Idle workers prefer ParallelFor ranges over
+            // queued tasks. Tasks still queued at destruction run before the destructor returns. A pool without
+            // workers runs the task on the calling thread.
+            void Submit(std::function<void()> task);
+            // Callable forwarding to Submit, e.g. as the job submitter of a BulletRT::Core::VulkanDeferredOperation.
+            // The pool must outlive it.
+            auto GetSubmitter()noexcept -> std::function<void(std::function<void()>)>;
+
+            auto GetWorkerCount()const noexcept -> uint32_t;
+            auto GetThreadCount()const noexcept -> uint32_t;
+        private:
+            VulkanWorkerPool()noexcept;
+
+            void Impl_WorkerMain();
+            void Impl_RunRanges();
+        private:
+            std::vector<std::thread>                 m_Workers;
+            std::mutex                               m_Mutex;
+            std::condition_variable                  m_WorkCondition;
+            std::condition_variable                  m_DoneCondition;
+            const std::function<void(size_t, size_t)>* m_Func;
+            size_t                                   m_Count;
+            size_t                                   m_GrainSize;
+            size_t                                   m_NextBegin;
+            size_t                                   m_ActiveCount;
+            std::deque<std::function<void()>>        m_Tasks;
+            bool                                     m_Exit;
+        };
+    }
+}
+#endif
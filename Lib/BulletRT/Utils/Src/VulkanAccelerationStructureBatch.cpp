@@ -0,0 +1,131 @@
+#include <BulletRT/Utils/VulkanAccelerationStructureBatch.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+#include <algorithm>
+
+auto BulletRT::Utils::VulkanAccelerationStructureBatch::New(VulkanAllocator* allocator, vk::DeviceSize scratchBudget) -> std::unique_ptr<VulkanAccelerationStructureBatch>
+{
+    if (!allocator || scratchBudget == 0 || !allocator->GetDevice()->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) {
+        return nullptr;
+    }
+    auto device = allocator->GetDevice();
+    auto scratchAlignment = device->GetPhysicalDeviceVk().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceAccelerationStructurePropertiesKHR>()
+        .get<vk::PhysicalDeviceAccelerationStructurePropertiesKHR>().minAccelerationStructureScratchOffsetAlignment;
+    scratchAlignment = std::max<vk::DeviceSize>(scratchAlignment, 1);
+    auto scratch = allocator->NewBuffer(BulletRT::Core::VulkanBuffer::Builder()
+        .SetUsage(vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress)
+        .SetSize(CalcAlignedSize(scratchBudget, scratchAlignment) + scratchAlignment),
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+    if (!scratch || !scratch->GetMemoryBuffer()->GetDeviceAddress()) {
+        return nullptr;
+    }
+    auto batch = new VulkanAccelerationStructureBatch();
+    batch->m_Device           = device;
+    batch->m_ScratchBudget    = CalcAlignedSize(scratchBudget, scratchAlignment);
+    batch->m_ScratchAlignment = scratchAlignment;
+    batch->m_ScratchAddress   = CalcAlignedSize(scratch->GetMemoryBuffer()->GetDeviceAddress().value(), scratchAlignment);
+    batch->m_Scratch          = std::move(scratch);
+    return std::unique_ptr<VulkanAccelerationStructureBatch>(batch);
+}
+
+BulletRT::Utils::VulkanAccelerationStructureBatch::~VulkanAccelerationStructureBatch() noexcept
+{
+    m_Builds.clear();
+    m_Scratch.reset();
+}
+
+bool BulletRT::Utils::VulkanAccelerationStructureBatch::Add(const BulletRT::Core::VulkanAccelerationStructure* accelerationStructure, vk::BuildAccelerationStructureModeKHR mode)
+{
+    if (!accelerationStructure || accelerationStructure->GetBuildType() != vk::AccelerationStructureBuildTypeKHR::eDevice) {
+        return false;
+    }
+    if (mode == vk::BuildAccelerationStructureModeKHR::eUpdate && !(accelerationStructure->GetFlags() & vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate)) {
+        return false;
+    }
+    if (CalcAlignedSize(accelerationStructure->GetScratchSize(mode), m_ScratchAlignment) > m_ScratchBudget) {
+        return false;
+    }
+    m_Builds.push_back(BuildDesc{ accelerationStructure, mode });
+    return true;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureBatch::Record(vk::CommandBuffer commandBuffer) -> vk::Result
+{
+    m_LastCallCount = 0;
+    if (m_Builds.empty()) {
+        return vk::Result::eSuccess;
+    }
+    auto buildBarrier = vk::MemoryBarrier()
+        .setSrcAccessMask(vk::AccessFlagBits::eAccelerationStructureWriteKHR)
+        .setDstAccessMask(vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR);
+    auto geometries         = std::vector<std::vector<vk::AccelerationStructureGeometryKHR>>(m_Builds.size());
+    auto buildRangeInfos    = std::vector<std::vector<vk::AccelerationStructureBuildRangeInfoKHR>>(m_Builds.size());
+    auto callGeometryInfos  = std::vector<vk::AccelerationStructureBuildGeometryInfoKHR>();
+    auto callRangeInfos     = std::vector<const vk::AccelerationStructureBuildRangeInfoKHR*>();
+    auto scratchOffset      = vk::DeviceSize(0);
+    auto recordCall = [&]() {
+        if (callGeometryInfos.empty()) {
+            return;
+        }
+        if (m_LastCallCount > 0) {
+            // The previous call still owns the scratch buffer until its builds complete.
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, {}, buildBarrier, nullptr, nullptr);
+        }
+        commandBuffer.buildAccelerationStructuresKHR(callGeometryInfos, callRangeInfos);
+        callGeometryInfos.clear();
+        callRangeInfos.clear();
+        scratchOffset = 0;
+        ++m_LastCallCount;
+    };
+    for (size_t i = 0; i < m_Builds.size(); ++i) {
+        auto& build      = m_Builds[i];
+        auto scratchSize = CalcAlignedSize(build.accelerationStructure->GetScratchSize(build.mode), m_ScratchAlignment);
+        if (scratchOffset + scratchSize > m_ScratchBudget) {
+            recordCall();
+        }
+        buildRangeInfos[i] = build.accelerationStructure->GetBuildRangeInfoVks();
+        callGeometryInfos.push_back(build.accelerationStructure->GetBuildGeometryInfoVk(geometries[i], build.mode)
+            .setScratchData(vk::DeviceOrHostAddressKHR().setDeviceAddress(m_ScratchAddress + scratchOffset)));
+        callRangeInfos.push_back(buildRangeInfos[i].data());
+        scratchOffset += scratchSize;
+    }
+    recordCall();
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+        vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits::eRayTracingShaderKHR, {},
+        buildBarrier, nullptr, nullptr);
+    m_Builds.clear();
+    return vk::Result::eSuccess;
+}
+
+void BulletRT::Utils::VulkanAccelerationStructureBatch::Clear()
+{
+    m_Builds.clear();
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureBatch::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice*
+{
+    return m_Device;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureBatch::GetScratchBudget() const noexcept -> vk::DeviceSize
+{
+    return m_ScratchBudget;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureBatch::GetPendingCount() const noexcept -> size_t
+{
+    return m_Builds.size();
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureBatch::GetLastCallCount() const noexcept -> uint32_t
+{
+    return m_LastCallCount;
+}
+
+BulletRT::Utils::VulkanAccelerationStructureBatch::VulkanAccelerationStructureBatch() noexcept
+{
+    m_Device           = nullptr;
+    m_ScratchBudget    = 0;
+    m_ScratchAlignment = 1;
+    m_ScratchAddress   = 0;
+    m_LastCallCount    = 0;
+}
@@ -0,0 +1,390 @@
+#include <BulletRT/Utils/VulkanAccelerationStructureCache.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+static constexpr uint32_t       kFileMagic     = 0x41545242; // "BRTA"
+static constexpr uint32_t       kFileVersion   = 1;
+static constexpr vk::DeviceSize kBlobAlignment = 256;
+static constexpr uint32_t       kMaxEntryCount = 1u << 20;
+struct VulkanAccelerationStructureCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint32_t entryCount;
+    uint8_t  driverUUID[VK_UUID_SIZE];
+};
+struct VulkanAccelerationStructureCacheEntry
+{
+    uint64_t key;
+    uint64_t offset;
+    uint64_t size;
+};
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::New(VulkanAllocator* allocator, const BulletRT::Core::VulkanCommandPool* commandPool, const BulletRT::Core::VulkanQueue& queue, const std::string& path) -> std::unique_ptr<VulkanAccelerationStructureCache>
+{
+    if (!allocator || !commandPool || allocator->GetDevice() != commandPool->GetDevice() || commandPool->GetQueueFamilyIndex() != queue.GetQueueFamilyIndex()) {
+        return nullptr;
+    }
+    auto device = commandPool->GetDevice();
+    if (!device->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) {
+        return nullptr;
+    }
+    auto properties = device->GetPhysicalDeviceVk().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceIDProperties>();
+    auto cache = new VulkanAccelerationStructureCache();
+    cache->m_Allocator        = allocator;
+    cache->m_Device           = device;
+    cache->m_CommandPool      = commandPool;
+    cache->m_Queue            = queue;
+    cache->m_Path             = path;
+    cache->m_DeviceProperties = properties.get<vk::PhysicalDeviceProperties2>().properties;
+    std::copy(std::begin(properties.get<vk::PhysicalDeviceIDProperties>().driverUUID), std::end(properties.get<vk::PhysicalDeviceIDProperties>().driverUUID), std::begin(cache->m_DriverUUID));
+    cache->Impl_Load();
+    return std::unique_ptr<VulkanAccelerationStructureCache>(cache);
+}
+
+BulletRT::Utils::VulkanAccelerationStructureCache::~VulkanAccelerationStructureCache() noexcept
+{
+    m_Entries.clear();
+}
+
+bool BulletRT::Utils::VulkanAccelerationStructureCache::Contains(uint64_t contentHash, const BulletRT::Core::VulkanAccelerationStructureBuilder& builder) const
+{
+    if (builder.GetType() == vk::AccelerationStructureTypeKHR::eTopLevel) {
+        return false;
+    }
+    return m_Entries.count(Impl_MakeKey(contentHash, builder.GetType(), builder.GetFlags(), builder.GetGeometries())) > 0;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::Store(const std::vector<StoreDesc>& descs) -> vk::Result
+{
+    if (descs.empty()) {
+        return vk::Result::eSuccess;
+    }
+    auto accelerationStructureVks = std::vector<vk::AccelerationStructureKHR>();
+    for (auto& desc : descs) {
+        // Deserializing a TLAS does not patch the BLAS addresses in its instances, so it is never cached.
+        if (!desc.accelerationStructure || desc.accelerationStructure->GetType() == vk::AccelerationStructureTypeKHR::eTopLevel) {
+            return vk::Result::eErrorUnknown;
+        }
+        accelerationStructureVks.push_back(desc.accelerationStructure->GetAccelerationStructureVk());
+    }
+    auto queryCount = static_cast<uint32_t>(descs.size());
+    auto queryPool  = m_Device->GetDeviceVk().createQueryPoolUnique(vk::QueryPoolCreateInfo()
+        .setQueryType(vk::QueryType::eAccelerationStructureSerializationSizeKHR)
+        .setQueryCount(queryCount));
+    auto commandBuffer = m_CommandPool->NewCommandBuffer(vk::CommandBufferLevel::ePrimary);
+    if (!queryPool || !commandBuffer) {
+        return vk::Result::eErrorOutOfHostMemory;
+    }
+    auto commandBufferVk = commandBuffer->GetCommandBufferVk();
+    commandBufferVk.begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    commandBufferVk.resetQueryPool(queryPool.get(), 0, queryCount);
+    commandBufferVk.writeAccelerationStructuresPropertiesKHR(accelerationStructureVks, vk::QueryType::eAccelerationStructureSerializationSizeKHR, queryPool.get(), 0);
+    commandBufferVk.end();
+    auto res = Impl_Submit(commandBufferVk);
+    if (res != vk::Result::eSuccess) {
+        return res;
+    }
+    auto queryResults = m_Device->GetDeviceVk().getQueryPoolResults<vk::DeviceSize>(queryPool.get(), 0, queryCount,
+        queryCount * sizeof(vk::DeviceSize), sizeof(vk::DeviceSize), vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+    if (queryResults.result != vk::Result::eSuccess) {
+        return queryResults.result;
+    }
+    // All blobs are read back through one buffer and one submission.
+    auto offsets   = std::vector<vk::DeviceSize>(descs.size());
+    auto totalSize = vk::DeviceSize(0);
+    for (size_t i = 0; i < descs.size(); ++i) {
+        offsets[i] = totalSize;
+        totalSize  = CalcAlignedSize(totalSize + queryResults.value[i], kBlobAlignment);
+    }
+    auto readback = Impl_NewHostBuffer(totalSize, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress);
+    if (!readback) {
+        return vk::Result::eErrorOutOfDeviceMemory;
+    }
+    auto readbackAddress = readback->GetMemoryBuffer()->GetDeviceAddress().value();
+    commandBufferVk.reset();
+    commandBufferVk.begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    for (size_t i = 0; i < descs.size(); ++i) {
+        commandBufferVk.copyAccelerationStructureToMemoryKHR(vk::CopyAccelerationStructureToMemoryInfoKHR()
+            .setSrc(accelerationStructureVks[i])
+            .setDst(vk::DeviceOrHostAddressKHR().setDeviceAddress(readbackAddress + offsets[i]))
+            .setMode(vk::CopyAccelerationStructureModeKHR::eSerialize));
+    }
+    commandBufferVk.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR, vk::PipelineStageFlagBits::eHost, {},
+        vk::MemoryBarrier().setSrcAccessMask(vk::AccessFlagBits::eTransferWrite).setDstAccessMask(vk::AccessFlagBits::eHostRead),
+        nullptr, nullptr);
+    commandBufferVk.end();
+    res = Impl_Submit(commandBufferVk);
+    if (res != vk::Result::eSuccess) {
+        return res;
+    }
+    res = readback->GetMemoryBuffer()->InvalidateMappedRange();
+    if (res != vk::Result::eSuccess) {
+        return res;
+    }
+    auto pMappedData = static_cast<const uint8_t*>(readback->GetMappedData());
+    for (size_t i = 0; i < descs.size(); ++i) {
+        auto accelerationStructure = descs[i].accelerationStructure;
+        auto key = Impl_MakeKey(descs[i].contentHash, accelerationStructure->GetType(), accelerationStructure->GetFlags(), accelerationStructure->GetGeometries());
+        m_Entries[key].assign(pMappedData + offsets[i], pMappedData + offsets[i] + queryResults.value[i]);
+    }
+    return vk::Result::eSuccess;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::Load(const std::vector<LoadDesc>& descs) -> std::vector<std::unique_ptr<BulletRT::Core::VulkanAccelerationStructure>>
+{
+    auto accelerationStructures = std::vector<std::unique_ptr<BulletRT::Core::VulkanAccelerationStructure>>(descs.size());
+    auto blobs     = std::vector<const std::vector<uint8_t>*>(descs.size(), nullptr);
+    auto offsets   = std::vector<vk::DeviceSize>(descs.size());
+    auto totalSize = vk::DeviceSize(0);
+    // Serialized blobs begin with the driver and compatibility UUIDs, then the serialized and deserialized sizes.
+    constexpr size_t versionDataSize = 2 * VK_UUID_SIZE;
+    constexpr size_t blobHeaderSize  = versionDataSize + 2 * sizeof(uint64_t);
+    for (size_t i = 0; i < descs.size(); ++i) {
+        auto& builder = descs[i].builder;
+        if (builder.GetType() == vk::AccelerationStructureTypeKHR::eTopLevel) {
+            continue;
+        }
+        auto iter = m_Entries.find(Impl_MakeKey(descs[i].contentHash, builder.GetType(), builder.GetFlags(), builder.GetGeometries()));
+        if (iter == std::end(m_Entries) || iter->second.size() < blobHeaderSize) {
+            continue;
+        }
+        auto compatibility = m_Device->GetDeviceVk().getAccelerationStructureCompatibilityKHR(vk::AccelerationStructureVersionInfoKHR().setPVersionData(iter->second.data()));
+        if (compatibility != vk::AccelerationStructureCompatibilityKHR::eCompatible) {
+            continue;
+        }
+        auto deserializedSize = uint64_t(0);
+        std::memcpy(&deserializedSize, iter->second.data() + versionDataSize + sizeof(uint64_t), sizeof(deserializedSize));
+        accelerationStructures[i] = BulletRT::Core::VulkanAccelerationStructureBuilder(builder)
+            .SetStorageSize(deserializedSize)
+            .Build(m_Device);
+        if (!accelerationStructures[i]) {
+            continue;
+        }
+        blobs[i]   = &iter->second;
+        offsets[i] = totalSize;
+        totalSize  = CalcAlignedSize(totalSize + iter->second.size(), kBlobAlignment);
+    }
+    if (totalSize == 0) {
+        return accelerationStructures;
+    }
+    auto upload        = Impl_NewHostBuffer(totalSize, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress);
+    auto commandBuffer = m_CommandPool->NewCommandBuffer(vk::CommandBufferLevel::ePrimary);
+    auto dropAll = [&]() {
+        for (size_t i = 0; i < descs.size(); ++i) {
+            if (blobs[i]) {
+                accelerationStructures[i].reset();
+            }
+        }
+        return std::move(accelerationStructures);
+    };
+    if (!upload || !commandBuffer) {
+        return dropAll();
+    }
+    auto pMappedData   = static_cast<uint8_t*>(upload->GetMappedData());
+    auto uploadAddress = upload->GetMemoryBuffer()->GetDeviceAddress().value();
+    auto commandBufferVk = commandBuffer->GetCommandBufferVk();
+    commandBufferVk.begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    for (size_t i = 0; i < descs.size(); ++i) {
+        if (!blobs[i]) {
+            continue;
+        }
+        std::memcpy(pMappedData + offsets[i], blobs[i]->data(), blobs[i]->size());
+        commandBufferVk.copyMemoryToAccelerationStructureKHR(vk::CopyMemoryToAccelerationStructureInfoKHR()
+            .setSrc(vk::DeviceOrHostAddressConstKHR().setDeviceAddress(uploadAddress + offsets[i]))
+            .setDst(accelerationStructures[i]->GetAccelerationStructureVk())
+            .setMode(vk::CopyAccelerationStructureModeKHR::eDeserialize));
+    }
+    commandBufferVk.pipelineBarrier(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+        vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR | vk::PipelineStageFlagBits::eRayTracingShaderKHR, {},
+        vk::MemoryBarrier()
+            .setSrcAccessMask(vk::AccessFlagBits::eAccelerationStructureWriteKHR)
+            .setDstAccessMask(vk::AccessFlagBits::eAccelerationStructureReadKHR | vk::AccessFlagBits::eAccelerationStructureWriteKHR),
+        nullptr, nullptr);
+    commandBufferVk.end();
+    if (upload->GetMemoryBuffer()->FlushMappedRange() != vk::Result::eSuccess || Impl_Submit(commandBufferVk) != vk::Result::eSuccess) {
+        return dropAll();
+    }
+    return accelerationStructures;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::Save() const -> bool
+{
+    auto header = VulkanAccelerationStructureCacheHeader{};
+    header.magic         = kFileMagic;
+    header.version       = kFileVersion;
+    header.vendorID      = m_DeviceProperties.vendorID;
+    header.deviceID      = m_DeviceProperties.deviceID;
+    header.driverVersion = m_DeviceProperties.driverVersion;
+    header.entryCount    = static_cast<uint32_t>(m_Entries.size());
+    std::copy(std::begin(m_DriverUUID), std::end(m_DriverUUID), std::begin(header.driverUUID));
+    auto entries = std::vector<VulkanAccelerationStructureCacheEntry>();
+    entries.reserve(m_Entries.size());
+    auto offset = CalcAlignedSize(sizeof(header) + sizeof(VulkanAccelerationStructureCacheEntry) * m_Entries.size(), kBlobAlignment);
+    for (auto& [key, blob] : m_Entries) {
+        entries.push_back(VulkanAccelerationStructureCacheEntry{ key, offset, blob.size() });
+        offset = CalcAlignedSize(offset + blob.size(), kBlobAlignment);
+    }
+    // Written next to the old file and renamed over it, so a crash mid-write never leaves a truncated cache.
+    auto temporaryPath = m_Path + ".tmp";
+    {
+        auto file = std::ofstream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(entries.data()), sizeof(VulkanAccelerationStructureCacheEntry) * entries.size());
+        for (auto& entry : entries) {
+            auto& blob = m_Entries.at(entry.key);
+            file.seekp(static_cast<std::streamoff>(entry.offset));
+            file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        }
+        file.flush();
+        if (!file) {
+            file.close();
+            auto errorCode = std::error_code();
+            std::filesystem::remove(temporaryPath, errorCode);
+            return false;
+        }
+    }
+    auto errorCode = std::error_code();
+    std::filesystem::rename(temporaryPath, m_Path, errorCode);
+    if (errorCode) {
+        std::filesystem::remove(temporaryPath, errorCode);
+        return false;
+    }
+    return true;
+}
+
+void BulletRT::Utils::VulkanAccelerationStructureCache::Clear()
+{
+    m_Entries.clear();
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::GetPath() const noexcept -> const std::string&
+{
+    return m_Path;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::GetEntryCount() const noexcept -> size_t
+{
+    return m_Entries.size();
+}
+
+BulletRT::Utils::VulkanAccelerationStructureCache::VulkanAccelerationStructureCache() noexcept
+{
+    m_Allocator        = nullptr;
+    m_Device           = nullptr;
+    m_CommandPool      = nullptr;
+    m_Queue            = std::nullopt;
+    m_Path             = {};
+    m_DeviceProperties = {};
+    m_DriverUUID       = {};
+    m_Entries          = {};
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::Impl_MakeKey(uint64_t contentHash, vk::AccelerationStructureTypeKHR type, vk::BuildAccelerationStructureFlagsKHR flags,
+    const std::vector<BulletRT::Core::VulkanAccelerationStructureGeometryDesc>& geometries) noexcept -> uint64_t
+{
+    auto key = BulletRT::Core::HashBytes(&contentHash, sizeof(contentHash));
+    auto typeVk  = static_cast<uint32_t>(type);
+    auto flagsVk = static_cast<uint32_t>(flags);
+    key = BulletRT::Core::HashBytes(&typeVk, sizeof(typeVk), key);
+    key = BulletRT::Core::HashBytes(&flagsVk, sizeof(flagsVk), key);
+    for (auto& geometry : geometries) {
+        uint32_t layout[] = {
+            static_cast<uint32_t>(geometry.GetGeometryType()),
+            static_cast<uint32_t>(VkGeometryFlagsKHR(geometry.GetFlags())),
+            geometry.GetPrimitiveCount(),
+            static_cast<uint32_t>(geometry.GetVertexFormat()),
+            static_cast<uint32_t>(geometry.GetVertexStride()),
+            geometry.GetMaxVertex(),
+            static_cast<uint32_t>(geometry.GetIndexType()),
+        };
+        key = BulletRT::Core::HashBytes(layout, sizeof(layout), key);
+    }
+    return key;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::Impl_NewHostBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage) const -> std::unique_ptr<VulkanAllocation>
+{
+    auto builder    = BulletRT::Core::VulkanBuffer::Builder().SetUsage(usage).SetSize(size);
+    auto allocation = m_Allocator->NewBuffer(builder, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCached);
+    if (!allocation) {
+        allocation = m_Allocator->NewBuffer(builder, vk::MemoryPropertyFlagBits::eHostVisible);
+    }
+    if (!allocation || !allocation->GetMappedData() || !allocation->GetMemoryBuffer()->GetDeviceAddress()) {
+        return nullptr;
+    }
+    return allocation;
+}
+
+auto BulletRT::Utils::VulkanAccelerationStructureCache::Impl_Submit(vk::CommandBuffer commandBuffer) const -> vk::Result
+{
+    auto fence = m_Device->AcquireFence();
+    if (!fence) {
+        return vk::Result::eErrorOutOfHostMemory;
+    }
+    auto res = m_Queue->Submit(BulletRT::Core::VulkanSubmitDesc().AddCommandBuffer(commandBuffer), fence.get());
+    if (res == vk::Result::eSuccess) {
+        res = fence->Wait(UINT64_MAX);
+    }
+    m_Device->ReleaseFence(std::move(fence));
+    return res;
+}
+
+bool BulletRT::Utils::VulkanAccelerationStructureCache::Impl_Load()
+{
+    auto file = std::ifstream(m_Path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    auto fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    auto header = VulkanAccelerationStructureCacheHeader{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (header.magic != kFileMagic || header.version != kFileVersion ||
+        header.vendorID != m_DeviceProperties.vendorID || header.deviceID != m_DeviceProperties.deviceID ||
+        header.driverVersion != m_DeviceProperties.driverVersion ||
+        !std::equal(std::begin(m_DriverUUID), std::end(m_DriverUUID), std::begin(header.driverUUID))) {
+        return false;
+    }
+    // Sizes read from the file only drive allocations once they are known to lie within it.
+    auto tableEnd = sizeof(header) + sizeof(VulkanAccelerationStructureCacheEntry) * static_cast<uint64_t>(header.entryCount);
+    if (header.entryCount > kMaxEntryCount || tableEnd > fileSize) {
+        return false;
+    }
+    try {
+        auto entries = std::vector<VulkanAccelerationStructureCacheEntry>(header.entryCount);
+        if (!file.read(reinterpret_cast<char*>(entries.data()), sizeof(VulkanAccelerationStructureCacheEntry) * entries.size())) {
+            return false;
+        }
+        for (auto& entry : entries) {
+            if (entry.offset < tableEnd || entry.size > fileSize || entry.offset > fileSize - entry.size) {
+                m_Entries.clear();
+                return false;
+            }
+            auto blob = std::vector<uint8_t>(entry.size);
+            file.seekg(static_cast<std::streamoff>(entry.offset));
+            if (!file.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size()))) {
+                m_Entries.clear();
+                return false;
+            }
+            m_Entries[entry.key] = std::move(blob);
+        }
+    }
+    catch (const std::bad_alloc&) {
+        m_Entries.clear();
+        return false;
+    }
+    return true;
+}
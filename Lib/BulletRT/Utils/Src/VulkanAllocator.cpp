@@ -0,0 +1,341 @@
+#include <BulletRT/Utils/VulkanAllocator.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+#include <algorithm>
+
+class BulletRT::Utils::VulkanAllocatorBlock
+{
+public:
+    std::unique_ptr<BulletRT::Core::VulkanDeviceMemory> m_Memory = nullptr;
+    uint32_t       m_MemoryTypeIndex = 0;
+    bool           m_IsOptimalImage  = false;
+    bool           m_IsDedicated     = false;
+    std::unique_ptr<VulkanOffsetAllocator> m_Metadata = nullptr;
+
+    auto GetSize()const noexcept -> vk::DeviceSize { return m_Memory->GetAllocationSize(); }
+    bool IsCompatible(uint32_t memoryTypeIndex, bool isOptimalImage)const noexcept
+    {
+        return !m_IsDedicated && m_MemoryTypeIndex == memoryTypeIndex && m_IsOptimalImage == isOptimalImage;
+    }
+};
+
+BulletRT::Utils::VulkanAllocation::~VulkanAllocation() noexcept
+{
+    m_MemoryBuffer.reset();
+    m_MemoryImage.reset();
+    m_Buffer.reset();
+    if (m_Allocator && m_Block) {
+        m_Allocator->Impl_Free(m_Block, m_Range);
+    }
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetAllocator() const noexcept -> VulkanAllocator*
+{
+    return m_Allocator;
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetMemory() const noexcept -> const BulletRT::Core::VulkanDeviceMemory*
+{
+    return m_Block ? m_Block->m_Memory.get() : nullptr;
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetMemoryVk() const noexcept -> vk::DeviceMemory
+{
+    return m_Block ? m_Block->m_Memory->GetDeviceMemoryVk() : nullptr;
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetMemoryOffset() const noexcept -> vk::DeviceSize
+{
+    return m_Range.offset;
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetMemoryTypeIndex() const noexcept -> uint32_t
+{
+    return m_Block ? m_Block->m_MemoryTypeIndex : 0;
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetSize() const noexcept -> vk::DeviceSize
+{
+    return m_Range.size;
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetMemoryBuffer() const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*
+{
+    return m_MemoryBuffer.get();
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetMemoryImage() const noexcept -> const BulletRT::Core::VulkanMemoryImage*
+{
+    return m_MemoryImage.get();
+}
+
+auto BulletRT::Utils::VulkanAllocation::GetMappedData() const noexcept -> void*
+{
+    if (!m_Block) {
+        return nullptr;
+    }
+    auto pMappedData = m_Block->m_Memory->GetMappedData();
+    return pMappedData ? static_cast<char*>(pMappedData) + m_Range.offset : nullptr;
+}
+
+bool BulletRT::Utils::VulkanAllocation::IsDedicated() const noexcept
+{
+    return m_Block ? m_Block->m_IsDedicated : false;
+}
+
+BulletRT::Utils::VulkanAllocation::VulkanAllocation() noexcept
+{
+    m_Allocator    = nullptr;
+    m_Block        = nullptr;
+    m_Range        = {};
+    m_Buffer       = nullptr;
+    m_MemoryBuffer = nullptr;
+    m_MemoryImage  = nullptr;
+}
+
+auto BulletRT::Utils::VulkanAllocator::New(const BulletRT::Core::VulkanDevice* device, vk::DeviceSize blockSize, VulkanOffsetAllocatorStrategy strategy) -> std::unique_ptr<VulkanAllocator>
+{
+    if (!device || blockSize == 0) {
+        return nullptr;
+    }
+    auto allocator = new VulkanAllocator();
+    allocator->m_Device                 = device;
+    allocator->m_MemoryProperties       = device->GetPhysicalDeviceVk().getMemoryProperties();
+    allocator->m_BufferImageGranularity = device->GetPhysicalDeviceVk().getProperties().limits.bufferImageGranularity;
+    allocator->m_BlockSize              = blockSize;
+    allocator->m_Strategy               = strategy;
+    allocator->m_SupportDeviceAddress   = SupportBufferDeviceAddress(device);
+    return std::unique_ptr<VulkanAllocator>(allocator);
+}
+
+BulletRT::Utils::VulkanAllocator::~VulkanAllocator() noexcept
+{
+    m_Blocks.clear();
+}
+
+auto BulletRT::Utils::VulkanAllocator::AllocateBuffer(const BulletRT::Core::VulkanBuffer* buffer, vk::MemoryPropertyFlags requiredFlags, vk::MemoryPropertyFlags avoidFlags) -> std::unique_ptr<VulkanAllocation>
+{
+    if (!buffer) {
+        return nullptr;
+    }
+    auto requirements = buffer->QueryMemoryRequirements();
+    auto range = VulkanOffsetAllocation{};
+    auto block = Impl_Allocate(requirements, requiredFlags, avoidFlags, false, &range);
+    if (!block) {
+        return nullptr;
+    }
+    auto allocation = std::unique_ptr<VulkanAllocation>(new VulkanAllocation());
+    allocation->m_Allocator    = this;
+    allocation->m_Block        = block;
+    allocation->m_Range        = range;
+    allocation->m_MemoryBuffer = BulletRT::Core::VulkanMemoryBuffer::Bind(buffer, block->m_Memory.get(), range.offset);
+    if (!allocation->m_MemoryBuffer) {
+        return nullptr;
+    }
+    return allocation;
+}
+
+auto BulletRT::Utils::VulkanAllocator::NewBuffer(const BulletRT::Core::VulkanBufferBuilder& builder, vk::MemoryPropertyFlags requiredFlags, vk::MemoryPropertyFlags avoidFlags) -> std::unique_ptr<VulkanAllocation>
+{
+    auto buffer = builder.Build(m_Device);
+    if (!buffer) {
+        return nullptr;
+    }
+    auto allocation = AllocateBuffer(buffer.get(), requiredFlags, avoidFlags);
+    if (!allocation) {
+        return nullptr;
+    }
+    allocation->m_Buffer = std::move(buffer);
+    return allocation;
+}
+
+auto BulletRT::Utils::VulkanAllocator::AllocateImage(const BulletRT::Core::VulkanImage* image, vk::MemoryPropertyFlags requiredFlags, vk::MemoryPropertyFlags avoidFlags) -> std::unique_ptr<VulkanAllocation>
+{
+    if (!image) {
+        return nullptr;
+    }
+    auto requirements = m_Device->GetDeviceVk().getImageMemoryRequirements(image->GetImageVk());
+    auto range = VulkanOffsetAllocation{};
+    auto block = Impl_Allocate(requirements, requiredFlags, avoidFlags, image->GetTiling() == vk::ImageTiling::eOptimal, &range);
+    if (!block) {
+        return nullptr;
+    }
+    auto allocation = std::unique_ptr<VulkanAllocation>(new VulkanAllocation());
+    allocation->m_Allocator    = this;
+    allocation->m_Block        = block;
+    allocation->m_Range        = range;
+    allocation->m_MemoryImage  = BulletRT::Core::VulkanMemoryImage::Bind(image, block->m_Memory.get(), range.offset);
+    if (!allocation->m_MemoryImage) {
+        return nullptr;
+    }
+    return allocation;
+}
+
+auto BulletRT::Utils::VulkanAllocator::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice*
+{
+    return m_Device;
+}
+
+auto BulletRT::Utils::VulkanAllocator::GetBlockSize() const noexcept -> vk::DeviceSize
+{
+    return m_BlockSize;
+}
+
+auto BulletRT::Utils::VulkanAllocator::GetStrategy() const noexcept -> VulkanOffsetAllocatorStrategy
+{
+    return m_Strategy;
+}
+
+auto BulletRT::Utils::VulkanAllocator::GetBlockCount() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Blocks.size();
+}
+
+auto BulletRT::Utils::VulkanAllocator::GetAllocationCount() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_AllocationCount;
+}
+
+auto BulletRT::Utils::VulkanAllocator::QueryBlockStatistics() const -> std::vector<VulkanAllocatorBlockStatistics>
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto statistics = std::vector<VulkanAllocatorBlockStatistics>();
+    statistics.reserve(m_Blocks.size());
+    for (auto& block : m_Blocks) {
+        statistics.push_back(VulkanAllocatorBlockStatistics{
+            block->m_MemoryTypeIndex,
+            block->m_IsOptimalImage,
+            block->m_IsDedicated,
+            block->m_Metadata->QueryStatistics()
+        });
+    }
+    return statistics;
+}
+
+BulletRT::Utils::VulkanAllocator::VulkanAllocator() noexcept
+{
+    m_Device                 = nullptr;
+    m_MemoryProperties       = {};
+    m_BufferImageGranularity = 1;
+    m_BlockSize              = 0;
+    m_Strategy               = VulkanOffsetAllocatorStrategy::eTlsf;
+    m_SupportDeviceAddress   = false;
+    m_AllocationCount        = 0;
+}
+
+auto BulletRT::Utils::VulkanAllocator::Impl_Allocate(const vk::MemoryRequirements& requirements, vk::MemoryPropertyFlags requiredFlags, vk::MemoryPropertyFlags avoidFlags, bool isOptimalImage, VulkanOffsetAllocation* pRange) -> VulkanAllocatorBlock*
+{
+    auto memoryTypeIndices = FindMemoryTypeIndices(m_MemoryProperties, requirements.memoryTypeBits, requiredFlags, avoidFlags);
+    if (memoryTypeIndices.empty()) {
+        return nullptr;
+    }
+    // Linear resources and optimal images never share a block unless the device
+    // reports a granularity of 1, so neighbouring ranges cannot alias a page.
+    if (m_BufferImageGranularity <= 1) {
+        isOptimalImage = false;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    // The preferred type's heap may be exhausted, so every compatible type is tried in order.
+    for (auto memoryTypeIndex : memoryTypeIndices) {
+        if (auto block = Impl_AllocateFromType(memoryTypeIndex, requirements, isOptimalImage, pRange)) {
+            ++m_AllocationCount;
+            return block;
+        }
+    }
+    return nullptr;
+}
+
+auto BulletRT::Utils::VulkanAllocator::Impl_AllocateFromType(uint32_t memoryTypeIndex, const vk::MemoryRequirements& requirements, bool isOptimalImage, VulkanOffsetAllocation* pRange) -> VulkanAllocatorBlock*
+{
+    if (requirements.size > m_BlockSize / 2) {
+        auto block = Impl_NewBlock(memoryTypeIndex, requirements.size, isOptimalImage, true);
+        if (!block) {
+            return nullptr;
+        }
+        auto range = block->m_Metadata->Allocate(requirements.size);
+        if (!range) {
+            Impl_RemoveBlock(block);
+            return nullptr;
+        }
+        *pRange = range.value();
+        return block;
+    }
+    for (auto it = m_Blocks.rbegin(); it != m_Blocks.rend(); ++it) {
+        auto& block = *it;
+        if (!block->IsCompatible(memoryTypeIndex, isOptimalImage)) {
+            continue;
+        }
+        if (auto range = block->m_Metadata->Allocate(requirements.size, requirements.alignment)) {
+            *pRange = range.value();
+            return block.get();
+        }
+    }
+    auto block = Impl_NewBlock(memoryTypeIndex, m_BlockSize, isOptimalImage, false);
+    if (!block) {
+        return nullptr;
+    }
+    auto range = block->m_Metadata->Allocate(requirements.size, requirements.alignment);
+    if (!range) {
+        Impl_RemoveBlock(block);
+        return nullptr;
+    }
+    *pRange = range.value();
+    return block;
+}
+
+auto BulletRT::Utils::VulkanAllocator::Impl_NewBlock(uint32_t memoryTypeIndex, vk::DeviceSize size, bool isOptimalImage, bool isDedicated) -> VulkanAllocatorBlock*
+{
+    auto memoryBuilder = BulletRT::Core::VulkanDeviceMemory::Builder()
+        .SetMemoryTypeIndex(memoryTypeIndex)
+        .SetAllocationSize(size)
+        .SetPersistentMapped(static_cast<bool>(m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible));
+    if (m_SupportDeviceAddress) {
+        memoryBuilder.SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress));
+    }
+    auto memory = std::unique_ptr<BulletRT::Core::VulkanDeviceMemory>();
+    try {
+        memory = memoryBuilder.Build(m_Device);
+    }
+    catch (const vk::OutOfDeviceMemoryError&) {
+        // Reported as a failed block so that Impl_Allocate can move on to the next memory type.
+        return nullptr;
+    }
+    if (!memory) {
+        return nullptr;
+    }
+    auto block = std::make_unique<VulkanAllocatorBlock>();
+    block->m_Memory          = std::move(memory);
+    block->m_MemoryTypeIndex = memoryTypeIndex;
+    block->m_IsOptimalImage  = isOptimalImage;
+    block->m_IsDedicated     = isDedicated;
+    // A dedicated block only ever hosts one range, so it does not need free-list bookkeeping.
+    block->m_Metadata        = VulkanOffsetAllocator::New(isDedicated ? VulkanOffsetAllocatorStrategy::eLinear : m_Strategy, size);
+    m_Blocks.push_back(std::move(block));
+    return m_Blocks.back().get();
+}
+
+void BulletRT::Utils::VulkanAllocator::Impl_Free(VulkanAllocatorBlock* block, const VulkanOffsetAllocation& range) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    --m_AllocationCount;
+    block->m_Metadata->Free(range);
+    if (!block->m_Metadata->IsEmpty()) {
+        return;
+    }
+    // Keep a single empty block per memory type around so that a scene reload
+    // does not bounce straight back into vkAllocateMemory.
+    auto hasSibling = std::any_of(std::begin(m_Blocks), std::end(m_Blocks), [block](const auto& other) {
+        return other.get() != block && other->IsCompatible(block->m_MemoryTypeIndex, block->m_IsOptimalImage);
+    });
+    if (block->m_IsDedicated || hasSibling) {
+        Impl_RemoveBlock(block);
+    }
+}
+
+void BulletRT::Utils::VulkanAllocator::Impl_RemoveBlock(VulkanAllocatorBlock* block) noexcept
+{
+    m_Blocks.erase(std::remove_if(std::begin(m_Blocks), std::end(m_Blocks), [block](const auto& other) {
+        return other.get() == block;
+    }), std::end(m_Blocks));
+}
@@ -0,0 +1,258 @@
+#include <BulletRT/Utils/VulkanAsyncUploader.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+
+auto BulletRT::Utils::VulkanAsyncUploader::New(const VulkanStaging* staging, const BulletRT::Core::VulkanCommandPool* commandPool, const BulletRT::Core::VulkanQueue& queue, uint32_t dstQueueFamilyIndex) -> std::unique_ptr<VulkanAsyncUploader>
+{
+    if (!staging || !commandPool || commandPool->GetQueueFamilyIndex() != queue.GetQueueFamilyIndex()) {
+        return nullptr;
+    }
+    auto device = commandPool->GetDevice();
+    if (!SupportTimelineSemaphore(device)) {
+        return nullptr;
+    }
+    auto ring = VulkanStagingRing::New(staging);
+    if (!ring) {
+        return nullptr;
+    }
+    auto semaphore = BulletRT::Core::VulkanSemaphore::New(device, vk::SemaphoreType::eTimeline);
+    if (!semaphore) {
+        return nullptr;
+    }
+    auto uploader = new VulkanAsyncUploader();
+    uploader->m_Ring                = std::move(ring);
+    uploader->m_CommandPool         = commandPool;
+    uploader->m_Queue               = queue;
+    uploader->m_SrcQueueFamilyIndex = queue.GetQueueFamilyIndex();
+    uploader->m_DstQueueFamilyIndex = dstQueueFamilyIndex;
+    uploader->m_Semaphore           = std::move(semaphore);
+    return std::unique_ptr<VulkanAsyncUploader>(uploader);
+}
+
+BulletRT::Utils::VulkanAsyncUploader::~VulkanAsyncUploader() noexcept
+{
+    while (Impl_RetireOldestBatch(true)) {}
+    m_Batches.clear();
+    m_PendingAcquires.clear();
+    m_PendingReturns.clear();
+    m_PendingWaits.clear();
+    m_WrittenBuffers.clear();
+    m_ReleasedBuffers.clear();
+    m_FreeCommandBuffers.clear();
+    m_Semaphore.reset();
+    m_Ring.reset();
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::Upload(const void* pData, vk::DeviceSize sizeInBytes, const BulletRT::Core::VulkanBuffer* dstBuffer, vk::DeviceSize dstOffset) -> vk::Result
+{
+    if (!pData || !dstBuffer || dstOffset + sizeInBytes > dstBuffer->GetSize()) {
+        return vk::Result::eErrorUnknown;
+    }
+    // The transfer family no longer owns a released buffer; it has to come back through RecordReleaseBarriers first.
+    if (m_ReleasedBuffers.count(dstBuffer) > 0) {
+        return vk::Result::eErrorUnknown;
+    }
+    // Flushes for ring space only submit the copies; ownership moves once, on the caller's Submit.
+    return m_Ring->Write(pData, sizeInBytes, dstBuffer, dstOffset,
+        [this]() { return Impl_Submit(false) ? vk::Result::eSuccess : vk::Result::eErrorDeviceLost; },
+        [this]() { return Impl_RetireOldestBatch(true); });
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::Submit() -> std::optional<uint64_t>
+{
+    return Impl_Submit(true);
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::Impl_Submit(bool releaseBuffers) -> std::optional<uint64_t>
+{
+    if (m_Ring->GetBatchSize() == 0 && (!releaseBuffers || m_WrittenBuffers.empty())) {
+        m_Ring->EndBatch();
+        return m_SubmittedValue;
+    }
+    while (Impl_RetireOldestBatch(false)) {}
+    auto commandBuffer = std::unique_ptr<BulletRT::Core::VulkanCommandBuffer>();
+    if (!m_FreeCommandBuffers.empty()) {
+        commandBuffer = std::move(m_FreeCommandBuffers.back());
+        m_FreeCommandBuffers.pop_back();
+        commandBuffer->GetCommandBufferVk().reset();
+    }
+    else {
+        commandBuffer = m_CommandPool->NewCommandBuffer(vk::CommandBufferLevel::ePrimary);
+    }
+    if (!commandBuffer) {
+        return std::nullopt;
+    }
+    auto value = m_SubmittedValue + 1;
+    auto writtenBuffers  = m_WrittenBuffers;
+    auto releaseBarriers = std::vector<vk::BufferMemoryBarrier>();
+    auto acquires        = std::vector<OwnershipDesc>();
+    auto commandBufferVk = commandBuffer->GetCommandBufferVk();
+    commandBufferVk.begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    if (!m_PendingReturns.empty()) {
+        // Acquire half of the transfers started by RecordReleaseBarriers; the copies below must not start before it.
+        commandBufferVk.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, nullptr, m_PendingReturns, nullptr);
+    }
+    for (auto& [dstBuffer, regions] : m_Ring->GetBatchRegions()) {
+        if (regions.empty()) {
+            continue;
+        }
+        commandBufferVk.copyBuffer(m_Ring->GetStaging()->GetBufferVk(), dstBuffer->GetBufferVk(), regions);
+        if (Impl_NeedOwnershipTransfer(dstBuffer)) {
+            writtenBuffers.insert(dstBuffer);
+        }
+    }
+    if (releaseBuffers) {
+        // One release per buffer written since the last Submit, however many ring flushes its copies took.
+        // The whole buffer changes hands, so ranges outside the written regions stay usable by the consumer.
+        for (auto& dstBuffer : writtenBuffers) {
+            auto barrier = Impl_NewOwnershipBarrier(dstBuffer, m_SrcQueueFamilyIndex, m_DstQueueFamilyIndex);
+            releaseBarriers.push_back(vk::BufferMemoryBarrier(barrier).setSrcAccessMask(vk::AccessFlagBits::eTransferWrite));
+            acquires.push_back(OwnershipDesc{ value, vk::BufferMemoryBarrier(barrier).setDstAccessMask(vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite) });
+        }
+    }
+    if (!releaseBarriers.empty()) {
+        commandBufferVk.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, nullptr, releaseBarriers, nullptr);
+    }
+    commandBufferVk.end();
+    auto submitDesc = BulletRT::Core::VulkanSubmitDesc();
+    for (auto& wait : m_PendingWaits) {
+        submitDesc.AddWaitSemaphore(wait.semaphore, vk::PipelineStageFlagBits::eTransfer, wait.value);
+    }
+    submitDesc
+        .AddCommandBuffer(commandBufferVk)
+        .AddSignalSemaphore(m_Semaphore.get(), value);
+    if (m_Queue->Submit(submitDesc) != vk::Result::eSuccess) {
+        return std::nullopt;
+    }
+    if (releaseBuffers) {
+        m_ReleasedBuffers.insert(std::begin(writtenBuffers), std::end(writtenBuffers));
+        m_PendingAcquires.insert(std::end(m_PendingAcquires), std::begin(acquires), std::end(acquires));
+        m_WrittenBuffers.clear();
+    }
+    else {
+        m_WrittenBuffers = std::move(writtenBuffers);
+    }
+    m_SubmittedValue = value;
+    m_Batches.push_back(BatchDesc{ std::move(commandBuffer), value, m_Ring->EndBatch() });
+    m_PendingReturns.clear();
+    m_PendingWaits.clear();
+    return value;
+}
+
+void BulletRT::Utils::VulkanAsyncUploader::RecordReleaseBarriers(vk::CommandBuffer commandBuffer, const BulletRT::Core::VulkanBuffer* buffer)
+{
+    // Only buffers a Submit released are owned by the consumer family, and each is handed back once.
+    if (!buffer || m_ReleasedBuffers.erase(buffer) == 0) {
+        return;
+    }
+    auto barrier = Impl_NewOwnershipBarrier(buffer, m_DstQueueFamilyIndex, m_SrcQueueFamilyIndex);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eBottomOfPipe, {}, nullptr,
+        vk::BufferMemoryBarrier(barrier).setSrcAccessMask(vk::AccessFlagBits::eMemoryWrite), nullptr);
+    m_PendingReturns.push_back(vk::BufferMemoryBarrier(barrier).setDstAccessMask(vk::AccessFlagBits::eTransferWrite));
+}
+
+void BulletRT::Utils::VulkanAsyncUploader::AddWaitSemaphore(const BulletRT::Core::VulkanSemaphore* semaphore, uint64_t value)
+{
+    if (semaphore) {
+        m_PendingWaits.push_back(WaitDesc{ semaphore, value });
+    }
+}
+
+void BulletRT::Utils::VulkanAsyncUploader::RecordAcquireBarriers(vk::CommandBuffer commandBuffer, uint64_t value)
+{
+    auto acquireBarriers = std::vector<vk::BufferMemoryBarrier>();
+    while (!m_PendingAcquires.empty() && m_PendingAcquires.front().value <= value) {
+        acquireBarriers.push_back(m_PendingAcquires.front().barrier);
+        m_PendingAcquires.pop_front();
+    }
+    if (!acquireBarriers.empty()) {
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands, {}, nullptr, acquireBarriers, nullptr);
+    }
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::Wait(uint64_t value, uint64_t timeout) const -> vk::Result
+{
+    return m_Semaphore->Wait(value, timeout);
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::QueryCompletedValue() const -> uint64_t
+{
+    return m_Semaphore->QueryCounterValue().value_or(0);
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::GetStaging() const noexcept -> const VulkanStaging*
+{
+    return m_Ring->GetStaging();
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::GetSemaphore() const noexcept -> const BulletRT::Core::VulkanSemaphore*
+{
+    return m_Semaphore.get();
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::GetSemaphoreVk() const noexcept -> vk::Semaphore
+{
+    return m_Semaphore ? m_Semaphore->GetSemaphoreVk() : nullptr;
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::GetSubmittedValue() const noexcept -> uint64_t
+{
+    return m_SubmittedValue;
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::GetSrcQueueFamilyIndex() const noexcept -> uint32_t
+{
+    return m_SrcQueueFamilyIndex;
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::GetDstQueueFamilyIndex() const noexcept -> uint32_t
+{
+    return m_DstQueueFamilyIndex;
+}
+
+BulletRT::Utils::VulkanAsyncUploader::VulkanAsyncUploader() noexcept
+{
+    m_Ring                = nullptr;
+    m_CommandPool         = nullptr;
+    m_Queue               = std::nullopt;
+    m_SrcQueueFamilyIndex = 0;
+    m_DstQueueFamilyIndex = 0;
+    m_Semaphore           = nullptr;
+    m_SubmittedValue      = 0;
+    m_PendingAcquires     = {};
+    m_PendingReturns      = {};
+    m_PendingWaits        = {};
+    m_WrittenBuffers      = {};
+    m_ReleasedBuffers     = {};
+}
+
+bool BulletRT::Utils::VulkanAsyncUploader::Impl_NeedOwnershipTransfer(const BulletRT::Core::VulkanBuffer* buffer) const noexcept
+{
+    return m_SrcQueueFamilyIndex != m_DstQueueFamilyIndex && buffer->GetSharingMode() == vk::SharingMode::eExclusive;
+}
+
+auto BulletRT::Utils::VulkanAsyncUploader::Impl_NewOwnershipBarrier(const BulletRT::Core::VulkanBuffer* buffer, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex) const noexcept -> vk::BufferMemoryBarrier
+{
+    return vk::BufferMemoryBarrier()
+        .setSrcQueueFamilyIndex(srcQueueFamilyIndex)
+        .setDstQueueFamilyIndex(dstQueueFamilyIndex)
+        .setBuffer(buffer->GetBufferVk())
+        .setOffset(0)
+        .setSize(VK_WHOLE_SIZE);
+}
+
+bool BulletRT::Utils::VulkanAsyncUploader::Impl_RetireOldestBatch(bool wait)
+{
+    if (m_Batches.empty()) {
+        return false;
+    }
+    auto& batch = m_Batches.front();
+    if (QueryCompletedValue() < batch.value) {
+        if (!wait || Wait(batch.value) != vk::Result::eSuccess) {
+            return false;
+        }
+    }
+    m_Ring->Release(batch.sizeInBytes);
+    m_FreeCommandBuffers.push_back(std::move(batch.commandBuffer));
+    m_Batches.pop_front();
+    return true;
+}
@@ -0,0 +1,128 @@
+#include <BulletRT/Utils/VulkanBufferPool.h>
+#include <algorithm>
+
+auto BulletRT::Utils::VulkanBufferPool::New(VulkanAllocator* allocator, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags requiredFlags, vk::DeviceSize blockSize, VulkanOffsetAllocatorStrategy strategy) -> std::unique_ptr<VulkanBufferPool>
+{
+    if (!allocator || blockSize == 0) {
+        return nullptr;
+    }
+    auto pool = std::unique_ptr<VulkanBufferPool>(new VulkanBufferPool());
+    pool->m_Allocator     = allocator;
+    pool->m_Usage         = usage;
+    pool->m_RequiredFlags = requiredFlags;
+    pool->m_BlockSize     = blockSize;
+    pool->m_Strategy      = strategy;
+    return pool;
+}
+
+BulletRT::Utils::VulkanBufferPool::~VulkanBufferPool() noexcept
+{
+    m_Blocks.clear();
+}
+
+auto BulletRT::Utils::VulkanBufferPool::AllocateRegion(vk::DeviceSize size, vk::DeviceSize alignment) -> std::optional<BulletRT::Core::VulkanBufferRegion>
+{
+    if (size == 0) {
+        return std::nullopt;
+    }
+    alignment = std::max<vk::DeviceSize>(alignment, 1);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto toRegion = [](const BlockDesc& block, const VulkanOffsetAllocation& range) {
+        return BulletRT::Core::VulkanBufferRegion{ block.allocation->GetMemoryBuffer(), range.offset, range.size, range.metadata };
+    };
+    if (size <= m_BlockSize) {
+        for (auto it = m_Blocks.rbegin(); it != m_Blocks.rend(); ++it) {
+            if (auto range = it->allocator->Allocate(size, alignment)) {
+                return toRegion(*it, range.value());
+            }
+        }
+    }
+    // Buffer offsets start at 0, so a fresh block of size bytes always satisfies the alignment.
+    auto block = Impl_NewBlock(std::max(size, m_BlockSize));
+    if (!block) {
+        return std::nullopt;
+    }
+    auto range = block->allocator->Allocate(size, alignment);
+    if (!range) {
+        return std::nullopt;
+    }
+    return toRegion(*block, range.value());
+}
+
+void BulletRT::Utils::VulkanBufferPool::FreeRegion(const BulletRT::Core::VulkanBufferRegion& region) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = std::find_if(std::begin(m_Blocks), std::end(m_Blocks), [&region](const auto& block) {
+        return block.allocation->GetMemoryBuffer() == region.buffer;
+    });
+    if (iter == std::end(m_Blocks)) {
+        return;
+    }
+    iter->allocator->Free(VulkanOffsetAllocation{ region.offset, region.size, static_cast<uint32_t>(region.userData) });
+    if (!iter->allocator->IsEmpty()) {
+        return;
+    }
+    // Keep a single empty block around so that a streaming scene does not bounce in and out of the allocator.
+    auto hasSibling = std::any_of(std::begin(m_Blocks), std::end(m_Blocks), [this, &iter](const auto& other) {
+        return &other != &*iter && other.allocator->GetSize() <= m_BlockSize && other.allocator->IsEmpty();
+    });
+    if (iter->allocator->GetSize() > m_BlockSize || hasSibling) {
+        m_Blocks.erase(iter);
+    }
+}
+
+auto BulletRT::Utils::VulkanBufferPool::GetAllocator() const noexcept -> VulkanAllocator*
+{
+    return m_Allocator;
+}
+
+auto BulletRT::Utils::VulkanBufferPool::GetUsage() const noexcept -> vk::BufferUsageFlags
+{
+    return m_Usage;
+}
+
+auto BulletRT::Utils::VulkanBufferPool::GetBlockSize() const noexcept -> vk::DeviceSize
+{
+    return m_BlockSize;
+}
+
+auto BulletRT::Utils::VulkanBufferPool::GetBlockCount() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Blocks.size();
+}
+
+auto BulletRT::Utils::VulkanBufferPool::QueryBlockStatistics() const -> std::vector<VulkanOffsetAllocatorStatistics>
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto statistics = std::vector<VulkanOffsetAllocatorStatistics>();
+    statistics.reserve(m_Blocks.size());
+    for (auto& block : m_Blocks) {
+        statistics.push_back(block.allocator->QueryStatistics());
+    }
+    return statistics;
+}
+
+BulletRT::Utils::VulkanBufferPool::VulkanBufferPool() noexcept
+{
+    m_Allocator     = nullptr;
+    m_Usage         = {};
+    m_RequiredFlags = {};
+    m_BlockSize     = 0;
+    m_Strategy      = VulkanOffsetAllocatorStrategy::eTlsf;
+}
+
+auto BulletRT::Utils::VulkanBufferPool::Impl_NewBlock(vk::DeviceSize size) -> BlockDesc*
+{
+    auto allocation = m_Allocator->NewBuffer(BulletRT::Core::VulkanBufferBuilder().SetSize(size).SetUsage(m_Usage), m_RequiredFlags);
+    if (!allocation) {
+        return nullptr;
+    }
+    // An oversized block only ever hosts one range, so it does not need free-list bookkeeping.
+    auto allocator = VulkanOffsetAllocator::New(size > m_BlockSize ? VulkanOffsetAllocatorStrategy::eLinear : m_Strategy, size);
+    if (!allocator) {
+        return nullptr;
+    }
+    m_Blocks.push_back(BlockDesc{ std::move(allocation), std::move(allocator) });
+    return &m_Blocks.back();
+}
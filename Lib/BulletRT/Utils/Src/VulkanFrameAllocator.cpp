@@ -0,0 +1,200 @@
+#include <BulletRT/Utils/VulkanFrameAllocator.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+#include <algorithm>
+
+auto BulletRT::Utils::VulkanFrameAllocator::New(const BulletRT::Core::VulkanDevice* device, vk::DeviceSize size, vk::BufferUsageFlags usage) -> std::unique_ptr<VulkanFrameAllocator>
+{
+    if (!device || size == 0) {
+        return nullptr;
+    }
+    auto supportDeviceAddress = SupportBufferDeviceAddress(device);
+    if (supportDeviceAddress) {
+        usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+    }
+    if (device->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) {
+        usage |= vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+    }
+    auto buffer = BulletRT::Core::VulkanBuffer::Builder()
+        .SetUsage(usage)
+        .SetSize(size)
+        .SetQueueFamilyIndices({})
+        .Build(device);
+    if (!buffer) {
+        return nullptr;
+    }
+    auto memoryProperties   = device->GetPhysicalDeviceVk().getMemoryProperties();
+    auto memoryRequirements = buffer->QueryMemoryRequirements();
+    // Prefer host visible device local memory (resizable BAR) so the GPU reads the ring without crossing the bus.
+    auto memoryTypeIndices  = FindMemoryTypeIndices(memoryProperties, memoryRequirements.memoryTypeBits,
+        vk::MemoryPropertyFlagBits::eDeviceLocal |
+        vk::MemoryPropertyFlagBits::eHostVisible |
+        vk::MemoryPropertyFlagBits::eHostCoherent);
+    if (memoryTypeIndices.empty()) {
+        memoryTypeIndices = FindMemoryTypeIndices(memoryProperties, memoryRequirements.memoryTypeBits,
+            vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent);
+    }
+    if (memoryTypeIndices.empty()) {
+        return nullptr;
+    }
+    auto memoryBuilder = BulletRT::Core::VulkanDeviceMemory::Builder()
+        .SetAllocationSize(memoryRequirements.size)
+        .SetMemoryTypeIndex(memoryTypeIndices.front())
+        .SetPersistentMapped(true);
+    if (supportDeviceAddress) {
+        memoryBuilder.SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress));
+    }
+    auto memory = memoryBuilder.Build(device);
+    if (!memory) {
+        return nullptr;
+    }
+    auto memoryBuffer = BulletRT::Core::VulkanMemoryBuffer::Bind(buffer.get(), memory.get(), 0);
+    if (!memoryBuffer) {
+        return nullptr;
+    }
+    auto pMappedData = memory->GetMappedData();
+    if (!pMappedData) {
+        return nullptr;
+    }
+    auto allocator = new VulkanFrameAllocator();
+    allocator->m_Buffer       = std::move(buffer);
+    allocator->m_Memory       = std::move(memory);
+    allocator->m_MemoryBuffer = std::move(memoryBuffer);
+    allocator->m_MappedData   = pMappedData;
+    return std::unique_ptr<VulkanFrameAllocator>(allocator);
+}
+
+BulletRT::Utils::VulkanFrameAllocator::~VulkanFrameAllocator() noexcept
+{
+    m_Frames.clear();
+    m_MappedData = nullptr;
+    m_MemoryBuffer.reset();
+    m_Buffer.reset();
+    m_Memory.reset();
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::Allocate(vk::DeviceSize size, vk::DeviceSize alignment) -> std::optional<VulkanFrameAllocation>
+{
+    if (size == 0 || size > GetSize()) {
+        return std::nullopt;
+    }
+    alignment = std::max<vk::DeviceSize>(alignment, 1);
+    auto offset = Impl_TryAllocate(size, alignment);
+    // The ring is exhausted: block on the oldest frame still in flight and try again.
+    while (!offset && Impl_RetireOldestFrame(true)) {
+        offset = Impl_TryAllocate(size, alignment);
+    }
+    if (!offset) {
+        return std::nullopt;
+    }
+    auto deviceAddress = GetDeviceAddress();
+    if (deviceAddress) {
+        deviceAddress = deviceAddress.value() + offset.value();
+    }
+    return VulkanFrameAllocation{
+        GetBufferVk(),
+        offset.value(),
+        size,
+        static_cast<char*>(m_MappedData) + offset.value(),
+        deviceAddress
+    };
+}
+
+void BulletRT::Utils::VulkanFrameAllocator::BeginFrame()
+{
+    while (Impl_RetireOldestFrame(false)) {}
+}
+
+void BulletRT::Utils::VulkanFrameAllocator::EndFrame(const BulletRT::Core::VulkanFence* fence)
+{
+    if (m_FrameSize == 0) {
+        return;
+    }
+    m_Frames.push_back(FrameDesc{ fence, m_FrameSize });
+    m_FrameSize = 0;
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::GetBuffer() const noexcept -> const BulletRT::Core::VulkanBuffer*
+{
+    return m_Buffer.get();
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::GetBufferVk() const noexcept -> vk::Buffer
+{
+    return m_Buffer ? m_Buffer->GetBufferVk() : nullptr;
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::GetMemory() const noexcept -> const BulletRT::Core::VulkanDeviceMemory*
+{
+    return m_Memory.get();
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::GetMemoryVk() const noexcept -> vk::DeviceMemory
+{
+    return m_Memory ? m_Memory->GetDeviceMemoryVk() : nullptr;
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::GetSize() const noexcept -> vk::DeviceSize
+{
+    return m_Buffer->GetSize();
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::GetUsedSize() const noexcept -> vk::DeviceSize
+{
+    return m_UsedSize;
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::GetDeviceAddress() const noexcept -> std::optional<vk::DeviceAddress>
+{
+    return m_MemoryBuffer->GetDeviceAddress();
+}
+
+BulletRT::Utils::VulkanFrameAllocator::VulkanFrameAllocator() noexcept
+{
+    m_Buffer       = nullptr;
+    m_Memory       = nullptr;
+    m_MemoryBuffer = nullptr;
+    m_MappedData   = nullptr;
+    m_Head         = 0;
+    m_UsedSize     = 0;
+    m_FrameSize    = 0;
+}
+
+auto BulletRT::Utils::VulkanFrameAllocator::Impl_TryAllocate(vk::DeviceSize size, vk::DeviceSize alignment) -> std::optional<vk::DeviceSize>
+{
+    auto offset = CalcAlignedSize(m_Head, alignment);
+    auto consumed = offset + size - m_Head;
+    if (offset + size > GetSize()) {
+        // Skip the tail end of the ring and restart at zero, which satisfies any alignment.
+        offset   = 0;
+        consumed = GetSize() - m_Head + size;
+    }
+    if (m_UsedSize + consumed > GetSize()) {
+        return std::nullopt;
+    }
+    m_Head       = offset + size;
+    m_UsedSize  += consumed;
+    m_FrameSize += consumed;
+    return offset;
+}
+
+bool BulletRT::Utils::VulkanFrameAllocator::Impl_RetireOldestFrame(bool wait)
+{
+    if (m_Frames.empty()) {
+        return false;
+    }
+    auto& frame = m_Frames.front();
+    if (frame.fence) {
+        if (frame.fence->QueryStatus() != vk::Result::eSuccess) {
+            if (!wait || frame.fence->Wait(UINT64_MAX) != vk::Result::eSuccess) {
+                return false;
+            }
+        }
+    }
+    m_UsedSize -= frame.sizeInBytes;
+    m_Frames.pop_front();
+    if (m_Frames.empty() && m_FrameSize == 0) {
+        m_Head = 0;
+    }
+    return true;
+}
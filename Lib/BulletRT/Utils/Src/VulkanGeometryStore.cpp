@@ -0,0 +1,239 @@
+#include <BulletRT/Utils/VulkanGeometryStore.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+#include <cstring>
+// Satisfies the component alignment required of acceleration structure build inputs and of vec4 fetches.
+static constexpr vk::DeviceSize kRangeAlignment = 16;
+
+auto BulletRT::Utils::VulkanGeometryStore::New(VulkanAllocator* allocator, vk::DeviceSize vertexCapacity, vk::DeviceSize indexCapacity, uint32_t maxMeshCount,
+    vk::MemoryPropertyFlags requiredFlags, vk::MemoryPropertyFlags avoidFlags) -> std::unique_ptr<VulkanGeometryStore>
+{
+    if (!allocator || vertexCapacity == 0 || indexCapacity == 0 || maxMeshCount == 0) {
+        return nullptr;
+    }
+    auto device = allocator->GetDevice();
+    if (!SupportBufferDeviceAddress(device)) {
+        return nullptr;
+    }
+    auto usage = vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress;
+    auto buildInputUsage = vk::BufferUsageFlags{};
+    if (device->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) {
+        buildInputUsage = vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+    }
+    auto store = std::unique_ptr<VulkanGeometryStore>(new VulkanGeometryStore());
+    store->m_VertexBuffer = BulletRT::Core::VulkanBuffer::Builder()
+        .SetUsage(usage | buildInputUsage | vk::BufferUsageFlagBits::eVertexBuffer)
+        .SetSize(vertexCapacity)
+        .Build(device);
+    store->m_IndexBuffer = BulletRT::Core::VulkanBuffer::Builder()
+        .SetUsage(usage | buildInputUsage | vk::BufferUsageFlagBits::eIndexBuffer)
+        .SetSize(indexCapacity)
+        .Build(device);
+    store->m_MeshTableBuffer = BulletRT::Core::VulkanBuffer::Builder()
+        .SetUsage(usage)
+        .SetSize(sizeof(VulkanGeometryMeshRecord) * maxMeshCount)
+        .Build(device);
+    if (!store->m_VertexBuffer || !store->m_IndexBuffer || !store->m_MeshTableBuffer) {
+        return nullptr;
+    }
+    store->m_VertexAllocation    = allocator->AllocateBuffer(store->m_VertexBuffer.get(), requiredFlags, avoidFlags);
+    store->m_IndexAllocation     = allocator->AllocateBuffer(store->m_IndexBuffer.get(), requiredFlags, avoidFlags);
+    store->m_MeshTableAllocation = allocator->AllocateBuffer(store->m_MeshTableBuffer.get(), requiredFlags, avoidFlags);
+    if (!store->m_VertexAllocation || !store->m_IndexAllocation || !store->m_MeshTableAllocation) {
+        return nullptr;
+    }
+    store->m_VertexAllocator = VulkanOffsetAllocator::New(VulkanOffsetAllocatorStrategy::eTlsf, vertexCapacity);
+    store->m_IndexAllocator  = VulkanOffsetAllocator::New(VulkanOffsetAllocatorStrategy::eTlsf, indexCapacity);
+    if (!store->m_VertexAllocator || !store->m_IndexAllocator) {
+        return nullptr;
+    }
+    store->m_MaxMeshCount = maxMeshCount;
+    store->m_Meshes.reserve(maxMeshCount);
+    return store;
+}
+
+BulletRT::Utils::VulkanGeometryStore::~VulkanGeometryStore() noexcept
+{
+    m_Meshes.clear();
+    m_FreeHandles.clear();
+    m_VertexAllocator.reset();
+    m_IndexAllocator.reset();
+    m_MeshTableAllocation.reset();
+    m_IndexAllocation.reset();
+    m_VertexAllocation.reset();
+    m_MeshTableBuffer.reset();
+    m_IndexBuffer.reset();
+    m_VertexBuffer.reset();
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::AddMesh(const VulkanGeometryMeshDesc& desc, VulkanStagingStream* stream) -> VulkanGeometryHandle
+{
+    if (!desc.pVertexData || desc.vertexStride == 0 || desc.vertexCount == 0 || (desc.indexCount > 0 && !desc.pIndexData)) {
+        return InvalidHandle;
+    }
+    if (m_FreeHandles.empty() && m_Meshes.size() >= m_MaxMeshCount) {
+        return InvalidHandle;
+    }
+    auto vertexSize = static_cast<vk::DeviceSize>(desc.vertexStride) * desc.vertexCount;
+    auto indexSize  = static_cast<vk::DeviceSize>(sizeof(uint32_t)) * desc.indexCount;
+    auto vertexRange = m_VertexAllocator->Allocate(vertexSize, kRangeAlignment);
+    if (!vertexRange) {
+        return InvalidHandle;
+    }
+    auto indexRange = std::optional<VulkanOffsetAllocation>(VulkanOffsetAllocation{ 0, 0, 0 });
+    if (indexSize > 0) {
+        indexRange = m_IndexAllocator->Allocate(indexSize, kRangeAlignment);
+        if (!indexRange) {
+            m_VertexAllocator->Free(vertexRange.value());
+            return InvalidHandle;
+        }
+    }
+    auto handle = InvalidHandle;
+    if (!m_FreeHandles.empty()) {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    }
+    else {
+        handle = static_cast<VulkanGeometryHandle>(m_Meshes.size());
+        m_Meshes.emplace_back();
+    }
+    auto& mesh = m_Meshes[handle];
+    mesh.vertexRange  = vertexRange.value();
+    mesh.indexRange   = indexRange.value();
+    mesh.vertexFormat = desc.vertexFormat;
+    mesh.isAlive      = true;
+    mesh.record.vertexAddress = m_VertexAllocation->GetMemoryBuffer()->GetDeviceAddress().value_or(0) + vertexRange->offset;
+    mesh.record.indexAddress  = indexSize > 0 ? m_IndexAllocation->GetMemoryBuffer()->GetDeviceAddress().value_or(0) + indexRange->offset : 0;
+    mesh.record.vertexStride  = desc.vertexStride;
+    mesh.record.vertexCount   = desc.vertexCount;
+    mesh.record.firstIndex    = static_cast<uint32_t>(indexRange->offset / sizeof(uint32_t));
+    mesh.record.indexCount    = desc.indexCount;
+    ++m_MeshCount;
+
+    auto res = Impl_Write(m_VertexAllocation.get(), desc.pVertexData, vertexSize, vertexRange->offset, stream);
+    if (res == vk::Result::eSuccess && indexSize > 0) {
+        res = Impl_Write(m_IndexAllocation.get(), desc.pIndexData, indexSize, indexRange->offset, stream);
+    }
+    if (res == vk::Result::eSuccess) {
+        res = Impl_Write(m_MeshTableAllocation.get(), &mesh.record, sizeof(VulkanGeometryMeshRecord), sizeof(VulkanGeometryMeshRecord) * handle, stream);
+    }
+    if (res != vk::Result::eSuccess) {
+        RemoveMesh(handle);
+        return InvalidHandle;
+    }
+    return handle;
+}
+
+bool BulletRT::Utils::VulkanGeometryStore::RemoveMesh(VulkanGeometryHandle handle)
+{
+    if (handle >= m_Meshes.size() || !m_Meshes[handle].isAlive) {
+        return false;
+    }
+    auto& mesh = m_Meshes[handle];
+    m_VertexAllocator->Free(mesh.vertexRange);
+    if (mesh.indexRange.size > 0) {
+        m_IndexAllocator->Free(mesh.indexRange);
+    }
+    mesh.isAlive = false;
+    m_FreeHandles.push_back(handle);
+    --m_MeshCount;
+    return true;
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetMesh(VulkanGeometryHandle handle) const -> std::optional<VulkanGeometryMeshRecord>
+{
+    if (handle >= m_Meshes.size() || !m_Meshes[handle].isAlive) {
+        return std::nullopt;
+    }
+    return m_Meshes[handle].record;
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetVertexOffset(VulkanGeometryHandle handle) const -> std::optional<vk::DeviceSize>
+{
+    if (handle >= m_Meshes.size() || !m_Meshes[handle].isAlive) {
+        return std::nullopt;
+    }
+    return m_Meshes[handle].vertexRange.offset;
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetIndexOffset(VulkanGeometryHandle handle) const -> std::optional<vk::DeviceSize>
+{
+    if (handle >= m_Meshes.size() || !m_Meshes[handle].isAlive) {
+        return std::nullopt;
+    }
+    return m_Meshes[handle].indexRange.offset;
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetGeometryDesc(VulkanGeometryHandle handle, vk::GeometryFlagsKHR flags) const -> std::optional<BulletRT::Core::VulkanAccelerationStructureGeometryDesc>
+{
+    if (handle >= m_Meshes.size() || !m_Meshes[handle].isAlive) {
+        return std::nullopt;
+    }
+    auto& mesh = m_Meshes[handle];
+    auto isIndexed = mesh.record.indexCount > 0;
+    return BulletRT::Core::VulkanAccelerationStructureGeometryDesc::Triangles(
+        m_VertexAllocation->GetMemoryBuffer(), mesh.vertexFormat, mesh.record.vertexStride, mesh.record.vertexCount,
+        isIndexed ? m_IndexAllocation->GetMemoryBuffer() : nullptr, vk::IndexType::eUint32,
+        isIndexed ? mesh.record.indexCount / 3 : mesh.record.vertexCount / 3)
+        .SetVertexBuffer(m_VertexAllocation->GetMemoryBuffer(), mesh.vertexRange.offset)
+        .SetIndexBuffer(isIndexed ? m_IndexAllocation->GetMemoryBuffer() : nullptr, isIndexed ? vk::IndexType::eUint32 : vk::IndexType::eNoneKHR, mesh.indexRange.offset)
+        .SetFlags(flags);
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetVertexBuffer() const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*
+{
+    return m_VertexAllocation->GetMemoryBuffer();
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetIndexBuffer() const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*
+{
+    return m_IndexAllocation->GetMemoryBuffer();
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetMeshTableBuffer() const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*
+{
+    return m_MeshTableAllocation->GetMemoryBuffer();
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetMeshTableAddress() const noexcept -> vk::DeviceAddress
+{
+    return m_MeshTableAllocation->GetMemoryBuffer()->GetDeviceAddress().value_or(0);
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetMeshCount() const noexcept -> uint32_t
+{
+    return m_MeshCount;
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::GetMaxMeshCount() const noexcept -> uint32_t
+{
+    return m_MaxMeshCount;
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::QueryVertexStatistics() const noexcept -> VulkanOffsetAllocatorStatistics
+{
+    return m_VertexAllocator->QueryStatistics();
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::QueryIndexStatistics() const noexcept -> VulkanOffsetAllocatorStatistics
+{
+    return m_IndexAllocator->QueryStatistics();
+}
+
+BulletRT::Utils::VulkanGeometryStore::VulkanGeometryStore() noexcept
+{
+    m_MaxMeshCount = 0;
+    m_MeshCount    = 0;
+}
+
+auto BulletRT::Utils::VulkanGeometryStore::Impl_Write(const VulkanAllocation* allocation, const void* pData, vk::DeviceSize sizeInBytes, vk::DeviceSize offset, VulkanStagingStream* stream) -> vk::Result
+{
+    auto memory = allocation->GetMemory();
+    if (memory->IsHostVisible() && memory->GetMappedData()) {
+        std::memcpy(static_cast<char*>(memory->GetMappedData()) + allocation->GetMemoryOffset() + offset, pData, sizeInBytes);
+        return allocation->GetMemoryBuffer()->FlushMappedRange(sizeInBytes, offset);
+    }
+    if (!stream) {
+        return vk::Result::eErrorMemoryMapFailed;
+    }
+    return stream->Upload(pData, sizeInBytes, allocation->GetMemoryBuffer()->GetBuffer(), offset);
+}
@@ -0,0 +1,112 @@
+#include <BulletRT/Utils/VulkanGraphicsPipelinePool.h>
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::New(const BulletRT::Core::VulkanDevice* device) -> std::unique_ptr<VulkanGraphicsPipelinePool>
+{
+    if (!device) {
+        return nullptr;
+    }
+    auto pool = new VulkanGraphicsPipelinePool();
+    pool->m_Device = device;
+    return std::unique_ptr<VulkanGraphicsPipelinePool>(pool);
+}
+
+BulletRT::Utils::VulkanGraphicsPipelinePool::~VulkanGraphicsPipelinePool() noexcept
+{
+    m_Pipelines.clear();
+}
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::Acquire(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder) -> const BulletRT::Core::VulkanGraphicsPipeline*
+{
+    auto key  = builder.GetStateKey();
+    auto hash = BulletRT::Core::HashBytes(key.data(), key.size());
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto iter = Impl_Find(hash, key);
+        if (iter != std::end(m_Pipelines)) {
+            ++m_HitCount;
+            return iter->second.pipeline.get();
+        }
+        ++m_MissCount;
+    }
+    auto pipeline = builder.Build(m_Device);
+    if (!pipeline) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = Impl_Find(hash, key);
+    if (iter != std::end(m_Pipelines)) {
+        return iter->second.pipeline.get();
+    }
+    return m_Pipelines.emplace(hash, PipelineDesc{ std::move(key), std::move(pipeline) })->second.pipeline.get();
+}
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::Find(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder) const -> const BulletRT::Core::VulkanGraphicsPipeline*
+{
+    auto key  = builder.GetStateKey();
+    auto hash = BulletRT::Core::HashBytes(key.data(), key.size());
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = Impl_Find(hash, key);
+    return iter != std::end(m_Pipelines) ? iter->second.pipeline.get() : nullptr;
+}
+
+bool BulletRT::Utils::VulkanGraphicsPipelinePool::Remove(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder)
+{
+    auto key  = builder.GetStateKey();
+    auto hash = BulletRT::Core::HashBytes(key.data(), key.size());
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = Impl_Find(hash, key);
+    if (iter == std::end(m_Pipelines)) {
+        return false;
+    }
+    m_Pipelines.erase(iter);
+    return true;
+}
+
+void BulletRT::Utils::VulkanGraphicsPipelinePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Pipelines.clear();
+    m_HitCount  = 0;
+    m_MissCount = 0;
+}
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice*
+{
+    return m_Device;
+}
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::GetPipelineCount() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Pipelines.size();
+}
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::GetHitCount() const -> uint64_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_HitCount;
+}
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::GetMissCount() const -> uint64_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_MissCount;
+}
+
+BulletRT::Utils::VulkanGraphicsPipelinePool::VulkanGraphicsPipelinePool() noexcept
+{
+    m_Device    = nullptr;
+    m_HitCount  = 0;
+    m_MissCount = 0;
+}
+
+auto BulletRT::Utils::VulkanGraphicsPipelinePool::Impl_Find(uint64_t hash, const std::vector<uint8_t>& key) const -> PipelineMap::const_iterator
+{
+    auto [first, last] = m_Pipelines.equal_range(hash);
+    for (auto iter = first; iter != last; ++iter) {
+        if (iter->second.key == key) {
+            return iter;
+        }
+    }
+    return std::end(m_Pipelines);
+}
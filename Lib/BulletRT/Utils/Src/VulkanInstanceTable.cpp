@@ -0,0 +1,237 @@
+#include <BulletRT/Utils/VulkanInstanceTable.h>
+#include <algorithm>
+// Dirty records closer than this are sent as one range; a few redundant records are cheaper than another copy region.
+static constexpr uint32_t kMaxMergeGap = 4;
+
+auto BulletRT::Utils::VulkanInstanceTable::New(VulkanAllocator* allocator, uint32_t maxInstanceCount) -> std::unique_ptr<VulkanInstanceTable>
+{
+    if (!allocator || maxInstanceCount == 0) {
+        return nullptr;
+    }
+    auto allocation = allocator->NewBuffer(BulletRT::Core::VulkanBuffer::Builder()
+        .SetUsage(vk::BufferUsageFlagBits::eTransferDst |
+            vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR |
+            vk::BufferUsageFlagBits::eShaderDeviceAddress)
+        .SetSize(sizeof(vk::AccelerationStructureInstanceKHR) * maxInstanceCount),
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+    if (!allocation) {
+        return nullptr;
+    }
+    auto table = new VulkanInstanceTable();
+    table->m_Allocation       = std::move(allocation);
+    table->m_MaxInstanceCount = maxInstanceCount;
+    table->m_Instances.reserve(maxInstanceCount);
+    table->m_SlotHandles.reserve(maxInstanceCount);
+    table->m_DirtyFlags.assign(maxInstanceCount, false);
+    return std::unique_ptr<VulkanInstanceTable>(table);
+}
+
+BulletRT::Utils::VulkanInstanceTable::~VulkanInstanceTable() noexcept
+{
+    m_Allocation.reset();
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::Add(const vk::AccelerationStructureInstanceKHR& instance) -> VulkanInstanceHandle
+{
+    if (m_Instances.size() >= m_MaxInstanceCount) {
+        return InvalidHandle;
+    }
+    auto handle = InvalidHandle;
+    if (!m_FreeHandles.empty()) {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    }
+    else {
+        handle = static_cast<VulkanInstanceHandle>(m_HandleSlots.size());
+        m_HandleSlots.push_back(InvalidHandle);
+    }
+    auto slot = static_cast<uint32_t>(m_Instances.size());
+    m_Instances.push_back(instance);
+    m_SlotHandles.push_back(handle);
+    m_HandleSlots[handle] = slot;
+    Impl_MarkDirty(slot);
+    return handle;
+}
+
+bool BulletRT::Utils::VulkanInstanceTable::Remove(VulkanInstanceHandle handle)
+{
+    auto slot = GetSlot(handle);
+    if (!slot) {
+        return false;
+    }
+    auto lastSlot = static_cast<uint32_t>(m_Instances.size() - 1);
+    if (slot.value() != lastSlot) {
+        m_Instances[slot.value()]   = m_Instances[lastSlot];
+        m_SlotHandles[slot.value()] = m_SlotHandles[lastSlot];
+        m_HandleSlots[m_SlotHandles[slot.value()]] = slot.value();
+        Impl_MarkDirty(slot.value());
+    }
+    m_Instances.pop_back();
+    m_SlotHandles.pop_back();
+    m_HandleSlots[handle] = InvalidHandle;
+    m_FreeHandles.push_back(handle);
+    return true;
+}
+
+bool BulletRT::Utils::VulkanInstanceTable::Set(VulkanInstanceHandle handle, const vk::AccelerationStructureInstanceKHR& instance)
+{
+    auto slot = GetSlot(handle);
+    if (!slot) {
+        return false;
+    }
+    m_Instances[slot.value()] = instance;
+    Impl_MarkDirty(slot.value());
+    return true;
+}
+
+bool BulletRT::Utils::VulkanInstanceTable::SetTransform(VulkanInstanceHandle handle, const vk::TransformMatrixKHR& transform)
+{
+    auto slot = GetSlot(handle);
+    if (!slot) {
+        return false;
+    }
+    m_Instances[slot.value()].transform = transform;
+    Impl_MarkDirty(slot.value());
+    return true;
+}
+
+bool BulletRT::Utils::VulkanInstanceTable::SetMask(VulkanInstanceHandle handle, uint32_t mask)
+{
+    auto slot = GetSlot(handle);
+    if (!slot) {
+        return false;
+    }
+    m_Instances[slot.value()].mask = mask;
+    Impl_MarkDirty(slot.value());
+    return true;
+}
+
+bool BulletRT::Utils::VulkanInstanceTable::SetShaderBindingTableRecordOffset(VulkanInstanceHandle handle, uint32_t offset)
+{
+    auto slot = GetSlot(handle);
+    if (!slot) {
+        return false;
+    }
+    m_Instances[slot.value()].instanceShaderBindingTableRecordOffset = offset;
+    Impl_MarkDirty(slot.value());
+    return true;
+}
+
+bool BulletRT::Utils::VulkanInstanceTable::SetFlags(VulkanInstanceHandle handle, vk::GeometryInstanceFlagsKHR flags)
+{
+    auto slot = GetSlot(handle);
+    if (!slot) {
+        return false;
+    }
+    m_Instances[slot.value()].flags = static_cast<VkGeometryInstanceFlagsKHR>(flags);
+    Impl_MarkDirty(slot.value());
+    return true;
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::Get(VulkanInstanceHandle handle) const -> std::optional<vk::AccelerationStructureInstanceKHR>
+{
+    auto slot = GetSlot(handle);
+    if (!slot) {
+        return std::nullopt;
+    }
+    return m_Instances[slot.value()];
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::GetSlot(VulkanInstanceHandle handle) const -> std::optional<uint32_t>
+{
+    if (handle >= m_HandleSlots.size() || m_HandleSlots[handle] == InvalidHandle) {
+        return std::nullopt;
+    }
+    return m_HandleSlots[handle];
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::Upload(VulkanStagingStream* stream) -> vk::Result
+{
+    m_LastUploadCount = 0;
+    if (!stream) {
+        return vk::Result::eErrorUnknown;
+    }
+    auto instanceCount = static_cast<uint32_t>(m_Instances.size());
+    std::sort(std::begin(m_DirtySlots), std::end(m_DirtySlots));
+    auto res = vk::Result::eSuccess;
+    auto remainingSlots = std::vector<uint32_t>();
+    auto idx = size_t(0);
+    while (idx < m_DirtySlots.size()) {
+        auto rangeBegin = m_DirtySlots[idx];
+        // Slots past the packed range were vacated by Remove and no longer need to be sent.
+        if (rangeBegin >= instanceCount) {
+            m_DirtyFlags[rangeBegin] = false;
+            ++idx;
+            continue;
+        }
+        auto firstIdx = idx;
+        auto rangeEnd = rangeBegin + 1;
+        for (++idx; idx < m_DirtySlots.size() && m_DirtySlots[idx] < instanceCount && m_DirtySlots[idx] <= rangeEnd + kMaxMergeGap; ++idx) {
+            rangeEnd = m_DirtySlots[idx] + 1;
+        }
+        if (res == vk::Result::eSuccess) {
+            res = stream->Upload(m_Instances.data() + rangeBegin, sizeof(vk::AccelerationStructureInstanceKHR) * (rangeEnd - rangeBegin),
+                m_Allocation->GetMemoryBuffer()->GetBuffer(), sizeof(vk::AccelerationStructureInstanceKHR) * rangeBegin);
+        }
+        if (res != vk::Result::eSuccess) {
+            remainingSlots.insert(std::end(remainingSlots), std::begin(m_DirtySlots) + firstIdx, std::begin(m_DirtySlots) + idx);
+            continue;
+        }
+        for (auto i = firstIdx; i < idx; ++i) {
+            m_DirtyFlags[m_DirtySlots[i]] = false;
+        }
+        m_LastUploadCount += rangeEnd - rangeBegin;
+    }
+    m_DirtySlots = std::move(remainingSlots);
+    return res;
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::GetGeometryDesc() const noexcept -> BulletRT::Core::VulkanAccelerationStructureGeometryDesc
+{
+    return BulletRT::Core::VulkanAccelerationStructureGeometryDesc::Instances(m_Allocation->GetMemoryBuffer(), GetInstanceCount());
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::GetBuffer() const noexcept -> const BulletRT::Core::VulkanMemoryBuffer*
+{
+    return m_Allocation->GetMemoryBuffer();
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::GetInstanceCount() const noexcept -> uint32_t
+{
+    return static_cast<uint32_t>(m_Instances.size());
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::GetMaxInstanceCount() const noexcept -> uint32_t
+{
+    return m_MaxInstanceCount;
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::GetDirtyCount() const noexcept -> size_t
+{
+    return m_DirtySlots.size();
+}
+
+auto BulletRT::Utils::VulkanInstanceTable::GetLastUploadCount() const noexcept -> uint32_t
+{
+    return m_LastUploadCount;
+}
+
+BulletRT::Utils::VulkanInstanceTable::VulkanInstanceTable() noexcept
+{
+    m_MaxInstanceCount = 0;
+    m_Instances        = {};
+    m_SlotHandles      = {};
+    m_HandleSlots      = {};
+    m_FreeHandles      = {};
+    m_DirtySlots       = {};
+    m_DirtyFlags       = {};
+    m_LastUploadCount  = 0;
+}
+
+void BulletRT::Utils::VulkanInstanceTable::Impl_MarkDirty(uint32_t slot)
+{
+    if (!m_DirtyFlags[slot]) {
+        m_DirtyFlags[slot] = true;
+        m_DirtySlots.push_back(slot);
+    }
+}
@@ -0,0 +1,61 @@
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+
+auto BulletRT::Utils::FindMemoryTypeIndices(const vk::PhysicalDeviceMemoryProperties& memoryProps, uint32_t memoryTypeBits, vk::MemoryPropertyFlags requiredFlags, vk::MemoryPropertyFlags avoidFlags) -> std::vector<uint32_t>
+{
+    auto indices = std::vector<uint32_t>();
+    for (uint32_t i = 0; i < memoryProps.memoryTypeCount; ++i)
+    {
+        if ((static_cast<uint32_t>(1) << i) & memoryTypeBits)
+        {
+            if (((memoryProps.memoryTypes[i].propertyFlags & requiredFlags) == requiredFlags) &&
+                ((memoryProps.memoryTypes[i].propertyFlags & ~avoidFlags) == memoryProps.memoryTypes[i].propertyFlags))
+            {
+                indices.push_back(i);
+            }
+        }
+    }
+    return indices;
+}
+
+auto BulletRT::Utils::CalcAlignedSize(vk::DeviceSize size, vk::DeviceSize alignment) noexcept -> vk::DeviceSize
+{
+    return ((size + alignment - 1) / alignment) * alignment;
+}
+
+bool BulletRT::Utils::SupportBufferDeviceAddress(const BulletRT::Core::VulkanDevice* device)
+{
+    if (auto features = device->QueryFeatures<vk::PhysicalDeviceVulkan12Features>())
+    {
+        if (features.value().bufferDeviceAddress)
+        {
+            return true;
+        }
+    }
+    if (auto features = device->QueryFeatures<vk::PhysicalDeviceBufferDeviceAddressFeaturesKHR>())
+    {
+        if (features.value().bufferDeviceAddress)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BulletRT::Utils::SupportTimelineSemaphore(const BulletRT::Core::VulkanDevice* device)
+{
+    if (auto features = device->QueryFeatures<vk::PhysicalDeviceVulkan12Features>())
+    {
+        if (features.value().timelineSemaphore)
+        {
+            return true;
+        }
+    }
+    if (auto features = device->QueryFeatures<vk::PhysicalDeviceTimelineSemaphoreFeatures>())
+    {
+        if (features.value().timelineSemaphore)
+        {
+            return true;
+        }
+    }
+    return false;
+}
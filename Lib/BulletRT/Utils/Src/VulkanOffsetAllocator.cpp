@@ -0,0 +1,329 @@
+#include <BulletRT/Utils/VulkanOffsetAllocator.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+#include <algorithm>
+#include <bit>
+
+class VulkanLinearOffsetAllocator : public BulletRT::Utils::VulkanOffsetAllocator
+{
+public:
+    VulkanLinearOffsetAllocator(vk::DeviceSize size)noexcept
+        :BulletRT::Utils::VulkanOffsetAllocator(BulletRT::Utils::VulkanOffsetAllocatorStrategy::eLinear, size)
+    {
+        m_Head = 0;
+        m_AllocationCount = 0;
+    }
+    virtual ~VulkanLinearOffsetAllocator()noexcept {}
+
+    virtual auto Allocate(vk::DeviceSize size, vk::DeviceSize alignment)->std::optional<BulletRT::Utils::VulkanOffsetAllocation> override
+    {
+        auto offset = BulletRT::Utils::CalcAlignedSize(m_Head, std::max<vk::DeviceSize>(alignment, 1));
+        if (size == 0 || offset + size > GetSize()) {
+            return std::nullopt;
+        }
+        m_Head = offset + size;
+        ++m_AllocationCount;
+        return BulletRT::Utils::VulkanOffsetAllocation{ offset, size, 0 };
+    }
+    virtual void Free(const BulletRT::Utils::VulkanOffsetAllocation& allocation)noexcept override
+    {
+        --m_AllocationCount;
+        if (m_AllocationCount == 0) {
+            m_Head = 0;
+        }
+        else if (allocation.offset + allocation.size == m_Head) {
+            m_Head = allocation.offset;
+        }
+    }
+    virtual void Reset()noexcept override
+    {
+        m_Head = 0;
+        m_AllocationCount = 0;
+    }
+    virtual bool IsEmpty()const noexcept override
+    {
+        return m_AllocationCount == 0;
+    }
+    virtual auto QueryStatistics()const noexcept -> BulletRT::Utils::VulkanOffsetAllocatorStatistics override
+    {
+        auto freeSize = GetSize() - m_Head;
+        return BulletRT::Utils::VulkanOffsetAllocatorStatistics{ GetSize(), freeSize, freeSize, m_AllocationCount, size_t(freeSize > 0 ? 1 : 0) };
+    }
+private:
+    vk::DeviceSize m_Head;
+    size_t         m_AllocationCount;
+};
+
+// Two-level segregated fit: the first level splits sizes by power of two, the second
+// level splits each power of two into kSlCount linear sub-ranges. Every bin keeps an
+// intrusive list of free nodes, and bitmaps over both levels let Allocate find a
+// non-empty bin with two bit scans. Nodes also link to their physical neighbours so
+// that Free can coalesce in constant time.
+class VulkanTlsfOffsetAllocator : public BulletRT::Utils::VulkanOffsetAllocator
+{
+public:
+    VulkanTlsfOffsetAllocator(vk::DeviceSize size)noexcept
+        :BulletRT::Utils::VulkanOffsetAllocator(BulletRT::Utils::VulkanOffsetAllocatorStrategy::eTlsf, size)
+    {
+        Reset();
+    }
+    virtual ~VulkanTlsfOffsetAllocator()noexcept {}
+
+    virtual auto Allocate(vk::DeviceSize size, vk::DeviceSize alignment)->std::optional<BulletRT::Utils::VulkanOffsetAllocation> override
+    {
+        alignment = std::max<vk::DeviceSize>(alignment, 1);
+        if (size == 0 || size > GetSize() || alignment > GetSize() - size + 1) {
+            return std::nullopt;
+        }
+        // Searching for size + alignment - 1 guarantees any node found can host an aligned range.
+        auto nodeIndex = Impl_FindFreeNode(size + alignment - 1);
+        if (nodeIndex == kNone) {
+            return std::nullopt;
+        }
+        Impl_RemoveFromBin(nodeIndex);
+
+        auto alignedOffset = BulletRT::Utils::CalcAlignedSize(m_Nodes[nodeIndex].offset, alignment);
+        auto padding = alignedOffset - m_Nodes[nodeIndex].offset;
+        if (padding > 0) {
+            auto paddingIndex = Impl_NewNode(m_Nodes[nodeIndex].offset, padding);
+            Impl_LinkBefore(paddingIndex, nodeIndex);
+            m_Nodes[nodeIndex].offset = alignedOffset;
+            m_Nodes[nodeIndex].size  -= padding;
+            Impl_InsertToBin(paddingIndex);
+        }
+        auto remainder = m_Nodes[nodeIndex].size - size;
+        if (remainder > 0) {
+            auto remainderIndex = Impl_NewNode(alignedOffset + size, remainder);
+            Impl_LinkAfter(remainderIndex, nodeIndex);
+            m_Nodes[nodeIndex].size = size;
+            Impl_InsertToBin(remainderIndex);
+        }
+        m_Nodes[nodeIndex].used = true;
+        m_FreeSize -= size;
+        ++m_AllocationCount;
+        return BulletRT::Utils::VulkanOffsetAllocation{ alignedOffset, size, nodeIndex };
+    }
+    virtual void Free(const BulletRT::Utils::VulkanOffsetAllocation& allocation)noexcept override
+    {
+        auto nodeIndex = allocation.metadata;
+        if (nodeIndex >= m_Nodes.size() || !m_Nodes[nodeIndex].used) {
+            return;
+        }
+        m_FreeSize += m_Nodes[nodeIndex].size;
+        --m_AllocationCount;
+        m_Nodes[nodeIndex].used = false;
+
+        auto prevIndex = m_Nodes[nodeIndex].neighborPrev;
+        if (prevIndex != kNone && !m_Nodes[prevIndex].used) {
+            Impl_RemoveFromBin(prevIndex);
+            m_Nodes[nodeIndex].offset = m_Nodes[prevIndex].offset;
+            m_Nodes[nodeIndex].size  += m_Nodes[prevIndex].size;
+            Impl_Unlink(prevIndex);
+            Impl_DeleteNode(prevIndex);
+        }
+        auto nextIndex = m_Nodes[nodeIndex].neighborNext;
+        if (nextIndex != kNone && !m_Nodes[nextIndex].used) {
+            Impl_RemoveFromBin(nextIndex);
+            m_Nodes[nodeIndex].size += m_Nodes[nextIndex].size;
+            Impl_Unlink(nextIndex);
+            Impl_DeleteNode(nextIndex);
+        }
+        Impl_InsertToBin(nodeIndex);
+    }
+    virtual void Reset()noexcept override
+    {
+        m_Nodes.clear();
+        m_UnusedNodes.clear();
+        m_FlBitmap = 0;
+        std::fill(std::begin(m_SlBitmaps), std::end(m_SlBitmaps), 0);
+        std::fill(std::begin(m_BinHeads), std::end(m_BinHeads), kNone);
+        m_FreeSize = GetSize();
+        m_AllocationCount = 0;
+        m_FreeRangeCount = 0;
+        if (GetSize() > 0) {
+            Impl_InsertToBin(Impl_NewNode(0, GetSize()));
+        }
+    }
+    virtual bool IsEmpty()const noexcept override
+    {
+        return m_AllocationCount == 0;
+    }
+    virtual auto QueryStatistics()const noexcept -> BulletRT::Utils::VulkanOffsetAllocatorStatistics override
+    {
+        auto largestFreeRange = vk::DeviceSize(0);
+        if (m_FlBitmap != 0) {
+            auto fl = static_cast<uint32_t>(std::bit_width(m_FlBitmap) - 1);
+            auto sl = static_cast<uint32_t>(std::bit_width(m_SlBitmaps[fl]) - 1);
+            for (auto nodeIndex = m_BinHeads[fl * kSlCount + sl]; nodeIndex != kNone; nodeIndex = m_Nodes[nodeIndex].binNext) {
+                largestFreeRange = std::max(largestFreeRange, m_Nodes[nodeIndex].size);
+            }
+        }
+        return BulletRT::Utils::VulkanOffsetAllocatorStatistics{ GetSize(), m_FreeSize, largestFreeRange, m_AllocationCount, m_FreeRangeCount };
+    }
+private:
+    static constexpr uint32_t kNone    = UINT32_MAX;
+    static constexpr uint32_t kSlLog2  = 4;
+    static constexpr uint32_t kSlCount = 1u << kSlLog2;
+    static constexpr uint32_t kFlCount = 64 - kSlLog2 + 1;
+
+    struct Node
+    {
+        vk::DeviceSize offset;
+        vk::DeviceSize size;
+        uint32_t       binPrev;
+        uint32_t       binNext;
+        uint32_t       neighborPrev;
+        uint32_t       neighborNext;
+        bool           used;
+    };
+
+    // Sizes below kSlCount map linearly into the first level; larger sizes map to
+    // the power-of-two bucket and the kSlLog2 bits right below the leading one.
+    static void Impl_MapSize(vk::DeviceSize size, uint32_t& fl, uint32_t& sl)noexcept
+    {
+        if (size < kSlCount) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size);
+        }
+        else {
+            auto msb = static_cast<uint32_t>(std::bit_width(size) - 1);
+            fl = msb - kSlLog2 + 1;
+            sl = static_cast<uint32_t>(size >> (msb - kSlLog2)) ^ kSlCount;
+        }
+    }
+    auto Impl_FindFreeNode(vk::DeviceSize size)const noexcept -> uint32_t
+    {
+        // Round up to the next bin boundary so every node in the chosen bin is large enough.
+        if (size >= kSlCount) {
+            auto msb = static_cast<uint32_t>(std::bit_width(size) - 1);
+            auto round = (vk::DeviceSize(1) << (msb - kSlLog2)) - 1;
+            if (size > UINT64_MAX - round) {
+                return kNone;
+            }
+            size += round;
+        }
+        uint32_t fl, sl;
+        Impl_MapSize(size, fl, sl);
+        if (fl >= kFlCount) {
+            return kNone;
+        }
+        auto slMap = m_SlBitmaps[fl] & (~0u << sl);
+        if (slMap == 0) {
+            auto flMap = (fl + 1 < 64) ? (m_FlBitmap & (~uint64_t(0) << (fl + 1))) : uint64_t(0);
+            if (flMap == 0) {
+                return kNone;
+            }
+            fl = static_cast<uint32_t>(std::countr_zero(flMap));
+            slMap = m_SlBitmaps[fl];
+        }
+        sl = static_cast<uint32_t>(std::countr_zero(slMap));
+        return m_BinHeads[fl * kSlCount + sl];
+    }
+    void Impl_InsertToBin(uint32_t nodeIndex)noexcept
+    {
+        uint32_t fl, sl;
+        Impl_MapSize(m_Nodes[nodeIndex].size, fl, sl);
+        auto& head = m_BinHeads[fl * kSlCount + sl];
+        m_Nodes[nodeIndex].binPrev = kNone;
+        m_Nodes[nodeIndex].binNext = head;
+        if (head != kNone) {
+            m_Nodes[head].binPrev = nodeIndex;
+        }
+        head = nodeIndex;
+        m_FlBitmap      |= uint64_t(1) << fl;
+        m_SlBitmaps[fl] |= 1u << sl;
+        ++m_FreeRangeCount;
+    }
+    void Impl_RemoveFromBin(uint32_t nodeIndex)noexcept
+    {
+        auto& node = m_Nodes[nodeIndex];
+        if (node.binPrev != kNone) {
+            m_Nodes[node.binPrev].binNext = node.binNext;
+        }
+        else {
+            uint32_t fl, sl;
+            Impl_MapSize(node.size, fl, sl);
+            m_BinHeads[fl * kSlCount + sl] = node.binNext;
+            if (node.binNext == kNone) {
+                m_SlBitmaps[fl] &= ~(1u << sl);
+                if (m_SlBitmaps[fl] == 0) {
+                    m_FlBitmap &= ~(uint64_t(1) << fl);
+                }
+            }
+        }
+        if (node.binNext != kNone) {
+            m_Nodes[node.binNext].binPrev = node.binPrev;
+        }
+        node.binPrev = kNone;
+        node.binNext = kNone;
+        --m_FreeRangeCount;
+    }
+    auto Impl_NewNode(vk::DeviceSize offset, vk::DeviceSize size) -> uint32_t
+    {
+        auto node = Node{ offset, size, kNone, kNone, kNone, kNone, false };
+        if (!m_UnusedNodes.empty()) {
+            auto nodeIndex = m_UnusedNodes.back();
+            m_UnusedNodes.pop_back();
+            m_Nodes[nodeIndex] = node;
+            return nodeIndex;
+        }
+        m_Nodes.push_back(node);
+        return static_cast<uint32_t>(m_Nodes.size() - 1);
+    }
+    void Impl_DeleteNode(uint32_t nodeIndex)
+    {
+        m_UnusedNodes.push_back(nodeIndex);
+    }
+    void Impl_LinkBefore(uint32_t nodeIndex, uint32_t nextIndex)noexcept
+    {
+        auto prevIndex = m_Nodes[nextIndex].neighborPrev;
+        m_Nodes[nodeIndex].neighborPrev = prevIndex;
+        m_Nodes[nodeIndex].neighborNext = nextIndex;
+        m_Nodes[nextIndex].neighborPrev = nodeIndex;
+        if (prevIndex != kNone) {
+            m_Nodes[prevIndex].neighborNext = nodeIndex;
+        }
+    }
+    void Impl_LinkAfter(uint32_t nodeIndex, uint32_t prevIndex)noexcept
+    {
+        auto nextIndex = m_Nodes[prevIndex].neighborNext;
+        m_Nodes[nodeIndex].neighborPrev = prevIndex;
+        m_Nodes[nodeIndex].neighborNext = nextIndex;
+        m_Nodes[prevIndex].neighborNext = nodeIndex;
+        if (nextIndex != kNone) {
+            m_Nodes[nextIndex].neighborPrev = nodeIndex;
+        }
+    }
+    void Impl_Unlink(uint32_t nodeIndex)noexcept
+    {
+        auto prevIndex = m_Nodes[nodeIndex].neighborPrev;
+        auto nextIndex = m_Nodes[nodeIndex].neighborNext;
+        if (prevIndex != kNone) {
+            m_Nodes[prevIndex].neighborNext = nextIndex;
+        }
+        if (nextIndex != kNone) {
+            m_Nodes[nextIndex].neighborPrev = prevIndex;
+        }
+    }
+private:
+    std::vector<Node>     m_Nodes;
+    std::vector<uint32_t> m_UnusedNodes;
+    uint64_t              m_FlBitmap;
+    uint32_t              m_SlBitmaps[kFlCount];
+    uint32_t              m_BinHeads[kFlCount * kSlCount];
+    vk::DeviceSize        m_FreeSize;
+    size_t                m_AllocationCount;
+    size_t                m_FreeRangeCount;
+};
+
+auto BulletRT::Utils::VulkanOffsetAllocator::New(VulkanOffsetAllocatorStrategy strategy, vk::DeviceSize size) -> std::unique_ptr<VulkanOffsetAllocator>
+{
+    switch (strategy)
+    {
+    case VulkanOffsetAllocatorStrategy::eLinear:
+        return std::unique_ptr<VulkanOffsetAllocator>(new VulkanLinearOffsetAllocator(size));
+    case VulkanOffsetAllocatorStrategy::eTlsf:
+        return std::unique_ptr<VulkanOffsetAllocator>(new VulkanTlsfOffsetAllocator(size));
+    default:
+        return nullptr;
+    }
+}
@@ -0,0 +1,98 @@
+#include <BulletRT/Utils/VulkanParallelRecorder.h>
+#include <algorithm>
+#include <atomic>
+
+auto BulletRT::Utils::VulkanParallelRecorder::New(BulletRT::Core::VulkanCommandBufferAllocator* allocator, VulkanWorkerPool* workerPool, size_t grainSize) -> std::unique_ptr<VulkanParallelRecorder>
+{
+    if (!allocator || !workerPool || grainSize == 0) {
+        return nullptr;
+    }
+    auto recorder = new VulkanParallelRecorder();
+    recorder->m_Allocator  = allocator;
+    recorder->m_WorkerPool = workerPool;
+    recorder->m_GrainSize  = grainSize;
+    return std::unique_ptr<VulkanParallelRecorder>(recorder);
+}
+
+BulletRT::Utils::VulkanParallelRecorder::~VulkanParallelRecorder() noexcept
+{
+    m_Secondaries.clear();
+}
+
+auto BulletRT::Utils::VulkanParallelRecorder::Record(vk::CommandBuffer primary, size_t itemCount, const RecordFunc& func) -> vk::Result
+{
+    return Impl_Record(primary, vk::CommandBufferInheritanceInfo(), vk::CommandBufferUsageFlagBits::eOneTimeSubmit, itemCount, func);
+}
+
+auto BulletRT::Utils::VulkanParallelRecorder::Record(vk::CommandBuffer primary, const BulletRT::Core::VulkanRenderPass* renderPass, uint32_t subpass, vk::Framebuffer framebuffer, size_t itemCount, const RecordFunc& func) -> vk::Result
+{
+    if (!renderPass || subpass >= renderPass->GetSubpassCount()) {
+        return vk::Result::eErrorUnknown;
+    }
+    auto inheritanceInfo = vk::CommandBufferInheritanceInfo()
+        .setRenderPass(renderPass->GetRenderPassVk())
+        .setSubpass(subpass)
+        .setFramebuffer(framebuffer);
+    return Impl_Record(primary, inheritanceInfo, vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue, itemCount, func);
+}
+
+auto BulletRT::Utils::VulkanParallelRecorder::GetAllocator() const noexcept -> BulletRT::Core::VulkanCommandBufferAllocator*
+{
+    return m_Allocator;
+}
+
+auto BulletRT::Utils::VulkanParallelRecorder::GetWorkerPool() const noexcept -> VulkanWorkerPool*
+{
+    return m_WorkerPool;
+}
+
+auto BulletRT::Utils::VulkanParallelRecorder::GetGrainSize() const noexcept -> size_t
+{
+    return m_GrainSize;
+}
+
+void BulletRT::Utils::VulkanParallelRecorder::SetGrainSize(size_t grainSize) noexcept
+{
+    m_GrainSize = std::max<size_t>(grainSize, 1);
+}
+
+BulletRT::Utils::VulkanParallelRecorder::VulkanParallelRecorder() noexcept
+{
+    m_Allocator   = nullptr;
+    m_WorkerPool  = nullptr;
+    m_GrainSize   = 1;
+    m_Secondaries = {};
+}
+
+auto BulletRT::Utils::VulkanParallelRecorder::Impl_Record(vk::CommandBuffer primary, const vk::CommandBufferInheritanceInfo& inheritanceInfo, vk::CommandBufferUsageFlags usage, size_t itemCount, const RecordFunc& func) -> vk::Result
+{
+    if (!primary || !func) {
+        return vk::Result::eErrorUnknown;
+    }
+    if (itemCount == 0) {
+        return vk::Result::eSuccess;
+    }
+    // Keep enough ranges for every thread to stay busy, but never split below the grain size.
+    auto threadCount = static_cast<size_t>(m_WorkerPool->GetThreadCount());
+    auto grainSize   = std::max(m_GrainSize, (itemCount + threadCount * 4 - 1) / (threadCount * 4));
+    auto rangeCount  = (itemCount + grainSize - 1) / grainSize;
+    m_Secondaries.assign(rangeCount, vk::CommandBuffer());
+    auto failed = std::atomic<bool>(false);
+    m_WorkerPool->ParallelFor(itemCount, grainSize, [&](size_t begin, size_t end) {
+        auto secondary = m_Allocator->Allocate(vk::CommandBufferLevel::eSecondary);
+        if (!secondary) {
+            failed = true;
+            return;
+        }
+        secondary.begin(vk::CommandBufferBeginInfo().setFlags(usage).setPInheritanceInfo(&inheritanceInfo));
+        func(secondary, begin, end);
+        secondary.end();
+        m_Secondaries[begin / grainSize] = secondary;
+    });
+    if (failed) {
+        m_Secondaries.clear();
+        return vk::Result::eErrorOutOfHostMemory;
+    }
+    primary.executeCommands(m_Secondaries);
+    return vk::Result::eSuccess;
+}
@@ -0,0 +1,125 @@
+#include <BulletRT/Utils/VulkanPipelineCompileService.h>
+#include <algorithm>
+
+auto BulletRT::Utils::VulkanPipelineCompileService::New(const BulletRT::Core::VulkanDevice* device, VulkanWorkerPool* workerPool) -> std::unique_ptr<VulkanPipelineCompileService>
+{
+    if (!device || !workerPool) {
+        return nullptr;
+    }
+    auto service = std::unique_ptr<VulkanPipelineCompileService>(new VulkanPipelineCompileService());
+    service->m_Device                = device;
+    service->m_WorkerPool            = workerPool;
+    service->m_State                 = std::make_shared<SharedState>();
+    service->m_UseDeferredOperations = device->SupportExtension(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+    return service;
+}
+
+BulletRT::Utils::VulkanPipelineCompileService::~VulkanPipelineCompileService() noexcept
+{
+    if (!m_State) {
+        return;
+    }
+    // Queued tasks see the flag and resolve to null without touching the device.
+    std::unique_lock<std::mutex> lock(m_State->mutex);
+    m_State->isCancelled = true;
+    m_State->idleCondition.wait(lock, [this] { return m_State->activeCount == 0; });
+}
+
+auto BulletRT::Utils::VulkanPipelineCompileService::Compile(const BulletRT::Core::VulkanGraphicsPipelineBuilder& builder, const BulletRT::Core::VulkanGraphicsPipeline* placeholder) -> VulkanAsyncGraphicsPipeline
+{
+    auto promise = std::make_shared<std::promise<std::shared_ptr<BulletRT::Core::VulkanGraphicsPipeline>>>();
+    auto future  = promise->get_future().share();
+    Impl_Enqueue([device = m_Device, builder, promise](bool isCancelled) {
+        if (isCancelled) {
+            promise->set_value(nullptr);
+            return;
+        }
+        auto pipeline = std::shared_ptr<BulletRT::Core::VulkanGraphicsPipeline>();
+        try {
+            pipeline = builder.Build(device);
+        }
+        catch (...) {
+            pipeline = nullptr;
+        }
+        promise->set_value(std::move(pipeline));
+    });
+    return VulkanAsyncGraphicsPipeline(std::move(future), placeholder);
+}
+
+auto BulletRT::Utils::VulkanPipelineCompileService::Compile(const BulletRT::Core::VulkanRayTracingPipelineBuilder& builder, const BulletRT::Core::VulkanRayTracingPipeline* placeholder) -> VulkanAsyncRayTracingPipeline
+{
+    auto promise = std::make_shared<std::promise<std::shared_ptr<BulletRT::Core::VulkanRayTracingPipeline>>>();
+    auto future  = promise->get_future().share();
+    Impl_Enqueue([device = m_Device, workerPool = m_WorkerPool, useDeferredOperations = m_UseDeferredOperations, builder, promise](bool isCancelled) {
+        if (isCancelled) {
+            promise->set_value(nullptr);
+            return;
+        }
+        auto pipeline = std::shared_ptr<BulletRT::Core::VulkanRayTracingPipeline>();
+        try {
+            // The driver's compile threads are helper jobs on the same pool rather than extra threads per pipeline.
+            auto deferredOperation = useDeferredOperations ? BulletRT::Core::VulkanDeferredOperation::New(device, workerPool->GetSubmitter()) : nullptr;
+            pipeline = builder.Build(device, deferredOperation.get());
+        }
+        catch (...) {
+            pipeline = nullptr;
+        }
+        promise->set_value(std::move(pipeline));
+    });
+    return VulkanAsyncRayTracingPipeline(std::move(future), placeholder);
+}
+
+void BulletRT::Utils::VulkanPipelineCompileService::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_State->mutex);
+    m_State->idleCondition.wait(lock, [this] { return m_State->queuedCount == 0 && m_State->activeCount == 0; });
+}
+
+auto BulletRT::Utils::VulkanPipelineCompileService::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice*
+{
+    return m_Device;
+}
+
+auto BulletRT::Utils::VulkanPipelineCompileService::GetWorkerPool() const noexcept -> VulkanWorkerPool*
+{
+    return m_WorkerPool;
+}
+
+auto BulletRT::Utils::VulkanPipelineCompileService::GetPendingCount() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+    return m_State->queuedCount + m_State->activeCount;
+}
+
+BulletRT::Utils::VulkanPipelineCompileService::VulkanPipelineCompileService() noexcept
+{
+    m_Device                = nullptr;
+    m_WorkerPool            = nullptr;
+    m_State                 = nullptr;
+    m_UseDeferredOperations = false;
+}
+
+void BulletRT::Utils::VulkanPipelineCompileService::Impl_Enqueue(std::function<void(bool)> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_State->mutex);
+        ++m_State->queuedCount;
+    }
+    m_WorkerPool->Submit([state = m_State, job = std::move(job)]() {
+        auto isCancelled = false;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            --state->queuedCount;
+            isCancelled = state->isCancelled;
+            if (!isCancelled) {
+                ++state->activeCount;
+            }
+        }
+        job(isCancelled);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!isCancelled) {
+            --state->activeCount;
+        }
+        state->idleCondition.notify_all();
+    });
+}
@@ -0,0 +1,152 @@
+#include <BulletRT/Utils/VulkanRayTracingPipelineLibraryCache.h>
+#include <unordered_set>
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::New(const BulletRT::Core::VulkanDevice* device, VulkanWorkerPool* workerPool) -> std::unique_ptr<VulkanRayTracingPipelineLibraryCache>
+{
+    if (!device || !device->SupportExtension(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME) || !device->SupportExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+        return nullptr;
+    }
+    auto cache = new VulkanRayTracingPipelineLibraryCache();
+    cache->m_Device                = device;
+    cache->m_WorkerPool            = workerPool;
+    cache->m_UseDeferredOperations = workerPool && device->SupportExtension(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+    return std::unique_ptr<VulkanRayTracingPipelineLibraryCache>(cache);
+}
+
+BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::~VulkanRayTracingPipelineLibraryCache() noexcept
+{
+    m_Libraries.clear();
+}
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::Compile(const std::vector<VulkanRayTracingPipelineLibraryDesc>& descs) -> vk::Result
+{
+    auto pendingDescs = std::vector<const VulkanRayTracingPipelineLibraryDesc*>();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto pendingKeys = std::unordered_set<uint64_t>();
+        for (auto& desc : descs) {
+            if (m_Libraries.count(desc.key) == 0 && pendingKeys.insert(desc.key).second) {
+                pendingDescs.push_back(&desc);
+            }
+        }
+    }
+    if (pendingDescs.empty()) {
+        return vk::Result::eSuccess;
+    }
+    // vkCreateRayTracingPipelinesKHR may be called from several threads at once, even with one shared pipeline
+    // cache (pipeline caches are internally synchronized unless created with the externally synchronized flag),
+    // so libraries are created concurrently without holding m_Mutex.
+    auto libraries = std::vector<std::unique_ptr<BulletRT::Core::VulkanRayTracingPipeline>>(pendingDescs.size());
+    auto compileRange = [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            // Module and pipeline creation throw on failure; an exception escaping a worker would terminate the
+            // process, so it is reported as a failed library instead.
+            try {
+                auto builder = pendingDescs[i]->builder;
+                builder.SetFlags(builder.GetFlags() | vk::PipelineCreateFlagBits::eLibraryKHR);
+                auto deferredOperation = Impl_NewDeferredOperation();
+                libraries[i] = builder.Build(m_Device, deferredOperation.get());
+            }
+            catch (...) {
+                libraries[i] = nullptr;
+            }
+        }
+    };
+    if (m_WorkerPool) {
+        m_WorkerPool->ParallelFor(pendingDescs.size(), 1, compileRange);
+    }
+    else {
+        compileRange(0, pendingDescs.size());
+    }
+    auto res = vk::Result::eSuccess;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (size_t i = 0; i < pendingDescs.size(); ++i) {
+        if (!libraries[i]) {
+            res = vk::Result::eErrorInitializationFailed;
+            continue;
+        }
+        m_Libraries.emplace(pendingDescs[i]->key, std::move(libraries[i]));
+    }
+    return res;
+}
+
+bool BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::Contains(uint64_t key) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Libraries.count(key) > 0;
+}
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::Get(uint64_t key) const -> const BulletRT::Core::VulkanRayTracingPipeline*
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = m_Libraries.find(key);
+    return iter != std::end(m_Libraries) ? iter->second.get() : nullptr;
+}
+
+bool BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::Remove(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Libraries.erase(key) > 0;
+}
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::Link(const BulletRT::Core::VulkanRayTracingPipelineBuilder& baseBuilder, const std::vector<uint64_t>& keys, std::vector<uint32_t>* pGroupOffsets) const -> std::unique_ptr<BulletRT::Core::VulkanRayTracingPipeline>
+{
+    auto builder = baseBuilder;
+    auto groupOffsets = std::vector<uint32_t>();
+    groupOffsets.reserve(keys.size());
+    auto groupOffset = static_cast<uint32_t>(baseBuilder.GetGroups().size());
+    for (auto& library : baseBuilder.GetLibraries()) {
+        groupOffset += library ? library->GetGroupCount() : 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (auto key : keys) {
+            auto iter = m_Libraries.find(key);
+            if (iter == std::end(m_Libraries)) {
+                return nullptr;
+            }
+            builder.AddLibrary(iter->second.get());
+            groupOffsets.push_back(groupOffset);
+            groupOffset += iter->second->GetGroupCount();
+        }
+    }
+    builder.SetFlags(builder.GetFlags() & ~vk::PipelineCreateFlags(vk::PipelineCreateFlagBits::eLibraryKHR));
+    auto deferredOperation = Impl_NewDeferredOperation();
+    auto pipeline = builder.Build(m_Device, deferredOperation.get());
+    if (pipeline && pGroupOffsets) {
+        *pGroupOffsets = std::move(groupOffsets);
+    }
+    return pipeline;
+}
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice*
+{
+    return m_Device;
+}
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::GetWorkerPool() const noexcept -> VulkanWorkerPool*
+{
+    return m_WorkerPool;
+}
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::GetLibraryCount() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Libraries.size();
+}
+
+BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::VulkanRayTracingPipelineLibraryCache() noexcept
+{
+    m_Device                = nullptr;
+    m_WorkerPool            = nullptr;
+    m_UseDeferredOperations = false;
+}
+
+auto BulletRT::Utils::VulkanRayTracingPipelineLibraryCache::Impl_NewDeferredOperation() const -> std::unique_ptr<BulletRT::Core::VulkanDeferredOperation>
+{
+    // Lets the driver split a compile across pool workers instead of threads of its own.
+    if (!m_UseDeferredOperations) {
+        return nullptr;
+    }
+    return BulletRT::Core::VulkanDeferredOperation::New(m_Device, m_WorkerPool->GetSubmitter());
+}
@@ -0,0 +1,405 @@
+#include <BulletRT/Utils/VulkanReflection.h>
+#include <spirv_cross.hpp>
+#include <algorithm>
+#include <map>
+
+static auto GetShaderStage(spv::ExecutionModel model) -> std::optional<vk::ShaderStageFlagBits>
+{
+    switch (model) {
+    case spv::ExecutionModelVertex:                 return vk::ShaderStageFlagBits::eVertex;
+    case spv::ExecutionModelTessellationControl:    return vk::ShaderStageFlagBits::eTessellationControl;
+    case spv::ExecutionModelTessellationEvaluation: return vk::ShaderStageFlagBits::eTessellationEvaluation;
+    case spv::ExecutionModelGeometry:               return vk::ShaderStageFlagBits::eGeometry;
+    case spv::ExecutionModelFragment:               return vk::ShaderStageFlagBits::eFragment;
+    case spv::ExecutionModelGLCompute:              return vk::ShaderStageFlagBits::eCompute;
+    case spv::ExecutionModelTaskNV:                 return vk::ShaderStageFlagBits::eTaskNV;
+    case spv::ExecutionModelMeshNV:                 return vk::ShaderStageFlagBits::eMeshNV;
+    case spv::ExecutionModelRayGenerationKHR:       return vk::ShaderStageFlagBits::eRaygenKHR;
+    case spv::ExecutionModelIntersectionKHR:        return vk::ShaderStageFlagBits::eIntersectionKHR;
+    case spv::ExecutionModelAnyHitKHR:              return vk::ShaderStageFlagBits::eAnyHitKHR;
+    case spv::ExecutionModelClosestHitKHR:          return vk::ShaderStageFlagBits::eClosestHitKHR;
+    case spv::ExecutionModelMissKHR:                return vk::ShaderStageFlagBits::eMissKHR;
+    case spv::ExecutionModelCallableKHR:            return vk::ShaderStageFlagBits::eCallableKHR;
+    default:                                        return std::nullopt;
+    }
+}
+
+static auto GetVertexFormat(const spirv_cross::SPIRType& type) -> vk::Format
+{
+    if (type.vecsize < 1 || type.vecsize > 4) {
+        return vk::Format::eUndefined;
+    }
+    auto idx = type.vecsize - 1;
+    switch (type.basetype) {
+    case spirv_cross::SPIRType::Float: {
+        constexpr vk::Format formats[] = { vk::Format::eR32Sfloat, vk::Format::eR32G32Sfloat, vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32B32A32Sfloat };
+        return formats[idx];
+    }
+    case spirv_cross::SPIRType::Int: {
+        constexpr vk::Format formats[] = { vk::Format::eR32Sint, vk::Format::eR32G32Sint, vk::Format::eR32G32B32Sint, vk::Format::eR32G32B32A32Sint };
+        return formats[idx];
+    }
+    case spirv_cross::SPIRType::UInt: {
+        constexpr vk::Format formats[] = { vk::Format::eR32Uint, vk::Format::eR32G32Uint, vk::Format::eR32G32B32Uint, vk::Format::eR32G32B32A32Uint };
+        return formats[idx];
+    }
+    case spirv_cross::SPIRType::Half: {
+        constexpr vk::Format formats[] = { vk::Format::eR16Sfloat, vk::Format::eR16G16Sfloat, vk::Format::eR16G16B16Sfloat, vk::Format::eR16G16B16A16Sfloat };
+        return formats[idx];
+    }
+    case spirv_cross::SPIRType::Short: {
+        constexpr vk::Format formats[] = { vk::Format::eR16Sint, vk::Format::eR16G16Sint, vk::Format::eR16G16B16Sint, vk::Format::eR16G16B16A16Sint };
+        return formats[idx];
+    }
+    case spirv_cross::SPIRType::UShort: {
+        constexpr vk::Format formats[] = { vk::Format::eR16Uint, vk::Format::eR16G16Uint, vk::Format::eR16G16B16Uint, vk::Format::eR16G16B16A16Uint };
+        return formats[idx];
+    }
+    case spirv_cross::SPIRType::Double: {
+        constexpr vk::Format formats[] = { vk::Format::eR64Sfloat, vk::Format::eR64G64Sfloat, vk::Format::eR64G64B64Sfloat, vk::Format::eR64G64B64A64Sfloat };
+        return formats[idx];
+    }
+    default:
+        return vk::Format::eUndefined;
+    }
+}
+
+static auto GetDescriptorCount(const spirv_cross::Compiler& compiler, const spirv_cross::SPIRType& type) -> uint32_t
+{
+    auto count = uint32_t(1);
+    for (size_t i = 0; i < type.array.size(); ++i) {
+        // Array sizes may be specialization constants; their default value is used.
+        auto size = type.array_size_literal[i] ? type.array[i] : compiler.get_constant(type.array[i]).scalar();
+        count *= size;
+    }
+    return count;
+}
+
+static auto ReflectModule(const std::vector<uint32_t>& codes, const std::string& entryPoint) -> std::shared_ptr<BulletRT::Utils::VulkanShaderReflection>
+{
+    // SPIRV-Cross reports malformed modules by throwing; nothing of it escapes this function.
+    try {
+        auto compiler    = spirv_cross::Compiler(codes);
+        auto entryPoints = compiler.get_entry_points_and_stages();
+        auto iter = std::find_if(std::begin(entryPoints), std::end(entryPoints), [&entryPoint](const spirv_cross::EntryPoint& ep) {
+            return entryPoint.empty() || ep.name == entryPoint;
+        });
+        if (iter == std::end(entryPoints)) {
+            return nullptr;
+        }
+        auto stage = GetShaderStage(iter->execution_model);
+        if (!stage) {
+            return nullptr;
+        }
+        compiler.set_entry_point(iter->name, iter->execution_model);
+
+        auto reflection = std::make_shared<BulletRT::Utils::VulkanShaderReflection>();
+        reflection->stage      = *stage;
+        reflection->entryPoint = iter->name;
+
+        // Only the resources reachable from the entry point, so modules with several entry points do not
+        // inflate each other's layouts.
+        auto activeVariables = compiler.get_active_interface_variables();
+        auto resources       = compiler.get_shader_resources(activeVariables);
+        auto addBindings = [&](const spirv_cross::SmallVector<spirv_cross::Resource>& resourceList, vk::DescriptorType descriptorType, vk::DescriptorType texelBufferType) {
+            for (auto& resource : resourceList) {
+                auto& type    = compiler.get_type(resource.type_id);
+                auto  binding = BulletRT::Utils::VulkanReflectedDescriptorBinding();
+                binding.set             = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+                binding.binding         = compiler.get_decoration(resource.id, spv::DecorationBinding);
+                binding.descriptorType  = type.image.dim == spv::DimBuffer ? texelBufferType : descriptorType;
+                binding.descriptorCount = GetDescriptorCount(compiler, type);
+                binding.stageFlags      = *stage;
+                binding.name            = resource.name;
+                reflection->descriptorBindings.push_back(std::move(binding));
+            }
+        };
+        addBindings(resources.uniform_buffers,         vk::DescriptorType::eUniformBuffer,            vk::DescriptorType::eUniformBuffer);
+        addBindings(resources.storage_buffers,         vk::DescriptorType::eStorageBuffer,            vk::DescriptorType::eStorageBuffer);
+        addBindings(resources.sampled_images,          vk::DescriptorType::eCombinedImageSampler,     vk::DescriptorType::eUniformTexelBuffer);
+        addBindings(resources.separate_images,         vk::DescriptorType::eSampledImage,             vk::DescriptorType::eUniformTexelBuffer);
+        addBindings(resources.separate_samplers,       vk::DescriptorType::eSampler,                  vk::DescriptorType::eSampler);
+        addBindings(resources.storage_images,          vk::DescriptorType::eStorageImage,             vk::DescriptorType::eStorageTexelBuffer);
+        addBindings(resources.subpass_inputs,          vk::DescriptorType::eInputAttachment,          vk::DescriptorType::eInputAttachment);
+        addBindings(resources.acceleration_structures, vk::DescriptorType::eAccelerationStructureKHR, vk::DescriptorType::eAccelerationStructureKHR);
+
+        for (auto& resource : resources.push_constant_buffers) {
+            auto ranges = compiler.get_active_buffer_ranges(resource.id);
+            if (ranges.empty()) {
+                continue;
+            }
+            auto begin = UINT32_MAX;
+            auto end   = uint32_t(0);
+            for (auto& range : ranges) {
+                begin = std::min<uint32_t>(begin, static_cast<uint32_t>(range.offset));
+                end   = std::max<uint32_t>(end, static_cast<uint32_t>(range.offset + range.range));
+            }
+            // Push constant offsets and sizes must be multiples of 4.
+            begin &= ~uint32_t(3);
+            end    = (end + 3) & ~uint32_t(3);
+            reflection->pushConstantRanges.push_back(vk::PushConstantRange(*stage, begin, end - begin));
+        }
+
+        for (auto& specializationConstant : compiler.get_specialization_constants()) {
+            auto& type = compiler.get_type(compiler.get_constant(specializationConstant.id).constant_type);
+            auto  desc = BulletRT::Utils::VulkanReflectedSpecializationConstant();
+            desc.constantID = specializationConstant.constant_id;
+            desc.size       = type.basetype == spirv_cross::SPIRType::Boolean ? sizeof(vk::Bool32) : type.width / 8;
+            desc.name       = compiler.get_name(specializationConstant.id);
+            reflection->specializationConstants.push_back(std::move(desc));
+        }
+
+        if (*stage == vk::ShaderStageFlagBits::eVertex) {
+            for (auto& resource : resources.stage_inputs) {
+                if (compiler.has_decoration(resource.id, spv::DecorationBuiltIn)) {
+                    continue;
+                }
+                auto& type     = compiler.get_type(resource.type_id);
+                auto  location = compiler.get_decoration(resource.id, spv::DecorationLocation);
+                auto  format   = GetVertexFormat(type);
+                for (uint32_t column = 0; column < std::max<uint32_t>(type.columns, 1); ++column) {
+                    reflection->vertexInputs.push_back({ location + column, format, resource.name });
+                }
+            }
+            std::sort(std::begin(reflection->vertexInputs), std::end(reflection->vertexInputs), [](const auto& a, const auto& b) {
+                return a.location < b.location;
+            });
+        }
+        return reflection;
+    }
+    catch (const spirv_cross::CompilerError&) {
+        return nullptr;
+    }
+}
+
+auto BulletRT::Utils::VulkanReflection::New(const BulletRT::Core::VulkanDevice* device) -> std::unique_ptr<VulkanReflection>
+{
+    if (!device) {
+        return nullptr;
+    }
+    auto reflection = new VulkanReflection();
+    reflection->m_Device = device;
+    return std::unique_ptr<VulkanReflection>(reflection);
+}
+
+BulletRT::Utils::VulkanReflection::~VulkanReflection() noexcept
+{
+    m_Reflections.clear();
+}
+
+auto BulletRT::Utils::VulkanReflection::Reflect(const std::vector<uint32_t>& codes, const std::string& entryPoint) -> std::shared_ptr<const VulkanShaderReflection>
+{
+    if (codes.empty()) {
+        return nullptr;
+    }
+    auto hash = BulletRT::Core::HashBytes(codes.data(), codes.size() * sizeof(uint32_t));
+    hash = BulletRT::Core::HashBytes(entryPoint.data(), entryPoint.size(), hash);
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (auto reflection = Impl_Find(hash, codes, entryPoint)) {
+            return reflection;
+        }
+    }
+    // Parsing runs outside the lock; if two threads race on one module the first result inserted wins.
+    auto reflection = std::shared_ptr<const VulkanShaderReflection>(ReflectModule(codes, entryPoint));
+    if (!reflection) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (auto inserted = Impl_Find(hash, codes, entryPoint)) {
+        return inserted;
+    }
+    m_Reflections.emplace(hash, ReflectionDesc{ codes, entryPoint, reflection });
+    return reflection;
+}
+
+auto BulletRT::Utils::VulkanReflection::Reflect(const BulletRT::Core::VulkanShaderModule* module, const std::string& entryPoint) -> std::shared_ptr<const VulkanShaderReflection>
+{
+    if (!module) {
+        return nullptr;
+    }
+    return Reflect(module->GetCodes(), entryPoint);
+}
+
+auto BulletRT::Utils::VulkanReflection::Reflect(const std::vector<BulletRT::Core::VulkanPipelineShaderStageDesc>& stages) -> std::optional<VulkanPipelineReflection>
+{
+    auto reflections = std::vector<std::shared_ptr<const VulkanShaderReflection>>();
+    reflections.reserve(stages.size());
+    for (auto& stage : stages) {
+        auto reflection = std::shared_ptr<const VulkanShaderReflection>();
+        if (stage.GetModule()) {
+            reflection = Reflect(stage.GetModule(), stage.GetName());
+        }
+        else if (stage.GetShaderModuleBuilder()) {
+            reflection = Reflect(stage.GetShaderModuleBuilder()->GetCodes(), stage.GetName());
+        }
+        if (!reflection) {
+            return std::nullopt;
+        }
+        reflections.push_back(std::move(reflection));
+    }
+    auto pReflections = std::vector<const VulkanShaderReflection*>();
+    pReflections.reserve(reflections.size());
+    for (auto& reflection : reflections) {
+        pReflections.push_back(reflection.get());
+    }
+    return Merge(pReflections);
+}
+
+auto BulletRT::Utils::VulkanReflection::Merge(const std::vector<const VulkanShaderReflection*>& reflections) -> std::optional<VulkanPipelineReflection>
+{
+    auto merged   = VulkanPipelineReflection();
+    // Ordered maps keep the output sorted by set/binding, stage and constant ID.
+    auto bindings = std::map<std::pair<uint32_t, uint32_t>, VulkanReflectedDescriptorBinding>();
+    auto stageRanges = std::map<VkShaderStageFlags, std::pair<uint32_t, uint32_t>>();
+    auto specializationConstants = std::map<uint32_t, VulkanReflectedSpecializationConstant>();
+    for (auto& reflection : reflections) {
+        if (!reflection) {
+            continue;
+        }
+        merged.stageFlags |= reflection->stage;
+        for (auto& binding : reflection->descriptorBindings) {
+            auto [iter, isInserted] = bindings.emplace(std::make_pair(binding.set, binding.binding), binding);
+            if (isInserted) {
+                continue;
+            }
+            if (iter->second.descriptorType != binding.descriptorType) {
+                return std::nullopt;
+            }
+            iter->second.stageFlags |= binding.stageFlags;
+            // A runtime sized array in any stage keeps the binding runtime sized.
+            if (iter->second.descriptorCount != 0) {
+                iter->second.descriptorCount = binding.descriptorCount == 0 ? 0 : std::max(iter->second.descriptorCount, binding.descriptorCount);
+            }
+        }
+        // Each stage may appear in only one range, so stages seen twice (several hit shaders) get the union.
+        for (auto& range : reflection->pushConstantRanges) {
+            auto key = static_cast<VkShaderStageFlags>(range.stageFlags);
+            auto [iter, isInserted] = stageRanges.emplace(key, std::make_pair(range.offset, range.offset + range.size));
+            if (!isInserted) {
+                iter->second.first  = std::min(iter->second.first, range.offset);
+                iter->second.second = std::max(iter->second.second, range.offset + range.size);
+            }
+        }
+        for (auto& specializationConstant : reflection->specializationConstants) {
+            specializationConstants.emplace(specializationConstant.constantID, specializationConstant);
+        }
+        if (reflection->stage == vk::ShaderStageFlagBits::eVertex) {
+            merged.vertexInputs = reflection->vertexInputs;
+        }
+    }
+    for (auto& [key, binding] : bindings) {
+        if (merged.setBindings.size() <= key.first) {
+            merged.setBindings.resize(key.first + 1);
+        }
+        merged.setBindings[key.first].push_back(binding);
+    }
+    for (auto& [stageFlags, range] : stageRanges) {
+        auto iter = std::find_if(std::begin(merged.pushConstantRanges), std::end(merged.pushConstantRanges), [&range](const vk::PushConstantRange& pushConstantRange) {
+            return pushConstantRange.offset == range.first && pushConstantRange.size == range.second - range.first;
+        });
+        if (iter != std::end(merged.pushConstantRanges)) {
+            iter->stageFlags |= vk::ShaderStageFlags(stageFlags);
+            continue;
+        }
+        merged.pushConstantRanges.push_back(vk::PushConstantRange(vk::ShaderStageFlags(stageFlags), range.first, range.second - range.first));
+    }
+    for (auto& [constantID, specializationConstant] : specializationConstants) {
+        merged.specializationConstants.push_back(specializationConstant);
+    }
+    return merged;
+}
+
+auto BulletRT::Utils::VulkanReflection::CreateDescriptorSetLayouts(const VulkanPipelineReflection& reflection, vk::DescriptorSetLayoutCreateFlags flags,
+    const std::vector<std::vector<vk::DescriptorBindingFlags>>* pBindingFlags) const -> std::optional<std::vector<vk::UniqueDescriptorSetLayout>>
+{
+    if (pBindingFlags && pBindingFlags->size() != reflection.setBindings.size()) {
+        return std::nullopt;
+    }
+    for (size_t set = 0; set < reflection.setBindings.size(); ++set) {
+        if (pBindingFlags && (*pBindingFlags)[set].size() != reflection.setBindings[set].size()) {
+            return std::nullopt;
+        }
+        // A count of 0 would declare the binding empty instead of runtime sized.
+        for (auto& binding : reflection.setBindings[set]) {
+            if (binding.descriptorCount == 0) {
+                return std::nullopt;
+            }
+        }
+    }
+    auto setLayouts = std::vector<vk::UniqueDescriptorSetLayout>();
+    setLayouts.reserve(reflection.setBindings.size());
+    for (size_t set = 0; set < reflection.setBindings.size(); ++set) {
+        auto& bindings   = reflection.setBindings[set];
+        auto  bindingVks = std::vector<vk::DescriptorSetLayoutBinding>();
+        bindingVks.reserve(bindings.size());
+        for (auto& binding : bindings) {
+            bindingVks.push_back(vk::DescriptorSetLayoutBinding(binding.binding, binding.descriptorType, binding.descriptorCount, binding.stageFlags));
+        }
+        auto createInfo   = vk::DescriptorSetLayoutCreateInfo().setFlags(flags).setBindings(bindingVks);
+        auto bindingFlags = vk::DescriptorSetLayoutBindingFlagsCreateInfo();
+        if (pBindingFlags) {
+            bindingFlags.setBindingFlags((*pBindingFlags)[set]);
+            createInfo.setPNext(&bindingFlags);
+        }
+        setLayouts.push_back(m_Device->GetDeviceVk().createDescriptorSetLayoutUnique(createInfo));
+    }
+    return setLayouts;
+}
+
+auto BulletRT::Utils::VulkanReflection::CreatePipelineLayout(const VulkanPipelineReflection& reflection, vk::DescriptorSetLayoutCreateFlags setLayoutFlags,
+    const std::vector<std::vector<vk::DescriptorBindingFlags>>* pBindingFlags) const -> std::optional<VulkanReflectedPipelineLayout>
+{
+    auto setLayouts = CreateDescriptorSetLayouts(reflection, setLayoutFlags, pBindingFlags);
+    if (!setLayouts) {
+        return std::nullopt;
+    }
+    auto layout = VulkanReflectedPipelineLayout();
+    layout.setLayouts = std::move(*setLayouts);
+    auto setLayoutVks = std::vector<vk::DescriptorSetLayout>();
+    setLayoutVks.reserve(layout.setLayouts.size());
+    for (auto& setLayout : layout.setLayouts) {
+        setLayoutVks.push_back(setLayout.get());
+    }
+    layout.pipelineLayout = BulletRT::Core::VulkanPipelineLayoutBuilder()
+        .SetSetLayouts(setLayoutVks)
+        .SetPushConstantRanges(reflection.pushConstantRanges)
+        .Build(m_Device);
+    if (!layout.pipelineLayout) {
+        return std::nullopt;
+    }
+    return layout;
+}
+
+auto BulletRT::Utils::VulkanReflection::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice*
+{
+    return m_Device;
+}
+
+auto BulletRT::Utils::VulkanReflection::GetReflectionCount() const -> size_t
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Reflections.size();
+}
+
+void BulletRT::Utils::VulkanReflection::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Reflections.clear();
+}
+
+BulletRT::Utils::VulkanReflection::VulkanReflection() noexcept
+{
+    m_Device = nullptr;
+}
+
+auto BulletRT::Utils::VulkanReflection::Impl_Find(uint64_t hash, const std::vector<uint32_t>& codes, const std::string& entryPoint) const -> std::shared_ptr<const VulkanShaderReflection>
+{
+    auto [first, last] = m_Reflections.equal_range(hash);
+    for (auto iter = first; iter != last; ++iter) {
+        if (iter->second.entryPoint == entryPoint && iter->second.codes == codes) {
+            return iter->second.reflection;
+        }
+    }
+    return nullptr;
+}
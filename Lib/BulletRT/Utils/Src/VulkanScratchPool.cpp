@@ -0,0 +1,140 @@
+#include <BulletRT/Utils/VulkanScratchPool.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
+#include <algorithm>
+
+auto BulletRT::Utils::VulkanScratchPool::New(VulkanAllocator* allocator, vk::DeviceSize blockSize, VulkanOffsetAllocatorStrategy strategy) -> std::unique_ptr<VulkanScratchPool>
+{
+    if (!allocator || blockSize == 0 || !allocator->GetDevice()->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) {
+        return nullptr;
+    }
+    auto alignment = allocator->GetDevice()->GetPhysicalDeviceVk().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceAccelerationStructurePropertiesKHR>()
+        .get<vk::PhysicalDeviceAccelerationStructurePropertiesKHR>().minAccelerationStructureScratchOffsetAlignment;
+    alignment = std::max<vk::DeviceSize>(alignment, 1);
+    auto bufferPool = VulkanBufferPool::New(allocator, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress,
+        vk::MemoryPropertyFlagBits::eDeviceLocal, CalcAlignedSize(blockSize, alignment), strategy);
+    if (!bufferPool) {
+        return nullptr;
+    }
+    auto pool = std::unique_ptr<VulkanScratchPool>(new VulkanScratchPool());
+    pool->m_BufferPool = std::move(bufferPool);
+    pool->m_Alignment  = alignment;
+    return pool;
+}
+
+BulletRT::Utils::VulkanScratchPool::~VulkanScratchPool() noexcept
+{
+    m_PendingFrees.clear();
+    m_BufferPool.reset();
+}
+
+auto BulletRT::Utils::VulkanScratchPool::Allocate(vk::DeviceSize size) -> std::optional<VulkanScratchAllocation>
+{
+    if (size == 0) {
+        return std::nullopt;
+    }
+    size = CalcAlignedSize(size, m_Alignment);
+    auto region = m_BufferPool->AllocateRegion(size, m_Alignment);
+    if (!region) {
+        return std::nullopt;
+    }
+    auto baseAddress = region->buffer->GetDeviceAddress();
+    if (!baseAddress) {
+        m_BufferPool->FreeRegion(region.value());
+        return std::nullopt;
+    }
+    auto deviceAddress = baseAddress.value() + region->offset;
+    if (deviceAddress % m_Alignment != 0) {
+        // The buffer itself is not aligned to the scratch alignment, so one extra unit lets the address be rounded up.
+        m_BufferPool->FreeRegion(region.value());
+        region = m_BufferPool->AllocateRegion(size + m_Alignment, m_Alignment);
+        if (!region) {
+            return std::nullopt;
+        }
+        deviceAddress = CalcAlignedSize(region->buffer->GetDeviceAddress().value() + region->offset, m_Alignment);
+    }
+    ++m_AllocationCount;
+    m_AllocatedSize += region->size;
+    auto allocation = VulkanScratchAllocation();
+    allocation.deviceAddress = deviceAddress;
+    allocation.size          = size;
+    allocation.region        = region.value();
+    return allocation;
+}
+
+auto BulletRT::Utils::VulkanScratchPool::Allocate(const BulletRT::Core::VulkanAccelerationStructure* accelerationStructure, vk::BuildAccelerationStructureModeKHR mode) -> std::optional<VulkanScratchAllocation>
+{
+    if (!accelerationStructure || accelerationStructure->GetBuildType() != vk::AccelerationStructureBuildTypeKHR::eDevice) {
+        return std::nullopt;
+    }
+    return Allocate(accelerationStructure->GetScratchSize(mode));
+}
+
+void BulletRT::Utils::VulkanScratchPool::Free(const VulkanScratchAllocation& allocation, uint64_t timelineValue)
+{
+    m_PendingFrees.push_back(PendingFreeDesc{ timelineValue, allocation });
+}
+
+void BulletRT::Utils::VulkanScratchPool::Reclaim(uint64_t completedValue)
+{
+    auto end = std::remove_if(std::begin(m_PendingFrees), std::end(m_PendingFrees), [this, completedValue](const PendingFreeDesc& pendingFree) {
+        if (pendingFree.timelineValue > completedValue) {
+            return false;
+        }
+        m_BufferPool->FreeRegion(pendingFree.allocation.region);
+        --m_AllocationCount;
+        m_AllocatedSize -= pendingFree.allocation.region.size;
+        return true;
+    });
+    m_PendingFrees.erase(end, std::end(m_PendingFrees));
+}
+
+auto BulletRT::Utils::VulkanScratchPool::Reclaim(const BulletRT::Core::VulkanSemaphore* timelineSemaphore) -> vk::Result
+{
+    if (!timelineSemaphore || !timelineSemaphore->IsTimeline()) {
+        return vk::Result::eErrorUnknown;
+    }
+    auto completedValue = timelineSemaphore->QueryCounterValue();
+    if (!completedValue) {
+        return vk::Result::eErrorDeviceLost;
+    }
+    Reclaim(completedValue.value());
+    return vk::Result::eSuccess;
+}
+
+auto BulletRT::Utils::VulkanScratchPool::GetDevice() const noexcept -> const BulletRT::Core::VulkanDevice*
+{
+    return m_BufferPool->GetAllocator()->GetDevice();
+}
+
+auto BulletRT::Utils::VulkanScratchPool::GetBlockSize() const noexcept -> vk::DeviceSize
+{
+    return m_BufferPool->GetBlockSize();
+}
+
+auto BulletRT::Utils::VulkanScratchPool::GetAlignment() const noexcept -> vk::DeviceSize
+{
+    return m_Alignment;
+}
+
+auto BulletRT::Utils::VulkanScratchPool::QueryStatistics() const -> VulkanScratchPoolStatistics
+{
+    auto blockStatistics = m_BufferPool->QueryBlockStatistics();
+    auto statistics = VulkanScratchPoolStatistics();
+    statistics.blockCount       = blockStatistics.size();
+    statistics.totalSize        = 0;
+    statistics.allocatedSize    = m_AllocatedSize;
+    statistics.allocationCount  = m_AllocationCount;
+    statistics.pendingFreeCount = m_PendingFrees.size();
+    for (auto& block : blockStatistics) {
+        statistics.totalSize += block.totalSize;
+    }
+    return statistics;
+}
+
+BulletRT::Utils::VulkanScratchPool::VulkanScratchPool() noexcept
+{
+    m_BufferPool      = nullptr;
+    m_Alignment       = 1;
+    m_AllocatedSize   = 0;
+    m_AllocationCount = 0;
+}
@@ -1,24 +1,6 @@
 #include <BulletRT/Utils/VulkanStaging.h>
+#include <BulletRT/Utils/VulkanMemoryUtils.h>
 #include <cmath>
-static auto FindMemoryTypeIndices(const vk::PhysicalDeviceMemoryProperties& memoryProps,
-    uint32_t memoryTypeBits,
-    vk::MemoryPropertyFlags requiredFlags,
-    vk::MemoryPropertyFlags avoidFlags = vk::MemoryPropertyFlags{}) -> std::vector<uint32_t>
-{
-    auto indices = std::vector<uint32_t>();
-    for (uint32_t i = 0; i < memoryProps.memoryTypeCount; ++i)
-    {
-        if ((static_cast<uint32_t>(1) << i) & memoryTypeBits)
-        {
-            if (((memoryProps.memoryTypes[i].propertyFlags & requiredFlags) == requiredFlags) &&
-                ((memoryProps.memoryTypes[i].propertyFlags & ~avoidFlags) == memoryProps.memoryTypes[i].propertyFlags))
-            {
-                indices.push_back(i);
-            }
-        }
-    }
-    return indices;
-};
 auto BulletRT::Utils::VulkanStaging::New(const BulletRT::Core::VulkanDevice* device, vk::DeviceSize size) -> std::unique_ptr<VulkanStaging>
 {
     auto vulkanMemoryProperties = device->GetPhysicalDeviceVk().getMemoryProperties();
@@ -44,6 +26,7 @@ auto BulletRT::Utils::VulkanStaging::New(const BulletRT::Core::VulkanDevice* dev
     auto vulkanStagingMemory = BulletRT::Core::VulkanDeviceMemory::Builder()
         .SetAllocationSize(sMemRequirements.size)
         .SetMemoryTypeIndex(sMemTypeIndex)
+        .SetPersistentMapped(true)
         .Build(device);
     if (!vulkanStagingMemory) {
         return nullptr;
@@ -94,16 +77,17 @@ auto BulletRT::Utils::VulkanStaging::Upload(const std::vector<VulkanStagingUploa
             maxRange = std::max<uint64_t>(maxRange, desc.offset + desc.sizeInBytes);
         }
     }
-    size_t sizeInBytes = maxRange - minRange;
-    void* pMappedData;
-    auto res = Map(&pMappedData, sizeInBytes, minRange);
-    if (res == vk::Result::eSuccess) {
-        for (auto& desc : executeDescs) {
-            std::memcpy((char*)pMappedData + desc.offset - minRange, desc.pData, desc.sizeInBytes);
-        }
-        Unmap();
+    if (executeDescs.empty()) {
+        return vk::Result::eSuccess;
+    }
+    auto pMappedData = m_Memory->GetMappedData();
+    if (!pMappedData) {
+        return vk::Result::eErrorMemoryMapFailed;
+    }
+    for (auto& desc : executeDescs) {
+        std::memcpy((char*)pMappedData + desc.offset, desc.pData, desc.sizeInBytes);
     }
-    return res;
+    return m_Memory->FlushMappedRange(maxRange - minRange, minRange);
 }
 
 auto BulletRT::Utils::VulkanStaging::GetBuffer() const noexcept -> const BulletRT::Core::VulkanBuffer*
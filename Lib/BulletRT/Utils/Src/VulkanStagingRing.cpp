@@ -0,0 +1,132 @@
+#include <BulletRT/Utils/VulkanStagingRing.h>
+#include <algorithm>
+#include <cstring>
+
+auto BulletRT::Utils::VulkanStagingRing::New(const VulkanStaging* staging) -> std::unique_ptr<VulkanStagingRing>
+{
+    if (!staging || staging->GetSize() == 0) {
+        return nullptr;
+    }
+    auto pMappedData = staging->GetMemory()->GetMappedData();
+    if (!pMappedData) {
+        return nullptr;
+    }
+    auto ring = new VulkanStagingRing();
+    ring->m_Staging    = staging;
+    ring->m_MappedData = pMappedData;
+    return std::unique_ptr<VulkanStagingRing>(ring);
+}
+
+BulletRT::Utils::VulkanStagingRing::~VulkanStagingRing() noexcept
+{
+    m_BatchRegions.clear();
+}
+
+auto BulletRT::Utils::VulkanStagingRing::Write(const void* pData, vk::DeviceSize sizeInBytes, const BulletRT::Core::VulkanBuffer* dstBuffer, vk::DeviceSize dstOffset,
+    const std::function<vk::Result()>& flush, const std::function<bool()>& retire) -> vk::Result
+{
+    auto pSrcData = static_cast<const char*>(pData);
+    while (sizeInBytes > 0) {
+        auto srcOffset = vk::DeviceSize(0);
+        auto chunkSize = Impl_Reserve(sizeInBytes, &srcOffset);
+        if (chunkSize == 0) {
+            // The ring is full: hand the pending copies to the GPU and wait for the oldest batch.
+            auto res = flush();
+            if (res != vk::Result::eSuccess) {
+                return res;
+            }
+            if (!retire()) {
+                return vk::Result::eErrorOutOfDeviceMemory;
+            }
+            continue;
+        }
+        std::memcpy(static_cast<char*>(m_MappedData) + srcOffset, pSrcData, chunkSize);
+        auto& batchRegions = m_BatchRegions[dstBuffer];
+        if (!batchRegions.empty() &&
+            batchRegions.back().srcOffset + batchRegions.back().size == srcOffset &&
+            batchRegions.back().dstOffset + batchRegions.back().size == dstOffset) {
+            batchRegions.back().size += chunkSize;
+        }
+        else {
+            batchRegions.push_back(vk::BufferCopy().setSrcOffset(srcOffset).setDstOffset(dstOffset).setSize(chunkSize));
+        }
+        pSrcData    += chunkSize;
+        dstOffset   += chunkSize;
+        sizeInBytes -= chunkSize;
+        if (m_BatchSize >= GetSize() / 2) {
+            auto res = flush();
+            if (res != vk::Result::eSuccess) {
+                return res;
+            }
+        }
+    }
+    return vk::Result::eSuccess;
+}
+
+auto BulletRT::Utils::VulkanStagingRing::EndBatch() noexcept -> vk::DeviceSize
+{
+    auto batchSize = m_BatchSize;
+    m_BatchRegions.clear();
+    m_BatchSize = 0;
+    return batchSize;
+}
+
+void BulletRT::Utils::VulkanStagingRing::Release(vk::DeviceSize sizeInBytes) noexcept
+{
+    m_UsedSize -= std::min(sizeInBytes, m_UsedSize);
+    if (m_UsedSize == 0) {
+        m_Head = 0;
+    }
+}
+
+auto BulletRT::Utils::VulkanStagingRing::GetStaging() const noexcept -> const VulkanStaging*
+{
+    return m_Staging;
+}
+
+auto BulletRT::Utils::VulkanStagingRing::GetSize() const noexcept -> vk::DeviceSize
+{
+    return m_Staging->GetSize();
+}
+
+auto BulletRT::Utils::VulkanStagingRing::GetUsedSize() const noexcept -> vk::DeviceSize
+{
+    return m_UsedSize;
+}
+
+auto BulletRT::Utils::VulkanStagingRing::GetBatchSize() const noexcept -> vk::DeviceSize
+{
+    return m_BatchSize;
+}
+
+auto BulletRT::Utils::VulkanStagingRing::GetBatchRegions() const noexcept -> const BatchRegions&
+{
+    return m_BatchRegions;
+}
+
+BulletRT::Utils::VulkanStagingRing::VulkanStagingRing() noexcept
+{
+    m_Staging      = nullptr;
+    m_MappedData   = nullptr;
+    m_Head         = 0;
+    m_UsedSize     = 0;
+    m_BatchSize    = 0;
+    m_BatchRegions = {};
+}
+
+auto BulletRT::Utils::VulkanStagingRing::Impl_Reserve(vk::DeviceSize sizeInBytes, vk::DeviceSize* pOffset) noexcept -> vk::DeviceSize
+{
+    auto size = GetSize();
+    if (m_UsedSize >= size) {
+        return 0;
+    }
+    // Live data occupies [tail, head) modulo the ring size; hand out the contiguous run after head.
+    auto tail = (m_Head + size - m_UsedSize) % size;
+    auto contiguousSize = (m_Head >= tail) ? size - m_Head : tail - m_Head;
+    auto chunkSize = std::min(sizeInBytes, contiguousSize);
+    *pOffset = m_Head;
+    m_Head = (m_Head + chunkSize) % size;
+    m_UsedSize  += chunkSize;
+    m_BatchSize += chunkSize;
+    return chunkSize;
+}
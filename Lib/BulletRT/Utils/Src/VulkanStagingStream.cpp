@@ -0,0 +1,133 @@
+#include <BulletRT/Utils/VulkanStagingStream.h>
+
+auto BulletRT::Utils::VulkanStagingStream::New(const VulkanStaging* staging, const BulletRT::Core::VulkanCommandPool* commandPool, const BulletRT::Core::VulkanQueue& queue) -> std::unique_ptr<VulkanStagingStream>
+{
+    if (!staging || !commandPool || commandPool->GetQueueFamilyIndex() != queue.GetQueueFamilyIndex()) {
+        return nullptr;
+    }
+    auto ring = VulkanStagingRing::New(staging);
+    if (!ring) {
+        return nullptr;
+    }
+    auto stream = new VulkanStagingStream();
+    stream->m_Ring        = std::move(ring);
+    stream->m_CommandPool = commandPool;
+    stream->m_Queue       = queue.GetQueueVk();
+    return std::unique_ptr<VulkanStagingStream>(stream);
+}
+
+BulletRT::Utils::VulkanStagingStream::~VulkanStagingStream() noexcept
+{
+    while (Impl_RetireOldestBatch(true)) {}
+    m_Batches.clear();
+    m_FreeCommandBuffers.clear();
+    m_Ring.reset();
+}
+
+auto BulletRT::Utils::VulkanStagingStream::Upload(const void* pData, vk::DeviceSize sizeInBytes, const BulletRT::Core::VulkanBuffer* dstBuffer, vk::DeviceSize dstOffset) -> vk::Result
+{
+    if (!pData || !dstBuffer || dstOffset + sizeInBytes > dstBuffer->GetSize()) {
+        return vk::Result::eErrorUnknown;
+    }
+    return m_Ring->Write(pData, sizeInBytes, dstBuffer, dstOffset,
+        [this]() { return Flush(); },
+        [this]() { return Impl_RetireOldestBatch(true); });
+}
+
+auto BulletRT::Utils::VulkanStagingStream::Flush() -> vk::Result
+{
+    if (m_Ring->GetBatchSize() == 0) {
+        m_Ring->EndBatch();
+        return vk::Result::eSuccess;
+    }
+    while (Impl_RetireOldestBatch(false)) {}
+    auto commandBuffer = std::unique_ptr<BulletRT::Core::VulkanCommandBuffer>();
+    if (!m_FreeCommandBuffers.empty()) {
+        commandBuffer = std::move(m_FreeCommandBuffers.back());
+        m_FreeCommandBuffers.pop_back();
+        commandBuffer->GetCommandBufferVk().reset();
+    }
+    else {
+        commandBuffer = m_CommandPool->NewCommandBuffer(vk::CommandBufferLevel::ePrimary);
+    }
+    auto fence = m_CommandPool->GetDevice()->AcquireFence();
+    if (!commandBuffer || !fence) {
+        return vk::Result::eErrorOutOfHostMemory;
+    }
+    auto commandBufferVk = commandBuffer->GetCommandBufferVk();
+    commandBufferVk.begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    for (auto& [dstBuffer, regions] : m_Ring->GetBatchRegions()) {
+        if (!regions.empty()) {
+            commandBufferVk.copyBuffer(m_Ring->GetStaging()->GetBufferVk(), dstBuffer->GetBufferVk(), regions);
+        }
+    }
+    // Make the copies visible to whatever the queue executes next, so destinations can be used right after Flush.
+    commandBufferVk.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {},
+        vk::MemoryBarrier().setSrcAccessMask(vk::AccessFlagBits::eTransferWrite).setDstAccessMask(vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite),
+        nullptr, nullptr);
+    commandBufferVk.end();
+    auto submitInfo = vk::SubmitInfo().setCommandBuffers(commandBufferVk);
+    auto res = m_Queue.submit(1, &submitInfo, fence->GetFenceVk());
+    if (res != vk::Result::eSuccess) {
+        return res;
+    }
+    m_Batches.push_back(BatchDesc{ std::move(commandBuffer), std::move(fence), m_Ring->EndBatch() });
+    return vk::Result::eSuccess;
+}
+
+auto BulletRT::Utils::VulkanStagingStream::Finish() -> vk::Result
+{
+    auto res = Flush();
+    while (Impl_RetireOldestBatch(true)) {}
+    return res;
+}
+
+auto BulletRT::Utils::VulkanStagingStream::GetStaging() const noexcept -> const VulkanStaging*
+{
+    return m_Ring->GetStaging();
+}
+
+auto BulletRT::Utils::VulkanStagingStream::GetCommandPool() const noexcept -> const BulletRT::Core::VulkanCommandPool*
+{
+    return m_CommandPool;
+}
+
+auto BulletRT::Utils::VulkanStagingStream::GetSize() const noexcept -> vk::DeviceSize
+{
+    return m_Ring->GetSize();
+}
+
+auto BulletRT::Utils::VulkanStagingStream::GetUsedSize() const noexcept -> vk::DeviceSize
+{
+    return m_Ring->GetUsedSize();
+}
+
+auto BulletRT::Utils::VulkanStagingStream::GetPendingBatchCount() const noexcept -> size_t
+{
+    return m_Batches.size();
+}
+
+BulletRT::Utils::VulkanStagingStream::VulkanStagingStream() noexcept
+{
+    m_Ring               = nullptr;
+    m_CommandPool        = nullptr;
+    m_Queue              = vk::Queue();
+}
+
+bool BulletRT::Utils::VulkanStagingStream::Impl_RetireOldestBatch(bool wait)
+{
+    if (m_Batches.empty()) {
+        return false;
+    }
+    auto& batch = m_Batches.front();
+    if (batch.fence->QueryStatus() != vk::Result::eSuccess) {
+        if (!wait || batch.fence->Wait(UINT64_MAX) != vk::Result::eSuccess) {
+            return false;
+        }
+    }
+    m_Ring->Release(batch.sizeInBytes);
+    m_FreeCommandBuffers.push_back(std::move(batch.commandBuffer));
+    m_CommandPool->GetDevice()->ReleaseFence(std::move(batch.fence));
+    m_Batches.pop_front();
+    return true;
+}
@@ -0,0 +1,142 @@
+#include <BulletRT/Utils/VulkanWorkerPool.h>
+#include <algorithm>
+
+auto BulletRT::Utils::VulkanWorkerPool::New(uint32_t workerCount) -> std::unique_ptr<VulkanWorkerPool>
+{
+    if (workerCount == 0) {
+        workerCount = std::max<uint32_t>(std::thread::hardware_concurrency(), 2) - 1;
+    }
+    auto pool = std::unique_ptr<VulkanWorkerPool>(new VulkanWorkerPool());
+    pool->m_Workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        pool->m_Workers.emplace_back(&VulkanWorkerPool::Impl_WorkerMain, pool.get());
+    }
+    return pool;
+}
+
+BulletRT::Utils::VulkanWorkerPool::~VulkanWorkerPool() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Exit = true;
+    }
+    m_WorkCondition.notify_all();
+    for (auto& worker : m_Workers) {
+        worker.join();
+    }
+    m_Workers.clear();
+}
+
+void BulletRT::Utils::VulkanWorkerPool::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func)
+{
+    if (count == 0) {
+        return;
+    }
+    grainSize = std::max<size_t>(grainSize, 1);
+    if (m_Workers.empty() || count <= grainSize) {
+        for (size_t begin = 0; begin < count; begin += grainSize) {
+            func(begin, std::min(begin + grainSize, count));
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Func        = &func;
+        m_Count       = count;
+        m_GrainSize   = grainSize;
+        m_NextBegin   = 0;
+        // Workers add themselves while ranges are left, so the wait below only covers threads that took part.
+        m_ActiveCount = 1;
+    }
+    m_WorkCondition.notify_all();
+    Impl_RunRanges();
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this] { return m_ActiveCount == 0; });
+    m_Func = nullptr;
+}
+
+void BulletRT::Utils::VulkanWorkerPool::Submit(std::function<void()> task)
+{
+    if (m_Workers.empty()) {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Tasks.push_back(std::move(task));
+    }
+    m_WorkCondition.notify_one();
+}
+
+auto BulletRT::Utils::VulkanWorkerPool::GetWorkerCount() const noexcept -> uint32_t
+{
+    return static_cast<uint32_t>(m_Workers.size());
+}
+
+auto BulletRT::Utils::VulkanWorkerPool::GetSubmitter() noexcept -> std::function<void(std::function<void()>)>
+{
+    return [this](std::function<void()> task) { Submit(std::move(task)); };
+}
+
+auto BulletRT::Utils::VulkanWorkerPool::GetThreadCount() const noexcept -> uint32_t
+{
+    return GetWorkerCount() + 1;
+}
+
+BulletRT::Utils::VulkanWorkerPool::VulkanWorkerPool() noexcept
+{
+    m_Func        = nullptr;
+    m_Count       = 0;
+    m_GrainSize   = 1;
+    m_NextBegin   = 0;
+    m_ActiveCount = 0;
+    m_Exit        = false;
+}
+
+void BulletRT::Utils::VulkanWorkerPool::Impl_WorkerMain()
+{
+    while (true) {
+        auto task = std::function<void()>();
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WorkCondition.wait(lock, [this] { return m_Exit || (m_Func && m_NextBegin < m_Count) || !m_Tasks.empty(); });
+            if (m_Func && m_NextBegin < m_Count) {
+                ++m_ActiveCount;
+            }
+            else if (!m_Tasks.empty()) {
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            else {
+                return;
+            }
+        }
+        if (task) {
+            task();
+        }
+        else {
+            Impl_RunRanges();
+        }
+    }
+}
+
+void BulletRT::Utils::VulkanWorkerPool::Impl_RunRanges()
+{
+    while (true) {
+        auto begin = size_t(0);
+        auto end   = size_t(0);
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_NextBegin >= m_Count) {
+                if (--m_ActiveCount == 0) {
+                    m_DoneCondition.notify_one();
+                }
+                return;
+            }
+            begin = m_NextBegin;
+            end   = std::min(begin + m_GrainSize, m_Count);
+            m_NextBegin = end;
+        }
+        (*m_Func)(begin, end);
+    }
+}
@@ -2,6 +2,10 @@
 #define TEST0_TEST0_H
 #include <BulletRT/Core/BulletRTCore.h>
 #include <BulletRT/Utils/VulkanStaging.h>
+#include <BulletRT/Utils/VulkanStagingStream.h>
+#include <BulletRT/Utils/VulkanAsyncUploader.h>
+#include <BulletRT/Utils/VulkanAllocator.h>
+#include <BulletRT/Utils/VulkanGeometryStore.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <string>
@@ -32,20 +36,24 @@ private:
         BulletRT::Core::VulkanContext::Initialize();
         InitInstance();
         InitDevice();
+        InitAllocator();
         InitCommandPool();
         if (IsDiscrateGpu())
         {
             InitStaging(128 * 1024 * 1024);
         }
         InitMesh();
+        InitAccelerationStructure();
         InitRenderPass();
     }
     void Terminate()
     {
         FreeRenderPass();
+        FreeAccelerationStructure();
         FreeMesh();
         FreeStaging();
         FreeCommandPool();
+        FreeAllocator();
         FreeDevice();
         FreeInstance();
         BulletRT::Core::VulkanContext::Terminate();
@@ -60,6 +68,11 @@ private:
     {
         m_VulkanDevice.reset();
     }
+    void InitAllocator();
+    void FreeAllocator()
+    {
+        m_VulkanAllocator.reset();
+    }
     void InitStaging(vk::DeviceSize deviceSize);
     void FreeStaging()
     {
@@ -82,11 +95,15 @@ private:
     }
     void InitMesh();
     void FreeMesh(){
+        m_VulkanGeometryStore.reset();
+        m_VulkanVertAllocation.reset();
+        m_VulkanIndxAllocation.reset();
         m_VulkanVertMeshBuffer.reset();
         m_VulkanIndxMeshBuffer.reset();
-        m_VulkanMeshMemories.clear();
-        m_VulkanVertMemoryBuffer.reset();
-        m_VulkanIndxMemoryBuffer.reset();
+    }
+    void InitAccelerationStructure();
+    void FreeAccelerationStructure(){
+        m_VulkanBlas.reset();
     }
     void InitRenderPass();
     void FreeRenderPass(){
@@ -165,15 +182,18 @@ private:
     std::optional<BulletRT::Core::VulkanQueueFamily>   m_VulkanTQueueFamily = std::nullopt;
     std::unique_ptr<BulletRT::Core::VulkanCommandPool> m_VulkanTCommandPool = nullptr;
     
-    std::unique_ptr<BulletRT::Utils::VulkanStaging> m_VulkanStaging             = nullptr;
-    size_t                                          m_VulkanStagingMemoryOffset = 0;
+    std::unique_ptr<BulletRT::Utils::VulkanAllocator> m_VulkanAllocator           = nullptr;
+    std::unique_ptr<BulletRT::Utils::VulkanStaging>   m_VulkanStaging             = nullptr;
+    size_t                                            m_VulkanStagingMemoryOffset = 0;
 
-    std::vector<std::unique_ptr<BulletRT::Core::VulkanDeviceMemory>> m_VulkanMeshMemories     = {};
-    std::unique_ptr<BulletRT::Core::VulkanBuffer>                    m_VulkanVertMeshBuffer   = nullptr;
-    std::unique_ptr<BulletRT::Core::VulkanMemoryBuffer>              m_VulkanVertMemoryBuffer = nullptr;
-    std::unique_ptr<BulletRT::Core::VulkanBuffer>                    m_VulkanIndxMeshBuffer   = nullptr;
-    std::unique_ptr<BulletRT::Core::VulkanMemoryBuffer>              m_VulkanIndxMemoryBuffer = nullptr;
-    std::unique_ptr<BulletRT::Core::VulkanRenderPass>                m_VulkanRenderPass       = nullptr;
+    std::unique_ptr<BulletRT::Core::VulkanBuffer>      m_VulkanVertMeshBuffer   = nullptr;
+    std::unique_ptr<BulletRT::Utils::VulkanAllocation> m_VulkanVertAllocation   = nullptr;
+    std::unique_ptr<BulletRT::Core::VulkanBuffer>      m_VulkanIndxMeshBuffer   = nullptr;
+    std::unique_ptr<BulletRT::Utils::VulkanAllocation> m_VulkanIndxAllocation   = nullptr;
+    std::unique_ptr<BulletRT::Utils::VulkanGeometryStore> m_VulkanGeometryStore = nullptr;
+    BulletRT::Utils::VulkanGeometryHandle              m_VulkanTriMeshHandle    = BulletRT::Utils::VulkanGeometryStore::InvalidHandle;
+    std::unique_ptr<BulletRT::Core::VulkanAccelerationStructure> m_VulkanBlas   = nullptr;
+    std::unique_ptr<BulletRT::Core::VulkanRenderPass>  m_VulkanRenderPass       = nullptr;
     
     GLFWwindow* m_Window = nullptr;
     int m_FbWidth  = 0;
@@ -163,7 +163,8 @@ void Test0Application::InitDevice()
                      .ResetFeatures<vk::PhysicalDeviceRayTracingPipelineFeaturesKHR>()
                      .ResetFeatures<vk::PhysicalDeviceRayQueryFeaturesKHR>()
                      .ResetFeatures<vk::PhysicalDeviceAccelerationStructureFeaturesKHR>()
-                     .SetQueueFamilies(queueFamilyBuilders);
+                     .SetQueueFamilies(queueFamilyBuilders)
+                     .SetPipelineCacheFilename("Test0.pipelinecache");
     }
 
     m_VulkanDevice = std::unique_ptr<BulletRT::Core::VulkanDevice>(deviceBuilders.front().Build());
@@ -192,6 +193,11 @@ void Test0Application::InitStaging(vk::DeviceSize deviceSize)
     m_VulkanStaging = BulletRT::Utils::VulkanStaging::New(m_VulkanDevice.get(), deviceSize);
 }
 
+void Test0Application::InitAllocator()
+{
+    m_VulkanAllocator = BulletRT::Utils::VulkanAllocator::New(m_VulkanDevice.get());
+}
+
 void Test0Application::InitCommandPool()
 {
     {
@@ -214,10 +220,40 @@ void Test0Application::InitMesh()
     auto triIndxData = std::vector<uint32_t>{ 0,1,2 };
 
     auto triVertSize = triVertData.size() * sizeof(triVertData[0]);
-    auto triVertOffs = size_t(0);
     auto triIndxSize = triIndxData.size() * sizeof(triIndxData[0]);
-    auto triIndxOffs = triVertOffs;
-    
+
+    auto memPropRequired  = IsDiscrateGpu() ? vk::MemoryPropertyFlagBits::eDeviceLocal : vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+    auto memPropAvoided   = IsDiscrateGpu() ? vk::MemoryPropertyFlagBits::eHostVisible : vk::MemoryPropertyFlags{};
+
+    if (m_VulkanDevice->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) {
+        m_VulkanGeometryStore = BulletRT::Utils::VulkanGeometryStore::New(m_VulkanAllocator.get(), 16 * 1024 * 1024, 16 * 1024 * 1024, 1024, memPropRequired, memPropAvoided);
+        if (!m_VulkanGeometryStore) {
+            throw std::runtime_error("Failed To Create Geometry Store!");
+        }
+        auto stagingStream = std::unique_ptr<BulletRT::Utils::VulkanStagingStream>();
+        if (IsDiscrateGpu()) {
+            stagingStream = BulletRT::Utils::VulkanStagingStream::New(m_VulkanStaging.get(), m_VulkanGCommandPool.get(), m_VulkanGQueueFamily->GetQueues().front());
+            if (!stagingStream) {
+                throw std::runtime_error("Failed To Create Staging Stream!");
+            }
+        }
+        auto triMeshDesc = BulletRT::Utils::VulkanGeometryMeshDesc{};
+        triMeshDesc.pVertexData  = triVertData.data();
+        triMeshDesc.vertexFormat = vk::Format::eR32G32B32Sfloat;
+        triMeshDesc.vertexStride = 3 * sizeof(float);
+        triMeshDesc.vertexCount  = 3;
+        triMeshDesc.pIndexData   = triIndxData.data();
+        triMeshDesc.indexCount   = static_cast<uint32_t>(triIndxData.size());
+        m_VulkanTriMeshHandle = m_VulkanGeometryStore->AddMesh(triMeshDesc, stagingStream.get());
+        if (m_VulkanTriMeshHandle == BulletRT::Utils::VulkanGeometryStore::InvalidHandle) {
+            throw std::runtime_error("Failed To Upload Mesh Data!");
+        }
+        if (stagingStream && stagingStream->Finish() != vk::Result::eSuccess) {
+            throw std::runtime_error("Failed To Upload Mesh Data!");
+        }
+        return;
+    }
+
     auto bufferUsageExt = vk::BufferUsageFlags{};
 
     if (IsDiscrateGpu()) {
@@ -239,111 +275,89 @@ void Test0Application::InitMesh()
         .SetSize(triIndxSize)
         .Build(m_VulkanDevice.get());
 
-    auto vMemRequirements = m_VulkanVertMeshBuffer->QueryMemoryRequirements();
-    auto iMemRequirements = m_VulkanIndxMeshBuffer->QueryMemoryRequirements();
-
-    auto memPropRequired  = IsDiscrateGpu() ? vk::MemoryPropertyFlagBits::eDeviceLocal : vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
-    auto memPropAvoided   = IsDiscrateGpu() ? vk::MemoryPropertyFlagBits::eHostVisible : vk::MemoryPropertyFlags{};
-
-    auto vMemTypeIndices = FindMemoryTypeIndices(m_VulkanMemoryProperties, vMemRequirements.memoryTypeBits, memPropRequired, memPropAvoided);
-    auto iMemTypeIndices = FindMemoryTypeIndices(m_VulkanMemoryProperties, iMemRequirements.memoryTypeBits, memPropRequired, memPropAvoided);
-
-    if ( vMemTypeIndices.empty()||iMemTypeIndices.empty()) {
-        throw std::runtime_error("Failed To Find Memory Type!");
-    }
-
-    auto vMemTypeIndex = vMemTypeIndices.front();
-    auto iMemTypeIndex = iMemTypeIndices.front();
-
-    if (vMemTypeIndex == iMemTypeIndex) {
-        auto vertBufferOffset = 0;
-        auto vertBufferSize   = vMemRequirements.size;
-        auto indxBufferOffset = CalcAlignedSize(vertBufferSize, iMemRequirements.alignment);
-        auto indxBufferSize   = iMemRequirements.size;
-        auto allocationSize   = indxBufferOffset + indxBufferSize;
+    m_VulkanVertAllocation = m_VulkanAllocator->AllocateBuffer(m_VulkanVertMeshBuffer.get(), memPropRequired, memPropAvoided);
+    m_VulkanIndxAllocation = m_VulkanAllocator->AllocateBuffer(m_VulkanIndxMeshBuffer.get(), memPropRequired, memPropAvoided);
 
-        m_VulkanMeshMemories.reserve(1);
-        m_VulkanMeshMemories.push_back(BulletRT::Core::VulkanDeviceMemory::Builder()
-            .SetMemoryTypeIndex(vMemTypeIndex)
-            .SetAllocationSize(allocationSize)
-            .SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress))
-            .Build(m_VulkanDevice.get())
-        );
-        m_VulkanVertMemoryBuffer = BulletRT::Core::VulkanMemoryBuffer::Bind(
-            m_VulkanVertMeshBuffer.get(), m_VulkanMeshMemories.front().get(), vertBufferOffset
-        );
-        m_VulkanIndxMemoryBuffer = BulletRT::Core::VulkanMemoryBuffer::Bind(
-            m_VulkanIndxMeshBuffer.get(), m_VulkanMeshMemories.front().get(), indxBufferOffset
-        );
-    }
-    else {
-        m_VulkanMeshMemories.reserve(2);
-        m_VulkanMeshMemories.push_back(BulletRT::Core::VulkanDeviceMemory::Builder()
-            .SetMemoryTypeIndex(vMemTypeIndex)
-            .SetAllocationSize(vMemRequirements.size)
-            .SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress))
-            .Build(m_VulkanDevice.get())
-        );
-        m_VulkanMeshMemories.push_back(BulletRT::Core::VulkanDeviceMemory::Builder()
-            .SetMemoryTypeIndex(iMemTypeIndex)
-            .SetAllocationSize(iMemRequirements.size)
-            .SetMemoryAllocateFlagsInfo(vk::MemoryAllocateFlagsInfo().setFlags(vk::MemoryAllocateFlagBits::eDeviceAddress))
-            .Build(m_VulkanDevice.get())
-        );
-        m_VulkanVertMemoryBuffer = BulletRT::Core::VulkanMemoryBuffer::Bind(
-            m_VulkanVertMeshBuffer.get(), m_VulkanMeshMemories[0].get(), 0
-        );
-        m_VulkanIndxMemoryBuffer = BulletRT::Core::VulkanMemoryBuffer::Bind(
-            m_VulkanIndxMeshBuffer.get(), m_VulkanMeshMemories[1].get(), 0
-        );
+    if (!m_VulkanVertAllocation || !m_VulkanIndxAllocation) {
+        throw std::runtime_error("Failed To Allocate Mesh Memory!");
     }
 
     if (!IsDiscrateGpu()) {
-        if (vMemTypeIndex == iMemTypeIndex) {
-            void* pMapedData;
-            if (m_VulkanMeshMemories.front()->Map(&pMapedData) == vk::Result::eSuccess) {
-                std::memcpy((char*)pMapedData + m_VulkanVertMemoryBuffer->GetMemoryOffset(), triVertData.data(), triVertSize);
-                std::memcpy((char*)pMapedData + m_VulkanIndxMemoryBuffer->GetMemoryOffset(), triIndxData.data(), triIndxSize);
-                m_VulkanMeshMemories.front()->Unmap();
-            }
+        void* pMapedData;
+        if (m_VulkanVertAllocation->GetMemoryBuffer()->Map(&pMapedData) == vk::Result::eSuccess) {
+            std::memcpy((char*)pMapedData, triVertData.data(), triVertSize);
+            m_VulkanVertAllocation->GetMemoryBuffer()->Unmap();
         }
-        else {
-            void* pMapedData;
-            if (m_VulkanVertMemoryBuffer->Map(&pMapedData) == vk::Result::eSuccess) {
-                std::memcpy((char*)pMapedData, triVertData.data(), triVertSize);
-                m_VulkanVertMemoryBuffer->Unmap();
-            }
-            if (m_VulkanIndxMemoryBuffer->Map(&pMapedData) == vk::Result::eSuccess) {
-                std::memcpy((char*)pMapedData, triIndxData.data(), triIndxSize);
-                m_VulkanIndxMemoryBuffer->Unmap();
-            }
+        if (m_VulkanIndxAllocation->GetMemoryBuffer()->Map(&pMapedData) == vk::Result::eSuccess) {
+            std::memcpy((char*)pMapedData, triIndxData.data(), triIndxSize);
+            m_VulkanIndxAllocation->GetMemoryBuffer()->Unmap();
         }
         return;
     }
 
-    m_VulkanStaging->Upload({
-          {triVertData.data(),triVertSize,triVertOffs},
-          {triIndxData.data(),triIndxSize,triIndxOffs}
-    });
-
-    auto copyCommand = m_VulkanGCommandPool->NewCommandBuffer(vk::CommandBufferLevel::ePrimary);
-    copyCommand->GetCommandBufferVk().begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
-    copyCommand->GetCommandBufferVk().copyBuffer(m_VulkanStaging->GetBufferVk(), m_VulkanVertMeshBuffer->GetBufferVk(), vk::BufferCopy().setSize(triVertSize).setSrcOffset(triVertOffs));
-    copyCommand->GetCommandBufferVk().copyBuffer(m_VulkanStaging->GetBufferVk(), m_VulkanIndxMeshBuffer->GetBufferVk(), vk::BufferCopy().setSize(triIndxSize).setSrcOffset(triIndxOffs));
-    copyCommand->GetCommandBufferVk().end();
+    if (m_VulkanTQueueFamily && m_VulkanTCommandPool) {
+        auto asyncUploader = BulletRT::Utils::VulkanAsyncUploader::New(m_VulkanStaging.get(), m_VulkanTCommandPool.get(), m_VulkanTQueueFamily->GetQueues().front(), m_VulkanGQueueFamily->GetQueueFamilyIndex());
+        if (asyncUploader) {
+            asyncUploader->Upload(triVertData.data(), triVertSize, m_VulkanVertMeshBuffer.get());
+            asyncUploader->Upload(triIndxData.data(), triIndxSize, m_VulkanIndxMeshBuffer.get());
+            auto uploadValue = asyncUploader->Submit();
+            if (!uploadValue) {
+                throw std::runtime_error("Failed To Upload Mesh Data!");
+            }
+            auto acquireCommand = m_VulkanGCommandPool->NewCommandBuffer(vk::CommandBufferLevel::ePrimary);
+            auto acquireCommandVk = acquireCommand->GetCommandBufferVk();
+            acquireCommandVk.begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+            asyncUploader->RecordAcquireBarriers(acquireCommandVk, uploadValue.value());
+            acquireCommandVk.end();
 
-    auto copyCommandVk = copyCommand->GetCommandBufferVk();
+            auto gQueue = m_VulkanGQueueFamily->GetQueues().front();
+            auto gFence = m_VulkanDevice->AcquireFence();
+            gQueue.Submit(BulletRT::Core::VulkanSubmitDesc()
+                .AddWaitSemaphore(asyncUploader->GetSemaphore(), vk::PipelineStageFlagBits::eAllCommands, uploadValue.value())
+                .AddCommandBuffer(acquireCommand.get()), gFence.get());
+            gFence->Wait(UINT64_MAX);
+            m_VulkanDevice->ReleaseFence(std::move(gFence));
+            return;
+        }
+    }
 
-    auto gQueue = m_VulkanGQueueFamily->GetQueues().front();
-    auto gFence = m_VulkanDevice->NewFence();
-    gQueue.GetQueueVk().submit(vk::SubmitInfo().setCommandBuffers(copyCommandVk), gFence->GetFenceVk());
+    auto stagingStream = BulletRT::Utils::VulkanStagingStream::New(m_VulkanStaging.get(), m_VulkanGCommandPool.get(), m_VulkanGQueueFamily->GetQueues().front());
+    if (!stagingStream) {
+        throw std::runtime_error("Failed To Create Staging Stream!");
+    }
+    stagingStream->Upload(triVertData.data(), triVertSize, m_VulkanVertMeshBuffer.get());
+    stagingStream->Upload(triIndxData.data(), triIndxSize, m_VulkanIndxMeshBuffer.get());
+    if (stagingStream->Finish() != vk::Result::eSuccess) {
+        throw std::runtime_error("Failed To Upload Mesh Data!");
+    }
+}
 
-    if (gFence->QueryStatus() != vk::Result::eSuccess)
-    {
-        gFence->Wait(UINT64_MAX);
+void Test0Application::InitAccelerationStructure()
+{
+    if (!m_VulkanDevice->SupportExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME)) {
+        return;
     }
-    gFence.reset();
-    copyCommand.reset();
+    m_VulkanBlas = BulletRT::Core::VulkanAccelerationStructure::Builder()
+        .SetType(vk::AccelerationStructureTypeKHR::eBottomLevel)
+        .SetFlags(vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace)
+        .AddGeometry(m_VulkanGeometryStore->GetGeometryDesc(m_VulkanTriMeshHandle).value())
+        .Build(m_VulkanDevice.get());
+    if (!m_VulkanBlas) {
+        throw std::runtime_error("Failed To Create Acceleration Structure!");
+    }
+    auto buildCommand = m_VulkanGCommandPool->NewCommandBuffer(vk::CommandBufferLevel::ePrimary);
+    auto buildCommandVk = buildCommand->GetCommandBufferVk();
+    buildCommandVk.begin(vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    if (m_VulkanBlas->RecordBuild(buildCommandVk) != vk::Result::eSuccess) {
+        throw std::runtime_error("Failed To Build Acceleration Structure!");
+    }
+    buildCommandVk.end();
+
+    auto gQueue = m_VulkanGQueueFamily->GetQueues().front();
+    auto gFence = m_VulkanDevice->AcquireFence();
+    gQueue.Submit(BulletRT::Core::VulkanSubmitDesc().AddCommandBuffer(buildCommand.get()), gFence.get());
+    gFence->Wait(UINT64_MAX);
+    m_VulkanDevice->ReleaseFence(std::move(gFence));
 }
 
 void Test0Application::InitRenderPass()